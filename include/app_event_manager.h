@@ -122,6 +122,50 @@ static inline bool app_event_get_type_flag(const struct event_type *et,
 	_APP_EVENT_SUBSCRIBE(lname, ename, _APP_EM_SUBS_PRIO_ID(_APP_EM_SUBS_PRIO_NORMAL))
 
 
+/** @brief Subscribe a listener to the early notification list for an
+ *  event type with a filter on the event field.
+ *
+ * The listener is notified only about the events with the @p field of the event
+ * structure equal to @p value. The filter is evaluated by the Application Event Manager,
+ * so the listener is not called for other events of the type.
+ *
+ * @note
+ * For this macro to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_SUBSCRIBER_FILTERS} option needs to be enabled.
+ *
+ * @param lname  Name of the listener.
+ * @param ename  Name of the event.
+ * @param field  Name of the filtered field of the event structure. The field size must be 1, 2, 4
+ *               bytes or equal to the size of a pointer.
+ * @param value  Value of the field required to notify the listener.
+ */
+#define APP_EVENT_SUBSCRIBE_EARLY_FILTER(lname, ename, field, value)			\
+	_APP_EVENT_SUBSCRIBE_FILTER(lname, ename,					\
+		_APP_EM_SUBS_PRIO_ID(_APP_EM_SUBS_PRIO_EARLY), field, value)
+
+
+/** @brief Subscribe a listener to the normal notification list for an event
+ *  type with a filter on the event field.
+ *
+ * The listener is notified only about the events with the @p field of the event
+ * structure equal to @p value. The filter is evaluated by the Application Event Manager,
+ * so the listener is not called for other events of the type.
+ *
+ * @note
+ * For this macro to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_SUBSCRIBER_FILTERS} option needs to be enabled.
+ *
+ * @param lname  Name of the listener.
+ * @param ename  Name of the event.
+ * @param field  Name of the filtered field of the event structure. The field size must be 1, 2, 4
+ *               bytes or equal to the size of a pointer.
+ * @param value  Value of the field required to notify the listener.
+ */
+#define APP_EVENT_SUBSCRIBE_FILTER(lname, ename, field, value)				\
+	_APP_EVENT_SUBSCRIBE_FILTER(lname, ename,					\
+		_APP_EM_SUBS_PRIO_ID(_APP_EM_SUBS_PRIO_NORMAL), field, value)
+
+
 /** @brief Subscribe a listener to an event type as final module that is
  *  being notified.
  *
@@ -178,6 +222,24 @@ static inline bool app_event_get_type_flag(const struct event_type *et,
 	_APP_EVENT_TYPE_DEFINE(ename, log_fn, ev_info_struct, app_event_type_flags)
 
 
+/** @brief Assign an event type to an event queue.
+ *
+ * Events of the given type are processed by the thread dedicated to the selected event queue.
+ * The thread processing the event queue with a higher index runs with a higher priority.
+ * Event types that are not assigned to any queue are processed by the queue with index 0.
+ * Only one assignment can be defined for a given event type.
+ *
+ * The assignment takes effect only if @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES}
+ * is enabled. Otherwise, all events are processed by a single queue.
+ *
+ * @param ename      Name of the event.
+ * @param queue_idx  Index of the event queue, lower than
+ *                   @kconfig{CONFIG_APP_EVENT_MANAGER_EVENT_QUEUE_COUNT}.
+ */
+#define APP_EVENT_TYPE_QUEUE_ASSIGN(ename, queue_idx) \
+	_APP_EVENT_TYPE_QUEUE_ASSIGN(ename, queue_idx)
+
+
 /** @brief Verify if an event ID is valid.
  *
  * The pointer to an event type structure is used as its ID. This macro
@@ -197,6 +259,38 @@ static inline bool app_event_get_type_flag(const struct event_type *et,
  */
 #define APP_EVENT_SUBMIT(event) _event_submit(&event->header)
 
+/** @brief Submit multiple events.
+ *
+ * The events are added to the event queues in the order of the array, under a single
+ * lock acquisition. The event queue processing is scheduled once for the whole batch.
+ *
+ * @param aehs  Array of pointers to the application event headers of the events.
+ * @param cnt   Number of events in the array.
+ */
+#define APP_EVENT_SUBMIT_BATCH(aehs, cnt) _event_submit_batch(aehs, cnt)
+
+/** @brief Define an event type as coalescing.
+ *
+ * If an event of the coalescing type is submitted while another event of the same type is
+ * still pending, that is, it was submitted but its delivery to listeners has not started yet,
+ * the merge function is called. If the merge function returns true, the submitted event is
+ * freed and it is not delivered. The merged data is delivered at the position of the pending
+ * event in the event queue.
+ *
+ * The merge function should have a form
+ * `bool merge(struct app_event_header *pending, const struct app_event_header *aeh)`.
+ * The function is called with the Application Event Manager lock held, so it must be short
+ * and must not block.
+ *
+ * @note
+ * For this macro to be available the
+ * @kconfig{CONFIG_APP_EVENT_MANAGER_COALESCING} option needs to be enabled.
+ *
+ * @param ename     Name of the event.
+ * @param merge_fn  Merge function.
+ */
+#define APP_EVENT_TYPE_COALESCE(ename, merge_fn) _APP_EVENT_TYPE_COALESCE(ename, merge_fn)
+
 /**
  * @brief Register event hook after the Application Event Manager is initialized.
  *
@@ -385,6 +479,8 @@ int app_event_manager_init(void);
  * The behavior of this function depends on the actual implementation.
  * The default implementation of this function is same as k_malloc.
  * It is annotated as weak and can be overridden by user.
+ * If @kconfig{CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB} is enabled, the function is used only
+ * for events with dynamic data.
  *
  * @param size  Amount of memory requested (in bytes).
  * @retval Address of the allocated memory if successful, otherwise NULL.
@@ -396,6 +492,8 @@ void *app_event_manager_alloc(size_t size);
  *
  * The behavior of this function depends on the actual implementation.
  * The default implementation of this function is same as k_free.
+ * If @kconfig{CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB} is enabled, the default implementation
+ * also returns events allocated from the memory slabs to the slabs.
  * It is annotated as weak and can be overridden by user.
  *
  * @param addr  Pointer to previously allocated memory.
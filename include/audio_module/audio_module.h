@@ -90,6 +90,11 @@ struct audio_module_context;
  */
 struct audio_module_configuration;
 
+/**
+ * @brief Graph of modules run by a single scheduler thread.
+ */
+struct audio_module_graph;
+
 /**
  * @brief Callback function for a response to a data_send as
  *        supplied by the module user.
@@ -247,6 +252,18 @@ struct audio_module_parameters {
 
 	/* The module's thread setting. */
 	struct audio_module_thread_configuration thread;
+
+#if CONFIG_AUDIO_MODULE_GRAPH
+	/* The graph to run the module in, or NULL to run the module in its own thread.
+	 * A module run in a graph does not need a thread stack.
+	 */
+	struct audio_module_graph *graph;
+
+	/* Processing time budget in microseconds for the module when run in a graph, 0 for
+	 * none. A frame processed in a longer time is counted as a deadline miss.
+	 */
+	uint32_t deadline_us;
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
 };
 
 /**
@@ -280,8 +297,13 @@ struct audio_module_handle {
 	/* Number of destination modules. */
 	uint8_t dest_count;
 
-	/* Semaphore to count messages between modules and on a module's TX FIFO. */
-	struct k_sem sem;
+	/* Reference count for each of the audio data buffers in the module's data slab. A buffer
+	 * is returned to the slab when the last module or FIFO holding it releases it.
+	 * The handle is allocated by the caller and the library does not use the heap, so the
+	 * array cannot be sized from the slab when the module is opened. Its size is an upper
+	 * bound instead, and only the first num_blocks entries of the slab are used.
+	 */
+	atomic_t data_ref[CONFIG_AUDIO_MODULE_BUFFER_POOL_SIZE];
 
 	/* Mutex to make the above destinations list thread safe. */
 	struct k_mutex dest_mutex;
@@ -291,6 +313,14 @@ struct audio_module_handle {
 
 	/* Private context for the module. */
 	struct audio_module_context *context;
+
+#if CONFIG_AUDIO_MODULE_GRAPH
+	/* The graph the module is run in, NULL if the module runs in its own thread. */
+	struct audio_module_graph *graph;
+
+	/* Index of the module in the graph. */
+	uint8_t graph_node;
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
 };
 
 /**
@@ -307,9 +337,99 @@ struct audio_module_message {
 	audio_module_response_cb response_cb;
 };
 
+#if CONFIG_AUDIO_MODULE_GRAPH || defined(__DOXYGEN__)
+/**
+ * @brief Processing time and deadline statistics of a graph or of a module in a graph.
+ */
+struct audio_module_graph_stats {
+	/* Number of frames processed. */
+	uint32_t frame_count;
+
+	/* Number of frames processed in a longer time than the deadline. */
+	uint32_t deadline_miss_count;
+
+	/* Processing time of the last frame in microseconds. */
+	uint32_t process_time_last_us;
+
+	/* Longest processing time of a frame in microseconds. */
+	uint32_t process_time_max_us;
+
+	/* Sum of the processing times of all frames in microseconds. */
+	uint64_t process_time_total_us;
+};
+
+/**
+ * @brief Private structure describing a module in a graph.
+ */
+struct audio_module_graph_node {
+	/* The module's handle, NULL if the node is free. */
+	struct audio_module_handle *handle;
+
+	/* Processing time budget in microseconds, 0 for none. */
+	uint32_t deadline_us;
+
+	/* Flag to indicate that no other module in the graph sends audio data to the module. */
+	bool root;
+
+	/* Audio data sent to the module by other modules in the graph during the frame. */
+	struct audio_module_message pending[CONFIG_AUDIO_MODULE_GRAPH_INPUTS_MAX];
+
+	/* Number of pending audio data items. */
+	uint8_t pending_count;
+
+	/* Processing time statistics of the module. */
+	struct audio_module_graph_stats stats;
+};
+
+/**
+ * @brief Graph of modules run by a single scheduler thread.
+ */
+struct audio_module_graph {
+	/* Scheduler thread ID. */
+	k_tid_t thread_id;
+
+	/* Scheduler thread data. */
+	struct k_thread thread_data;
+
+	/* Scheduler thread stack. */
+	k_thread_stack_t *stack;
+
+	/* Scheduler thread stack size. */
+	size_t stack_size;
+
+	/* Scheduler thread priority. */
+	int priority;
+
+	/* Processing time budget for a frame in microseconds, 0 for none. */
+	uint32_t deadline_us;
+
+	/* Flag to tell the scheduler thread to keep running frames, cleared to stop it. */
+	atomic_t running;
+
+	/* Modules in the graph. */
+	struct audio_module_graph_node nodes[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+
+	/* Number of modules in the graph. */
+	uint8_t node_count;
+
+	/* Indexes of the nodes in the order they are run. */
+	uint8_t order[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX];
+
+	/* Processing time statistics of the whole frame. */
+	struct audio_module_graph_stats stats;
+
+	/* Lock for reading the statistics while the graph is running. */
+	struct k_spinlock lock;
+};
+#endif /* CONFIG_AUDIO_MODULE_GRAPH || defined(__DOXYGEN__) */
+
 /**
  * @brief Open an audio module.
  *
+ * @note The module's data slab can hold at most CONFIG_AUDIO_MODULE_BUFFER_POOL_SIZE buffers.
+ *       The buffers are reference counted, so the audio data sent to several modules shares
+ *       a single buffer.
+ *
  * @param parameters     [in]      Pointer to the module set-up parameters.
  * @param configuration  [in]      Pointer to the module's configuration.
  * @param name           [in]      A NULL terminated string giving a unique name for this module
@@ -367,7 +487,7 @@ int audio_module_configuration_get(struct audio_module_handle const *const handl
  *                                    audio data items onto its TX FIFO for access via an external
  *                                    system.
  *
- * @return 0 if successful, error otherwise.
+ * @return 0 if successful, -EBUSY if a module is in a running graph, error otherwise.
  */
 int audio_module_connect(struct audio_module_handle *handle_from,
 			 struct audio_module_handle *handle_to, bool connect_external);
@@ -382,7 +502,7 @@ int audio_module_connect(struct audio_module_handle *handle_from,
  * @param disconnect_external  [in]      Flag to indicate that the output audio data items should
  *                                       stop being put on handle TX FIFO.
  *
- * @return 0 if successful, error otherwise.
+ * @return 0 if successful, -EBUSY if a module is in a running graph, error otherwise.
  */
 int audio_module_disconnect(struct audio_module_handle *handle,
 			    struct audio_module_handle *handle_disconnect,
@@ -423,6 +543,9 @@ int audio_module_data_tx(struct audio_module_handle *handle,
 /**
  * @brief Retrieve an audio data item from an audio module.
  *
+ * @note The audio data is copied into the buffer given by audio_data and the module's buffer is
+ *       released.
+ *
  * @param handle      [in/out]  The handle to the module instance.
  * @param audio_data  [out]     Pointer to the audio data from the module.
  * @param timeout     [in]      Non-negative waiting period to wait for operation to complete
@@ -491,6 +614,75 @@ int audio_module_state_get(struct audio_module_handle const *const handle,
  */
 int audio_module_number_channels_calculate(uint32_t locations, int8_t *number_channels);
 
+#if CONFIG_AUDIO_MODULE_GRAPH || defined(__DOXYGEN__)
+/**
+ * @brief Initialize a graph of modules.
+ *
+ * @note Modules are added to the graph when opened with the graph in their parameters. The
+ *       scheduler thread runs the modules one frame at a time, in an order where a module runs
+ *       after all the modules in the graph that send audio data to it. Modules in different
+ *       graphs, or in their own threads, can be connected to each other. A module in a graph
+ *       processes the audio data on its RX FIFO, from outside the graph, in every frame. The
+ *       connections cannot change while the graph is running.
+ *
+ * @param graph        [out]  Pointer to the graph.
+ * @param stack        [in]   Scheduler thread stack.
+ * @param stack_size   [in]   Scheduler thread stack size.
+ * @param priority     [in]   Scheduler thread priority.
+ * @param deadline_us  [in]   Processing time budget for a frame in microseconds, 0 for none.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_graph_init(struct audio_module_graph *graph, k_thread_stack_t *stack,
+			    size_t stack_size, int priority, uint32_t deadline_us);
+
+/**
+ * @brief Start running the modules in a graph.
+ *
+ * @note A frame starts with the modules that receive no audio data from other modules in the
+ *       graph. An input module runs its data process function, which should wait for its
+ *       audio data. Other modules wait for audio data on their RX FIFO.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ *
+ * @return 0 if successful, -EINVAL if the connections between the modules form a loop, error
+ *         otherwise.
+ */
+int audio_module_graph_start(struct audio_module_graph *graph);
+
+/**
+ * @brief Stop running the modules in a graph.
+ *
+ * @note The scheduler thread stops at the end of the current frame. A module waiting for audio
+ *       data from outside the graph, or for a free output buffer, stops waiting within
+ *       CONFIG_AUDIO_MODULE_GRAPH_WAIT_MS. The data process function of an input module must
+ *       return for the frame to end.
+ *
+ * @param graph    [in/out]  Pointer to the graph.
+ * @param timeout  [in]      Time to wait for the end of the current frame.
+ *
+ * @return 0 if successful, -EAGAIN if the frame did not end in time, error otherwise.
+ */
+int audio_module_graph_stop(struct audio_module_graph *graph, k_timeout_t timeout);
+
+/**
+ * @brief Get the processing time statistics of a graph or of a module in a graph.
+ *
+ * @note The processing time of a frame is measured from when the first modules in the graph
+ *       have their audio data. The processing time of an input module includes the wait for
+ *       its audio data.
+ *
+ * @param graph   [in]   Pointer to the graph.
+ * @param handle  [in]   The handle of a module in the graph, or NULL for the whole frame.
+ * @param stats   [out]  Pointer to the statistics.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+int audio_module_graph_stats_get(struct audio_module_graph *graph,
+				 struct audio_module_handle const *const handle,
+				 struct audio_module_graph_stats *stats);
+#endif /* CONFIG_AUDIO_MODULE_GRAPH || defined(__DOXYGEN__) */
+
 #ifdef __cplusplus
 }
 #endif
@@ -105,7 +105,7 @@ struct bt_scan_filter_info {
 	bool enabled;
 
 	/** Filter count. */
-	uint8_t cnt;
+	uint16_t cnt;
 };
 
 /**@brief Filter status structure.
@@ -223,7 +223,7 @@ struct bt_scan_uuid_filter_status {
 	const struct bt_uuid *uuid[CONFIG_BT_SCAN_UUID_CNT];
 
 	/** Matched UUID count. */
-	uint8_t count;
+	uint16_t count;
 };
 
 /**@brief Appearance filter status structure, used to inform the application
@@ -516,6 +516,24 @@ int bt_scan_filter_add(enum bt_scan_filter_type type,
  */
 void bt_scan_filter_remove_all(void);
 
+/**@brief Function for getting the number of matches of a filter.
+ *
+ * @details The filters of each type are indexed in the order they were
+ *          added, skipping the duplicates. A filter is counted once for
+ *          every advertising report it matched, whether or not the report
+ *          was passed to the application. The counts are reset when the
+ *          filters are removed.
+ *
+ * @param[in] type Filter type.
+ * @param[in] index Index of the filter among the filters of its type.
+ * @param[out] hit_cnt Number of matches of the filter.
+ *
+ * @return 0 If the operation was successful. Otherwise, a (negative) error
+ *	     code is returned.
+ */
+int bt_scan_filter_hit_count_get(enum bt_scan_filter_type type,
+				 uint16_t index, uint32_t *hit_cnt);
+
 #endif /* CONFIG_BT_SCAN_FILTER_ENABLE */
 
 /**@brief Function for changing the scanning parameters.
@@ -562,6 +580,41 @@ int bt_scan_blocklist_device_add(const bt_addr_le_t *addr);
  */
 void bt_scan_blocklist_clear(void);
 
+#if CONFIG_BT_SCAN_REPORT_CACHE
+/**@brief Advertising report cache statistics. */
+struct bt_scan_report_cache_stats {
+	/** Number of reports passed to the application without checking
+	 *  the filters again.
+	 */
+	uint32_t hits;
+
+	/** Number of reports checked against the filters. */
+	uint32_t misses;
+
+	/** Number of devices replaced in the full cache. */
+	uint32_t evictions;
+
+	/** Number of filter callbacks dropped by the rate limit. */
+	uint32_t rate_limited;
+};
+
+/**@brief Function for getting the advertising report cache statistics.
+ *
+ * @param[out] stats Pointer to the statistics structure.
+ *
+ * @return 0 If the operation was successful. Otherwise, a (negative) error
+ *	     code is returned.
+ */
+int bt_scan_report_cache_stats_get(struct bt_scan_report_cache_stats *stats);
+
+/**@brief Function for clearing the advertising report cache.
+ *
+ * @details The function removes all devices from the cache, including
+ *          their rate limit state, and resets the statistics.
+ */
+void bt_scan_report_cache_clear(void);
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
+
 /**@brief Function to update the autoconnect flag after a filter match.
  *
  * @note The function should not be used when scanning is active.
@@ -180,6 +180,10 @@ int emds_prepare(void);
  * registered in the entries. This value is dependent on the chip used, and
  * should be checked against the chip datasheet.
  *
+ * @note With CONFIG_EMDS_PACKED_STORE, only the time of packing the entries is
+ * measured. The time of writing them to flash is estimated with the same
+ * formula as for the entries stored one by one.
+ *
  * @return Time needed to store all data (in microseconds).
  */
 uint32_t emds_store_time_get(void);
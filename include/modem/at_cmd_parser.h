@@ -61,6 +61,8 @@ extern "C" {
  * @retval -E2BIG  The at_param_list supplied cannot hold all detected
  *                 parameters in string. The list will contain the maximum
  *                 number of parameters possible.
+ * @retval -ENOMEM There is not enough memory to store the value of a
+ *                 parameter.
  * @retval -EINVAL One or more of the supplied parameters are invalid.
  *
  */
@@ -102,6 +104,8 @@ int at_parser_max_params_from_str(const char *at_params_str,
  * @retval -E2BIG  The at_param_list supplied cannot hold all detected
  *                 parameters in string. The list will contain the maximum
  *                 number of parameters possible.
+ * @retval -ENOMEM There is not enough memory to store the value of a
+ *                 parameter.
  * @retval -EINVAL One or more of the supplied parameters are invalid.
  */
 int at_parser_params_from_str(const char *at_params_str, char **next_param_str,
@@ -31,6 +31,9 @@ extern "C" {
  * All parameters values are copied in the list. Parameters should be
  * cleared to free that memory. Getter and setter methods are available
  * to read and write parameter values.
+ *
+ * A list can also be backed by caller-supplied memory, see
+ * @ref at_params_list_init_arena. Such a list does not use the heap.
  */
 
 /** @brief Parameter types that can be stored. */
@@ -64,6 +67,21 @@ struct at_param {
 	union at_param_value value;
 };
 
+/**
+ * @brief Memory for string and array values of a parameter list.
+ *
+ * Values are allocated sequentially from the buffer. The memory of a value is not reclaimed when
+ * the parameter is replaced or cleared, but only when the whole list is cleared.
+ */
+struct at_param_arena {
+	/** Buffer for the values. */
+	uint8_t *buf;
+	/** Size of the buffer. */
+	size_t size;
+	/** Number of bytes in use. */
+	size_t used;
+};
+
 /**
  * @brief List of AT parameters that compose an AT command or response.
  *
@@ -73,6 +91,8 @@ struct at_param {
 struct at_param_list {
 	size_t param_count;
 	struct at_param *params;
+	/** Memory for string and array values, NULL if the values are allocated on the heap. */
+	struct at_param_arena *arena;
 };
 
 /**
@@ -91,10 +111,30 @@ struct at_param_list {
  */
 int at_params_list_init(struct at_param_list *list, size_t max_params_count);
 
+/**
+ * @brief Create a list of parameters backed by caller-supplied memory.
+ *
+ * The list uses the @p params array and stores string and array values in
+ * @p arena instead of allocating them on the heap. Each parameter is
+ * initialized to its default value. Both @p params and the buffer of @p arena
+ * must stay valid until the list is freed.
+ *
+ * @param[in] list Parameter list to initialize.
+ * @param[in] params Array of parameters used by the list.
+ * @param[in] max_params_count Number of elements in @p params.
+ * @param[in] arena Memory for string and array values.
+ *
+ * @retval 0 If the operation was successful.
+ *           Otherwise, a (negative) error code is returned.
+ */
+int at_params_list_init_arena(struct at_param_list *list, struct at_param *params,
+			      size_t max_params_count, struct at_param_arena *arena);
+
 /**
  * @brief Clear/reset all parameter types and values.
  *
- * All parameter types and values are reset to default values.
+ * All parameter types and values are reset to default values. The memory
+ * of the arena, if any, is reclaimed.
  *
  * @param[in] list Parameter list to clear.
  */
@@ -104,6 +144,7 @@ void at_params_list_clear(struct at_param_list *list);
  * @brief Free a list of parameters.
  *
  * First the list is cleared. Then the list and its elements are deleted.
+ * The memory of a list backed by caller-supplied memory is not freed.
  *
  * @param[in] list Parameter list to free.
  */
@@ -124,6 +124,39 @@ struct nrf_rpc_ipc {
 		.ctx = &_name##_instance                                     \
 	}
 
+/** @brief Hold the receive buffer that contains the data.
+ *
+ * By default, the data received by the nRF RPC IPC Service transport is valid only until
+ * the decoding of the packet is done. Holding the receive buffer keeps the data valid until
+ * @ref nrf_rpc_ipc_rx_release is called, so a command handler can use large payloads directly
+ * from the shared memory instead of copying them before calling @ref nrf_rpc_decoding_done.
+ *
+ * The function must be called before the decoding of the packet is done.
+ * If holding fails, for example because the IPC Service backend does not support it,
+ * the data must be copied.
+ *
+ * @kconfig_dep{CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD}
+ *
+ * @param[in] data Pointer to any byte of the received packet.
+ *
+ * @retval 0 The receive buffer is held.
+ * @retval -NRF_EINVAL The data is not a part of a packet that is being received.
+ * @retval -NRF_EIO The IPC Service backend failed to hold the buffer.
+ */
+int nrf_rpc_ipc_rx_hold(const void *data);
+
+/** @brief Release the receive buffer held with @ref nrf_rpc_ipc_rx_hold.
+ *
+ * @kconfig_dep{CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD}
+ *
+ * @param[in] data Pointer to any byte of the held packet.
+ *
+ * @retval 0 The receive buffer is released.
+ * @retval -NRF_EINVAL The data is not a part of a held packet.
+ * @retval -NRF_EIO The IPC Service backend failed to release the buffer.
+ */
+int nrf_rpc_ipc_rx_release(const void *data);
+
 /**
  * @}
  */
@@ -30,6 +30,23 @@ extern "C" {
  */
 #define NRF_RPC_SCRATCHPAD_ALIGN(size) WB_UP(size)
 
+/** @brief Fragment of a buffer to encode. */
+struct nrf_rpc_buffer_frag {
+	/** Fragment data. If NULL, the fragment is encoded as zeros. */
+	const void *data;
+
+	/** Fragment size. */
+	size_t size;
+};
+
+/** @brief Get the maximum number of bytes needed to encode a buffer.
+ *
+ * @param[in] size Buffer size.
+ *
+ * @retval Buffer size increased by the size of the longest CBOR byte string header.
+ */
+#define NRF_RPC_BUFFER_ENCODED_SIZE_MAX(size) ((size) + 1 + sizeof(uint32_t))
+
 /** @brief Alloc the scratchpad. Scratchpad is used to store a data when decoding serialized data.
  *
  *  @param[in] _scratchpad Scratchpad name.
@@ -114,6 +131,20 @@ void nrf_rpc_encode_str(struct nrf_rpc_cbor_ctx *ctx, const char *value, int len
  */
 void nrf_rpc_encode_buffer(struct nrf_rpc_cbor_ctx *ctx, const void *data, size_t size);
 
+/** @brief Encode a buffer made of fragments.
+ *
+ * The fragments are encoded as a single byte string, so the buffer can be decoded with any of
+ * the buffer decoding functions. The fragments are copied directly into the CBOR stream, so they
+ * do not need to be merged into a contiguous buffer first. The whole byte string is still sent
+ * in one packet, and the receiver decodes it as a contiguous buffer.
+ *
+ * @param[in,out] ctx CBOR encoding context.
+ * @param[in] frags Array of fragments to encode. If NULL, null value is encoded.
+ * @param[in] frag_cnt Number of fragments.
+ */
+void nrf_rpc_encode_buffer_frags(struct nrf_rpc_cbor_ctx *ctx,
+				 const struct nrf_rpc_buffer_frag *frags, size_t frag_cnt);
+
 /** @brief Encode a callback.
  *
  * This function will use callback proxy module to convert a callback pointer
@@ -21,6 +21,9 @@
  * @{
  */
 
+/** @brief Gain of 1.0 in the unsigned Q2.14 fixed-point format used by @ref pcm_mix_ext. */
+#define PCM_MIX_GAIN_UNITY 0x4000
+
 enum pcm_mix_mode {
 	B_STEREO_INTO_A_STEREO,
 	B_MONO_INTO_A_MONO,
@@ -52,6 +55,32 @@ enum pcm_mix_mode {
 int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
 	    enum pcm_mix_mode mix_mode);
 
+/**
+ * @brief Mixes two buffers of PCM data with a given bit depth and gain per input.
+ *
+ * @note Each sample of A that B is mixed into is replaced by
+ * (A * gain_a + B * gain_b), saturated to the range of the bit depth.
+ * Samples of A that B is not mixed into are left unchanged.
+ * The 24-bit samples are packed in three bytes.
+ *
+ * @param pcm_a         [in/out] Pointer to the PCM data buffer A.
+ * @param size_a        [in]     Size of the PCM data buffer A (in bytes).
+ * @param gain_a        [in]     Gain of buffer A in the Q2.14 format.
+ * @param pcm_b         [in]     Pointer to the PCM data buffer B.
+ * @param size_b        [in]     Size of the PCM data buffer B (in bytes).
+ * @param gain_b        [in]     Gain of buffer B in the Q2.14 format.
+ * @param mix_mode      [in]     Mixing mode according to pcm_mix_mode.
+ * @param pcm_bit_depth [in]     Bit depth of the PCM samples (16, 24, or 32).
+ *
+ * @retval 0            Success. Result stored in pcm_a.
+ * @retval -EINVAL      pcm_a is NULL, size_a = 0 or the bit depth is invalid.
+ * @retval -EPERM       Either size_b < size_a (for stereo to stereo, mono to mono)
+ *			or size_a/2 < size_b (for mono to stereo mix).
+ * @retval -ESRCH       Invalid mixing mode.
+ */
+int pcm_mix_ext(void *const pcm_a, size_t size_a, uint16_t gain_a, void const *const pcm_b,
+		size_t size_b, uint16_t gain_b, enum pcm_mix_mode mix_mode, uint8_t pcm_bit_depth);
+
 /**
  * @}
  */
@@ -19,6 +19,7 @@
  * @{
  */
 
+#include <stdbool.h>
 #include <zephyr/sys/ring_buffer.h>
 #include <dsp/filtering_functions.h>
 
@@ -40,9 +41,13 @@
 /** Filter types supported by the sample rate converter */
 enum sample_rate_converter_filter {
 	SAMPLE_RATE_FILTER_TEST = 1,
-	SAMPLE_RATE_FILTER_SIMPLE
+	SAMPLE_RATE_FILTER_SIMPLE,
+	SAMPLE_RATE_FILTER_POLYPHASE
 };
 
+/** Largest clock drift in parts per million that can be compensated by the polyphase filter */
+#define SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX 1000
+
 /**
  * To maintain filter requirements the input buffer must in some cases store two samples between
  * each block processed.
@@ -75,6 +80,50 @@ enum sample_rate_converter_filter {
 #define SAMPLE_RATE_CONVERTER_RINGBUF_SIZE   0
 #endif
 
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+/**
+ * Streaming state of the polyphase filter.
+ *
+ * The output position is tracked as a fraction of an input sample with the denominator
+ * interpolation * 1000000, which keeps rational ratios exact while allowing the step to be
+ * adjusted in parts per million.
+ */
+struct sample_rate_converter_polyphase {
+	/* Conversion ratio reduced to interpolation / decimation. */
+	uint32_t interpolation;
+	uint32_t decimation;
+
+	/* Requested drift compensation in parts per million. */
+	int32_t drift_ppm;
+
+	/* Position of the next output sample relative to the newest input sample. */
+	uint32_t pos;
+	uint32_t pos_step;
+	uint32_t pos_den;
+
+	/* Number of phases in the filter bank. If the bank is interpolated, an extra phase is
+	 * stored after the last one to interpolate against.
+	 */
+	uint32_t phases;
+	bool interpolated;
+
+	/* Index of the oldest sample in the delay line. Every input sample is stored twice, so
+	 * that the newest taps samples are always contiguous.
+	 */
+	uint16_t delay_line_idx;
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	q15_t delay_line_15[CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS * 2];
+	q15_t coeffs_15[(CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES + 1) *
+			CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS];
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	q31_t delay_line_31[CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS * 2];
+	q31_t coeffs_31[(CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES + 1) *
+			CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS];
+#endif
+};
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
+
 /** Buffer used for storing input bytes to the sample rate converter */
 struct buf_ctx {
 	uint8_t buf[SAMPLE_RATE_CONVERTER_INPUT_BUF_SIZE];
@@ -88,7 +137,8 @@ struct sample_rate_converter_ctx {
 	uint32_t sample_rate_output;
 
 	/* The ratio for the current conversion. When the conversion is upsampling the ratio is
-	 * positive and negative when downsampling.
+	 * positive and negative when downsampling. Set to 0 for the polyphase filter, which
+	 * keeps the ratio in its own state.
 	 */
 	int conversion_ratio;
 
@@ -121,6 +171,11 @@ struct sample_rate_converter_ctx {
 #elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
 	q31_t state_buf_31[SAMPLE_RATE_CONVERTER_STATE_BUFFER_SIZE];
 #endif
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+	/* State of the polyphase filter, kept between process calls. */
+	struct sample_rate_converter_polyphase polyphase;
+#endif
 };
 
 /**
@@ -149,6 +204,12 @@ int sample_rate_converter_open(struct sample_rate_converter_ctx *ctx);
  *		based on the conversion ratio, the module will buffer both input and output bytes
  *		when needed to meet this criteria.
  *
+ *		The polyphase filter supports any pair of 8, 16, 24, 32, 44.1 and 48 kHz, including
+ *		equal rates for drift compensation. It takes any number of input samples, is
+ *		not limited by CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX, and writes directly to
+ *		the output. The number of output samples may vary by one between calls when the
+ *		input size is not a multiple of the conversion ratio.
+ *
  * @param[in,out]	ctx			Pointer to the sample rate conversion context.
  * @param[in]		filter			Filter type to be used for the conversion.
  * @param[in]		input			Pointer to samples to process.
@@ -170,6 +231,28 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 				  size_t output_size, size_t *output_written,
 				  uint32_t output_sample_rate);
 
+/**
+ * @brief	Set the clock drift to compensate for in the polyphase filter.
+ *
+ * @details	Adjusts the conversion ratio of the polyphase filter by the given number of parts
+ *		per million, for instance to follow the clock of an USB host. A positive value
+ *		consumes the input faster, which produces fewer output samples. The drift is kept
+ *		when the sample rates change, and applies from the next output sample without
+ *		resetting the filter history. Only used by @ref SAMPLE_RATE_FILTER_POLYPHASE.
+ *
+ * @note	The first call with a non-zero drift for a conversion where the exact filter bank
+ *		is used rebuilds the filter bank.
+ *
+ * @param[in,out]	ctx		Pointer to the sample rate conversion context.
+ * @param[in]		drift_ppm	Drift in parts per million, within
+ *					+/- @ref SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	NULL pointer given for context or drift out of range.
+ * @retval	-ENOTSUP	The polyphase filter is not enabled.
+ */
+int sample_rate_converter_drift_set(struct sample_rate_converter_ctx *ctx, int32_t drift_ppm);
+
 /**
  * @}
  */
@@ -181,6 +181,7 @@ static int at_parse_process_element(const char **str, int index,
 				    struct at_param_list *const list)
 {
 	const char *tmpstr = *str;
+	int err = 0;
 
 	if (is_terminated(*tmpstr)) {
 		return -1;
@@ -193,8 +194,7 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr, tmpstr - start_ptr);
 	} else if (state == COMMAND) {
 		const char *start_ptr = tmpstr;
 
@@ -204,8 +204,7 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr, tmpstr - start_ptr);
 
 		/* Skip read/test special characters. */
 		if ((*tmpstr == AT_CMD_SEPARATOR) &&
@@ -216,7 +215,7 @@ static int at_parse_process_element(const char **str, int index,
 		}
 
 	} else if (state == OPTIONAL) {
-		at_params_empty_put(list, index);
+		err = at_params_empty_put(list, index);
 
 	} else if (state == STRING) {
 		const char *start_ptr = tmpstr;
@@ -225,8 +224,7 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr, tmpstr - start_ptr);
 
 		tmpstr++;
 	} else if (state == QUOTED_STRING) {
@@ -236,8 +234,7 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr, tmpstr - start_ptr);
 
 		tmpstr++;
 	} else if (state == ARRAY) {
@@ -268,7 +265,7 @@ static int at_parse_process_element(const char **str, int index,
 			}
 		}
 
-		at_params_array_put(list, index, tmparray, i * sizeof(uint32_t));
+		err = at_params_array_put(list, index, tmparray, i * sizeof(uint32_t));
 
 		tmpstr++;
 	} else if (state == NUMBER) {
@@ -277,7 +274,7 @@ static int at_parse_process_element(const char **str, int index,
 
 		tmpstr = next;
 
-		at_params_int_put(list, index, value);
+		err = at_params_int_put(list, index, value);
 	} else if (state == SMS_PDU) {
 		const char *start_ptr = tmpstr;
 
@@ -285,8 +282,7 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr, tmpstr - start_ptr);
 	} else if (state == CLAC) {
 		const char *start_ptr = tmpstr;
 
@@ -294,12 +290,11 @@ static int at_parse_process_element(const char **str, int index,
 			tmpstr++;
 		}
 
-		at_params_string_put(list, index, start_ptr,
-				     tmpstr - start_ptr);
+		err = at_params_string_put(list, index, start_ptr, tmpstr - start_ptr);
 	}
 
 	*str = tmpstr;
-	return 0;
+	return err;
 }
 
 /*
@@ -337,9 +332,14 @@ static int at_parse_param(const char **at_params_str,
 			index = 0;
 		}
 
-		if (at_parse_process_element(&str, index, list) == -1) {
+		ret = at_parse_process_element(&str, index, list);
+		if (ret == -1) {
 			break;
 		}
+		if (ret != 0) {
+			*at_params_str = str;
+			return ret;
+		}
 
 		if (is_separator(*str)) {
 			if (is_lfcr(*(str + 1))) {
@@ -356,10 +356,14 @@ static int at_parse_param(const char **at_params_str,
 					break;
 				}
 
-				if (at_parse_process_element(&str, index,
-							     list) == -1) {
+				ret = at_parse_process_element(&str, index, list);
+				if (ret == -1) {
 					break;
 				}
+				if (ret != 0) {
+					*at_params_str = str;
+					return ret;
+				}
 			}
 
 			str++;
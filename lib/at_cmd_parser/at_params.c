@@ -10,7 +10,7 @@
 #include <string.h>
 #include <zephyr/kernel.h>
 #include <zephyr/types.h>
-#include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
 
 #include <modem/at_params.h>
 
@@ -23,19 +23,41 @@ static void at_param_init(struct at_param *param)
 	memset(param, 0, sizeof(struct at_param));
 }
 
-/* Internal function. Parameter cannot be null. */
-static void at_param_clear(struct at_param *param)
+/* Internal function. Parameters cannot be null. */
+static void at_param_clear(const struct at_param_list *list, struct at_param *param)
 {
 	__ASSERT(param != NULL, "Parameter cannot be NULL.");
 
-	if ((param->type == AT_PARAM_TYPE_STRING) ||
-	    (param->type == AT_PARAM_TYPE_ARRAY)) {
+	/* Values in the arena are released when the whole list is cleared. */
+	if ((list->arena == NULL) &&
+	    ((param->type == AT_PARAM_TYPE_STRING) ||
+	     (param->type == AT_PARAM_TYPE_ARRAY))) {
 		k_free(param->value.str_val);
 	}
 
 	param->value.int_val = 0;
 }
 
+/* Internal function. List cannot be null. */
+static void *at_param_value_alloc(const struct at_param_list *list, size_t size, size_t align)
+{
+	struct at_param_arena *arena = list->arena;
+	size_t offset;
+
+	if (arena == NULL) {
+		return k_malloc(size);
+	}
+
+	offset = ROUND_UP((uintptr_t)&arena->buf[arena->used], align) - (uintptr_t)arena->buf;
+	if ((offset > arena->size) || (size > arena->size - offset)) {
+		return NULL;
+	}
+
+	arena->used = offset + size;
+
+	return &arena->buf[offset];
+}
+
 /* Internal function. Parameter cannot be null. */
 static struct at_param *at_params_get(const struct at_param_list *list,
 				      size_t index)
@@ -79,6 +101,23 @@ int at_params_list_init(struct at_param_list *list, size_t max_params_count)
 	}
 
 	list->param_count = max_params_count;
+	list->arena = NULL;
+	return 0;
+}
+
+int at_params_list_init_arena(struct at_param_list *list, struct at_param *params,
+			      size_t max_params_count, struct at_param_arena *arena)
+{
+	if (list == NULL || params == NULL || arena == NULL || arena->buf == NULL) {
+		return -EINVAL;
+	}
+
+	memset(params, 0, max_params_count * sizeof(struct at_param));
+	arena->used = 0;
+
+	list->params = params;
+	list->param_count = max_params_count;
+	list->arena = arena;
 	return 0;
 }
 
@@ -88,10 +127,16 @@ void at_params_list_clear(struct at_param_list *list)
 		return;
 	}
 
+	if (list->arena != NULL) {
+		memset(list->params, 0, list->param_count * sizeof(struct at_param));
+		list->arena->used = 0;
+		return;
+	}
+
 	for (size_t i = 0; i < list->param_count; ++i) {
 		struct at_param *params = list->params;
 
-		at_param_clear(&params[i]);
+		at_param_clear(list, &params[i]);
 		at_param_init(&params[i]);
 	}
 }
@@ -104,9 +149,13 @@ void at_params_list_free(struct at_param_list *list)
 
 	at_params_list_clear(list);
 
+	if (list->arena == NULL) {
+		k_free(list->params);
+	}
+
 	list->param_count = 0;
-	k_free(list->params);
 	list->params = NULL;
+	list->arena = NULL;
 }
 
 int at_params_empty_put(const struct at_param_list *list, size_t index)
@@ -121,7 +170,7 @@ int at_params_empty_put(const struct at_param_list *list, size_t index)
 		return -EINVAL;
 	}
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 
 	param->type = AT_PARAM_TYPE_EMPTY;
 	param->value.int_val = 0;
@@ -141,7 +190,7 @@ int at_params_int_put(const struct at_param_list *list, size_t index, int64_t va
 		return -EINVAL;
 	}
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 
 	param->type = AT_PARAM_TYPE_NUM_INT;
 	param->value.int_val = value;
@@ -161,15 +210,16 @@ int at_params_string_put(const struct at_param_list *list, size_t index,
 		return -EINVAL;
 	}
 
-	char *param_value = (char *)k_malloc(str_len + 1);
+	char *param_value = (char *)at_param_value_alloc(list, str_len + 1, sizeof(char));
 
 	if (param_value == NULL) {
 		return -ENOMEM;
 	}
 
 	memcpy(param_value, str, str_len);
+	param_value[str_len] = '\0';
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 	param->size = str_len;
 	param->type = AT_PARAM_TYPE_STRING;
 	param->value.str_val = param_value;
@@ -190,7 +240,8 @@ int at_params_array_put(const struct at_param_list *list, size_t index,
 		return -EINVAL;
 	}
 
-	uint32_t *param_value = (uint32_t *)k_malloc(array_len);
+	uint32_t *param_value =
+		(uint32_t *)at_param_value_alloc(list, array_len, sizeof(uint32_t));
 
 	if (param_value == NULL) {
 		return -ENOMEM;
@@ -198,7 +249,7 @@ int at_params_array_put(const struct at_param_list *list, size_t index,
 
 	memcpy(param_value, array, array_len);
 
-	at_param_clear(param);
+	at_param_clear(list, param);
 	param->size = array_len;
 	param->type = AT_PARAM_TYPE_ARRAY;
 	param->value.array_val = param_value;
@@ -17,6 +17,7 @@ LOG_MODULE_REGISTER(at_monitor, CONFIG_AT_MONITOR_LOG_LEVEL);
 
 struct at_notif_fifo {
 	void *fifo_reserved;
+	uint32_t match; /* Monitors matching the notification, when the filter index is used */
 	char data[]; /* Null-terminated AT notification string */
 };
 
@@ -36,8 +37,179 @@ static bool is_direct(const struct at_monitor_entry *mon)
 	return mon->flags.direct;
 }
 
-static bool has_match(const struct at_monitor_entry *mon, const char *notif)
+#if defined(CONFIG_AT_MONITOR_FILTER_INDEX)
+/* The filters of all monitors are compiled into an Aho-Corasick automaton,
+ * so that a notification is matched against all filters in a single pass.
+ * Each monitor is represented by a bit in the match mask.
+ */
+#define INDEX_MONITORS_MAX 32
+#define INDEX_ROOT 0
+#define INDEX_NONE UINT16_MAX
+
+STRUCT_SECTION_START_EXTERN(at_monitor_entry);
+
+BUILD_ASSERT(CONFIG_AT_MONITOR_FILTER_INDEX_NODES < INDEX_NONE);
+
+struct index_node {
+	/* Monitors whose filter matches when the node is reached. */
+	uint32_t match;
+	/* First child and next sibling in the trie. */
+	uint16_t child;
+	uint16_t sibling;
+	/* Node of the longest proper suffix that is also in the trie. */
+	uint16_t fail;
+	uint8_t depth;
+	char c;
+};
+
+static struct index_node index_nodes[CONFIG_AT_MONITOR_FILTER_INDEX_NODES];
+static uint16_t index_node_cnt;
+/* Monitors that match any notification. */
+static uint32_t index_match_any;
+static bool index_ready;
+
+static uint16_t index_child_get(uint16_t node, char c)
+{
+	for (uint16_t n = index_nodes[node].child; n != INDEX_NONE; n = index_nodes[n].sibling) {
+		if (index_nodes[n].c == c) {
+			return n;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+static int index_filter_add(const char *filter, uint32_t bit)
 {
+	uint16_t node = INDEX_ROOT;
+
+	for (const char *p = filter; *p != '\0'; p++) {
+		uint16_t next = index_child_get(node, *p);
+
+		if (next == INDEX_NONE) {
+			if (index_node_cnt == ARRAY_SIZE(index_nodes) ||
+			    index_nodes[node].depth == UINT8_MAX) {
+				return -ENOMEM;
+			}
+
+			next = index_node_cnt++;
+			index_nodes[next] = (struct index_node) {
+				.child = INDEX_NONE,
+				.sibling = index_nodes[node].child,
+				.fail = INDEX_ROOT,
+				.depth = index_nodes[node].depth + 1,
+				.c = *p,
+			};
+			index_nodes[node].child = next;
+		}
+
+		node = next;
+	}
+
+	index_nodes[node].match |= bit;
+
+	return 0;
+}
+
+static void index_links_build(uint8_t depth_max)
+{
+	/* Suffix links point to shallower nodes, so build them level by level. */
+	for (uint8_t depth = 0; depth < depth_max; depth++) {
+		for (uint16_t p = 0; p < index_node_cnt; p++) {
+			if (index_nodes[p].depth != depth) {
+				continue;
+			}
+
+			for (uint16_t n = index_nodes[p].child; n != INDEX_NONE;
+			     n = index_nodes[n].sibling) {
+				uint16_t f = index_nodes[p].fail;
+				uint16_t next = INDEX_NONE;
+
+				if (p != INDEX_ROOT) {
+					while ((next = index_child_get(f, index_nodes[n].c)) ==
+						       INDEX_NONE && f != INDEX_ROOT) {
+						f = index_nodes[f].fail;
+					}
+				}
+
+				index_nodes[n].fail = (next != INDEX_NONE) ? next : INDEX_ROOT;
+				index_nodes[n].match |= index_nodes[index_nodes[n].fail].match;
+			}
+		}
+	}
+}
+
+static int index_build(void)
+{
+	uint32_t bit = BIT(0);
+	uint8_t depth_max = 0;
+	int err;
+
+	index_nodes[INDEX_ROOT] = (struct index_node) {
+		.child = INDEX_NONE,
+		.sibling = INDEX_NONE,
+		.fail = INDEX_ROOT,
+	};
+	index_node_cnt = 1;
+
+	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
+		if (bit == 0) {
+			/* More monitors than bits in the match mask. */
+			return -ENOMEM;
+		}
+
+		if (e->filter == ANY || e->filter[0] == '\0') {
+			index_match_any |= bit;
+		} else {
+			err = index_filter_add(e->filter, bit);
+			if (err) {
+				return err;
+			}
+		}
+
+		bit <<= 1;
+	}
+
+	for (uint16_t n = 0; n < index_node_cnt; n++) {
+		depth_max = MAX(depth_max, index_nodes[n].depth);
+	}
+
+	index_links_build(depth_max);
+
+	LOG_DBG("Filter index uses %u nodes", index_node_cnt);
+
+	return 0;
+}
+
+static uint32_t index_match(const char *notif)
+{
+	uint32_t match = index_match_any;
+	uint16_t node = INDEX_ROOT;
+
+	for (; *notif != '\0'; notif++) {
+		uint16_t next;
+
+		while ((next = index_child_get(node, *notif)) == INDEX_NONE &&
+		       node != INDEX_ROOT) {
+			node = index_nodes[node].fail;
+		}
+
+		node = (next != INDEX_NONE) ? next : INDEX_ROOT;
+		match |= index_nodes[node].match;
+	}
+
+	return match;
+}
+#endif /* CONFIG_AT_MONITOR_FILTER_INDEX */
+
+/* The match mask is the result of the filter index lookup for the notification. */
+static bool has_match(const struct at_monitor_entry *mon, const char *notif, uint32_t match)
+{
+#if defined(CONFIG_AT_MONITOR_FILTER_INDEX)
+	if (index_ready) {
+		return match & BIT(mon - STRUCT_SECTION_START(at_monitor_entry));
+	}
+#endif
 	return (mon->filter == ANY || strstr(notif, mon->filter));
 }
 
@@ -50,12 +222,18 @@ void at_monitor_dispatch(const char *notif)
 	bool monitored;
 	struct at_notif_fifo *at_notif;
 	size_t sz_needed;
+	uint32_t match = 0;
 
 	__ASSERT_NO_MSG(notif != NULL);
 
 	monitored = false;
+#if defined(CONFIG_AT_MONITOR_FILTER_INDEX)
+	if (index_ready) {
+		match = index_match(notif);
+	}
+#endif
 	STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
-		if (!is_paused(e) && has_match(e, notif)) {
+		if (!is_paused(e) && has_match(e, notif, match)) {
 			if (is_direct(e)) {
 				LOG_DBG("Dispatching to %p (ISR)", e->handler);
 				e->handler(notif);
@@ -80,6 +258,7 @@ void at_monitor_dispatch(const char *notif)
 		return;
 	}
 
+	at_notif->match = match;
 	strcpy(at_notif->data, notif);
 
 	k_fifo_put(&at_monitor_fifo, at_notif);
@@ -94,7 +273,8 @@ static void at_monitor_task(struct k_work *work)
 		/* Match notification with all monitors */
 		LOG_DBG("AT notif: %.*s", strlen(at_notif->data) - strlen("\r\n"), at_notif->data);
 		STRUCT_SECTION_FOREACH(at_monitor_entry, e) {
-			if (!is_paused(e) && !is_direct(e) && has_match(e, at_notif->data)) {
+			if (!is_paused(e) && !is_direct(e) &&
+			    has_match(e, at_notif->data, at_notif->match)) {
 				LOG_DBG("Dispatching to %p", e->handler);
 				e->handler(at_notif->data);
 			}
@@ -107,6 +287,15 @@ static int at_monitor_sys_init(void)
 {
 	int err;
 
+#if defined(CONFIG_AT_MONITOR_FILTER_INDEX)
+	err = index_build();
+	if (err) {
+		LOG_WRN("Filter index not built, err %d. Matching filters one by one", err);
+	} else {
+		index_ready = true;
+	}
+#endif
+
 	err = nrf_modem_at_notif_handler_set(at_monitor_dispatch);
 	if (err) {
 		LOG_ERR("Failed to hook the dispatch function, err %d", err);
@@ -22,6 +22,19 @@ LOG_MODULE_DECLARE(lte_lc, CONFIG_LTE_LINK_CONTROL_LOG_LEVEL);
 
 static K_MUTEX_DEFINE(list_mtx);
 
+#if defined(CONFIG_LTE_LC_STATIC_PARAM_LIST)
+/* Parameter list storage used by the parsers of the frequent notifications, to avoid allocating
+ * every string parameter on the heap.
+ */
+static K_MUTEX_DEFINE(resp_mtx);
+static struct at_param resp_params[AT_RESP_PARAMS_COUNT_MAX];
+static uint8_t resp_arena_buf[AT_RESP_ARENA_SIZE];
+static struct at_param_arena resp_arena = {
+	.buf = resp_arena_buf,
+	.size = sizeof(resp_arena_buf),
+};
+#endif /* CONFIG_LTE_LC_STATIC_PARAM_LIST */
+
 /**@brief List element for event handler list. */
 struct event_handler {
 	sys_snode_t          node;
@@ -294,6 +307,60 @@ int string_to_int(const char *str_buf, int base, int *output)
 	return 0;
 }
 
+/**@brief Free a parameter list parsed by resp_list_parse(). */
+static void resp_list_free(struct at_param_list *list)
+{
+#if defined(CONFIG_LTE_LC_STATIC_PARAM_LIST)
+	bool is_static = (list->params == resp_params);
+
+	at_params_list_free(list);
+
+	if (is_static) {
+		k_mutex_unlock(&resp_mtx);
+	}
+#else
+	at_params_list_free(list);
+#endif
+}
+
+/**
+ * @brief Parse an AT response into a parameter list of @p param_count parameters.
+ *
+ * The static parameter list storage is used if it is enabled and the response fits in it.
+ * Otherwise, the list is allocated on the heap. The list must be freed with resp_list_free(),
+ * also on failure.
+ *
+ * @return Zero on success or a negative error code returned by the AT command parser.
+ */
+static int resp_list_parse(struct at_param_list *list, size_t param_count,
+			   const char *at_response)
+{
+	int err;
+
+#if defined(CONFIG_LTE_LC_STATIC_PARAM_LIST)
+	if (param_count <= ARRAY_SIZE(resp_params)) {
+		k_mutex_lock(&resp_mtx, K_FOREVER);
+
+		(void)at_params_list_init_arena(list, resp_params, param_count, &resp_arena);
+
+		err = at_parser_params_from_str(at_response, NULL, list);
+		if (err != -ENOMEM) {
+			return err;
+		}
+
+		/* The string parameters do not fit in the arena. */
+		resp_list_free(list);
+	}
+#endif /* CONFIG_LTE_LC_STATIC_PARAM_LIST */
+
+	err = at_params_list_init(list, param_count);
+	if (err) {
+		return err;
+	}
+
+	return at_parser_params_from_str(at_response, NULL, list);
+}
+
 /* Parses eDRX parameters from a +CEDRXS notification or a +CEDRXRDP response. */
 int parse_edrx(const char *at_response, struct lte_lc_edrx_cfg *cfg, char *edrx_str, char *ptw_str)
 {
@@ -715,16 +782,8 @@ int parse_cereg(const char *at_response,
 	size_t response_prefix_len = sizeof(response_prefix);
 	size_t len = sizeof(str_buf) - 1;
 
-	err = at_params_list_init(&resp_list, AT_CEREG_PARAMS_COUNT_MAX);
-	if (err) {
-		LOG_ERR("Could not init AT params list, error: %d", err);
-		return err;
-	}
-
 	/* Parse CEREG response and populate AT parameter list */
-	err = at_parser_params_from_str(at_response,
-					NULL,
-					&resp_list);
+	err = resp_list_parse(&resp_list, AT_CEREG_PARAMS_COUNT_MAX, at_response);
 	if (err) {
 		LOG_ERR("Could not parse AT+CEREG response, error: %d", err);
 		goto clean_exit;
@@ -879,7 +938,7 @@ int parse_cereg(const char *at_response,
 	}
 
 clean_exit:
-	at_params_list_free(&resp_list);
+	resp_list_free(&resp_list);
 
 	return err;
 }
@@ -974,15 +1033,7 @@ int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells)
 	cells->ncells_count = 0;
 	cells->current_cell.id = LTE_LC_CELL_EUTRAN_ID_INVALID;
 
-	err = at_params_list_init(&resp_list, param_count);
-	if (err) {
-		LOG_ERR("Could not init AT params list, error: %d", err);
-		return err;
-	}
-
-	err = at_parser_params_from_str(at_response,
-					NULL,
-					&resp_list);
+	err = resp_list_parse(&resp_list, param_count, at_response);
 	if (err && err != -E2BIG) {
 		LOG_ERR("Could not parse AT%%NCELLMEAS response, error: %d", err);
 		goto clean_exit;
@@ -1187,7 +1238,7 @@ int parse_ncellmeas(const char *at_response, struct lte_lc_cells_info *cells)
 	}
 
 clean_exit:
-	at_params_list_free(&resp_list);
+	resp_list_free(&resp_list);
 
 	return err;
 }
@@ -1243,13 +1294,7 @@ int parse_ncellmeas_gci(struct lte_lc_ncellmeas_params *params,
 	 *	[,<n_earfcn2>,<n_phys_cell_id2>,<n_rsrp2>,<n_rsrq2>,<time_diff2>]...]...
 	 */
 
-	err = at_params_list_init(&resp_list, param_count);
-	if (err) {
-		LOG_ERR("Could not init AT params list for cell_list, error: %d", err);
-		goto clean_exit;
-	}
-
-	err = at_parser_params_from_str(at_response, NULL, &resp_list);
+	err = resp_list_parse(&resp_list, param_count, at_response);
 	if (err && err != -E2BIG) {
 		LOG_ERR("Could not parse AT%%NCELLMEAS response, error: %d", err);
 		goto clean_exit;
@@ -1531,7 +1576,7 @@ int parse_ncellmeas_gci(struct lte_lc_ncellmeas_params *params,
 	}
 
 clean_exit:
-	at_params_list_free(&resp_list);
+	resp_list_free(&resp_list);
 
 	return err;
 }
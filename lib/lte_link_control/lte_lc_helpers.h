@@ -110,6 +110,11 @@
 
 #define AT_NCELLMEAS_GCI_CELL_PARAMS_COUNT	12
 
+/* Static storage for the parameter lists of the frequently parsed notifications. */
+#define AT_RESP_PARAMS_COUNT_MAX		MAX(AT_NCELLMEAS_PARAMS_COUNT_MAX,	\
+						    AT_CEREG_PARAMS_COUNT_MAX)
+#define AT_RESP_ARENA_SIZE			128
+
 /* XMODEMSLEEP command parameters. */
 #define AT_XMODEMSLEEP_SUB			"AT%%XMODEMSLEEP=1,%d,%d"
 #define AT_XMODEMSLEEP_PARAMS_COUNT_MAX		4
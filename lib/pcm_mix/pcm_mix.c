@@ -6,99 +6,178 @@
 
 #include <pcm_mix.h>
 
+#include <string.h>
 #include <zephyr/kernel.h>
+#include <zephyr/sys/util.h>
 
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(pcm_mix, CONFIG_PCM_MIX_LOG_LEVEL);
 
-/* Clip signal if amplitude is outside legal range */
-static void hard_limiter(int32_t *const pcm)
+#if CONFIG_PCM_MIX_SIMD && defined(__ARM_FEATURE_SIMD32) && (__ARM_FEATURE_SIMD32 == 1)
+#include <arm_acle.h>
+#define PCM_MIX_USE_SIMD 1
+#else
+#define PCM_MIX_USE_SIMD 0
+#endif
+
+#define GAIN_FRAC_BITS 14
+
+/* Position of the samples of buffer B in buffer A for a given mixing mode. */
+struct mix_layout {
+	/* Number of samples in A per sample in B. */
+	uint8_t a_stride;
+	/* Index of the first sample in A that B is mixed into. */
+	uint8_t a_offset;
+	/* Mix each sample of B into two consecutive samples of A. */
+	bool dual;
+};
+
+/* Saturate to the range of a signed integer of the given width */
+static inline int32_t saturate(int64_t val, uint8_t bits)
 {
-	if (*pcm < INT16_MIN) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MIN;
-	} else if (*pcm > INT16_MAX) {
-		LOG_DBG("Clip");
-		*pcm = INT16_MAX;
-	}
+	const int64_t max = (INT64_C(1) << (bits - 1)) - 1;
+
+	return (int32_t)CLAMP(val, -max - 1, max);
 }
 
-/* Mix stereo-stereo or mono-mono. I.e. buffers are of equal size */
-static void pcm_mix_identical(void *const pcm_a, size_t size_a, void const *const pcm_b,
-			      size_t size_b)
+static inline int16_t sat_add_q15(int16_t a, int16_t b)
 {
-	int32_t res;
-
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i];
+	return (int16_t)CLAMP((int32_t)a + b, INT16_MIN, INT16_MAX);
+}
 
-		hard_limiter(&res);
+static inline int32_t sample_get(const uint8_t *p, uint8_t bytes)
+{
+	if (bytes == 2) {
+		int16_t val;
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
+		memcpy(&val, p, sizeof(val));
+		return val;
+	} else if (bytes == 3) {
+		/* Little-endian packed sample, sign extended by the arithmetic shift. */
+		return (int32_t)(((uint32_t)p[0] << 8) | ((uint32_t)p[1] << 16) |
+				 ((uint32_t)p[2] << 24)) >> 8;
 	}
-}
 
-/* Mix mono into both channels of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_lr(void *const pcm_a, size_t size_a,
-					    void const *const pcm_b, size_t size_b)
-{
-	int32_t res;
+	int32_t val;
 
-	/* Use size_b as this is the length of the mono sample.
-	 * This must be *2 to traverse the stereo sample and /2 since
-	 * the sample is two bytes in size.
-	 */
-	for (uint32_t i = 0; i < size_b; i++) {
-		res = ((int16_t *)pcm_a)[i] + ((int16_t *)pcm_b)[i / 2];
+	memcpy(&val, p, sizeof(val));
+	return val;
+}
 
-		hard_limiter(&res);
+static inline void sample_put(uint8_t *p, uint8_t bytes, int32_t val)
+{
+	if (bytes == 2) {
+		int16_t tmp = (int16_t)val;
 
-		((int16_t *)pcm_a)[i] = (int16_t)res;
+		memcpy(p, &tmp, sizeof(tmp));
+	} else if (bytes == 3) {
+		p[0] = (uint8_t)val;
+		p[1] = (uint8_t)(val >> 8);
+		p[2] = (uint8_t)(val >> 16);
+	} else {
+		memcpy(p, &val, sizeof(val));
 	}
 }
 
-/* Mix mono into left channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_l(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+#if PCM_MIX_USE_SIMD
+static inline int16x2_t load_q15x2(const int16_t *p)
 {
-	int32_t res;
+	int16x2_t val;
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2] + ((int16_t *)pcm_b)[i];
+	memcpy(&val, p, sizeof(val));
+	return val;
+}
 
-		hard_limiter(&res);
+static inline void store_q15x2(int16_t *p, int16x2_t val)
+{
+	memcpy(p, &val, sizeof(val));
+}
 
-		((int16_t *)pcm_a)[i * 2] = (int16_t)res;
-	}
+/* Duplicate a sample into both halves of a packed pair */
+static inline int16x2_t dup_q15(int16_t val)
+{
+	return (int16x2_t)(((uint32_t)(uint16_t)val) | ((uint32_t)(uint16_t)val << 16));
 }
+#endif /* PCM_MIX_USE_SIMD */
 
-/* Mix mono into right channel of a stereo buffer */
-static void pcm_mix_b_mono_into_a_stereo_r(void *const pcm_a, size_t size_a,
-					   void const *const pcm_b, size_t size_b)
+/* Mix stereo-stereo or mono-mono. I.e. buffers are of equal size */
+static void pcm_mix_identical(int16_t *pcm_a, const int16_t *pcm_b, size_t cnt)
 {
-	int32_t res;
+	size_t i = 0;
 
-	for (uint32_t i = 0; i < size_b / 2; i++) {
-		res = ((int16_t *)pcm_a)[i * 2 + 1] + ((int16_t *)pcm_b)[i];
+#if PCM_MIX_USE_SIMD
+	for (; i + 2 <= cnt; i += 2) {
+		store_q15x2(&pcm_a[i], __qadd16(load_q15x2(&pcm_a[i]), load_q15x2(&pcm_b[i])));
+	}
+#endif
 
-		hard_limiter(&res);
+	for (; i < cnt; i++) {
+		pcm_a[i] = sat_add_q15(pcm_a[i], pcm_b[i]);
+	}
+}
 
-		((int16_t *)pcm_a)[i * 2 + 1] = (int16_t)res;
+/* Mix mono into both channels of a stereo buffer */
+static void pcm_mix_b_mono_into_a_stereo_lr(int16_t *pcm_a, const int16_t *pcm_b, size_t cnt)
+{
+	for (size_t i = 0; i < cnt; i++) {
+#if PCM_MIX_USE_SIMD
+		store_q15x2(&pcm_a[i * 2], __qadd16(load_q15x2(&pcm_a[i * 2]), dup_q15(pcm_b[i])));
+#else
+		pcm_a[i * 2] = sat_add_q15(pcm_a[i * 2], pcm_b[i]);
+		pcm_a[i * 2 + 1] = sat_add_q15(pcm_a[i * 2 + 1], pcm_b[i]);
+#endif
 	}
 }
 
-int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
-	    enum pcm_mix_mode mix_mode)
+/* Mix mono into one channel of a stereo buffer, left if offset is 0 and right if 1 */
+static void pcm_mix_b_mono_into_a_stereo_ch(int16_t *pcm_a, const int16_t *pcm_b, size_t cnt,
+					    uint8_t offset)
 {
-	if (pcm_a == NULL || size_a == 0) {
-		return -EINVAL;
+	for (size_t i = 0; i < cnt; i++) {
+#if PCM_MIX_USE_SIMD
+		/* Adding zero to the other channel leaves it unchanged. */
+		int16x2_t b = (int16x2_t)((uint32_t)(uint16_t)pcm_b[i] << (offset * 16));
+
+		store_q15x2(&pcm_a[i * 2], __qadd16(load_q15x2(&pcm_a[i * 2]), b));
+#else
+		pcm_a[i * 2 + offset] = sat_add_q15(pcm_a[i * 2 + offset], pcm_b[i]);
+#endif
 	}
+}
 
-	if (pcm_b == NULL || size_b == 0) {
-		/* Nothing to mix, returning */
-		return 0;
+/* Mix with any bit depth and gain */
+static void pcm_mix_generic(uint8_t *pcm_a, uint16_t gain_a, const uint8_t *pcm_b, size_t cnt,
+			    uint16_t gain_b, const struct mix_layout *layout, uint8_t bit_depth)
+{
+	const uint8_t bytes = bit_depth / 8;
+	const bool unity = (gain_a == PCM_MIX_GAIN_UNITY) && (gain_b == PCM_MIX_GAIN_UNITY);
+
+	for (size_t i = 0; i < cnt; i++) {
+		int64_t b = sample_get(&pcm_b[i * bytes], bytes);
+		uint8_t *a_ptr = &pcm_a[(i * layout->a_stride + layout->a_offset) * bytes];
+
+		if (!unity) {
+			b *= gain_b;
+		}
+
+		for (uint8_t ch = 0; ch < (layout->dual ? 2 : 1); ch++) {
+			int64_t res = sample_get(a_ptr, bytes);
+
+			if (unity) {
+				res += b;
+			} else {
+				res = (res * gain_a + b) >> GAIN_FRAC_BITS;
+			}
+
+			sample_put(a_ptr, bytes, saturate(res, bit_depth));
+			a_ptr += bytes;
+		}
 	}
+}
 
+static int mix_layout_get(enum pcm_mix_mode mix_mode, size_t size_a, size_t size_b,
+			  struct mix_layout *layout)
+{
 	switch (mix_mode) {
 	case B_STEREO_INTO_A_STEREO:
 		/* Fall through */
@@ -106,26 +185,26 @@ int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t si
 		if (size_b > size_a) {
 			return -EPERM;
 		}
-		pcm_mix_identical(pcm_a, size_a, pcm_b, size_b);
+		*layout = (struct mix_layout){.a_stride = 1};
 		break;
 	case B_MONO_INTO_A_STEREO_LR:
 		if (size_b > (size_a / 2)) {
 			return -EPERM;
 		}
-		pcm_mix_b_mono_into_a_stereo_lr(pcm_a, size_a, pcm_b, size_b);
+		*layout = (struct mix_layout){.a_stride = 2, .dual = true};
 		break;
 	case B_MONO_INTO_A_STEREO_L:
-		pcm_mix_b_mono_into_a_stereo_l(pcm_a, size_a, pcm_b, size_b);
 		if (size_b > (size_a / 2)) {
 			LOG_ERR("size a %d size b %d", size_a, size_b);
 			return -EPERM;
 		}
+		*layout = (struct mix_layout){.a_stride = 2};
 		break;
 	case B_MONO_INTO_A_STEREO_R:
-		pcm_mix_b_mono_into_a_stereo_r(pcm_a, size_a, pcm_b, size_b);
 		if (size_b > (size_a / 2)) {
 			return -EPERM;
 		}
+		*layout = (struct mix_layout){.a_stride = 2, .a_offset = 1};
 		break;
 	default:
 		return -ESRCH;
@@ -133,3 +212,70 @@ int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t si
 
 	return 0;
 }
+
+int pcm_mix(void *const pcm_a, size_t size_a, void const *const pcm_b, size_t size_b,
+	    enum pcm_mix_mode mix_mode)
+{
+	int ret;
+	struct mix_layout layout;
+
+	if (pcm_a == NULL || size_a == 0) {
+		return -EINVAL;
+	}
+
+	if (pcm_b == NULL || size_b == 0) {
+		/* Nothing to mix, returning */
+		return 0;
+	}
+
+	ret = mix_layout_get(mix_mode, size_a, size_b, &layout);
+	if (ret) {
+		return ret;
+	}
+
+	if (layout.a_stride == 1) {
+		pcm_mix_identical(pcm_a, pcm_b, size_b / sizeof(int16_t));
+	} else if (layout.dual) {
+		pcm_mix_b_mono_into_a_stereo_lr(pcm_a, pcm_b, size_b / sizeof(int16_t));
+	} else {
+		pcm_mix_b_mono_into_a_stereo_ch(pcm_a, pcm_b, size_b / sizeof(int16_t),
+						layout.a_offset);
+	}
+
+	return 0;
+}
+
+int pcm_mix_ext(void *const pcm_a, size_t size_a, uint16_t gain_a, void const *const pcm_b,
+		size_t size_b, uint16_t gain_b, enum pcm_mix_mode mix_mode, uint8_t pcm_bit_depth)
+{
+	int ret;
+	struct mix_layout layout;
+
+	if (pcm_a == NULL || size_a == 0) {
+		return -EINVAL;
+	}
+
+	if (pcm_bit_depth != 16 && pcm_bit_depth != 24 && pcm_bit_depth != 32) {
+		LOG_ERR("Invalid bit depth: %d", pcm_bit_depth);
+		return -EINVAL;
+	}
+
+	if (pcm_b == NULL || size_b == 0) {
+		/* Nothing to mix, returning */
+		return 0;
+	}
+
+	ret = mix_layout_get(mix_mode, size_a, size_b, &layout);
+	if (ret) {
+		return ret;
+	}
+
+	if (pcm_bit_depth == 16 && gain_a == PCM_MIX_GAIN_UNITY && gain_b == PCM_MIX_GAIN_UNITY) {
+		return pcm_mix(pcm_a, size_a, pcm_b, size_b, mix_mode);
+	}
+
+	pcm_mix_generic(pcm_a, gain_a, pcm_b, size_b / (pcm_bit_depth / 8), gain_b, &layout,
+			pcm_bit_depth);
+
+	return 0;
+}
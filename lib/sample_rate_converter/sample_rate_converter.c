@@ -6,6 +6,7 @@
 
 #include "sample_rate_converter.h"
 #include "sample_rate_converter_filter.h"
+#include "sample_rate_converter_polyphase.h"
 
 #include <errno.h>
 #include <stdbool.h>
@@ -102,6 +103,26 @@ static int sample_rate_converter_reconfigure(struct sample_rate_converter_ctx *c
 
 	__ASSERT(ctx != NULL, "Context cannot be NULL");
 
+	if (filter == SAMPLE_RATE_FILTER_POLYPHASE) {
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+		ret = sample_rate_converter_polyphase_init(&ctx->polyphase, sample_rate_input,
+							   sample_rate_output);
+		if (ret) {
+			return ret;
+		}
+
+		ctx->sample_rate_input = sample_rate_input;
+		ctx->sample_rate_output = sample_rate_output;
+		ctx->conversion_ratio = 0;
+		ctx->filter_type = filter;
+
+		return 0;
+#else
+		LOG_ERR("Polyphase filter not enabled");
+		return -EINVAL;
+#endif
+	}
+
 	ret = validate_sample_rates(sample_rate_input, sample_rate_output);
 	if (ret) {
 		LOG_ERR("Invalid sample rate given (%d)", ret);
@@ -199,11 +220,12 @@ int sample_rate_converter_open(struct sample_rate_converter_ctx *ctx)
 	return 0;
 }
 
-int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
-				  enum sample_rate_converter_filter filter, void const *const input,
-				  size_t input_size, uint32_t sample_rate_input, void *const output,
-				  size_t output_size, size_t *output_written,
-				  uint32_t sample_rate_output)
+/* Converts with the CMSIS-DSP FIR interpolator or decimator. Kept out of line, so that the
+ * internal buffers are only on the stack when this filter is used.
+ */
+static __noinline int fir_process(struct sample_rate_converter_ctx *ctx, void const *const input,
+				  size_t input_size, size_t samples_in, size_t bytes_per_sample,
+				  void *const output, size_t output_size, size_t *output_written)
 {
 	int ret;
 	const uint8_t *read_ptr;
@@ -213,40 +235,11 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 	uint8_t internal_input_buf[SAMPLE_RATE_CONVERTER_INTERNAL_INPUT_BUF_SIZE];
 	uint8_t internal_output_buf[SAMPLE_RATE_CONVERTER_INTERNAL_OUTPUT_BUF_SIZE];
 
-#if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
-	size_t bytes_per_sample = sizeof(uint16_t);
-#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
-	size_t bytes_per_sample = sizeof(uint32_t);
-#endif
-
-	if (input_size % bytes_per_sample != 0) {
-		LOG_ERR("Size of input is not a byte multiple");
-		return -EINVAL;
-	}
-
-	size_t samples_in = input_size / bytes_per_sample;
-
 	if (samples_in > CONFIG_SAMPLE_RATE_CONVERTER_BLOCK_SIZE_MAX) {
 		LOG_ERR("Too many samples given as input");
 		return -EINVAL;
 	}
 
-	if ((ctx == NULL) || (input == NULL) || (output == NULL) || (output_written == NULL)) {
-		LOG_ERR("Null pointer received");
-		return -EINVAL;
-	}
-
-	if ((ctx->sample_rate_input != sample_rate_input) ||
-	    (ctx->sample_rate_output != sample_rate_output) || (ctx->filter_type != filter)) {
-		LOG_DBG("State has changed, re-initializing filter");
-		ret = sample_rate_converter_reconfigure(ctx, sample_rate_input, sample_rate_output,
-							filter);
-		if (ret) {
-			LOG_ERR("Failed to initialize converter (%d)", ret);
-			return ret;
-		}
-	}
-
 	if ((ctx->conversion_ratio < 0) && (samples_in < abs(ctx->conversion_ratio))) {
 		LOG_ERR("Number of samples in can not be less than the conversion ratio (%d) when "
 			"downsampling",
@@ -393,3 +386,84 @@ int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
 
 	return 0;
 }
+
+int sample_rate_converter_process(struct sample_rate_converter_ctx *ctx,
+				  enum sample_rate_converter_filter filter, void const *const input,
+				  size_t input_size, uint32_t sample_rate_input, void *const output,
+				  size_t output_size, size_t *output_written,
+				  uint32_t sample_rate_output)
+{
+	int ret;
+
+#if CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	size_t bytes_per_sample = sizeof(uint16_t);
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	size_t bytes_per_sample = sizeof(uint32_t);
+#endif
+
+	if (input_size % bytes_per_sample != 0) {
+		LOG_ERR("Size of input is not a byte multiple");
+		return -EINVAL;
+	}
+
+	size_t samples_in = input_size / bytes_per_sample;
+
+	if ((ctx == NULL) || (input == NULL) || (output == NULL) || (output_written == NULL)) {
+		LOG_ERR("Null pointer received");
+		return -EINVAL;
+	}
+
+	if ((ctx->sample_rate_input != sample_rate_input) ||
+	    (ctx->sample_rate_output != sample_rate_output) || (ctx->filter_type != filter)) {
+		LOG_DBG("State has changed, re-initializing filter");
+		ret = sample_rate_converter_reconfigure(ctx, sample_rate_input, sample_rate_output,
+							filter);
+		if (ret) {
+			LOG_ERR("Failed to initialize converter (%d)", ret);
+			return ret;
+		}
+	}
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+	if (filter == SAMPLE_RATE_FILTER_POLYPHASE) {
+		size_t samples_out =
+			sample_rate_converter_polyphase_output_count(&ctx->polyphase, samples_in);
+
+		if ((samples_out * bytes_per_sample) > output_size) {
+			LOG_ERR("Conversion process will produce more bytes than the output buffer "
+				"can hold");
+			return -EINVAL;
+		}
+
+		samples_out = sample_rate_converter_polyphase_process(&ctx->polyphase, input,
+								      samples_in, output);
+		*output_written = samples_out * bytes_per_sample;
+
+		return 0;
+	}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE */
+
+	return fir_process(ctx, input, input_size, samples_in, bytes_per_sample, output,
+			   output_size, output_written);
+}
+
+int sample_rate_converter_drift_set(struct sample_rate_converter_ctx *ctx, int32_t drift_ppm)
+{
+	if (ctx == NULL) {
+		LOG_ERR("Context cannot be NULL");
+		return -EINVAL;
+	}
+
+	if (abs(drift_ppm) > SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX) {
+		LOG_ERR("Drift out of range: %d ppm", drift_ppm);
+		return -EINVAL;
+	}
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE
+	sample_rate_converter_polyphase_drift_set(&ctx->polyphase, drift_ppm);
+
+	return 0;
+#else
+	return -ENOTSUP;
+#endif
+}
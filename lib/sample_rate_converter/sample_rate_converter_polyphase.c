@@ -0,0 +1,291 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "sample_rate_converter_polyphase.h"
+
+#include <errno.h>
+#include <math.h>
+#include <string.h>
+#include <dsp/basic_math_functions.h>
+#include <zephyr/sys/util.h>
+
+#include <zephyr/logging/log.h>
+LOG_MODULE_REGISTER(sample_rate_converter_polyphase, CONFIG_SAMPLE_RATE_CONVERTER_LOG_LEVEL);
+
+#define TAPS	CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_TAPS
+#define PHASES	CONFIG_SAMPLE_RATE_CONVERTER_POLYPHASE_PHASES
+
+BUILD_ASSERT((TAPS % 2) == 0, "Number of taps per phase must be even");
+
+/* Denominator of the drift, the position is kept in units of 1 / (interpolation * PPM_SCALE) */
+#define PPM_SCALE 1000000
+
+/* Cut-off of the filter relative to the lower of the input and output sample rates */
+#define CUTOFF_RATIO 0.9f
+
+/* Kaiser window shape, gives about 80 dB of stop-band attenuation */
+#define KAISER_BETA 8.0f
+
+/* Fractional bits used when interpolating between two phases of the filter bank */
+#define PHASE_FRAC_BITS 15
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+typedef q15_t sample_t;
+#define DELAY_LINE(pp) ((pp)->delay_line_15)
+#define COEFFS(pp)     ((pp)->coeffs_15)
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+typedef q31_t sample_t;
+#define DELAY_LINE(pp) ((pp)->delay_line_31)
+#define COEFFS(pp)     ((pp)->coeffs_31)
+#endif
+
+static const uint32_t supported_sample_rates[] = {8000, 16000, 24000, 32000, 44100, 48000};
+
+static bool sample_rate_supported(uint32_t sample_rate)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(supported_sample_rates); i++) {
+		if (supported_sample_rates[i] == sample_rate) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static uint32_t gcd(uint32_t a, uint32_t b)
+{
+	while (b != 0) {
+		uint32_t tmp = a % b;
+
+		a = b;
+		b = tmp;
+	}
+
+	return a;
+}
+
+/* Zeroth order modified Bessel function of the first kind, used by the Kaiser window */
+static float bessel_i0(float x)
+{
+	float sum = 1.0f;
+	float term = 1.0f;
+
+	for (int k = 1; k < 20; k++) {
+		float tmp = x / (2.0f * k);
+
+		term *= tmp * tmp;
+		sum += term;
+	}
+
+	return sum;
+}
+
+static inline sample_t coeff_quantize(float coeff)
+{
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	return (sample_t)CLAMP(lrintf(coeff * 32768.0f), INT16_MIN, INT16_MAX);
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	return (sample_t)CLAMP(llrintf(coeff * 2147483648.0f), INT32_MIN, INT32_MAX);
+#endif
+}
+
+/* Windowed sinc evaluated at the distance from the output position, in input samples */
+static float prototype_get(float dist, float cutoff, float i0_beta)
+{
+	float ratio = dist / (TAPS / 2);
+	float window;
+	float sinc;
+
+	if (fabsf(ratio) > 1.0f) {
+		return 0.0f;
+	}
+
+	window = bessel_i0(KAISER_BETA * sqrtf(1.0f - ratio * ratio)) / i0_beta;
+
+	if (dist == 0.0f) {
+		sinc = 2.0f * cutoff;
+	} else {
+		sinc = sinf(2.0f * (float)M_PI * cutoff * dist) / ((float)M_PI * dist);
+	}
+
+	return sinc * window;
+}
+
+/**
+ * @brief Build the filter bank.
+ *
+ * @details Phase p holds the taps for an output located p / phases of an input sample after the
+ *	    center of the delay line. Each phase is normalized to unity gain at DC. An
+ *	    interpolated bank has an extra phase, equal to phase 0 shifted by one sample, so the
+ *	    phase after the last one can always be read.
+ */
+static void coeffs_build(struct sample_rate_converter_polyphase *pp, bool interpolated)
+{
+	const float i0_beta = bessel_i0(KAISER_BETA);
+	float cutoff = 0.5f * CUTOFF_RATIO;
+	uint32_t phases_stored;
+
+	if (pp->interpolation < pp->decimation) {
+		cutoff = cutoff * pp->interpolation / pp->decimation;
+	}
+
+	pp->interpolated = interpolated;
+	pp->phases = interpolated ? PHASES : pp->interpolation;
+	phases_stored = interpolated ? (PHASES + 1) : pp->interpolation;
+
+	for (uint32_t p = 0; p < phases_stored; p++) {
+		float frac = (float)p / pp->phases;
+		sample_t *coeffs = &COEFFS(pp)[p * TAPS];
+		float sum = 0.0f;
+
+		for (int k = 0; k < TAPS; k++) {
+			sum += prototype_get(k - (TAPS / 2) + 1 - frac, cutoff, i0_beta);
+		}
+
+		for (int k = 0; k < TAPS; k++) {
+			coeffs[k] = coeff_quantize(
+				prototype_get(k - (TAPS / 2) + 1 - frac, cutoff, i0_beta) / sum);
+		}
+	}
+
+	LOG_DBG("Filter bank built with %d phases, interpolated: %d", pp->phases, interpolated);
+}
+
+static bool bank_interpolated(const struct sample_rate_converter_polyphase *pp)
+{
+	return (pp->drift_ppm != 0) || (pp->interpolation > PHASES);
+}
+
+static inline q63_t dot_prod(const sample_t *samples, const sample_t *coeffs)
+{
+	q63_t acc;
+
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	/* Result in 34.30 format */
+	arm_dot_prod_q15(samples, coeffs, TAPS, &acc);
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	/* Result in 16.48 format */
+	arm_dot_prod_q31(samples, coeffs, TAPS, &acc);
+#endif
+
+	return acc;
+}
+
+static inline sample_t acc_to_sample(q63_t acc)
+{
+#ifdef CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+	return (sample_t)CLAMP(acc >> 15, INT16_MIN, INT16_MAX);
+#elif CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_32
+	return (sample_t)CLAMP(acc >> 17, INT32_MIN, INT32_MAX);
+#endif
+}
+
+static inline sample_t output_get(const struct sample_rate_converter_polyphase *pp,
+				  const sample_t *samples)
+{
+	if (!pp->interpolated) {
+		/* The position is a multiple of PPM_SCALE when the drift is 0 */
+		return acc_to_sample(
+			dot_prod(samples, &COEFFS(pp)[(pp->pos / PPM_SCALE) * TAPS]));
+	}
+
+	uint64_t phase = (uint64_t)pp->pos * pp->phases;
+	uint32_t idx = phase / pp->pos_den;
+	int64_t frac = ((phase % pp->pos_den) << PHASE_FRAC_BITS) / pp->pos_den;
+	q63_t acc_a = dot_prod(samples, &COEFFS(pp)[idx * TAPS]);
+	q63_t acc_b = dot_prod(samples, &COEFFS(pp)[(idx + 1) * TAPS]);
+
+	return acc_to_sample(acc_a + (((acc_b - acc_a) * frac) >> PHASE_FRAC_BITS));
+}
+
+int sample_rate_converter_polyphase_init(struct sample_rate_converter_polyphase *pp,
+					 uint32_t sample_rate_input,
+					 uint32_t sample_rate_output)
+{
+	uint32_t div;
+
+	if (!sample_rate_supported(sample_rate_input) ||
+	    !sample_rate_supported(sample_rate_output)) {
+		LOG_ERR("Sample rates not supported by the polyphase filter: %d -> %d",
+			sample_rate_input, sample_rate_output);
+		return -EINVAL;
+	}
+
+	div = gcd(sample_rate_input, sample_rate_output);
+	pp->interpolation = sample_rate_output / div;
+	pp->decimation = sample_rate_input / div;
+
+	pp->pos = 0;
+	pp->pos_den = pp->interpolation * PPM_SCALE;
+	pp->pos_step = pp->decimation * (PPM_SCALE + pp->drift_ppm);
+
+	pp->delay_line_idx = 0;
+	memset(DELAY_LINE(pp), 0, sizeof(DELAY_LINE(pp)));
+
+	coeffs_build(pp, bank_interpolated(pp));
+
+	LOG_DBG("Polyphase filter initialized, ratio %d/%d", pp->interpolation, pp->decimation);
+	return 0;
+}
+
+void sample_rate_converter_polyphase_drift_set(struct sample_rate_converter_polyphase *pp,
+					       int32_t drift_ppm)
+{
+	pp->drift_ppm = drift_ppm;
+
+	if (pp->interpolation == 0) {
+		/* Applied when the filter is initialized */
+		return;
+	}
+
+	if (bank_interpolated(pp) != pp->interpolated) {
+		if (!bank_interpolated(pp)) {
+			/* Snap to the closest earlier phase of the exact filter bank */
+			pp->pos -= pp->pos % PPM_SCALE;
+		}
+
+		coeffs_build(pp, bank_interpolated(pp));
+	}
+
+	pp->pos_step = pp->decimation * (PPM_SCALE + drift_ppm);
+}
+
+size_t sample_rate_converter_polyphase_output_count(const struct sample_rate_converter_polyphase *pp,
+						    size_t samples_in)
+{
+	uint64_t end = (uint64_t)samples_in * pp->pos_den;
+
+	if (end <= pp->pos) {
+		return 0;
+	}
+
+	return DIV_ROUND_UP(end - pp->pos, pp->pos_step);
+}
+
+size_t sample_rate_converter_polyphase_process(struct sample_rate_converter_polyphase *pp,
+					       void const *input, size_t samples_in, void *output)
+{
+	const sample_t *in = input;
+	sample_t *out = output;
+	sample_t *delay_line = DELAY_LINE(pp);
+	size_t samples_out = 0;
+
+	for (size_t i = 0; i < samples_in; i++) {
+		delay_line[pp->delay_line_idx] = in[i];
+		delay_line[pp->delay_line_idx + TAPS] = in[i];
+		pp->delay_line_idx = (pp->delay_line_idx + 1) % TAPS;
+
+		/* Produce every output located between this input sample and the next */
+		while (pp->pos < pp->pos_den) {
+			out[samples_out++] = output_get(pp, &delay_line[pp->delay_line_idx]);
+			pp->pos += pp->pos_step;
+		}
+
+		pp->pos -= pp->pos_den;
+	}
+
+	return samples_out;
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _SAMPLE_RATE_CONVERTER_POLYPHASE_H_
+#define _SAMPLE_RATE_CONVERTER_POLYPHASE_H_
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sample_rate_converter.h"
+
+/**
+ * @brief Initialize the polyphase filter for a new conversion.
+ *
+ * @details Reduces the conversion ratio, builds the filter bank and clears the filter history.
+ *	    The drift set in the state is kept.
+ *
+ * @param[in,out]	pp			Pointer to the polyphase filter state.
+ * @param[in]		sample_rate_input	Sample rate of the input samples.
+ * @param[in]		sample_rate_output	Sample rate of the output samples.
+ *
+ * @retval	0	On success.
+ * @retval	-EINVAL	Sample rate not supported.
+ */
+int sample_rate_converter_polyphase_init(struct sample_rate_converter_polyphase *pp,
+					 uint32_t sample_rate_input,
+					 uint32_t sample_rate_output);
+
+/**
+ * @brief Set the drift to compensate for.
+ *
+ * @details If the filter has not been initialized, the drift is only stored.
+ *
+ * @param[in,out]	pp		Pointer to the polyphase filter state.
+ * @param[in]		drift_ppm	Drift in parts per million.
+ */
+void sample_rate_converter_polyphase_drift_set(struct sample_rate_converter_polyphase *pp,
+					       int32_t drift_ppm);
+
+/**
+ * @brief Get the number of output samples produced for a number of input samples.
+ *
+ * @param[in]	pp		Pointer to the polyphase filter state.
+ * @param[in]	samples_in	Number of input samples.
+ *
+ * @return	Number of output samples the next process call will produce.
+ */
+size_t sample_rate_converter_polyphase_output_count(const struct sample_rate_converter_polyphase *pp,
+						    size_t samples_in);
+
+/**
+ * @brief Convert input samples directly into the output.
+ *
+ * @note The output must have room for the number of samples given by
+ *	 @ref sample_rate_converter_polyphase_output_count.
+ *
+ * @param[in,out]	pp		Pointer to the polyphase filter state.
+ * @param[in]		input		Input samples.
+ * @param[in]		samples_in	Number of input samples.
+ * @param[out]		output		Output samples.
+ *
+ * @return	Number of output samples written.
+ */
+size_t sample_rate_converter_polyphase_process(struct sample_rate_converter_polyphase *pp,
+					       void const *input, size_t samples_in, void *output);
+
+#endif /* _SAMPLE_RATE_CONVERTER_POLYPHASE_H_ */
@@ -8,6 +8,7 @@
 #include <zephyr/kernel.h>
 #include <zephyr/spinlock.h>
 #include <zephyr/sys/slist.h>
+#include <zephyr/sys/mpsc_lockfree.h>
 #include <app_event_manager.h>
 #include <zephyr/logging/log.h>
 #include <zephyr/sys/reboot.h>
@@ -15,14 +16,88 @@
 LOG_MODULE_REGISTER(app_event_manager, CONFIG_APP_EVENT_MANAGER_LOG_LEVEL);
 
 
+#define EVENT_QUEUE_COUNT _APP_EVENT_QUEUE_CNT
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_LOCKLESS)
+#define EVENT_QUEUE_INITIALIZER(i, _)						\
+	{									\
+		.processor = Z_WORK_INITIALIZER(event_processor_fn),		\
+		.events = MPSC_INIT(event_queues[i].events),			\
+		.wakeup_pending = ATOMIC_INIT(0),				\
+	}
+
+struct event_queue {
+	struct k_work processor;
+	struct mpsc events;
+	/* Set by the submission that schedules the processor. */
+	atomic_t wakeup_pending;
+};
+#else
+#define EVENT_QUEUE_INITIALIZER(i, _)						\
+	{									\
+		.processor = Z_WORK_INITIALIZER(event_processor_fn),		\
+		.events = SYS_SLIST_STATIC_INIT(&event_queues[i].events),	\
+	}
+
+struct event_queue {
+	struct k_work processor;
+	sys_slist_t events;
+};
+#endif
+
 static void event_processor_fn(struct k_work *work);
 
 struct app_event_manager_event_display_bm _app_event_manager_event_display_bm;
 
-static K_WORK_DEFINE(event_processor, event_processor_fn);
-static sys_slist_t eventq = SYS_SLIST_STATIC_INIT(&eventq);
+static struct event_queue event_queues[EVENT_QUEUE_COUNT] = {
+	LISTIFY(EVENT_QUEUE_COUNT, EVENT_QUEUE_INITIALIZER, (,))
+};
 static struct k_spinlock lock;
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+BUILD_ASSERT(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUE_THREAD_PRIORITY - EVENT_QUEUE_COUNT + 1 >=
+	     -CONFIG_NUM_COOP_PRIORITIES,
+	     "Event queue thread priority out of range");
+
+static K_THREAD_STACK_ARRAY_DEFINE(event_queue_stacks, EVENT_QUEUE_COUNT,
+				   CONFIG_APP_EVENT_MANAGER_EVENT_QUEUE_STACK_SIZE);
+static struct k_work_q event_work_qs[EVENT_QUEUE_COUNT];
+
+/* Event queue index per event type. Event types without assignment use queue 0. */
+static uint8_t event_queue_map[CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT];
+#endif
+
+static struct event_queue *event_queue_get(const struct event_type *et)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+	size_t idx = et - _event_type_list_start;
+
+	return &event_queues[event_queue_map[idx]];
+#else
+	return &event_queues[0];
+#endif
+}
+
+static struct k_work_q *event_work_q_get(const struct event_queue *queue)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+	return &event_work_qs[queue - event_queues];
+#else
+	return &k_sys_work_q;
+#endif
+}
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_COALESCING)
+struct event_coalesce_state {
+	app_event_merge_fn merge;
+	struct app_event_header *pending;
+	struct app_event_manager_coalesce_stats stats;
+};
+
+/* Coalescing state per event type. Protected by the lock. */
+static struct event_coalesce_state coalesce_states[CONFIG_APP_EVENT_MANAGER_MAX_EVENT_CNT];
+#endif
+
 static bool log_is_event_displayed(const struct event_type *et)
 {
 	size_t idx = et - _event_type_list_start;
@@ -114,42 +189,282 @@ static void log_event_init(void)
 	}
 }
 
+static void event_alloc_failed(void)
+{
+	LOG_ERR("Application Event Manager OOM error\n");
+	__ASSERT_NO_MSG(false);
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_REBOOT_ON_EVENT_ALLOC_FAIL)) {
+		sys_reboot(SYS_REBOOT_WARM);
+	} else {
+		k_panic();
+	}
+}
+
 void * __weak app_event_manager_alloc(size_t size)
 {
 	void *event = k_malloc(size);
 
 	if (unlikely(!event)) {
-		LOG_ERR("Application Event Manager OOM error\n");
-		__ASSERT_NO_MSG(false);
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_REBOOT_ON_EVENT_ALLOC_FAIL)) {
-			sys_reboot(SYS_REBOOT_WARM);
-		} else {
-			k_panic();
-		}
+		event_alloc_failed();
 		return NULL;
 	}
 
 	return event;
 }
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB)
+static bool slab_owns(const struct k_mem_slab *slab, const void *addr)
+{
+	const char *start = slab->buffer;
+	const char *end = start + (slab->info.num_blocks * slab->info.block_size);
+
+	return ((const char *)addr >= start) && ((const char *)addr < end);
+}
+
+void *_app_event_manager_slab_alloc(const struct event_type *et, size_t size)
+{
+	APP_EVENT_ASSERT_ID(et);
+
+	if (!et->slab) {
+		return app_event_manager_alloc(size);
+	}
+
+	__ASSERT_NO_MSG(size <= et->slab->info.block_size);
+
+	void *event;
+
+	if (unlikely(k_mem_slab_alloc(et->slab, &event, K_NO_WAIT))) {
+		event_alloc_failed();
+		return NULL;
+	}
+
+	return event;
+}
+
+static int event_slabs_init(void)
+{
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		struct k_mem_slab *slab = et->slab;
+
+		if (slab) {
+			int err = k_mem_slab_init(slab, slab->buffer, slab->info.block_size,
+						  slab->info.num_blocks);
+
+			__ASSERT_NO_MSG(!err);
+			ARG_UNUSED(err);
+		}
+	}
+
+	return 0;
+}
+
+/* The slabs must be ready before the first event is allocated. */
+SYS_INIT(event_slabs_init, PRE_KERNEL_1, 0);
+#endif
+
 void __weak app_event_manager_free(void *addr)
 {
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB)
+	if (!addr) {
+		return;
+	}
+
+	const struct app_event_header *aeh = addr;
+	struct k_mem_slab *slab = aeh->type_id->slab;
+
+	/* Events received by Event Manager Proxy are allocated from the heap
+	 * regardless of the event type.
+	 */
+	if (slab && slab_owns(slab, addr)) {
+		k_mem_slab_free(slab, addr);
+		return;
+	}
+#endif
+
 	k_free(addr);
 }
 
+static bool subscriber_filter_match(const struct app_event_header *aeh,
+				    const struct event_subscriber *es)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBSCRIBER_FILTERS)
+	const struct event_subscriber_filter *filter = &es->filter;
+	const void *field = (const uint8_t *)aeh + filter->offset;
+
+	switch (filter->size) {
+	case 0:
+		return true;
+
+	case sizeof(uint8_t):
+		return *(const uint8_t *)field == (uint8_t)filter->value;
+
+	case sizeof(uint16_t):
+		return *(const uint16_t *)field == (uint16_t)filter->value;
+
+	case sizeof(uint32_t):
+		return *(const uint32_t *)field == (uint32_t)filter->value;
+
+	default:
+		__ASSERT_NO_MSG(filter->size == sizeof(uintptr_t));
+		return *(const uintptr_t *)field == filter->value;
+	}
+#else
+	return true;
+#endif
+}
+
+/* Must be called with the lock held. */
+static bool event_coalesce(struct app_event_header *aeh)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_COALESCING)
+	struct event_coalesce_state *cs =
+		&coalesce_states[aeh->type_id - _event_type_list_start];
+
+	if (!cs->merge) {
+		return false;
+	}
+
+	if (cs->pending && cs->merge(cs->pending, aeh)) {
+		cs->stats.merged++;
+		return true;
+	}
+
+	cs->pending = aeh;
+#endif
+	return false;
+}
+
+static void event_coalesce_stop(struct app_event_header *aeh)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_COALESCING)
+	struct event_coalesce_state *cs =
+		&coalesce_states[aeh->type_id - _event_type_list_start];
+
+	if (!cs->merge) {
+		return;
+	}
+
+	/* No events can be merged into the event after its delivery is started. */
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	if (cs->pending == aeh) {
+		cs->pending = NULL;
+	}
+	cs->stats.delivered++;
+
+	k_spin_unlock(&lock, key);
+#endif
+}
+
+bool _app_event_manager_coalesce_stats_get(const struct event_type *et,
+					   struct app_event_manager_coalesce_stats *stats)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_COALESCING)
+	APP_EVENT_ASSERT_ID(et);
+
+	const struct event_coalesce_state *cs = &coalesce_states[et - _event_type_list_start];
+
+	if (!cs->merge) {
+		return false;
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&lock);
+
+	*stats = cs->stats;
+
+	k_spin_unlock(&lock, key);
+
+	return true;
+#else
+	return false;
+#endif
+}
+
+static void event_dispatch(struct app_event_header *aeh)
+{
+	APP_EVENT_ASSERT_ID(aeh->type_id);
+
+	const struct event_type *et = aeh->type_id;
+
+	event_coalesce_stop(aeh);
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
+			h->hook(aeh);
+		}
+	}
+
+	log_event(aeh);
+
+	bool consumed = false;
+
+	for (const struct event_subscriber *es = et->subs_start;
+	     (es != et->subs_stop) && !consumed;
+	     es++) {
+
+		__ASSERT_NO_MSG(es != NULL);
+
+		const struct event_listener *el = es->listener;
+
+		__ASSERT_NO_MSG(el != NULL);
+		__ASSERT_NO_MSG(el->notification != NULL);
+
+		if (!subscriber_filter_match(aeh, es)) {
+			continue;
+		}
+
+		log_event_progress(et, el);
+
+		consumed = el->notification(aeh);
+
+		if (consumed) {
+			log_event_consumed(et);
+		}
+	}
+
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
+			h->hook(aeh);
+		}
+	}
+
+	app_event_manager_free(aeh);
+}
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_LOCKLESS)
+static void event_processor_fn(struct k_work *work)
+{
+	struct event_queue *queue = CONTAINER_OF(work, struct event_queue, processor);
+	struct mpsc_node *node;
+
+	/* Clear the flag before draining the queue. An event pushed after
+	 * the queue is found empty schedules the processor again.
+	 */
+	atomic_clear(&queue->wakeup_pending);
+
+	while ((node = mpsc_pop(&queue->events)) != NULL) {
+		struct app_event_header *aeh = CONTAINER_OF(node,
+						       struct app_event_header,
+						       mpsc_node);
+
+		event_dispatch(aeh);
+	}
+}
+#else
 static void event_processor_fn(struct k_work *work)
 {
+	struct event_queue *queue = CONTAINER_OF(work, struct event_queue, processor);
 	sys_slist_t events = SYS_SLIST_STATIC_INIT(&events);
 
 	/* Make current event list local. */
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
-	if (sys_slist_is_empty(&eventq)) {
+	if (sys_slist_is_empty(&queue->events)) {
 		k_spin_unlock(&lock, key);
 		return;
 	}
 
-	sys_slist_merge_slist(&events, &eventq);
+	sys_slist_merge_slist(&events, &queue->events);
 
 	k_spin_unlock(&lock, key);
 
@@ -160,68 +475,182 @@ static void event_processor_fn(struct k_work *work)
 						       struct app_event_header,
 						       node);
 
-		APP_EVENT_ASSERT_ID(aeh->type_id);
+		event_dispatch(aeh);
+	}
+}
+#endif
 
-		const struct event_type *et = aeh->type_id;
+/* Locks the event queues for submission. No-op if lock-free submission is used. */
+static k_spinlock_key_t submit_lock(void)
+{
+	k_spinlock_key_t key = {0};
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_PREPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_preprocess_hook, h) {
-				h->hook(aeh);
-			}
-		}
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_LOCKLESS)) {
+		key = k_spin_lock(&lock);
+	}
 
-		log_event(aeh);
+	return key;
+}
 
-		bool consumed = false;
+static void submit_unlock(k_spinlock_key_t key)
+{
+	if (!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_LOCKLESS)) {
+		k_spin_unlock(&lock, key);
+	}
+}
+
+/* Must be called with the submit lock held.
+ * Returns the queue the event was added to or NULL if the event was merged.
+ */
+static struct event_queue *event_enqueue(struct app_event_header *aeh)
+{
+	__ASSERT_NO_MSG(aeh);
+	APP_EVENT_ASSERT_ID(aeh->type_id);
+
+	if (event_coalesce(aeh)) {
+		return NULL;
+	}
 
-		for (const struct event_subscriber *es = et->subs_start;
-		     (es != et->subs_stop) && !consumed;
-		     es++) {
+	struct event_queue *queue = event_queue_get(aeh->type_id);
 
-			__ASSERT_NO_MSG(es != NULL);
+	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
+		STRUCT_SECTION_FOREACH(event_submit_hook, h) {
+			h->hook(aeh);
+		}
+	}
 
-			const struct event_listener *el = es->listener;
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_LOCKLESS)
+	mpsc_push(&queue->events, &aeh->mpsc_node);
+#else
+	sys_slist_append(&queue->events, &aeh->node);
+#endif
 
-			__ASSERT_NO_MSG(el != NULL);
-			__ASSERT_NO_MSG(el->notification != NULL);
+	return queue;
+}
 
-			log_event_progress(et, el);
+static void event_queue_kick(struct event_queue *queue)
+{
+	/* Work queues are started on Application Event Manager initialization.
+	 * Events submitted before are processed after the initialization.
+	 */
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_LOCKLESS)
+	/* Only the submission that sets the flag schedules the processor. */
+	if (atomic_set(&queue->wakeup_pending, 1)) {
+		return;
+	}
 
-			consumed = el->notification(aeh);
+	if (k_work_submit_to_queue(event_work_q_get(queue), &queue->processor) < 0) {
+		/* Work queue is not running yet. Let the next submission retry. */
+		atomic_clear(&queue->wakeup_pending);
+	}
+#else
+	(void)k_work_submit_to_queue(event_work_q_get(queue), &queue->processor);
+#endif
+}
 
-			if (consumed) {
-				log_event_consumed(et);
-			}
-		}
+void _event_submit(struct app_event_header *aeh)
+{
+	k_spinlock_key_t key = submit_lock();
+	struct event_queue *queue = event_enqueue(aeh);
 
-		if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTPROCESS_HOOKS)) {
-			STRUCT_SECTION_FOREACH(event_postprocess_hook, h) {
-				h->hook(aeh);
-			}
-		}
+	submit_unlock(key);
 
+	if (!queue) {
 		app_event_manager_free(aeh);
+		return;
 	}
+
+	event_queue_kick(queue);
 }
 
-void _event_submit(struct app_event_header *aeh)
+void _event_submit_batch(struct app_event_header *const aehs[], size_t cnt)
 {
-	__ASSERT_NO_MSG(aeh);
-	APP_EVENT_ASSERT_ID(aeh->type_id);
+	__ASSERT_NO_MSG(aehs || (cnt == 0));
 
-	k_spinlock_key_t key = k_spin_lock(&lock);
+	sys_slist_t merged = SYS_SLIST_STATIC_INIT(&merged);
+	bool queue_used[EVENT_QUEUE_COUNT] = {false};
+	k_spinlock_key_t key = submit_lock();
 
-	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBMIT_HOOKS)) {
-		STRUCT_SECTION_FOREACH(event_submit_hook, h) {
-			h->hook(aeh);
+	for (size_t i = 0; i < cnt; i++) {
+		struct event_queue *queue = event_enqueue(aehs[i]);
+
+		if (queue) {
+			queue_used[queue - event_queues] = true;
+		} else {
+			sys_slist_append(&merged, &aehs[i]->node);
 		}
 	}
-	sys_slist_append(&eventq, &aeh->node);
-	k_spin_unlock(&lock, key);
 
-	k_work_submit(&event_processor);
+	submit_unlock(key);
+
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(&merged)) != NULL) {
+		app_event_manager_free(CONTAINER_OF(node, struct app_event_header, node));
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(queue_used); i++) {
+		if (queue_used[i]) {
+			event_queue_kick(&event_queues[i]);
+		}
+	}
 }
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES) || \
+	IS_ENABLED(CONFIG_APP_EVENT_MANAGER_COALESCING)
+static int event_type_maps_init(void)
+{
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+	STRUCT_SECTION_FOREACH(event_queue_assignment, qa) {
+		APP_EVENT_ASSERT_ID(qa->type);
+
+		size_t idx = qa->type - _event_type_list_start;
+
+		__ASSERT_NO_MSG(qa->queue < EVENT_QUEUE_COUNT);
+		event_queue_map[idx] = qa->queue;
+	}
+#endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_COALESCING)
+	STRUCT_SECTION_FOREACH(event_coalesce, ec) {
+		APP_EVENT_ASSERT_ID(ec->type);
+		__ASSERT_NO_MSG(ec->merge);
+
+		size_t idx = ec->type - _event_type_list_start;
+
+		coalesce_states[idx].merge = ec->merge;
+	}
+#endif
+
+	return 0;
+}
+
+/* The maps must be ready before the first event is submitted. */
+SYS_INIT(event_type_maps_init, PRE_KERNEL_1, 0);
+#endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+static void event_queues_start(void)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(event_work_qs); i++) {
+		char name[sizeof("app_event_qXX")];
+		struct k_work_queue_config cfg = {
+			.name = name,
+		};
+
+		(void)snprintf(name, sizeof(name), "app_event_q%zu", i);
+
+		k_work_queue_start(&event_work_qs[i], event_queue_stacks[i],
+				   K_THREAD_STACK_SIZEOF(event_queue_stacks[i]),
+				   CONFIG_APP_EVENT_MANAGER_EVENT_QUEUE_THREAD_PRIORITY - (int)i,
+				   &cfg);
+
+		/* Process events submitted before the work queue was started. */
+		(void)k_work_submit_to_queue(&event_work_qs[i], &event_queues[i].processor);
+	}
+}
+#endif
+
 int app_event_manager_init(void)
 {
 	int ret = 0;
@@ -231,6 +660,10 @@ int app_event_manager_init(void)
 
 	log_event_init();
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+	event_queues_start();
+#endif
+
 	if (IS_ENABLED(CONFIG_APP_EVENT_MANAGER_POSTINIT_HOOK)) {
 		STRUCT_SECTION_FOREACH(app_event_manager_postinit_hook, h) {
 			ret = h->hook();
@@ -16,6 +16,7 @@
 #include <zephyr/types.h>
 #include <zephyr/sys/__assert.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/mpsc_lockfree.h>
 
 #ifdef __cplusplus
 extern "C" {
@@ -115,10 +116,41 @@ extern "C" {
 	}
 
 
+/* Subscribe a listener to an event with a filter on the event field. */
+#define _APP_EVENT_SUBSCRIBE_FILTER(lname, ename, prio, field, val)				\
+	BUILD_ASSERT(IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBSCRIBER_FILTERS),			\
+		     "Enable APP_EVENT_MANAGER_SUBSCRIBER_FILTERS before usage");		\
+	BUILD_ASSERT((_APP_EVENT_FIELD_SIZE(ename, field) == sizeof(uint8_t)) ||		\
+		     (_APP_EVENT_FIELD_SIZE(ename, field) == sizeof(uint16_t)) ||		\
+		     (_APP_EVENT_FIELD_SIZE(ename, field) == sizeof(uint32_t)) ||		\
+		     (_APP_EVENT_FIELD_SIZE(ename, field) == sizeof(uintptr_t)),		\
+		     "Unsupported size of the filtered field");					\
+	const struct event_subscriber _CONCAT(_CONCAT(__event_subscriber_, ename), lname)	\
+	__used __aligned(__alignof(struct event_subscriber))					\
+	__attribute__((__section__(_APP_EVENT_SUBSCRIBERS_SECTION_NAME(ename, prio)))) = {	\
+		.listener = &_CONCAT(__event_listener_, lname),					\
+		.filter = {									\
+			.offset = offsetof(struct ename, field),				\
+			.size = _APP_EVENT_FIELD_SIZE(ename, field),				\
+			.value = (uintptr_t)(val),						\
+		},										\
+	}
+
+/* Size of the event structure field. */
+#define _APP_EVENT_FIELD_SIZE(ename, field) sizeof(((struct ename *)0)->field)
+
+
 /* Pointer to event type definition is used as event type identifier. */
 #define _EVENT_ID(ename) (&_CONCAT(__event_type_, ename))
 
 
+/* Allocate memory for an event of the given ename type. */
+#define _APP_EVENT_ALLOC(ename, size)						\
+	COND_CODE_1(IS_ENABLED(CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB),		\
+		(_app_event_manager_slab_alloc(_EVENT_ID(ename), (size))),	\
+		(app_event_manager_alloc(size)))
+
+
 /* Macro generates a function of name new_ename where ename is provided as
  * an argument. Allocator function is used to create an event of the given
  * ename type.
@@ -127,7 +159,7 @@ extern "C" {
 	static inline struct ename *_CONCAT(new_, ename)(void)			\
 	{									\
 		struct ename *event =						\
-			(struct ename *)app_event_manager_alloc(sizeof(*event));\
+			(struct ename *)_APP_EVENT_ALLOC(ename, sizeof(*event));\
 		BUILD_ASSERT(offsetof(struct ename, header) == 0,		\
 				 "");						\
 		if (event != NULL) {						\
@@ -145,7 +177,7 @@ extern "C" {
 	static inline struct ename *_CONCAT(new_, ename)(size_t size)			\
 	{										\
 		struct ename *event =							\
-			(struct ename *)app_event_manager_alloc(sizeof(*event) + size);	\
+			(struct ename *)_APP_EVENT_ALLOC(ename, sizeof(*event) + size);	\
 		BUILD_ASSERT((offsetof(struct ename, dyndata) +				\
 				  sizeof(event->dyndata.size)) ==			\
 				 sizeof(*event), "");					\
@@ -219,14 +251,47 @@ extern "C" {
 #define _APP_EVENT_TYPE_DEFINE_SIZES(ename)
 #endif
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB)
+#define _APP_EVENT_SLAB_NAME(ename) _CONCAT(__event_slab_, ename)
+#define _APP_EVENT_SLAB_BUF_NAME(ename) _CONCAT(__event_slab_buf_, ename)
+
+#define _APP_EVENT_SLAB_DEFINE_IMPL(name, buf_name, block_size, block_cnt, align)	\
+	static char __aligned(align) buf_name[(block_cnt) * WB_UP(block_size)];	\
+	static struct k_mem_slab name =							\
+		Z_MEM_SLAB_INITIALIZER(name, buf_name, WB_UP(block_size), block_cnt)
+
+/* Events with dynamic data are allocated using app_event_manager_alloc.
+ * The slab is only referenced by an event type without dynamic data, so it is not
+ * emitted for the other types. As it is not placed in the kernel section of memory slabs,
+ * it is initialized by the Application Event Manager.
+ */
+#define _APP_EVENT_SLAB_DEFINE(ename)							\
+	_APP_EVENT_SLAB_DEFINE_IMPL(_APP_EVENT_SLAB_NAME(ename),			\
+		_APP_EVENT_SLAB_BUF_NAME(ename),					\
+		sizeof(struct ename),							\
+		CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB_BLOCK_CNT,				\
+		MAX(__alignof__(struct ename), sizeof(void *)));
+
+#define _APP_EVENT_TYPE_DEFINE_SLAB(ename)						\
+	.slab = (_CONCAT(ename, _HAS_DYNDATA) ? NULL : &_APP_EVENT_SLAB_NAME(ename)),
+#else
+#define _APP_EVENT_SLAB_DEFINE(ename)
+#define _APP_EVENT_TYPE_DEFINE_SLAB(ename)
+#endif
+
 /** @brief Event header.
  *
  * When defining an event structure, the application event header
  * must be placed as the first field.
  */
 struct app_event_header {
-	/** Linked list node used to chain events. */
-	sys_snode_t node;
+	union {
+		/** Linked list node used to chain events. */
+		sys_snode_t node;
+
+		/** Lock-free queue node used to chain submitted events. */
+		struct mpsc_node mpsc_node;
+	};
 
 	/** Pointer to the event type object. */
 	const struct event_type *type_id;
@@ -292,6 +357,11 @@ struct event_type {
 	/** The size of the event structure */
 	uint16_t struct_size;
 #endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB)
+	/** Memory slab used to allocate events, NULL for events with dynamic data. */
+	struct k_mem_slab *slab;
+#endif
 };
 
 
@@ -304,6 +374,7 @@ extern struct event_type _event_type_list_end[];
 		APP_EVENT_TYPE_FLAGS_SYSTEM_START))<<					\
 		APP_EVENT_TYPE_FLAGS_SYSTEM_START)) == 0);				\
 	_APP_EVENT_SUBSCRIBERS_ARRAY_TAGS(ename);					\
+	_APP_EVENT_SLAB_DEFINE(ename)							\
 	STRUCT_SECTION_ITERABLE(event_type, _CONCAT(__event_type_, ename)) = {		\
 		.name            = STRINGIFY(ename),					\
 		.subs_start      = _APP_EVENT_SUBSCRIBERS_START_TAG(ename),		\
@@ -315,6 +386,7 @@ extern struct event_type _event_type_list_end[];
 				((et_flags) | BIT(APP_EVENT_TYPE_FLAGS_HAS_DYNDATA)) :	\
 				((et_flags) & (~BIT(APP_EVENT_TYPE_FLAGS_HAS_DYNDATA)))),\
 		_APP_EVENT_TYPE_DEFINE_SIZES(ename) /* No comma here intentionally */	\
+		_APP_EVENT_TYPE_DEFINE_SLAB(ename) /* No comma here intentionally */	\
 	}
 
 /**
@@ -390,11 +462,33 @@ struct event_listener {
 };
 
 
+/** @brief Event subscriber filter.
+ *
+ * The listener is notified only about events with the field of the event structure
+ * equal to the given value.
+ */
+struct event_subscriber_filter {
+	/** Offset of the filtered field in the event structure. */
+	uint16_t offset;
+
+	/** Size of the filtered field. Zero if the filter is not used. */
+	uint8_t size;
+
+	/** Value of the field required to notify the listener. */
+	uintptr_t value;
+};
+
+
 /** @brief Event subscriber.
  */
 struct event_subscriber {
 	/** Pointer to the listener. */
 	const struct event_listener *listener;
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBSCRIBER_FILTERS)
+	/** Filter applied before the listener is notified. */
+	struct event_subscriber_filter filter;
+#endif
 };
 
 
@@ -427,12 +521,101 @@ struct event_postprocess_hook {
 
 
 
+/** @brief Structure used to assign an event type to an event queue
+ */
+struct event_queue_assignment {
+	/** @brief Event type */
+	const struct event_type *type;
+
+	/** @brief Index of the event queue */
+	uint8_t queue;
+};
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+#define _APP_EVENT_QUEUE_CNT CONFIG_APP_EVENT_MANAGER_EVENT_QUEUE_COUNT
+#else
+#define _APP_EVENT_QUEUE_CNT 1
+#endif
+
+#define _APP_EVENT_TYPE_QUEUE_ASSIGN(ename, queue_idx)					\
+	BUILD_ASSERT(!IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES) ||		\
+		     ((queue_idx) < _APP_EVENT_QUEUE_CNT), "Invalid event queue index");	\
+	STRUCT_SECTION_ITERABLE(event_queue_assignment,					\
+				_CONCAT(__event_queue_assignment_, ename)) = {		\
+		.type = _EVENT_ID(ename),						\
+		.queue = (queue_idx),							\
+	}
+
+
+/** @brief Function merging a submitted event into the pending event of the same type.
+ *
+ * @param pending  Pointer to the application event header of the pending event.
+ * @param aeh      Pointer to the application event header of the submitted event.
+ * @retval True if the submitted event was merged and should be dropped, false otherwise.
+ */
+typedef bool (*app_event_merge_fn)(struct app_event_header *pending,
+				   const struct app_event_header *aeh);
+
+/** @brief Structure used to define a coalescing event type
+ */
+struct event_coalesce {
+	/** @brief Event type */
+	const struct event_type *type;
+
+	/** @brief Merge function */
+	app_event_merge_fn merge;
+};
+
+/** @brief Coalescing statistics of an event type
+ */
+struct app_event_manager_coalesce_stats {
+	/** @brief Number of events delivered to the listeners */
+	uint32_t delivered;
+
+	/** @brief Number of events merged into a pending event */
+	uint32_t merged;
+};
+
+#define _APP_EVENT_TYPE_COALESCE(ename, merge_fn)					\
+	BUILD_ASSERT(IS_ENABLED(CONFIG_APP_EVENT_MANAGER_COALESCING),			\
+		     "Enable APP_EVENT_MANAGER_COALESCING before usage");		\
+	STRUCT_SECTION_ITERABLE(event_coalesce, _CONCAT(__event_coalesce_, ename)) = {	\
+		.type = _EVENT_ID(ename),						\
+		.merge = (merge_fn),							\
+	}
+
+/** @brief Get coalescing statistics of an event type.
+ *
+ * @param et     Pointer to the event type.
+ * @param stats  Pointer to the structure filled with the statistics.
+ * @retval True if the event type is coalescing, false otherwise.
+ */
+bool _app_event_manager_coalesce_stats_get(const struct event_type *et,
+					   struct app_event_manager_coalesce_stats *stats);
+
+/** @brief Allocate an event from the memory slab of its event type.
+ *
+ * Events of types without a memory slab are allocated using app_event_manager_alloc.
+ *
+ * @param et    Pointer to the event type.
+ * @param size  Size of the event (in bytes).
+ * @retval Address of the allocated event if successful, otherwise NULL.
+ */
+void *_app_event_manager_slab_alloc(const struct event_type *et, size_t size);
+
 /** @brief Submit an event to the Application Event Manager.
  *
  * @param aeh  Pointer to the application event header element in the event object.
  */
 void _event_submit(struct app_event_header *aeh);
 
+/** @brief Submit multiple events to the Application Event Manager.
+ *
+ * @param aehs  Array of pointers to the application event header elements in the event objects.
+ * @param cnt   Number of events.
+ */
+void _event_submit_batch(struct app_event_header *const aehs[], size_t cnt);
+
 #ifdef __cplusplus
 }
 #endif
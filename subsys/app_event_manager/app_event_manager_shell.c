@@ -63,9 +63,19 @@ static int show_subscribers(const struct shell *shell, size_t argc,
 
 			__ASSERT_NO_MSG(el != NULL);
 			shell_fprintf(shell, SHELL_NORMAL,
-					"|\t[E:%s] -> [L:%s]\n",
+					"|\t[E:%s] -> [L:%s]",
 				et->name, el->name);
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_SUBSCRIBER_FILTERS)
+			if (es->filter.size > 0) {
+				shell_fprintf(shell, SHELL_NORMAL,
+					      " (filter: offset %u == 0x%lx)",
+					      es->filter.offset,
+					      (unsigned long)es->filter.value);
+			}
+#endif
+			shell_fprintf(shell, SHELL_NORMAL, "\n");
+
 			is_subscribed = true;
 		}
 
@@ -81,6 +91,61 @@ static int show_subscribers(const struct shell *shell, size_t argc,
 	return 0;
 }
 
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB)
+static int show_mem_stats(const struct shell *shell, size_t argc,
+			  char **argv)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "Event memory slabs:\n");
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		struct k_mem_slab *slab = et->slab;
+
+		if (!slab) {
+			shell_fprintf(shell, SHELL_NORMAL,
+				      "|\t[E:%s] allocated from heap\n",
+				      et->name);
+			continue;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[E:%s] block size: %zu, used: %u/%u",
+			      et->name, slab->info.block_size,
+			      k_mem_slab_num_used_get(slab), slab->info.num_blocks);
+
+		if (IS_ENABLED(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)) {
+			shell_fprintf(shell, SHELL_NORMAL, ", high-water mark: %u",
+				      k_mem_slab_max_used_get(slab));
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL, "\n");
+	}
+
+	return 0;
+}
+#endif
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_COALESCING)
+static int show_coalescing(const struct shell *shell, size_t argc,
+			   char **argv)
+{
+	shell_fprintf(shell, SHELL_NORMAL, "Coalescing events:\n");
+
+	STRUCT_SECTION_FOREACH(event_type, et) {
+		struct app_event_manager_coalesce_stats stats;
+
+		if (!_app_event_manager_coalesce_stats_get(et, &stats)) {
+			continue;
+		}
+
+		shell_fprintf(shell, SHELL_NORMAL,
+			      "|\t[E:%s] delivered: %u, merged: %u\n",
+			      et->name, stats.delivered, stats.merged);
+	}
+
+	return 0;
+}
+#endif
+
 static void set_event_displaying(const struct shell *shell, size_t argc,
 				 char **argv, bool enable)
 {
@@ -155,6 +220,14 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_app_event_manager,
 	SHELL_CMD_ARG(show_subscribers, NULL, "Show subscribers",
 		      show_subscribers, 0, 0),
 	SHELL_CMD_ARG(show_events, NULL, "Show events", show_events, 0, 0),
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_COALESCING)
+	SHELL_CMD_ARG(show_coalescing, NULL, "Show delivered and merged coalescing events",
+		      show_coalescing, 0, 0),
+#endif
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB)
+	SHELL_CMD_ARG(show_mem_stats, NULL, "Show event memory slab statistics",
+		      show_mem_stats, 0, 0),
+#endif
 	SHELL_CMD_ARG(disable, NULL, "Disable displaying event with given ID",
 		      disable_event_displaying, 0,
 		      sizeof(_app_event_manager_event_display_bm) * 8 - 1),
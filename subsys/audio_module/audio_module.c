@@ -126,6 +126,13 @@ static bool validate_parameters(struct audio_module_parameters const *const para
 		return false;
 	}
 
+#if CONFIG_AUDIO_MODULE_GRAPH
+	/* A module run in a graph has no thread of its own. */
+	if (parameters->graph != NULL) {
+		return true;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	if (parameters->thread.stack == NULL || parameters->thread.stack_size == 0) {
 		return false;
 	}
@@ -134,30 +141,89 @@ static bool validate_parameters(struct audio_module_parameters const *const para
 }
 
 /**
- * @brief General callback for releasing the data when inter-module data
- *        passing.
+ * @brief Helper function to get the reference count of a buffer from the module's data slab.
  *
- * @param handle      [in/out]  The handle of the sending modules instance.
- * @param audio_data  [in]      Pointer to the audio data to release.
+ * @param handle  [in]  The handle of the module owning the data slab.
+ * @param data    [in]  Pointer to the buffer.
+ *
+ * @return Pointer to the reference count, NULL if the buffer is not from the data slab.
  */
-static void audio_data_release_cb(struct audio_module_handle_private *handle,
-				  struct audio_data const *const audio_data)
+static atomic_t *data_ref_get(struct audio_module_handle *handle, void const *data)
+{
+	struct k_mem_slab *slab = handle->thread.data_slab;
+	size_t offset;
+
+	if (slab == NULL || (uint8_t const *)data < (uint8_t const *)slab->buffer) {
+		return NULL;
+	}
+
+	offset = (uint8_t const *)data - (uint8_t const *)slab->buffer;
+	if (offset % slab->info.block_size ||
+	    offset / slab->info.block_size >= slab->info.num_blocks) {
+		return NULL;
+	}
+
+	return &handle->data_ref[offset / slab->info.block_size];
+}
+
+/**
+ * @brief Allocate a buffer from the module's data slab, holding a single reference.
+ *
+ * @param handle   [in/out]  The handle of the module owning the data slab.
+ * @param data     [out]     Pointer to the allocated buffer.
+ * @param timeout  [in]      Time to wait for a free buffer.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int data_alloc(struct audio_module_handle *handle, void **data, k_timeout_t timeout)
 {
 	int ret;
-	struct audio_module_handle *hdl = (struct audio_module_handle *)handle;
 
-	ret = k_sem_take(&hdl->sem, K_NO_WAIT);
+	ret = k_mem_slab_alloc(handle->thread.data_slab, data, timeout);
 	if (ret) {
-		LOG_ERR("Failed to take semaphore for data release callback function");
+		return ret;
+	}
+
+	atomic_set(data_ref_get(handle, *data), 1);
+
+	return 0;
+}
+
+/**
+ * @brief Release a reference to a buffer, the buffer is freed when no references remain.
+ *
+ * @param handle  [in/out]  The handle of the module owning the data slab.
+ * @param data    [in]      Pointer to the buffer.
+ */
+static void data_unref(struct audio_module_handle *handle, void *data)
+{
+	atomic_t *ref = data_ref_get(handle, data);
+
+	if (ref == NULL) {
+		LOG_ERR("Audio data %p is not from the data slab of module %s", data,
+			handle->name);
 		return;
 	}
 
-	if (k_sem_count_get(&hdl->sem) == 0) {
-		/* Audio data has been consumed by all modules so now can free the data memory. */
-		k_mem_slab_free(hdl->thread.data_slab, (void **)&audio_data->data);
+	/* The previous value is returned, so 1 means the last reference was released. */
+	if (atomic_dec(ref) == 1) {
+		k_mem_slab_free(handle->thread.data_slab, data);
 	}
 }
 
+/**
+ * @brief General callback for releasing the data when inter-module data
+ *        passing.
+ *
+ * @param handle      [in/out]  The handle of the sending modules instance.
+ * @param audio_data  [in]      Pointer to the audio data to release.
+ */
+static void audio_data_release_cb(struct audio_module_handle_private *handle,
+				  struct audio_data const *const audio_data)
+{
+	data_unref((struct audio_module_handle *)handle, audio_data->data);
+}
+
 /**
  * @brief Send an audio data item to a module, all data is consumed by the module.
  *
@@ -246,20 +312,77 @@ static int tx_fifo_put(struct audio_module_handle *handle,
 
 		data_fifo_block_free(handle->thread.msg_tx, (void **)&data_msg_tx);
 
-		ret = k_sem_take(&handle->sem, K_NO_WAIT);
-		if (ret) {
-			LOG_ERR("Failed to take semaphore for TX FIFO put");
-		}
-
 		return ret;
 	}
 
 	return 0;
 }
 
+#if CONFIG_AUDIO_MODULE_GRAPH
+/**
+ * @brief Give audio data to a module in the same graph, to be processed later in the frame.
+ *
+ * @param tx_handle   [in/out]  The handle for the sending module instance.
+ * @param rx_handle   [in/out]  The handle for the receiving module instance.
+ * @param audio_data  [in]      Pointer to the audio data to send to the module.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int graph_data_tx(struct audio_module_handle *tx_handle,
+			 struct audio_module_handle *rx_handle,
+			 struct audio_data const *const audio_data)
+{
+	struct audio_module_graph_node *node = &rx_handle->graph->nodes[rx_handle->graph_node];
+	struct audio_module_message *msg;
+
+	if (rx_handle->state != AUDIO_MODULE_STATE_RUNNING) {
+		LOG_WRN("Receiving module %s is in an invalid state %d", rx_handle->name,
+			rx_handle->state);
+		return -ECANCELED;
+	}
+
+	if (node->pending_count >= CONFIG_AUDIO_MODULE_GRAPH_INPUTS_MAX) {
+		LOG_ERR("Module %s has too many inputs in the frame", rx_handle->name);
+		return -ENOMEM;
+	}
+
+	msg = &node->pending[node->pending_count++];
+	memcpy(&msg->audio_data, audio_data, sizeof(struct audio_data));
+	msg->tx_handle = tx_handle;
+	msg->response_cb = audio_data_release_cb;
+
+	return 0;
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
+/**
+ * @brief Send an audio data item to a connected module.
+ *
+ * @param tx_handle   [in/out]  The handle for the sending module instance.
+ * @param rx_handle   [in/out]  The handle for the receiving module instance.
+ * @param audio_data  [in]      Pointer to the audio data to send to the module.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int connected_data_tx(struct audio_module_handle *tx_handle,
+			     struct audio_module_handle *rx_handle,
+			     struct audio_data const *const audio_data)
+{
+#if CONFIG_AUDIO_MODULE_GRAPH
+	if (tx_handle->graph != NULL && rx_handle->graph == tx_handle->graph) {
+		return graph_data_tx(tx_handle, rx_handle, audio_data);
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
+	return data_tx(tx_handle, rx_handle, audio_data, &audio_data_release_cb);
+}
+
 /**
  * @brief Send the audio data item to all connected modules.
  *
+ * @note The audio data buffer is not copied, each receiver takes a reference to it. The reference
+ *       held by the caller is released.
+ *
  * @param handle      [in/out]  The handle for this modules instance.
  * @param audio_data  [in]      A pointer to the audio data.
  *
@@ -269,144 +392,213 @@ static int send_to_connected_modules(struct audio_module_handle *handle,
 				     struct audio_data const *const audio_data)
 {
 	int ret;
+	int ret_send = 0;
 	struct audio_module_handle *handle_to;
+	atomic_t *ref = data_ref_get(handle, audio_data->data);
+
+	if (ref == NULL) {
+		LOG_ERR("Audio data is not from the data slab of module %s", handle->name);
+		return -EINVAL;
+	}
 
 	if (handle->dest_count == 0) {
 		LOG_WRN("Nowhere to send the audio data from module %s so releasing it",
 			handle->name);
 
-		k_mem_slab_free(handle->thread.data_slab, (void **)audio_data->data);
+		data_unref(handle, audio_data->data);
 
 		return 0;
 	}
 
-	/* We need to ensure that all receiving modules have got the audio data.
+	/* The caller's reference is held until all receiving modules have got the audio data.
 	 * This is so the first receiver cannot free the audio data before all receivers
 	 * have all gotten the audio data.
 	 */
 	ret = k_mutex_lock(&handle->dest_mutex, LOCK_TIMEOUT_US);
 	if (ret) {
 		LOG_ERR("Failed to take MUTEX lock in time");
-		return ret;
-	}
-
-	/* Here the semaphore is used as a count of the number of audio data items out in the
-	 * connected modules.
-	 */
-	ret = k_sem_init(&handle->sem, handle->dest_count, handle->dest_count);
-	if (ret) {
-		LOG_ERR("Failed to initiate semaphore");
+		data_unref(handle, audio_data->data);
 		return ret;
 	}
 
 	/* Send to all internally connected modules. */
 	SYS_SLIST_FOR_EACH_CONTAINER(&handle->handle_dest_list, handle_to, node) {
-		ret = data_tx(handle, handle_to, audio_data, &audio_data_release_cb);
+		atomic_inc(ref);
+
+		ret = connected_data_tx(handle, handle_to, audio_data);
 		if (ret) {
 			LOG_ERR("Failed to send audio data to module %s from %s, ret %d",
 				handle_to->name, handle->name, ret);
 
-			return ret;
+			atomic_dec(ref);
+			ret_send = ret;
 		}
 	}
 
 	ret = k_mutex_unlock(&handle->dest_mutex);
 	if (ret) {
 		LOG_ERR("Failed to release MUTEX");
-		return ret;
+		ret_send = ret;
 	}
 
 	/* Send to this module's TX FIFO for extraction by an external
 	 * process with audio_module_rx().
 	 */
 	if (handle->use_tx_queue && handle->thread.msg_tx) {
+		atomic_inc(ref);
+
 		ret = tx_fifo_put(handle, audio_data);
 		if (ret) {
 			LOG_ERR("Failed to send audio data on module %s TX message queue",
 				handle->name);
 
-			ret = k_sem_take(&handle->sem, K_NO_WAIT);
-			if (ret) {
-				LOG_ERR("Failed to take semaphore");
-			}
-
-			return ret;
+			atomic_dec(ref);
+			ret_send = ret;
 		}
 	}
 
-	return 0;
+	data_unref(handle, audio_data->data);
+
+	return ret_send;
 }
 
 /**
- * @brief The thread that receives data from outside (e.g. the system and passes it into the audio
- *        system.
+ * @brief Get new audio data from an input module and send it to the connected modules.
  *
- * @note An input module obtains data internally within the module (e.g. I2S in) and hence has no RX
- *       FIFO.
- *
- * @param handle  [in/out]  The handle for this modules instance.
+ * @param handle   [in/out]  The handle for this modules instance.
+ * @param timeout  [in]      Time to wait for a free output buffer.
  *
- * @return 0 if successful, error otherwise.
+ * @return 0 if audio data was sent, -EAGAIN if no output buffer was freed in time, error
+ *         otherwise.
  */
-static void module_thread_input(struct audio_module_handle *handle, void *p2, void *p3)
+static int input_data_process(struct audio_module_handle *handle, k_timeout_t timeout)
 {
 	int ret;
 	struct audio_data audio_data;
-	void *data;
+	void *data = NULL;
 
-	__ASSERT(handle != NULL, "Module task has NULL handle");
-	__ASSERT(handle->description->functions->data_process != NULL,
-		 "Module task has NULL process function pointer");
+	/* Get a new output buffer.
+	 * Since this input module generates data within itself, the module itself
+	 * will control the data flow. Waiting for a buffer to be released paces the
+	 * module to the slowest of the modules it is connected to.
+	 */
+	ret = data_alloc(handle, &data, timeout);
+	if (ret) {
+		__ASSERT(!K_TIMEOUT_EQ(timeout, K_FOREVER), "No free data for module %s, ret %d",
+			 handle->name, ret);
+		return ret;
+	}
 
-	/* Execute thread */
-	while (1) {
-		data = NULL;
+	/* Configure new audio data. */
+	audio_data.data = data;
+	audio_data.data_size = handle->thread.data_size;
 
-		/* Get a new output buffer.
-		 * Since this input module generates data within itself, the module itself
-		 * will control the data flow.
-		 */
-		ret = k_mem_slab_alloc(handle->thread.data_slab, (void **)&data, K_NO_WAIT);
-		__ASSERT(ret, "No free data for module %s, ret %d", handle->name, ret);
+	/* Process the input audio data */
+	ret = handle->description->functions->data_process(
+		(struct audio_module_handle_private *)handle, NULL, &audio_data);
+	if (ret) {
+		data_unref(handle, data);
+
+		LOG_ERR("Data process error in module %s, ret %d", handle->name, ret);
+		return ret;
+	}
+
+	LOG_DBG("Module %s received new audio data ", handle->name);
+
+	/* Send input audio data to next module(s). */
+	send_to_connected_modules(handle, &audio_data);
+
+	return 0;
+}
 
-		/* Configure new audio data. */
+/**
+ * @brief Process an audio data message in an output or in/out module and release its audio data.
+ *
+ * @param handle  [in/out]  The handle for this modules instance.
+ * @param msg     [in]      The message holding the input audio data.
+ */
+static void message_process(struct audio_module_handle *handle,
+			    struct audio_module_message const *const msg)
+{
+	int ret;
+	struct audio_data audio_data;
+	void *data = NULL;
+
+	if (handle->description->type == AUDIO_MODULE_TYPE_OUTPUT) {
+		/* Process the input audio data and output from the audio system. */
+		ret = handle->description->functions->data_process(
+			(struct audio_module_handle_private *)handle, &msg->audio_data, NULL);
+		if (ret) {
+			LOG_ERR("Data process error in module %s, ret %d", handle->name, ret);
+		}
+	} else if (data_alloc(handle, &data, K_NO_WAIT)) {
+		LOG_WRN("No free data buffer for module %s, dropping input", handle->name);
+	} else {
+		/* Configure new audio audio_data. */
 		audio_data.data = data;
 		audio_data.data_size = handle->thread.data_size;
 
-		/* Process the input audio data */
+		/* Process the input audio data into the output audio data. */
 		ret = handle->description->functions->data_process(
-			(struct audio_module_handle_private *)handle, NULL, &audio_data);
+			(struct audio_module_handle_private *)handle, &msg->audio_data,
+			&audio_data);
 		if (ret) {
-			k_mem_slab_free(handle->thread.data_slab, (void **)(&data));
+			data_unref(handle, data);
 
 			LOG_ERR("Data process error in module %s, ret %d", handle->name, ret);
-			continue;
+		} else {
+			/* Send processed audio data to next module(s). */
+			send_to_connected_modules(handle, &audio_data);
 		}
+	}
 
-		LOG_DBG("Module %s received new audio data ", handle->name);
+	if (msg->response_cb != NULL) {
+		msg->response_cb((struct audio_module_handle_private *)msg->tx_handle,
+				 &msg->audio_data);
+	}
+}
 
-		/* Send input audio data to next module(s). */
-		send_to_connected_modules(handle, &audio_data);
+/**
+ * @brief The thread that receives data from outside (e.g. the system and passes it into the audio
+ *        system.
+ *
+ * @note An input module obtains data internally within the module (e.g. I2S in) and hence has no RX
+ *       FIFO.
+ *
+ * @param handle  [in/out]  The handle for this modules instance.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static void module_thread_input(struct audio_module_handle *handle, void *p2, void *p3)
+{
+	__ASSERT(handle != NULL, "Module task has NULL handle");
+	__ASSERT(handle->description->functions->data_process != NULL,
+		 "Module task has NULL process function pointer");
+
+	/* Execute thread */
+	while (1) {
+		input_data_process(handle, K_FOREVER);
 	}
 
 	CODE_UNREACHABLE;
 }
 
 /**
- * @brief The thread that processes inputs and outputs them out of the audio system.
+ * @brief The thread that processes inputs and outputs them out of the audio system, or
+ *        processes inputs and outputs the data from the module.
  *
  * @note An output module takes audio data from an input or in/out module.
  *       It then outputs data internally within the module (e.g. I2S out) and hence has no
- *       TX FIFO.
+ *       TX FIFO. An processing module takes input and outputs from/to another module, thus
+ *       having RX and TX FIFOs.
  *
  * @param handle  [in/out]  The handle for this modules instance.
  *
  * @return 0 if successful, error otherwise.
  */
-static void module_thread_output(struct audio_module_handle *handle, void *p2, void *p3)
+static void module_thread_rx(struct audio_module_handle *handle, void *p2, void *p3)
 {
 	int ret;
-
 	struct audio_module_message *msg_rx;
 	size_t size;
 
@@ -426,28 +618,11 @@ static void module_thread_output(struct audio_module_handle *handle, void *p2, v
 		 */
 		ret = data_fifo_pointer_last_filled_get(handle->thread.msg_rx, (void **)&msg_rx,
 							&size, K_FOREVER);
-		__ASSERT(ret, "Module %s error in getting last filled", handle->name);
+		__ASSERT(ret == 0, "Module %s error in getting last filled", handle->name);
 
 		LOG_DBG("Module %s new audio data received", handle->name);
 
-		/* Process the input audio data and output from the audio system. */
-		ret = handle->description->functions->data_process(
-			(struct audio_module_handle_private *)handle, &msg_rx->audio_data, NULL);
-		if (ret) {
-			if (msg_rx->response_cb != NULL) {
-				msg_rx->response_cb(
-					(struct audio_module_handle_private *)msg_rx->tx_handle,
-					&msg_rx->audio_data);
-			}
-
-			LOG_ERR("Data process error in module %s, ret %d", handle->name, ret);
-			continue;
-		}
-
-		if (msg_rx->response_cb != NULL) {
-			msg_rx->response_cb((struct audio_module_handle_private *)msg_rx->tx_handle,
-					    &msg_rx->audio_data);
-		}
+		message_process(handle, msg_rx);
 
 		data_fifo_block_free(handle->thread.msg_rx, (void **)&msg_rx);
 	}
@@ -455,84 +630,267 @@ static void module_thread_output(struct audio_module_handle *handle, void *p2, v
 	CODE_UNREACHABLE;
 }
 
+#if CONFIG_AUDIO_MODULE_GRAPH
 /**
- * @brief The thread that processes inputs and outputs the data from the module.
+ * @brief Add the processing time of a frame to the statistics.
  *
- * @note An processing module takes input and outputs from/to another
- *       module, thus having RX and TX FIFOs.
+ * @param graph        [in/out]  Pointer to the graph.
+ * @param stats        [in/out]  Pointer to the statistics to update.
+ * @param cycles       [in]      Processing time in cycles.
+ * @param deadline_us  [in]      Processing time budget in microseconds, 0 for none.
+ */
+static void graph_stats_update(struct audio_module_graph *graph,
+			       struct audio_module_graph_stats *stats, uint32_t cycles,
+			       uint32_t deadline_us)
+{
+	uint32_t time_us = k_cyc_to_us_floor32(cycles);
+	k_spinlock_key_t key = k_spin_lock(&graph->lock);
+
+	stats->frame_count++;
+	stats->process_time_last_us = time_us;
+	stats->process_time_max_us = MAX(stats->process_time_max_us, time_us);
+	stats->process_time_total_us += time_us;
+
+	if (deadline_us != 0 && time_us > deadline_us) {
+		stats->deadline_miss_count++;
+	}
+
+	k_spin_unlock(&graph->lock, key);
+}
+
+/**
+ * @brief Run a module in a graph for the current frame.
  *
- * @param handle  [in/out]  The handle for this modules instance.
+ * @param graph  [in/out]  Pointer to the graph.
+ * @param node   [in/out]  Pointer to the module's node.
  *
- * @return 0 if successful, error otherwise.
+ * @return true if the module processed audio data, false otherwise.
  */
-static void module_thread_in_out(struct audio_module_handle *handle, void *p2, void *p3)
+static bool graph_node_run(struct audio_module_graph *graph, struct audio_module_graph_node *node)
 {
 	int ret;
+	struct audio_module_handle *handle = node->handle;
 	struct audio_module_message *msg_rx;
-	struct audio_data audio_data;
-	void *data;
 	size_t size;
+	uint32_t start;
+	bool processed;
 
-	__ASSERT(handle != NULL, "Module task has NULL handle");
-	__ASSERT(handle->description->functions->data_process != NULL,
-		 "Module task has NULL process function pointer");
+	if (handle->description->type == AUDIO_MODULE_TYPE_INPUT) {
+		start = k_cycle_get_32();
 
-	/* Execute thread. */
-	while (1) {
-		data = NULL;
+		/* The output buffers are waited for in steps, so that a stop of the graph is
+		 * noticed while they are all held outside of the graph.
+		 */
+		do {
+			ret = input_data_process(handle, K_MSEC(CONFIG_AUDIO_MODULE_GRAPH_WAIT_MS));
+		} while (ret == -EAGAIN && atomic_get(&graph->running));
+
+		if (ret) {
+			return false;
+		}
+	} else if (node->root) {
+		/* Nothing in the graph sends audio data to the module, so wait for audio data from
+		 * outside the graph. The wait is done in steps, so that a stop of the graph is
+		 * noticed when no audio data comes.
+		 */
+		if (handle->thread.msg_rx == NULL) {
+			return false;
+		}
 
-		LOG_DBG("Module %s is waiting for audio data", handle->name);
+		do {
+			ret = data_fifo_pointer_last_filled_get(
+				handle->thread.msg_rx, (void **)&msg_rx, &size,
+				K_MSEC(CONFIG_AUDIO_MODULE_GRAPH_WAIT_MS));
+		} while (ret == -EAGAIN && atomic_get(&graph->running));
+
+		if (ret == -EAGAIN) {
+			return false;
+		} else if (ret) {
+			LOG_ERR("Module %s error in getting last filled, ret %d", handle->name, ret);
+			return false;
+		}
 
-		/* Get a new input message.
-		 * Since this input message is queued outside the module, this will then control the
-		 * data flow.
+		start = k_cycle_get_32();
+
+		message_process(handle, msg_rx);
+
+		data_fifo_block_free(handle->thread.msg_rx, (void **)&msg_rx);
+	} else {
+		start = k_cycle_get_32();
+
+		for (int i = 0; i < node->pending_count; i++) {
+			message_process(handle, &node->pending[i]);
+		}
+
+		processed = (node->pending_count != 0);
+		node->pending_count = 0;
+
+		/* Audio data can also come from outside the graph, it is processed without waiting
+		 * for it.
 		 */
-		ret = data_fifo_pointer_last_filled_get(handle->thread.msg_rx, (void **)&msg_rx,
-							&size, K_FOREVER);
-		__ASSERT(ret, "Module %s error in getting last filled", handle->name);
+		while (handle->thread.msg_rx != NULL &&
+		       data_fifo_pointer_last_filled_get(handle->thread.msg_rx, (void **)&msg_rx,
+							 &size, K_NO_WAIT) == 0) {
+			message_process(handle, msg_rx);
 
-		LOG_DBG("Module %s new audio data received", handle->name);
+			data_fifo_block_free(handle->thread.msg_rx, (void **)&msg_rx);
 
-		/* Get a new output buffer. */
-		ret = k_mem_slab_alloc(handle->thread.data_slab, (void **)&data, K_NO_WAIT);
-		__ASSERT(ret, "No free data buffer for module %s, dropping input, ret %d",
-			 handle->name, ret);
+			processed = true;
+		}
 
-		/* Configure new audio audio_data. */
-		audio_data.data = data;
-		audio_data.data_size = handle->thread.data_size;
+		if (!processed) {
+			return false;
+		}
+	}
 
-		/* Process the input audio data into the output audio data. */
-		ret = handle->description->functions->data_process(
-			(struct audio_module_handle_private *)handle, &msg_rx->audio_data,
-			&audio_data);
-		if (ret) {
-			if (msg_rx->response_cb != NULL) {
-				msg_rx->response_cb(
-					(struct audio_module_handle_private *)(msg_rx->tx_handle),
-					&msg_rx->audio_data);
+	graph_stats_update(graph, &node->stats, k_cycle_get_32() - start, node->deadline_us);
+
+	return true;
+}
+
+/**
+ * @brief The thread that runs all the modules in a graph, one frame at a time.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ */
+static void graph_thread(struct audio_module_graph *graph, void *p2, void *p3)
+{
+	struct audio_module_graph_node *node;
+	uint32_t frame_start;
+	bool frame_processed;
+
+	while (atomic_get(&graph->running)) {
+		frame_start = 0;
+		frame_processed = false;
+
+		for (int i = 0; i < graph->node_count; i++) {
+			node = &graph->nodes[graph->order[i]];
+
+			if (graph_node_run(graph, node)) {
+				frame_processed = true;
 			}
 
-			data_fifo_block_free(handle->thread.msg_rx, (void **)(&msg_rx));
+			/* The roots are run first, the frame starts once they have their data. */
+			if (node->root) {
+				frame_start = k_cycle_get_32();
+			}
+		}
 
-			k_mem_slab_free(handle->thread.data_slab, (void **)(&data));
+		if (frame_processed) {
+			graph_stats_update(graph, &graph->stats, k_cycle_get_32() - frame_start,
+					   graph->deadline_us);
+		}
+	}
+}
 
-			LOG_ERR("Data process error in module %s, ret %d", handle->name, ret);
+/**
+ * @brief Build the order to run the modules of a graph in, so that a module runs after all the
+ *        modules in the graph sending audio data to it.
+ *
+ * @param graph  [in/out]  Pointer to the graph.
+ *
+ * @return 0 if successful, -EINVAL if the connections form a loop.
+ */
+static int graph_order_build(struct audio_module_graph *graph)
+{
+	uint8_t in_count[CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX] = {0};
+	struct audio_module_handle *handle_to;
+	uint8_t order_count = 0;
+
+	for (int i = 0; i < CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX; i++) {
+		if (graph->nodes[i].handle == NULL) {
 			continue;
 		}
 
-		/* Send processed audio data to next module(s). */
-		send_to_connected_modules(handle, &audio_data);
+		SYS_SLIST_FOR_EACH_CONTAINER(&graph->nodes[i].handle->handle_dest_list, handle_to,
+					     node) {
+			if (handle_to->graph == graph) {
+				in_count[handle_to->graph_node]++;
+			}
+		}
+	}
 
-		if (msg_rx->response_cb != NULL) {
-			msg_rx->response_cb((struct audio_module_handle_private *)msg_rx->tx_handle,
-					    &msg_rx->audio_data);
+	for (int i = 0; i < CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX; i++) {
+		graph->nodes[i].root = (in_count[i] == 0);
+
+		if (graph->nodes[i].handle != NULL && graph->nodes[i].root) {
+			graph->order[order_count++] = i;
 		}
+	}
 
-		data_fifo_block_free(handle->thread.msg_rx, (void **)&msg_rx);
+	/* Append a module once all the modules sending to it are in the order. */
+	for (int i = 0; i < order_count; i++) {
+		struct audio_module_handle *handle = graph->nodes[graph->order[i]].handle;
+
+		SYS_SLIST_FOR_EACH_CONTAINER(&handle->handle_dest_list, handle_to, node) {
+			if (handle_to->graph == graph && --in_count[handle_to->graph_node] == 0) {
+				graph->order[order_count++] = handle_to->graph_node;
+			}
+		}
 	}
 
-	CODE_UNREACHABLE;
+	if (order_count != graph->node_count) {
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/**
+ * @brief Add a module to a graph.
+ *
+ * @param graph        [in/out]  Pointer to the graph.
+ * @param handle       [in/out]  The handle for the module instance.
+ * @param deadline_us  [in]      Processing time budget in microseconds, 0 for none.
+ *
+ * @return 0 if successful, error otherwise.
+ */
+static int graph_node_add(struct audio_module_graph *graph, struct audio_module_handle *handle,
+			  uint32_t deadline_us)
+{
+	if (graph->thread_id != NULL) {
+		LOG_ERR("Module %s cannot be added to a running graph", handle->name);
+		return -EBUSY;
+	}
+
+	for (int i = 0; i < CONFIG_AUDIO_MODULE_GRAPH_MODULES_MAX; i++) {
+		if (graph->nodes[i].handle == NULL) {
+			memset(&graph->nodes[i], 0, sizeof(struct audio_module_graph_node));
+			graph->nodes[i].handle = handle;
+			graph->nodes[i].deadline_us = deadline_us;
+			graph->node_count++;
+
+			handle->graph = graph;
+			handle->graph_node = i;
+
+			return 0;
+		}
+	}
+
+	LOG_ERR("No room for module %s in the graph", handle->name);
+	return -ENOMEM;
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
+/**
+ * @brief Check if a module is in a graph that is running.
+ *
+ * @note The order the modules of a graph run in is built from their connections when the graph
+ *       is started, so the connections cannot change while it runs.
+ *
+ * @param handle  [in]  The handle for the module instance, can be NULL.
+ *
+ * @return true if the module is in a running graph, false otherwise.
+ */
+static bool graph_running(struct audio_module_handle const *const handle)
+{
+#if CONFIG_AUDIO_MODULE_GRAPH
+	return handle != NULL && handle->graph != NULL && handle->graph->thread_id != NULL;
+#else
+	ARG_UNUSED(handle);
+
+	return false;
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
 }
 
 int audio_module_open(struct audio_module_parameters const *const parameters,
@@ -559,6 +917,14 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 		return -ECANCELED;
 	}
 
+	if (parameters->thread.data_slab != NULL &&
+	    parameters->thread.data_slab->info.num_blocks > CONFIG_AUDIO_MODULE_BUFFER_POOL_SIZE) {
+		LOG_ERR("Data slab has %d buffers, more than the maximum of %d",
+			parameters->thread.data_slab->info.num_blocks,
+			CONFIG_AUDIO_MODULE_BUFFER_POOL_SIZE);
+		return -EINVAL;
+	}
+
 	/* Clear handle to known state. */
 	memset(handle, 0, sizeof(struct audio_module_handle));
 
@@ -591,17 +957,32 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 		return ret;
 	}
 
+	sys_slist_init(&handle->handle_dest_list);
+	k_mutex_init(&handle->dest_mutex);
+
+#if CONFIG_AUDIO_MODULE_GRAPH
+	if (parameters->graph != NULL) {
+		ret = graph_node_add(parameters->graph, handle, parameters->deadline_us);
+		if (ret) {
+			return ret;
+		}
+
+		handle->state = AUDIO_MODULE_STATE_CONFIGURED;
+
+		LOG_DBG("Module %s added to graph", handle->name);
+
+		return 0;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 	switch (handle->description->type) {
 	case AUDIO_MODULE_TYPE_INPUT:
 		thread_entry = (k_thread_entry_t)module_thread_input;
 		break;
 
 	case AUDIO_MODULE_TYPE_OUTPUT:
-		thread_entry = (k_thread_entry_t)module_thread_output;
-		break;
-
 	case AUDIO_MODULE_TYPE_IN_OUT:
-		thread_entry = (k_thread_entry_t)module_thread_in_out;
+		thread_entry = (k_thread_entry_t)module_thread_rx;
 		break;
 
 	default:
@@ -610,9 +991,6 @@ int audio_module_open(struct audio_module_parameters const *const parameters,
 		return -EINVAL;
 	}
 
-	sys_slist_init(&handle->handle_dest_list);
-	k_mutex_init(&handle->dest_mutex);
-
 	handle->thread_id = k_thread_create(
 		&handle->thread_data, handle->thread.stack, handle->thread.stack_size, thread_entry,
 		(void *)handle, NULL, NULL, K_PRIO_PREEMPT(handle->thread.priority), 0, K_FOREVER);
@@ -650,6 +1028,11 @@ int audio_module_close(struct audio_module_handle *handle)
 		return -ECANCELED;
 	}
 
+	if (graph_running(handle)) {
+		LOG_ERR("Module %s cannot be closed while its graph is running", handle->name);
+		return -EBUSY;
+	}
+
 	if (handle->description->functions->close != NULL) {
 		ret = handle->description->functions->close(
 			(struct audio_module_handle_private *)handle);
@@ -667,10 +1050,38 @@ int audio_module_close(struct audio_module_handle *handle)
 		data_fifo_empty(handle->thread.msg_tx);
 	}
 
-	/*
-	 * TODO: How to return all the data to the slab items?
-	 *       Test the semaphore and wait for it to be zero.
-	 */
+	if (handle->thread.data_slab != NULL) {
+		for (int i = 0; i < handle->thread.data_slab->info.num_blocks; i++) {
+			if (atomic_get(&handle->data_ref[i]) != 0) {
+				LOG_WRN("Module %s closed with audio data still held by other "
+					"modules",
+					handle->name);
+				break;
+			}
+		}
+	}
+
+#if CONFIG_AUDIO_MODULE_GRAPH
+	if (handle->graph != NULL) {
+		struct audio_module_graph_node *node = &handle->graph->nodes[handle->graph_node];
+
+		/* Release the audio data sent to the module in a frame that was not completed. */
+		for (int i = 0; i < node->pending_count; i++) {
+			node->pending[i].response_cb(
+				(struct audio_module_handle_private *)node->pending[i].tx_handle,
+				&node->pending[i].audio_data);
+		}
+
+		node->pending_count = 0;
+		node->handle = NULL;
+		handle->graph->node_count--;
+		handle->graph = NULL;
+
+		LOG_DBG("Closed module %s", handle->name);
+
+		return 0;
+	}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
 
 	k_thread_abort(handle->thread_id);
 
@@ -769,6 +1180,11 @@ int audio_module_connect(struct audio_module_handle *handle_from,
 		return -ECANCELED;
 	}
 
+	if (graph_running(handle_from) || graph_running(handle_to)) {
+		LOG_WRN("Modules cannot be connected while their graph is running");
+		return -EBUSY;
+	}
+
 	if (connect_external) {
 		if (handle_to != NULL || handle_from->thread.msg_tx == NULL) {
 			LOG_ERR("Module %s has no TX FIFO or module handle to is not NULL",
@@ -858,6 +1274,11 @@ int audio_module_disconnect(struct audio_module_handle *handle,
 		return -ECANCELED;
 	}
 
+	if (graph_running(handle) || graph_running(handle_disconnect)) {
+		LOG_WRN("Modules cannot be disconnected while their graph is running");
+		return -EBUSY;
+	}
+
 	if (disconnect_external) {
 		if (handle_disconnect != NULL) {
 			LOG_ERR("Module disconnect handle is not NULL");
@@ -1072,6 +1493,11 @@ int audio_module_data_rx(struct audio_module_handle *handle, struct audio_data *
 		       msg_tx->audio_data.data_size);
 	}
 
+	if (msg_tx->response_cb != NULL) {
+		msg_tx->response_cb((struct audio_module_handle_private *)msg_tx->tx_handle,
+				    &msg_tx->audio_data);
+	}
+
 	data_fifo_block_free(handle->thread.msg_tx, (void **)&msg_tx);
 
 	return ret;
@@ -1131,7 +1557,7 @@ int audio_module_data_tx_rx(struct audio_module_handle *handle_tx,
 
 	LOG_DBG("Wait for message on module %s TX queue", handle_rx->name);
 
-	ret = data_fifo_pointer_last_filled_get(handle_rx->thread.msg_rx, (void **)&msg_rx,
+	ret = data_fifo_pointer_last_filled_get(handle_rx->thread.msg_tx, (void **)&msg_rx,
 						&msg_rx_size, timeout);
 	if (ret) {
 		LOG_ERR("Failed to retrieve audio data from module %s, ret %d", handle_rx->name,
@@ -1139,7 +1565,8 @@ int audio_module_data_tx_rx(struct audio_module_handle *handle_tx,
 		return ret;
 	}
 
-	if (msg_rx->audio_data.data == NULL || msg_rx->audio_data.data_size == 0) {
+	if (msg_rx->audio_data.data == NULL || msg_rx->audio_data.data_size == 0 ||
+	    msg_rx->audio_data.data_size > audio_data_rx->data_size) {
 		LOG_ERR("Data output buffer too small for received buffer from module %s "
 			"(%d)",
 			handle_rx->name, msg_rx->audio_data.data_size);
@@ -1151,7 +1578,12 @@ int audio_module_data_tx_rx(struct audio_module_handle *handle_tx,
 		       msg_rx->audio_data.data_size);
 	}
 
-	data_fifo_block_free(handle_rx->thread.msg_rx, (void **)&msg_rx);
+	if (msg_rx->response_cb != NULL) {
+		msg_rx->response_cb((struct audio_module_handle_private *)msg_rx->tx_handle,
+				    &msg_rx->audio_data);
+	}
+
+	data_fifo_block_free(handle_rx->thread.msg_tx, (void **)&msg_rx);
 
 	return ret;
 };
@@ -1194,6 +1626,120 @@ int audio_module_state_get(struct audio_module_handle const *const handle,
 	return 0;
 };
 
+#if CONFIG_AUDIO_MODULE_GRAPH
+int audio_module_graph_init(struct audio_module_graph *graph, k_thread_stack_t *stack,
+			    size_t stack_size, int priority, uint32_t deadline_us)
+{
+	if (graph == NULL || stack == NULL || stack_size == 0) {
+		LOG_ERR("Invalid parameters for graph init");
+		return -EINVAL;
+	}
+
+	memset(graph, 0, sizeof(struct audio_module_graph));
+
+	graph->stack = stack;
+	graph->stack_size = stack_size;
+	graph->priority = priority;
+	graph->deadline_us = deadline_us;
+
+	return 0;
+}
+
+int audio_module_graph_start(struct audio_module_graph *graph)
+{
+	int ret;
+
+	if (graph == NULL) {
+		LOG_ERR("Graph is NULL");
+		return -EINVAL;
+	}
+
+	if (graph->thread_id != NULL) {
+		LOG_WRN("Graph already running");
+		return -EALREADY;
+	}
+
+	if (graph->node_count == 0) {
+		LOG_ERR("No modules in the graph");
+		return -ECANCELED;
+	}
+
+	ret = graph_order_build(graph);
+	if (ret) {
+		LOG_ERR("The connections between the modules in the graph form a loop");
+		return ret;
+	}
+
+	atomic_set(&graph->running, 1);
+
+	graph->thread_id = k_thread_create(&graph->thread_data, graph->stack, graph->stack_size,
+					   (k_thread_entry_t)graph_thread, (void *)graph, NULL,
+					   NULL, K_PRIO_PREEMPT(graph->priority), 0, K_NO_WAIT);
+
+	LOG_DBG("Graph started with %d modules", graph->node_count);
+
+	return 0;
+}
+
+int audio_module_graph_stop(struct audio_module_graph *graph, k_timeout_t timeout)
+{
+	int ret;
+
+	if (graph == NULL) {
+		LOG_ERR("Graph is NULL");
+		return -EINVAL;
+	}
+
+	if (graph->thread_id == NULL) {
+		LOG_WRN("Graph is not running");
+		return -EALREADY;
+	}
+
+	atomic_set(&graph->running, 0);
+
+	ret = k_thread_join(&graph->thread_data, timeout);
+	if (ret) {
+		/* The thread stops at the end of the frame, the stop can be retried. */
+		LOG_WRN("Graph frame did not end in time, ret %d", ret);
+		return -EAGAIN;
+	}
+
+	graph->thread_id = NULL;
+
+	return 0;
+}
+
+int audio_module_graph_stats_get(struct audio_module_graph *graph,
+				 struct audio_module_handle const *const handle,
+				 struct audio_module_graph_stats *stats)
+{
+	k_spinlock_key_t key;
+
+	if (graph == NULL || stats == NULL) {
+		LOG_ERR("Input parameter is NULL");
+		return -EINVAL;
+	}
+
+	if (handle != NULL && handle->graph != graph) {
+		LOG_ERR("Module %s is not in the graph", handle->name);
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&graph->lock);
+
+	if (handle == NULL) {
+		memcpy(stats, &graph->stats, sizeof(struct audio_module_graph_stats));
+	} else {
+		memcpy(stats, &graph->nodes[handle->graph_node].stats,
+		       sizeof(struct audio_module_graph_stats));
+	}
+
+	k_spin_unlock(&graph->lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_AUDIO_MODULE_GRAPH */
+
 int audio_module_number_channels_calculate(uint32_t locations, int8_t *number_channels)
 {
 	if (number_channels == NULL) {
@@ -246,25 +246,32 @@ static const STR_CHECK_LIST_ENTRY_TYPE str_check_list[] =
 	CHECK_STR_END();
 
 #if defined(CONFIG_BT_RPC_HOST)
-void bt_rpc_get_check_list(uint8_t *data, size_t size)
+size_t bt_rpc_get_check_list(struct nrf_rpc_buffer_frag frags[BT_RPC_CHECK_LIST_FRAG_CNT],
+			     size_t size)
 {
 	size_t str_copy_bytes = sizeof(str_check_list);
 
-	memset(data, 0, size);
-
 	if (size < sizeof(check_table)) {
-		return;
+		frags[0].data = NULL;
+		frags[0].size = size;
+		return 1;
 	} else if (size < sizeof(check_table) + str_copy_bytes) {
 		str_copy_bytes = size - sizeof(check_table);
 	}
 
-	memcpy(data, check_table, sizeof(check_table));
-	memcpy(&data[sizeof(check_table)], str_check_list, str_copy_bytes);
+	frags[0].data = check_table;
+	frags[0].size = sizeof(check_table);
+	frags[1].data = str_check_list;
+	frags[1].size = str_copy_bytes;
+	frags[2].data = NULL;
+	frags[2].size = size - sizeof(check_table) - str_copy_bytes;
 
 	LOG_DBG("Check table size: %d+%d=%d (copied %d)", sizeof(check_table),
 		sizeof(str_check_list),
 		sizeof(check_table) + sizeof(str_check_list),
 		sizeof(check_table) + str_copy_bytes);
+
+	return BT_RPC_CHECK_LIST_FRAG_CNT;
 }
 
 #else
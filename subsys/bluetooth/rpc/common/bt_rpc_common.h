@@ -20,6 +20,7 @@
 
 #include <nrf_rpc_cbor.h>
 #include <nrf_rpc/nrf_rpc_cbkproxy.h>
+#include <nrf_rpc/nrf_rpc_serialize.h>
 
 #define BT_RPC_SIZE_OF_FIELD(structure, field) (sizeof(((structure *)NULL)->field))
 
@@ -247,12 +248,22 @@ typedef void (*bt_le_ext_adv_cb_scanned)(struct bt_le_ext_adv *adv,
 NRF_RPC_GROUP_DECLARE(bt_rpc_grp);
 
 #if defined(CONFIG_BT_RPC_HOST)
-/** @brief Read configuration "check list" from the host.
+/** @brief Number of fragments of the configuration "check list". */
+#define BT_RPC_CHECK_LIST_FRAG_CNT 3
+
+/** @brief Get the configuration "check list" of the host.
+ *
+ * The "check list" is not copied. It is described by fragments that can be encoded with
+ * @ref nrf_rpc_encode_buffer_frags. The fragments always add up to the requested size:
+ * the "check list" is cut to it, or padded with zeros.
+ *
+ * @param[out] frags Fragments of the configuration "check list".
+ * @param[in]  size  Size of the "check list" requested by the client.
  *
- * @param[out] data Pointer to received configuration "check list".
- * @param[in]  size Size of data buffer.
+ * @retval Number of fragments.
  */
-void bt_rpc_get_check_list(uint8_t *data, size_t size);
+size_t bt_rpc_get_check_list(struct nrf_rpc_buffer_frag frags[BT_RPC_CHECK_LIST_FRAG_CNT],
+			     size_t size);
 #else
 /** @brief Validate configuration "check list".
  *
@@ -25,29 +25,25 @@ static void bt_rpc_get_check_list_rpc_handler(const struct nrf_rpc_group *group,
 					      struct nrf_rpc_cbor_ctx *ctx, void *handler_data)
 {
 	size_t size;
-	uint8_t *data;
-	size_t buffer_size_max = 5;
-	struct nrf_rpc_scratchpad scratchpad;
-
-	NRF_RPC_SCRATCHPAD_DECLARE(&scratchpad, ctx);
+	struct nrf_rpc_buffer_frag frags[BT_RPC_CHECK_LIST_FRAG_CNT];
+	size_t frag_cnt;
 
+	/* The "check list" is not copied, so the scratchpad requested by the client is not used. */
+	nrf_rpc_decode_skip(ctx);
 	size = nrf_rpc_decode_uint(ctx);
-	data = nrf_rpc_scratchpad_add(&scratchpad, sizeof(uint8_t) * size);
 
 	if (!nrf_rpc_decoding_done_and_check(group, ctx)) {
 		goto decoding_error;
 	}
 
-	bt_rpc_get_check_list(data, size);
-
-	buffer_size_max += sizeof(uint8_t) * size;
+	frag_cnt = bt_rpc_get_check_list(frags, size);
 
 	{
 		struct nrf_rpc_cbor_ctx ectx;
 
-		NRF_RPC_CBOR_ALLOC(group, ectx, buffer_size_max);
+		NRF_RPC_CBOR_ALLOC(group, ectx, NRF_RPC_BUFFER_ENCODED_SIZE_MAX(size));
 
-		nrf_rpc_encode_buffer(&ectx, data, sizeof(uint8_t) * size);
+		nrf_rpc_encode_buffer_frags(&ectx, frags, frag_cnt);
 
 		nrf_rpc_cbor_rsp_no_err(group, &ectx);
 	}
@@ -17,6 +17,7 @@
 #include "bt_rpc_common.h"
 #include <nrf_rpc/nrf_rpc_serialize.h>
 #include <nrf_rpc/nrf_rpc_cbkproxy.h>
+#include <nrf_rpc/nrf_rpc_ipc.h>
 
 #include <zephyr/logging/log.h>
 
@@ -769,15 +770,52 @@ static inline void bt_gatt_complete_func_t_callback(struct bt_conn *conn, void *
 NRF_RPC_CBKPROXY_HANDLER(bt_gatt_complete_func_t_encoder, bt_gatt_complete_func_t_callback,
 			 (struct bt_conn *conn, void *user_data), (conn, user_data));
 
+/* Decode a buffer without copying it if the receive buffer can be held. Otherwise, copy the buffer
+ * into the scratchpad. The held pointer must be released with rx_buffer_release().
+ */
+static const void *decode_buffer_held(struct nrf_rpc_scratchpad *scratchpad, const void **held)
+{
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD)
+	size_t size = 0;
+	const void *data = nrf_rpc_decode_buffer_ptr_and_size(scratchpad->ctx, &size);
+	void *copy;
+
+	if (!data || (size == 0)) {
+		return data;
+	}
+
+	if (nrf_rpc_ipc_rx_hold(data) == 0) {
+		*held = data;
+		return data;
+	}
+
+	copy = nrf_rpc_scratchpad_add(scratchpad, size);
+	memcpy(copy, data, size);
+
+	return copy;
+#else
+	return nrf_rpc_decode_buffer_into_scratchpad(scratchpad, NULL);
+#endif
+}
+
+static void rx_buffer_release(const void *held)
+{
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD)
+	if (held) {
+		(void)nrf_rpc_ipc_rx_release(held);
+	}
+#endif
+}
+
 static void bt_gatt_notify_params_dec(struct nrf_rpc_scratchpad *scratchpad,
-				      struct bt_gatt_notify_params *data)
+				      struct bt_gatt_notify_params *data, const void **held)
 {
 
 	struct nrf_rpc_cbor_ctx *ctx = scratchpad->ctx;
 
 	data->attr = bt_rpc_decode_gatt_attr(ctx);
 	data->len = nrf_rpc_decode_uint(ctx);
-	data->data = nrf_rpc_decode_buffer_into_scratchpad(scratchpad, NULL);
+	data->data = decode_buffer_held(scratchpad, held);
 	data->func = (bt_gatt_complete_func_t)nrf_rpc_decode_callbackd(
 		ctx, bt_gatt_complete_func_t_encoder);
 	data->user_data = (void *)(uintptr_t)nrf_rpc_decode_uint(ctx);
@@ -793,22 +831,26 @@ static void bt_gatt_notify_cb_rpc_handler(const struct nrf_rpc_group *group,
 	struct bt_gatt_notify_params params;
 	int result;
 	struct nrf_rpc_scratchpad scratchpad;
+	const void *rx_held = NULL;
 
 	NRF_RPC_SCRATCHPAD_DECLARE(&scratchpad, ctx);
 
 	conn = bt_rpc_decode_bt_conn(ctx);
-	bt_gatt_notify_params_dec(&scratchpad, &params);
+	bt_gatt_notify_params_dec(&scratchpad, &params, &rx_held);
 
 	if (!nrf_rpc_decoding_done_and_check(group, ctx)) {
 		goto decoding_error;
 	}
 
+	/* Notification data is copied by the Bluetooth host, so the buffer can be released. */
 	result = bt_gatt_notify_cb(conn, &params);
+	rx_buffer_release(rx_held);
 
 	nrf_rpc_rsp_send_int(group, result);
 
 	return;
 decoding_error:
+	rx_buffer_release(rx_held);
 	report_decoding_error(BT_GATT_NOTIFY_CB_RPC_CMD, handler_data);
 }
 
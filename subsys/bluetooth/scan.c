@@ -9,6 +9,9 @@
 #include <string.h>
 #include <bluetooth/scan.h>
 
+#include "scan_addr_set.h"
+#include "scan_prefix_trie.h"
+
 #include <zephyr/logging/log.h>
 LOG_MODULE_REGISTER(nrf_bt_scan, CONFIG_BT_SCAN_LOG_LEVEL);
 
@@ -21,6 +24,66 @@ LOG_MODULE_REGISTER(nrf_bt_scan, CONFIG_BT_SCAN_LOG_LEVEL);
 /* Scan filter mutex. */
 K_MUTEX_DEFINE(scan_mutex);
 
+#if CONFIG_BT_SCAN_REPORT_CACHE
+/* Advertising report cache entry of a device. The devices are kept in the
+ * report_cache_set, at the same index as their entry.
+ */
+struct report_cache_entry {
+	/* Node in the list of the entries, from the most recently used. */
+	sys_dnode_t node;
+
+	/* Hash of the last advertising report of the device. */
+	uint32_t report_hash;
+
+	/* Filter generation the last report was checked with. */
+	atomic_val_t filter_gen;
+
+	/* Uptime of the last filter callback for the device, in
+	 * milliseconds.
+	 */
+	uint32_t notify_time;
+
+	/* Set to true if the last report matched none of the filters. */
+	bool no_match;
+
+	/* Set to true if a filter callback was made for the device. */
+	bool notified;
+};
+
+struct report_cache {
+	/* Cache entries. */
+	struct report_cache_entry entry[CONFIG_BT_SCAN_REPORT_CACHE_SIZE];
+
+	/* Entries in use, from the most recently used. */
+	sys_dlist_t lru;
+
+	/* Filter generation, changed with the filters. */
+	atomic_t filter_gen;
+
+	/* Lock serializing the updates of the entry list and of the
+	 * statistics.
+	 */
+	struct k_spinlock lock;
+
+	/* Cache statistics. */
+	struct bt_scan_report_cache_stats stats;
+};
+
+SCAN_ADDR_SET_DEFINE(report_cache_set, CONFIG_BT_SCAN_REPORT_CACHE_SIZE);
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
+
+/* Result of checking an advertising report against the filters. */
+enum scan_filter_result {
+	/* The device is on the blocklist or out of connection attempts. */
+	SCAN_FILTER_DROPPED,
+
+	/* The report matched none of the filters. */
+	SCAN_FILTER_NO_MATCH,
+
+	/* The report matched the filters. */
+	SCAN_FILTER_MATCH,
+};
+
 /* Scanning control structure used to
  * compare matching filters, their mode and event generation.
  */
@@ -45,6 +108,11 @@ struct bt_scan_control {
 
 	/* Scan filter status. */
 	struct bt_scan_filter_match filter_status;
+
+#if CONFIG_BT_SCAN_REPORT_CACHE
+	/* Advertising report cache entry of the device. */
+	struct report_cache_entry *cache_entry;
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
 };
 
 /* Name filter structure.
@@ -55,8 +123,11 @@ struct bt_scan_name_filter {
 	 */
 	char target_name[CONFIG_BT_SCAN_NAME_CNT][CONFIG_BT_SCAN_NAME_MAX_LEN];
 
+	/* Number of matches of each name. */
+	uint32_t hits[CONFIG_BT_SCAN_NAME_CNT];
+
 	/* Name filter counter. */
-	uint8_t cnt;
+	uint16_t cnt;
 
 	/* Flag to inform about enabling or disabling this filter.
 	 */
@@ -76,26 +147,29 @@ struct bt_scan_short_name_filter {
 		uint8_t min_len;
 	} name[CONFIG_BT_SCAN_SHORT_NAME_CNT];
 
+	/* Number of matches of each short name. */
+	uint32_t hits[CONFIG_BT_SCAN_SHORT_NAME_CNT];
+
 	/* Short name filter counter. */
-	uint8_t cnt;
+	uint16_t cnt;
 
 	/* Flag to inform about enabling or disabling this filter. */
 	bool enabled;
 };
 
-/* BLE Addresses filter structure.
+/* BLE Addresses filter structure. The addresses advertised by the
+ * peripherals are kept in the addr_filter_set.
  */
 struct bt_scan_addr_filter {
-	/* Addresses advertised by the peripherals. */
-	bt_addr_le_t target_addr[CONFIG_BT_SCAN_ADDRESS_CNT];
-
-	/* Address filter counter. */
-	uint8_t cnt;
+	/* Number of matches of each address, at the index of the address. */
+	uint32_t hits[CONFIG_BT_SCAN_ADDRESS_CNT];
 
 	/* Flag to inform about enabling or disabling this filter. */
 	bool enabled;
 };
 
+SCAN_ADDR_SET_DEFINE(addr_filter_set, CONFIG_BT_SCAN_ADDRESS_CNT);
+
 /* Structure for storing different types of UUIDs */
 struct bt_scan_uuid {
 	/* Pointer to the appropriate type of UUID. **/
@@ -110,6 +184,9 @@ struct bt_scan_uuid {
 		/* 128-bit UUID. */
 		struct bt_uuid_128 uuid_128;
 	} uuid_data;
+
+	/* UUID expanded to 128 bits, in little-endian order. */
+	uint8_t key[BT_SCAN_UUID_128_SIZE];
 };
 
 /* UUIDs filter structure.
@@ -120,8 +197,14 @@ struct bt_scan_uuid_filter {
 	 */
 	struct bt_scan_uuid uuid[CONFIG_BT_SCAN_UUID_CNT];
 
+	/* Indexes of the UUIDs sorted by their 128-bit key. */
+	uint16_t index[CONFIG_BT_SCAN_UUID_CNT];
+
+	/* Number of matches of each UUID. */
+	uint32_t hits[CONFIG_BT_SCAN_UUID_CNT];
+
 	/* UUID filter counter. */
-	uint8_t cnt;
+	uint16_t cnt;
 
 	/* Flag to inform about enabling or disabling this filter. */
 	bool enabled;
@@ -133,8 +216,14 @@ struct bt_scan_appearance_filter {
 	 */
 	uint16_t appearance[CONFIG_BT_SCAN_APPEARANCE_CNT];
 
+	/* Indexes of the appearances sorted by their value. */
+	uint16_t index[CONFIG_BT_SCAN_APPEARANCE_CNT];
+
+	/* Number of matches of each appearance. */
+	uint32_t hits[CONFIG_BT_SCAN_APPEARANCE_CNT];
+
 	/* Appearance filter counter. */
-	uint8_t cnt;
+	uint16_t cnt;
 
 	/* Flag to inform about enabling or disabling this filter. */
 	bool enabled;
@@ -155,8 +244,11 @@ struct bt_scan_manufacturer_data_filter {
 		uint8_t data_len;
 	} manufacturer_data[CONFIG_BT_SCAN_MANUFACTURER_DATA_CNT];
 
-	/* Name filter counter. */
-	uint8_t cnt;
+	/* Number of matches of each manufacturer data. */
+	uint32_t hits[CONFIG_BT_SCAN_MANUFACTURER_DATA_CNT];
+
+	/* Manufacturer data filter counter. */
+	uint16_t cnt;
 
 	/* Flag to inform about enabling or disabling this filter. */
 	bool enabled;
@@ -197,37 +289,23 @@ struct bt_scan_filters {
 };
 
 #if CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER
-/* Connection attempts filter device */
-struct conn_attempts_device {
-	/* Filtered device address. */
-	bt_addr_le_t addr;
-
-	/* Number of the connection attempts. */
-	size_t attempts;
-};
-
-/* Connection attempts filter. */
+/* Connection attempts filter. The filtered device addresses are kept in the
+ * attempts_filter_set, at the same index as their attempts count.
+ */
 struct conn_attempts_filter {
-	/* Array of the filtered devices. */
-	struct conn_attempts_device device[CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN];
+	/* Number of the connection attempts of the filtered devices. */
+	size_t attempts[CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN];
 
 	/* The oldest device index. */
 	uint32_t oldest_idx;
-
-	/* Count of the filtered devices. */
-	size_t count;
 };
+
+SCAN_ADDR_SET_DEFINE(attempts_filter_set, CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER_LEN);
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
 #if CONFIG_BT_SCAN_BLOCKLIST
 /* Connection blocklist */
-struct conn_blocklist {
-	/* Array of the blocklist devices. */
-	bt_addr_le_t addr[CONFIG_BT_SCAN_BLOCKLIST_LEN];
-
-	/* Blocklist device count. */
-	uint32_t count;
-};
+SCAN_ADDR_SET_DEFINE(blocklist_set, CONFIG_BT_SCAN_BLOCKLIST_LEN);
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
 /* Scanning module instance. Options for the different scanning modes.
@@ -261,10 +339,10 @@ static struct bt_scan {
 	struct conn_attempts_filter attempts_filter;
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
-#if CONFIG_BT_SCAN_BLOCKLIST
-	/* Scan device blocklist. */
-	struct conn_blocklist blocklist;
-#endif /* CONFIG_BT_SCAN_BLOCKLIST */
+#if CONFIG_BT_SCAN_REPORT_CACHE
+	/* Advertising report cache. */
+	struct report_cache report_cache;
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
 
 } bt_scan;
 
@@ -333,21 +411,7 @@ static void notify_connecting_error(struct bt_scan_device_info *device_info)
 #if CONFIG_BT_SCAN_BLOCKLIST
 static bool blocklist_device_check(const bt_addr_le_t *addr)
 {
-	bool blocklist_device = false;
-
-	k_mutex_lock(&scan_mutex, K_FOREVER);
-
-	for (size_t i = 0; i < bt_scan.blocklist.count; i++) {
-		if (bt_addr_le_cmp(&bt_scan.blocklist.addr[i], addr) == 0) {
-			blocklist_device = true;
-
-			break;
-		}
-	}
-
-	k_mutex_unlock(&scan_mutex);
-
-	return blocklist_device;
+	return scan_addr_set_find(&blocklist_set, addr) >= 0;
 }
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
 
@@ -356,10 +420,10 @@ static void attempts_filter_force_add(struct conn_attempts_filter *filter,
 				      const bt_addr_le_t *addr)
 {
 	/* Overwrite the oldest device */
-	filter->device[filter->oldest_idx].attempts = 0;
-	bt_addr_le_copy(&filter->device[filter->oldest_idx].addr, addr);
+	filter->attempts[filter->oldest_idx] = 0;
+	scan_addr_set_replace(&attempts_filter_set, filter->oldest_idx, addr);
 
-	if (filter->oldest_idx == (ARRAY_SIZE(filter->device) - 1)) {
+	if (filter->oldest_idx == (ARRAY_SIZE(filter->attempts) - 1)) {
 		filter->oldest_idx = 0;
 
 		return;
@@ -372,31 +436,23 @@ static void scan_attempts_filter_device_add(const bt_addr_le_t *addr)
 {
 	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
 	char addr_str[BT_ADDR_LE_STR_LEN];
+	int idx;
 
 	bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
 
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
-	/* Check if device is already in the filter array. */
-	for (size_t i = 0; i < filter->count; i++) {
-		struct conn_attempts_device *device = &filter->device[i];
-
-		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
-			LOG_DBG("Device %s is already in the filter array",
-				addr_str);
-			goto out;
-		}
-	}
-
-	if (filter->count >= ARRAY_SIZE(filter->device)) {
+	idx = scan_addr_set_add(&attempts_filter_set, addr);
+	if (idx == -EALREADY) {
+		LOG_DBG("Device %s is already in the filter array",
+			addr_str);
+	} else if (idx == -ENOMEM) {
 		LOG_DBG("Force adding %s device filter", addr_str);
 		attempts_filter_force_add(filter, addr);
 	} else {
-		bt_addr_le_copy(&filter->device[filter->count].addr, addr);
-		filter->count++;
+		filter->attempts[idx] = 0;
 	}
 
-out:
 	k_mutex_unlock(&scan_mutex);
 }
 
@@ -404,55 +460,212 @@ static void device_conn_attempts_count(struct bt_conn *conn)
 {
 	const bt_addr_le_t *addr = bt_conn_get_dst(conn);
 	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
+	int idx;
 
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
-	for (size_t i = 0; i < filter->count; i++) {
-		struct conn_attempts_device *device = &filter->device[i];
-
-		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
-			if (device->attempts < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT) {
-				device->attempts++;
-			}
-
-			break;
-		}
+	idx = scan_addr_set_find(&attempts_filter_set, addr);
+	if ((idx >= 0) &&
+	    (filter->attempts[idx] < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT)) {
+		filter->attempts[idx]++;
 	}
 
 	k_mutex_unlock(&scan_mutex);
 }
 
+/* Called for every advertising report, so it neither takes the scan mutex nor
+ * formats the address unless it is logged.
+ */
 static bool conn_attempts_exceeded(const bt_addr_le_t *addr)
 {
 	struct conn_attempts_filter *filter = &bt_scan.attempts_filter;
-	char addr_str[BT_ADDR_LE_STR_LEN];
-	bool attempts_exceeded = false;
+	int idx;
 
-	bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
+	idx = scan_addr_set_find(&attempts_filter_set, addr);
+	if ((idx < 0) ||
+	    (filter->attempts[idx] < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT)) {
+		return false;
+	}
 
-	k_mutex_lock(&scan_mutex, K_FOREVER);
+	if (IS_ENABLED(CONFIG_BT_SCAN_LOG_LEVEL_DBG)) {
+		char addr_str[BT_ADDR_LE_STR_LEN];
+
+		bt_addr_le_to_str(addr, addr_str, sizeof(addr_str));
+		LOG_DBG("Connection attempts count for %s exceeded", addr_str);
+	}
 
-	/* Check if the device is in the filter array. */
-	for (size_t i = 0; i < filter->count; i++) {
-		struct conn_attempts_device *device = &filter->device[i];
+	return true;
+}
+
+#endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
-		if (bt_addr_le_cmp(addr, &device->addr) == 0) {
-			if (device->attempts >= CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT) {
-				LOG_DBG("Connection attempts count for %s exceeded",
-					addr_str);
-				attempts_exceeded = true;
-			}
+#if CONFIG_BT_SCAN_REPORT_CACHE
+#define REPORT_HASH_OFFSET_BASIS 2166136261U
+#define REPORT_HASH_PRIME        16777619U
 
-			break;
+static uint32_t report_hash_update(uint32_t hash, const uint8_t *data,
+				   size_t len)
+{
+	for (size_t i = 0; i < len; i++) {
+		hash = (hash ^ data[i]) * REPORT_HASH_PRIME;
+	}
+
+	return hash;
+}
+
+/* FNV-1a hash of the advertising report fields the filters and
+ * the filter no match callback depend on.
+ */
+static uint32_t report_hash(const struct bt_le_scan_recv_info *info,
+			    const struct net_buf_simple *ad)
+{
+	uint32_t hash = REPORT_HASH_OFFSET_BASIS;
+	uint8_t header[] = {
+		info->adv_type,
+		info->adv_props & 0xFF,
+		info->adv_props >> 8,
+		ad->len & 0xFF,
+		ad->len >> 8,
+	};
+
+	hash = report_hash_update(hash, header, sizeof(header));
+
+	return report_hash_update(hash, ad->data, ad->len);
+}
+
+/* Get the cache entry of a device, replacing the entry of the device seen
+ * least recently if the device is not in the cache. Returns true in hit if
+ * the report is an unchanged report of a device that matched none of the
+ * filters, otherwise the entry is updated with the report.
+ */
+static struct report_cache_entry *report_cache_entry_get(const bt_addr_le_t *addr,
+							 uint32_t hash,
+							 atomic_val_t filter_gen,
+							 bool *hit)
+{
+	struct report_cache *cache = &bt_scan.report_cache;
+	struct report_cache_entry *entry;
+	k_spinlock_key_t key;
+	bool found;
+	int idx;
+
+	key = k_spin_lock(&cache->lock);
+
+	idx = scan_addr_set_find(&report_cache_set, addr);
+	found = (idx >= 0);
+
+	if (found) {
+		entry = &cache->entry[idx];
+		sys_dlist_remove(&entry->node);
+	} else {
+		idx = scan_addr_set_add(&report_cache_set, addr);
+		if (idx == -ENOMEM) {
+			entry = CONTAINER_OF(sys_dlist_peek_tail(&cache->lru),
+					     struct report_cache_entry, node);
+			idx = ARRAY_INDEX(cache->entry, entry);
+
+			sys_dlist_remove(&entry->node);
+			scan_addr_set_replace(&report_cache_set, idx, addr);
+			cache->stats.evictions++;
+		} else {
+			entry = &cache->entry[idx];
 		}
+
+		entry->no_match = false;
+		entry->notified = false;
 	}
 
-	k_mutex_unlock(&scan_mutex);
+	sys_dlist_prepend(&cache->lru, &entry->node);
+
+	*hit = found && entry->no_match && (entry->report_hash == hash) &&
+	       (entry->filter_gen == filter_gen);
+
+	if (*hit) {
+		cache->stats.hits++;
+	} else {
+		/* The filter generation is taken before the filters are
+		 * checked, so a result racing with a filter change is not
+		 * used again.
+		 */
+		entry->report_hash = hash;
+		entry->filter_gen = filter_gen;
+		entry->no_match = false;
+		cache->stats.misses++;
+	}
 
-	return attempts_exceeded;
+	k_spin_unlock(&cache->lock, key);
+
+	return entry;
 }
 
-#endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
+/* Look up the advertising report in the cache. Returns true if it is an
+ * unchanged report of a device that matched none of the filters.
+ */
+static bool report_cache_check(struct bt_scan_control *control,
+			       const struct bt_le_scan_recv_info *info,
+			       const struct net_buf_simple *ad)
+{
+	atomic_val_t filter_gen = atomic_get(&bt_scan.report_cache.filter_gen);
+	bool hit;
+
+	control->cache_entry = report_cache_entry_get(info->addr,
+						      report_hash(info, ad),
+						      filter_gen, &hit);
+
+	return hit;
+}
+
+static void report_cache_store(struct bt_scan_control *control,
+			       enum scan_filter_result result)
+{
+	control->cache_entry->no_match = (result == SCAN_FILTER_NO_MATCH);
+}
+
+static bool report_rate_limit_check(struct bt_scan_control *control)
+{
+	struct report_cache_entry *entry = control->cache_entry;
+	uint32_t now;
+
+	if (CONFIG_BT_SCAN_REPORT_RATE_LIMIT_MS == 0) {
+		return true;
+	}
+
+	now = k_uptime_get_32();
+
+	if (entry->notified &&
+	    ((now - entry->notify_time) < CONFIG_BT_SCAN_REPORT_RATE_LIMIT_MS)) {
+		struct report_cache *cache = &bt_scan.report_cache;
+		k_spinlock_key_t key = k_spin_lock(&cache->lock);
+
+		cache->stats.rate_limited++;
+		k_spin_unlock(&cache->lock, key);
+
+		return false;
+	}
+
+	entry->notified = true;
+	entry->notify_time = now;
+
+	return true;
+}
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
+
+static void report_cache_invalidate(void)
+{
+#if CONFIG_BT_SCAN_REPORT_CACHE
+	atomic_inc(&bt_scan.report_cache.filter_gen);
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
+}
+
+/* Check whether the filter callbacks can be made for the device. */
+static bool notify_allowed(struct bt_scan_control *control)
+{
+#if CONFIG_BT_SCAN_REPORT_CACHE
+	return report_rate_limit_check(control);
+#else
+	return true;
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
+}
 
 static bool scan_device_filter_check(const bt_addr_le_t *addr)
 {
@@ -509,19 +722,16 @@ static void scan_connect_with_target(struct bt_scan_control *control,
 static bool adv_addr_compare(const bt_addr_le_t *target_addr,
 			     struct bt_scan_control *control)
 {
-	const bt_addr_le_t *addr =
-			bt_scan.scan_filters.addr.target_addr;
-	uint8_t counter = bt_scan.scan_filters.addr.cnt;
+	int idx = scan_addr_set_find(&addr_filter_set, target_addr);
 
-	for (size_t i = 0; i < counter; i++) {
-		if (bt_addr_le_cmp(target_addr, &addr[i]) == 0) {
-			control->filter_status.addr.addr = &addr[i];
-
-			return true;
-		}
+	if (idx < 0) {
+		return false;
 	}
 
-	return false;
+	bt_scan.scan_filters.addr.hits[idx]++;
+	control->filter_status.addr.addr = &addr_filter_set.addr[idx];
+
+	return true;
 }
 
 static bool is_addr_filter_enabled(void)
@@ -546,68 +756,164 @@ static void check_addr(struct bt_scan_control *control,
 static int scan_addr_filter_add(const bt_addr_le_t *target_addr)
 {
 	char addr[BT_ADDR_LE_STR_LEN];
-	bt_addr_le_t *addr_filter =
-			bt_scan.scan_filters.addr.target_addr;
-	uint8_t counter = bt_scan.scan_filters.addr.cnt;
+	int idx;
 
-	/* If no memory for filter. */
-	if (counter >= CONFIG_BT_SCAN_ADDRESS_CNT) {
-		return -ENOMEM;
+	/* Add target address to filter. */
+	idx = scan_addr_set_add(&addr_filter_set, target_addr);
+
+	/* Duplicated filter. */
+	if (idx == -EALREADY) {
+		return 0;
 	}
 
-	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (bt_addr_le_cmp(target_addr, &addr_filter[i]) == 0) {
-			return 0;
-		}
+	/* If no memory for filter. */
+	if (idx < 0) {
+		return idx;
 	}
 
-	/* Add target address to filter. */
-	bt_addr_le_copy(&addr_filter[counter], target_addr);
+	bt_scan.scan_filters.addr.hits[idx] = 0;
 
-	LOG_DBG("Filter set on address type %i",
-		addr_filter[counter].type);
+	LOG_DBG("Filter set on address type %i", target_addr->type);
 
 	bt_addr_le_to_str(target_addr, addr, sizeof(addr));
 
 	LOG_DBG("Address: %s", addr);
 
-	/* Increase the address filter counter. */
-	bt_scan.scan_filters.addr.cnt++;
-
 	return 0;
 }
 
-static bool adv_name_cmp(const uint8_t *data,
-			 uint8_t data_len,
-			 const char *target_name)
+/* The key accessors of the tries. They check the key index against the
+ * filter array size, as the arrays are empty if a filter type is disabled.
+ */
+static const uint8_t *name_key_get(uint16_t key_idx, uint8_t *len)
+{
+	const char *name;
+
+	if (key_idx >= CONFIG_BT_SCAN_NAME_CNT) {
+		*len = 0;
+		return NULL;
+	}
+
+	name = bt_scan.scan_filters.name.target_name[key_idx];
+	*len = strnlen(name, CONFIG_BT_SCAN_NAME_MAX_LEN);
+
+	return (const uint8_t *)name;
+}
+
+static const uint8_t *short_name_key_get(uint16_t key_idx, uint8_t *len)
+{
+	const char *name;
+
+	if (key_idx >= CONFIG_BT_SCAN_SHORT_NAME_CNT) {
+		*len = 0;
+		return NULL;
+	}
+
+	name = bt_scan.scan_filters.short_name.name[key_idx].target_name;
+	*len = strnlen(name, CONFIG_BT_SCAN_SHORT_NAME_MAX_LEN);
+
+	return (const uint8_t *)name;
+}
+
+static bool short_name_key_accept(uint16_t key_idx, uint8_t len)
 {
-	return strncmp(target_name, data, data_len) == 0;
+	return len >= bt_scan.scan_filters.short_name.name[key_idx].min_len;
+}
+
+static const uint8_t *manufacturer_data_key_get(uint16_t key_idx, uint8_t *len)
+{
+	const struct bt_scan_manufacturer_data_filter *md_filter =
+		&bt_scan.scan_filters.manufacturer_data;
+
+	if (key_idx >= CONFIG_BT_SCAN_MANUFACTURER_DATA_CNT) {
+		*len = 0;
+		return NULL;
+	}
+
+	*len = md_filter->manufacturer_data[key_idx].data_len;
+
+	return md_filter->manufacturer_data[key_idx].data;
+}
+
+/* The name and manufacturer data filters are looked up through tries,
+ * so an advertising data structure is compared to all of them at once.
+ */
+SCAN_PREFIX_TRIE_DEFINE(name_trie, CONFIG_BT_SCAN_NAME_CNT, name_key_get);
+SCAN_PREFIX_TRIE_DEFINE(short_name_trie, CONFIG_BT_SCAN_SHORT_NAME_CNT,
+			short_name_key_get);
+SCAN_PREFIX_TRIE_DEFINE(manufacturer_data_trie,
+			CONFIG_BT_SCAN_MANUFACTURER_DATA_CNT,
+			manufacturer_data_key_get);
+
+/* The UUID and appearance filters are looked up through indexes of the
+ * filters sorted by their value.
+ */
+typedef int (*filter_key_cmp_t)(const void *key, uint16_t filter_idx);
+
+static uint16_t filter_index_search(const uint16_t *index, uint16_t cnt,
+				    const void *key, filter_key_cmp_t cmp,
+				    bool *found)
+{
+	uint16_t low = 0;
+	uint16_t high = cnt;
+
+	*found = false;
+
+	while (low < high) {
+		uint16_t mid = low + (high - low) / 2;
+		int res = cmp(key, index[mid]);
+
+		if (res == 0) {
+			*found = true;
+
+			return mid;
+		}
+
+		if (res < 0) {
+			high = mid;
+		} else {
+			low = mid + 1;
+		}
+	}
+
+	return low;
+}
+
+static void filter_index_insert(uint16_t *index, uint16_t cnt, uint16_t pos,
+				uint16_t filter_idx)
+{
+	memmove(&index[pos + 1], &index[pos], (cnt - pos) * sizeof(index[0]));
+	index[pos] = filter_idx;
+}
+
+static void filters_index_clear(void)
+{
+	scan_prefix_trie_clear(&name_trie);
+	scan_prefix_trie_clear(&short_name_trie);
+	scan_prefix_trie_clear(&manufacturer_data_trie);
 }
 
 static bool adv_name_compare(const struct bt_data *data,
 			     struct bt_scan_control *control)
 {
-	struct bt_scan_name_filter const *name_filter =
+	struct bt_scan_name_filter *name_filter =
 			&bt_scan.scan_filters.name;
-	uint8_t counter = bt_scan.scan_filters.name.cnt;
 	uint8_t data_len = data->data_len;
+	int idx;
 
-	/* Compare the name found with the name filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (adv_name_cmp(data->data,
-				 data_len,
-				 name_filter->target_name[i])) {
+	/* Find the first name filter starting with the name found. */
+	idx = scan_prefix_trie_extension_find(&name_trie, data->data, data_len,
+					      NULL);
+	if (idx < 0) {
+		return false;
+	}
 
-			control->filter_status.name.name =
-				name_filter->target_name[i];
-			control->filter_status.name.len = data_len;
+	name_filter->hits[idx]++;
 
-			return true;
-		}
-	}
+	control->filter_status.name.name = name_filter->target_name[idx];
+	control->filter_status.name.len = data_len;
 
-	return false;
+	return true;
 }
 
 static inline bool is_name_filter_enabled(void)
@@ -631,7 +937,8 @@ static void name_check(struct bt_scan_control *control,
 
 static int scan_name_filter_add(const char *name)
 {
-	uint8_t counter = bt_scan.scan_filters.name.cnt;
+	uint16_t counter = bt_scan.scan_filters.name.cnt;
+	char *target_name = bt_scan.scan_filters.name.target_name[counter];
 	size_t name_len;
 
 	/* If no memory for filter. */
@@ -646,17 +953,16 @@ static int scan_name_filter_add(const char *name)
 		return -EINVAL;
 	}
 
+	/* Add name to filter. */
+	memset(target_name, 0, CONFIG_BT_SCAN_NAME_MAX_LEN);
+	memcpy(target_name, name, name_len);
+
 	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (!strcmp(bt_scan.scan_filters.name.target_name[i], name)) {
-			return 0;
-		}
+	if (scan_prefix_trie_insert(&name_trie, counter) == -EALREADY) {
+		return 0;
 	}
 
-	/* Add name to filter. */
-	memcpy(bt_scan.scan_filters.name.target_name[counter],
-	       name, name_len);
-
+	bt_scan.scan_filters.name.hits[counter] = 0;
 	bt_scan.scan_filters.name.cnt++;
 
 	LOG_DBG("Adding filter on %s name", name);
@@ -664,43 +970,30 @@ static int scan_name_filter_add(const char *name)
 	return 0;
 }
 
-static bool adv_short_name_cmp(const uint8_t *data,
-			       uint8_t data_len,
-			       const char *target_name,
-			       uint8_t short_name_min_len)
-{
-	if ((data_len >= short_name_min_len) &&
-	    (strncmp(target_name, data, data_len) == 0)) {
-		return true;
-	}
-
-	return false;
-}
-
 static bool adv_short_name_compare(const struct bt_data *data,
 				   struct bt_scan_control *control)
 {
-	const struct bt_scan_short_name_filter *name_filter =
+	struct bt_scan_short_name_filter *name_filter =
 			&bt_scan.scan_filters.short_name;
-	uint8_t counter = bt_scan.scan_filters.short_name.cnt;
 	uint8_t data_len = data->data_len;
+	int idx;
 
-	/* Compare the name found with the name filters. */
-	for (size_t i = 0; i < counter; i++) {
-		if (adv_short_name_cmp(data->data,
-				       data_len,
-				       name_filter->name[i].target_name,
-				       name_filter->name[i].min_len)) {
+	/* Find the first short name filter starting with the name found
+	 * and not longer than the name found allows.
+	 */
+	idx = scan_prefix_trie_extension_find(&short_name_trie, data->data,
+					      data_len, short_name_key_accept);
+	if (idx < 0) {
+		return false;
+	}
 
-			control->filter_status.short_name.name =
-				name_filter->name[i].target_name;
-			control->filter_status.short_name.len = data_len;
+	name_filter->hits[idx]++;
 
-			return true;
-		}
-	}
+	control->filter_status.short_name.name =
+		name_filter->name[idx].target_name;
+	control->filter_status.short_name.len = data_len;
 
-	return false;
+	return true;
 }
 
 static inline bool is_short_name_filter_enabled(void)
@@ -724,7 +1017,7 @@ static void short_name_check(struct bt_scan_control *control,
 
 static int scan_short_name_filter_add(const struct bt_scan_short_name *short_name)
 {
-	uint8_t counter =
+	uint16_t counter =
 		bt_scan.scan_filters.short_name.cnt;
 	struct bt_scan_short_name_filter *short_name_filter =
 		    &bt_scan.scan_filters.short_name;
@@ -743,20 +1036,20 @@ static int scan_short_name_filter_add(const struct bt_scan_short_name *short_nam
 		return -EINVAL;
 	}
 
-	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (!strcmp(short_name_filter->name[i].target_name,
-			    short_name->name)) {
-			return 0;
-		}
-	}
-
 	/* Add name to the filter. */
 	short_name_filter->name[counter].min_len = short_name->min_len;
+	memset(short_name_filter->name[counter].target_name, 0,
+	       CONFIG_BT_SCAN_SHORT_NAME_MAX_LEN);
 	memcpy(short_name_filter->name[counter].target_name,
 	       short_name->name,
 	       name_len);
 
+	/* Check for duplicated filter. */
+	if (scan_prefix_trie_insert(&short_name_trie, counter) == -EALREADY) {
+		return 0;
+	}
+
+	short_name_filter->hits[counter] = 0;
 	bt_scan.scan_filters.short_name.cnt++;
 
 	LOG_DBG("Adding filter on %s name", short_name->name);
@@ -764,83 +1057,114 @@ static int scan_short_name_filter_add(const struct bt_scan_short_name *short_nam
 	return 0;
 }
 
-static bool find_uuid(const uint8_t *data,
-		      uint8_t data_len,
-		      uint8_t uuid_type,
-		      const struct bt_scan_uuid *target_uuid)
+static uint8_t uuid_len_get(uint8_t uuid_type)
 {
-	uint8_t uuid_len;
-
 	switch (uuid_type) {
 	case BT_UUID_TYPE_16:
-		uuid_len = sizeof(uint16_t);
-		break;
+		return sizeof(uint16_t);
 
 	case BT_UUID_TYPE_32:
-		uuid_len = sizeof(uint32_t);
-		break;
+		return sizeof(uint32_t);
 
 	case BT_UUID_TYPE_128:
-		uuid_len = BT_SCAN_UUID_128_SIZE * sizeof(uint8_t);
-		break;
+		return BT_SCAN_UUID_128_SIZE;
 
 	default:
-		return false;
+		return 0;
 	}
+}
 
-	for (size_t i = 0; i < data_len; i += uuid_len) {
-		struct bt_uuid_128 uuid;
+/* Expand an encoded UUID to 128 bits, so that UUIDs of any size can be
+ * compared as bt_uuid_cmp() does.
+ */
+static void uuid_key_get(const uint8_t *data, uint8_t uuid_len, uint8_t *key)
+{
+	static const uint8_t uuid_base[BT_SCAN_UUID_128_SIZE] = {
+		BT_UUID_128_ENCODE(0x00000000, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB)
+	};
 
-		if (!bt_uuid_create(&uuid.uuid, &data[i], uuid_len)) {
-			return false;
-		}
+	if (uuid_len == BT_SCAN_UUID_128_SIZE) {
+		memcpy(key, data, BT_SCAN_UUID_128_SIZE);
 
-		if (bt_uuid_cmp(&uuid.uuid, target_uuid->uuid) == 0) {
-			return true;
-		}
+		return;
 	}
 
-	return false;
+	/* The 16 and 32-bit UUIDs replace bytes 12 to 15 of the base UUID. */
+	memcpy(key, uuid_base, sizeof(uuid_base));
+	memcpy(&key[12], data, uuid_len);
+}
+
+static int uuid_key_cmp(const void *key, uint16_t filter_idx)
+{
+	return memcmp(key, bt_scan.scan_filters.uuid.uuid[filter_idx].key,
+		      BT_SCAN_UUID_128_SIZE);
 }
 
 static bool adv_uuid_compare(const struct bt_data *data, uint8_t uuid_type,
 			     struct bt_scan_control *control)
 {
-	const struct bt_scan_uuid_filter *uuid_filter =
+	struct bt_scan_uuid_filter *uuid_filter =
 			&bt_scan.scan_filters.uuid;
 	const bool all_filters_mode = bt_scan.scan_filters.all_mode;
-	const uint8_t counter = bt_scan.scan_filters.uuid.cnt;
+	const uint16_t counter = bt_scan.scan_filters.uuid.cnt;
+	const uint8_t uuid_len = uuid_len_get(uuid_type);
 	uint8_t data_len = data->data_len;
-	uint8_t uuid_match_cnt = 0;
+	uint32_t matched[DIV_ROUND_UP(CONFIG_BT_SCAN_UUID_CNT, 32)];
+	uint16_t uuid_match_cnt = 0;
+	uint16_t first_match = counter;
 
-	for (size_t i = 0; i < counter; i++) {
+	if (uuid_len == 0) {
+		return false;
+	}
 
-		if (find_uuid(data->data, data_len, uuid_type,
-			      &uuid_filter->uuid[i])) {
-			control->filter_status.uuid.uuid[uuid_match_cnt] =
-				uuid_filter->uuid[i].uuid;
+	memset(matched, 0, sizeof(matched));
 
-			uuid_match_cnt++;
+	/* Look up each UUID found, counting every filter once. */
+	for (size_t i = 0; i + uuid_len <= data_len; i += uuid_len) {
+		uint8_t key[BT_SCAN_UUID_128_SIZE];
+		uint16_t pos;
+		uint16_t idx;
+		bool found;
 
-			/* In the normal filter mode,
-			 * only one UUID is needed to match.
-			 */
-			if (!all_filters_mode) {
-				break;
-			}
+		uuid_key_get(&data->data[i], uuid_len, key);
 
-		} else if (all_filters_mode) {
-			break;
+		pos = filter_index_search(uuid_filter->index, counter, key,
+					  uuid_key_cmp, &found);
+		if (!found) {
+			continue;
+		}
+
+		idx = uuid_filter->index[pos];
+		if (matched[idx / 32] & BIT(idx % 32)) {
+			continue;
 		}
-	}
 
-	control->filter_status.uuid.count = uuid_match_cnt;
+		matched[idx / 32] |= BIT(idx % 32);
+		uuid_filter->hits[idx]++;
+		uuid_match_cnt++;
+		first_match = MIN(first_match, idx);
+	}
 
 	/* In the multifilter mode, all UUIDs must be found in
 	 * the advertisement packets.
 	 */
-	if ((all_filters_mode && (uuid_match_cnt == counter)) ||
-	    ((!all_filters_mode) && (uuid_match_cnt > 0))) {
+	if (all_filters_mode && (uuid_match_cnt == counter)) {
+		for (size_t i = 0; i < counter; i++) {
+			control->filter_status.uuid.uuid[i] =
+				uuid_filter->uuid[i].uuid;
+		}
+
+		control->filter_status.uuid.count = counter;
+
+		return true;
+	}
+
+	/* In the normal filter mode, only one UUID is needed to match. */
+	if ((!all_filters_mode) && (uuid_match_cnt > 0)) {
+		control->filter_status.uuid.uuid[0] =
+			uuid_filter->uuid[first_match].uuid;
+		control->filter_status.uuid.count = 1;
+
 		return true;
 	}
 
@@ -869,22 +1193,46 @@ static void uuid_check(struct bt_scan_control *control,
 
 static int scan_uuid_filter_add(struct bt_uuid *uuid)
 {
-	struct bt_scan_uuid *uuid_filter = bt_scan.scan_filters.uuid.uuid;
-	uint8_t counter = bt_scan.scan_filters.uuid.cnt;
+	struct bt_scan_uuid_filter *filter = &bt_scan.scan_filters.uuid;
+	struct bt_scan_uuid *uuid_filter = filter->uuid;
+	uint16_t counter = filter->cnt;
 	struct bt_uuid_16 *uuid_16;
 	struct bt_uuid_32 *uuid_32;
 	struct bt_uuid_128 *uuid_128;
+	uint8_t encoded[sizeof(uint32_t)];
+	uint8_t key[BT_SCAN_UUID_128_SIZE];
+	uint16_t pos;
+	bool found;
 
 	/* If no memory. */
 	if (counter >= CONFIG_BT_SCAN_UUID_CNT) {
 		return -ENOMEM;
 	}
 
+	switch (uuid->type) {
+	case BT_UUID_TYPE_16:
+		sys_put_le16(BT_UUID_16(uuid)->val, encoded);
+		uuid_key_get(encoded, sizeof(uint16_t), key);
+		break;
+
+	case BT_UUID_TYPE_32:
+		sys_put_le32(BT_UUID_32(uuid)->val, encoded);
+		uuid_key_get(encoded, sizeof(uint32_t), key);
+		break;
+
+	case BT_UUID_TYPE_128:
+		uuid_key_get(BT_UUID_128(uuid)->val, BT_SCAN_UUID_128_SIZE, key);
+		break;
+
+	default:
+		return -EINVAL;
+	}
+
 	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (bt_uuid_cmp(uuid_filter[i].uuid, uuid) == 0) {
-			return 0;
-		}
+	pos = filter_index_search(filter->index, counter, key, uuid_key_cmp,
+				  &found);
+	if (found) {
+		return 0;
 	}
 
 	/* Add UUID to the filter. */
@@ -912,60 +1260,60 @@ static int scan_uuid_filter_add(struct bt_uuid *uuid)
 		uuid_filter[counter].uuid =
 				(struct bt_uuid *)&uuid_filter[counter].uuid_data.uuid_128;
 		break;
-
-	default:
-		return -EINVAL;
 	}
 
-	bt_scan.scan_filters.uuid.cnt++;
+	memcpy(uuid_filter[counter].key, key, sizeof(key));
+	filter_index_insert(filter->index, counter, pos, counter);
+
+	filter->hits[counter] = 0;
+	filter->cnt++;
 	LOG_DBG("Added filter on UUID type %x", uuid->type);
 
 	return 0;
 }
 
-static bool find_appearance(const uint8_t *data,
-			    uint8_t data_len,
-			    const uint16_t *appearance)
+static int appearance_key_cmp(const void *key, uint16_t filter_idx)
 {
-	if (data_len != sizeof(uint16_t)) {
-		return false;
-	}
-
-	uint16_t decoded_appearance = sys_get_le16(data);
+	uint16_t appearance = *(const uint16_t *)key;
+	uint16_t filter_appearance =
+		bt_scan.scan_filters.appearance.appearance[filter_idx];
 
-	if (decoded_appearance == *appearance) {
-		return true;
-	}
-
-	/* Could not find the appearance among the encoded data. */
-	return false;
+	return (appearance > filter_appearance) - (appearance < filter_appearance);
 }
 
 static bool adv_appearance_compare(const struct bt_data *data,
 				   struct bt_scan_control *control)
 {
-	const struct bt_scan_appearance_filter *appearance_filter =
+	struct bt_scan_appearance_filter *appearance_filter =
 			&bt_scan.scan_filters.appearance;
-	const uint8_t counter =
-			bt_scan.scan_filters.appearance.cnt;
-	uint8_t data_len = data->data_len;
+	uint16_t decoded_appearance;
+	uint16_t pos;
+	uint16_t idx;
+	bool found;
+
+	if (data->data_len != sizeof(uint16_t)) {
+		return false;
+	}
+
+	decoded_appearance = sys_get_le16(data->data);
 
 	/* Verify if the advertised appearance matches
 	 * the provided appearance.
 	 */
-	for (size_t i = 0; i < counter; i++) {
-		if (find_appearance(data->data,
-				    data_len,
-				    &appearance_filter->appearance[i])) {
+	pos = filter_index_search(appearance_filter->index,
+				  appearance_filter->cnt, &decoded_appearance,
+				  appearance_key_cmp, &found);
+	if (!found) {
+		return false;
+	}
 
-			control->filter_status.appearance.appearance =
-					&appearance_filter->appearance[i];
+	idx = appearance_filter->index[pos];
+	appearance_filter->hits[idx]++;
 
-			return true;
-		}
-	}
+	control->filter_status.appearance.appearance =
+			&appearance_filter->appearance[idx];
 
-	return false;
+	return true;
 }
 
 static inline bool is_appearance_filter_enabled(void)
@@ -989,8 +1337,11 @@ static void appearance_check(struct bt_scan_control *control,
 
 static int scan_appearance_filter_add(uint16_t appearance)
 {
-	uint16_t *appearance_filter = bt_scan.scan_filters.appearance.appearance;
-	uint8_t counter = bt_scan.scan_filters.appearance.cnt;
+	struct bt_scan_appearance_filter *filter =
+		&bt_scan.scan_filters.appearance;
+	uint16_t counter = filter->cnt;
+	uint16_t pos;
+	bool found;
 
 	/* If no memory. */
 	if (counter >= CONFIG_BT_SCAN_APPEARANCE_CNT) {
@@ -998,61 +1349,45 @@ static int scan_appearance_filter_add(uint16_t appearance)
 	}
 
 	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (appearance_filter[i] == appearance) {
-			return 0;
-		}
+	pos = filter_index_search(filter->index, counter, &appearance,
+				  appearance_key_cmp, &found);
+	if (found) {
+		return 0;
 	}
 
 	/* Add appearance to the filter. */
-	appearance_filter[counter] = appearance;
-	bt_scan.scan_filters.appearance.cnt++;
+	filter->appearance[counter] = appearance;
+	filter_index_insert(filter->index, counter, pos, counter);
+	filter->hits[counter] = 0;
+	filter->cnt++;
 
 	LOG_DBG("Added filter on appearance %x", appearance);
 
 	return 0;
 }
 
-static bool adv_manufacturer_data_cmp(const uint8_t *data,
-				      uint8_t data_len,
-				      const uint8_t *target_data,
-				      uint8_t target_data_len)
-{
-	if (target_data_len > data_len) {
-		return false;
-	}
-
-	if (memcmp(target_data, data, target_data_len) != 0) {
-		return false;
-	}
-
-	return true;
-}
-
 static bool adv_manufacturer_data_compare(const struct bt_data *data,
 					  struct bt_scan_control *control)
 {
-	const struct bt_scan_manufacturer_data_filter *md_filter =
+	struct bt_scan_manufacturer_data_filter *md_filter =
 		&bt_scan.scan_filters.manufacturer_data;
-	uint8_t counter = bt_scan.scan_filters.manufacturer_data.cnt;
+	int idx;
 
-	/* Compare the name found with the name filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (adv_manufacturer_data_cmp(data->data,
-				data->data_len,
-				md_filter->manufacturer_data[i].data,
-				md_filter->manufacturer_data[i].data_len)) {
+	/* Find the first manufacturer data filter that starts the data found. */
+	idx = scan_prefix_trie_prefix_find(&manufacturer_data_trie, data->data,
+					   data->data_len);
+	if (idx < 0) {
+		return false;
+	}
 
-			control->filter_status.manufacturer_data.data =
-				md_filter->manufacturer_data[i].data;
-			control->filter_status.manufacturer_data.len =
-				md_filter->manufacturer_data[i].data_len;
+	md_filter->hits[idx]++;
 
-			return true;
-		}
-	}
+	control->filter_status.manufacturer_data.data =
+		md_filter->manufacturer_data[idx].data;
+	control->filter_status.manufacturer_data.len =
+		md_filter->manufacturer_data[idx].data_len;
 
-	return false;
+	return true;
 }
 static inline bool is_manufacturer_data_filter_enabled(void)
 {
@@ -1078,7 +1413,7 @@ static int scan_manufacturer_data_filter_add(const struct bt_scan_manufacturer_d
 {
 	struct bt_scan_manufacturer_data_filter *md_filter =
 		&bt_scan.scan_filters.manufacturer_data;
-	uint8_t counter = bt_scan.scan_filters.manufacturer_data.cnt;
+	uint16_t counter = bt_scan.scan_filters.manufacturer_data.cnt;
 
 	/* If no memory for filter. */
 	if (counter >= CONFIG_BT_SCAN_MANUFACTURER_DATA_CNT) {
@@ -1092,14 +1427,13 @@ static int scan_manufacturer_data_filter_add(const struct bt_scan_manufacturer_d
 		return -EINVAL;
 	}
 
-	/* Check for duplicated filter. */
-	for (size_t i = 0; i < counter; i++) {
-		if (adv_manufacturer_data_cmp(manufacturer_data->data,
-				manufacturer_data->data_len,
-				md_filter->manufacturer_data[i].data,
-				md_filter->manufacturer_data[i].data_len)) {
-			return 0;
-		}
+	/* Check for duplicated filter, or a filter matching all the data
+	 * this one would match.
+	 */
+	if (scan_prefix_trie_prefix_find(&manufacturer_data_trie,
+					 manufacturer_data->data,
+					 manufacturer_data->data_len) >= 0) {
+		return 0;
 	}
 
 	/* Add manufacturer data to filter. */
@@ -1108,6 +1442,9 @@ static int scan_manufacturer_data_filter_add(const struct bt_scan_manufacturer_d
 	md_filter->manufacturer_data[counter].data_len =
 		manufacturer_data->data_len;
 
+	scan_prefix_trie_insert(&manufacturer_data_trie, counter);
+
+	md_filter->hits[counter] = 0;
 	bt_scan.scan_filters.manufacturer_data.cnt++;
 
 	LOG_DBG("Adding filter on manufacturer data");
@@ -1209,6 +1546,8 @@ int bt_scan_filter_add(enum bt_scan_filter_type type,
 		break;
 	}
 
+	report_cache_invalidate();
+
 	k_mutex_unlock(&scan_mutex);
 
 	return err;
@@ -1226,9 +1565,7 @@ void bt_scan_filter_remove_all(void)
 			&bt_scan.scan_filters.short_name;
 	short_name_filter->cnt = 0;
 
-	struct bt_scan_addr_filter *addr_filter =
-			&bt_scan.scan_filters.addr;
-	addr_filter->cnt = 0;
+	scan_addr_set_clear(&addr_filter_set);
 
 	struct bt_scan_uuid_filter *uuid_filter =
 			&bt_scan.scan_filters.uuid;
@@ -1242,6 +1579,9 @@ void bt_scan_filter_remove_all(void)
 		&bt_scan.scan_filters.manufacturer_data;
 	manufacturer_data_filter->cnt = 0;
 
+	filters_index_clear();
+	report_cache_invalidate();
+
 	k_mutex_unlock(&scan_mutex);
 }
 
@@ -1254,6 +1594,8 @@ void bt_scan_filter_disable(void)
 	bt_scan.scan_filters.uuid.enabled = false;
 	bt_scan.scan_filters.appearance.enabled = false;
 	bt_scan.scan_filters.manufacturer_data.enabled = false;
+
+	report_cache_invalidate();
 }
 
 int bt_scan_filter_enable(uint8_t mode, bool match_all)
@@ -1296,6 +1638,8 @@ int bt_scan_filter_enable(uint8_t mode, bool match_all)
 	/* Select the filter mode. */
 	filters->all_mode = match_all;
 
+	report_cache_invalidate();
+
 	return 0;
 }
 
@@ -1306,7 +1650,7 @@ int bt_scan_filter_status_get(struct bt_filter_status *status)
 	}
 
 	status->addr.enabled = bt_scan.scan_filters.addr.enabled;
-	status->addr.cnt = bt_scan.scan_filters.addr.cnt;
+	status->addr.cnt = addr_filter_set.cnt;
 	status->name.enabled = bt_scan.scan_filters.name.enabled;
 	status->name.cnt = bt_scan.scan_filters.name.cnt;
 	status->short_name.enabled =
@@ -1325,6 +1669,68 @@ int bt_scan_filter_status_get(struct bt_filter_status *status)
 	return 0;
 }
 
+int bt_scan_filter_hit_count_get(enum bt_scan_filter_type type,
+				 uint16_t index, uint32_t *hit_cnt)
+{
+	const struct bt_scan_filters *filters = &bt_scan.scan_filters;
+	const uint32_t *hits;
+	uint16_t counter;
+	int err = 0;
+
+	if (!hit_cnt) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&scan_mutex, K_FOREVER);
+
+	switch (type) {
+	case BT_SCAN_FILTER_TYPE_NAME:
+		hits = filters->name.hits;
+		counter = filters->name.cnt;
+		break;
+
+	case BT_SCAN_FILTER_TYPE_SHORT_NAME:
+		hits = filters->short_name.hits;
+		counter = filters->short_name.cnt;
+		break;
+
+	case BT_SCAN_FILTER_TYPE_ADDR:
+		hits = filters->addr.hits;
+		counter = addr_filter_set.cnt;
+		break;
+
+	case BT_SCAN_FILTER_TYPE_UUID:
+		hits = filters->uuid.hits;
+		counter = filters->uuid.cnt;
+		break;
+
+	case BT_SCAN_FILTER_TYPE_APPEARANCE:
+		hits = filters->appearance.hits;
+		counter = filters->appearance.cnt;
+		break;
+
+	case BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA:
+		hits = filters->manufacturer_data.hits;
+		counter = filters->manufacturer_data.cnt;
+		break;
+
+	default:
+		hits = NULL;
+		counter = 0;
+		break;
+	}
+
+	if (index < counter) {
+		*hit_cnt = hits[index];
+	} else {
+		err = -EINVAL;
+	}
+
+	k_mutex_unlock(&scan_mutex);
+
+	return err;
+}
+
 int bt_scan_stop(void)
 {
 	return bt_le_scan_stop();
@@ -1337,6 +1743,12 @@ void bt_scan_init(const struct bt_scan_init_param *init)
 
 	/* Disable all scanning filters. */
 	memset(&bt_scan.scan_filters, 0, sizeof(bt_scan.scan_filters));
+	scan_addr_set_clear(&addr_filter_set);
+	filters_index_clear();
+
+#if CONFIG_BT_SCAN_REPORT_CACHE
+	bt_scan_report_cache_clear();
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
 
 	/* If the pointer to the initialization structure exist,
 	 * use it to scan the configuration.
@@ -1458,37 +1870,39 @@ static bool adv_data_found(struct bt_data *data, void *user_data)
 	return true;
 }
 
-static void filter_state_check(struct bt_scan_control *control,
-			       const bt_addr_le_t *addr)
+static enum scan_filter_result filter_state_check(struct bt_scan_control *control,
+						  const bt_addr_le_t *addr)
 {
 	if (!scan_device_filter_check(addr)) {
-		return;
+		return SCAN_FILTER_DROPPED;
 	}
 
-	if (control->all_mode &&
-	    (control->filter_match_cnt == control->filter_cnt)) {
-		notify_filter_matched(&control->device_info,
-				      &control->filter_status,
-				      control->connectable);
+	/* In the multifilter mode, the number of the active filters must
+	 * equal the number of the filters matched. In the normal filter mode,
+	 * only one filter match is needed to generate the notification to
+	 * the main application.
+	 */
+	if ((control->all_mode &&
+	     (control->filter_match_cnt == control->filter_cnt)) ||
+	    ((!control->all_mode) && control->filter_match)) {
+		if (notify_allowed(control)) {
+			notify_filter_matched(&control->device_info,
+					      &control->filter_status,
+					      control->connectable);
+		}
 #if CONFIG_BT_CENTRAL
 		scan_connect_with_target(control, addr);
 #endif /* CONFIG_BT_CENTRAL */
+
+		return SCAN_FILTER_MATCH;
 	}
 
-	/* In the normal filter mode, only one filter match is
-	 * needed to generate the notification to the main application.
-	 */
-	else if ((!control->all_mode) && control->filter_match) {
-		notify_filter_matched(&control->device_info,
-				      &control->filter_status,
-				      control->connectable);
-#if CONFIG_BT_CENTRAL
-		scan_connect_with_target(control, addr);
-#endif /* CONFIG_BT_CENTRAL */
-	} else {
+	if (notify_allowed(control)) {
 		notify_filter_no_match(&control->device_info,
 				       control->connectable);
 	}
+
+	return SCAN_FILTER_NO_MATCH;
 }
 
 static void scan_recv(const struct bt_le_scan_recv_info *info,
@@ -1496,36 +1910,63 @@ static void scan_recv(const struct bt_le_scan_recv_info *info,
 {
 	struct bt_scan_control scan_control;
 	struct net_buf_simple_state state;
+	enum scan_filter_result result;
 
 	memset(&scan_control, 0, sizeof(scan_control));
 
 	scan_control.all_mode = bt_scan.scan_filters.all_mode;
 
-	check_enabled_filters(&scan_control);
-
 	/* Check id device is connectable. */
 	scan_control.connectable =
 		(info->adv_props & BT_GAP_ADV_PROP_CONNECTABLE) != 0;
 
+	scan_control.device_info.recv_info = info;
+	scan_control.device_info.conn_param = &bt_scan.conn_param;
+	scan_control.device_info.adv_data = ad;
+
+#if CONFIG_BT_SCAN_REPORT_CACHE
+	/* An unchanged report of a device that matched none of the filters
+	 * does not match them now either, unless the filters changed.
+	 */
+	if (report_cache_check(&scan_control, info, ad)) {
+		if (scan_device_filter_check(info->addr) &&
+		    notify_allowed(&scan_control)) {
+			notify_filter_no_match(&scan_control.device_info,
+					       scan_control.connectable);
+		}
+
+		return;
+	}
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
+
+	check_enabled_filters(&scan_control);
+
 	/* Check the address filter. */
 	check_addr(&scan_control, info->addr);
 
 	/* Save advertising buffer state to transfer it
 	 * data to application if futher processing is needed.
+	 * The advertising data is only parsed if a filter needs it.
 	 */
-	net_buf_simple_save(ad, &state);
-	bt_data_parse(ad, adv_data_found, (void *)&scan_control);
-	net_buf_simple_restore(ad, &state);
-
-	scan_control.device_info.recv_info = info;
-	scan_control.device_info.conn_param = &bt_scan.conn_param;
-	scan_control.device_info.adv_data = ad;
+	if (is_name_filter_enabled() || is_short_name_filter_enabled() ||
+	    is_uuid_filter_enabled() || is_appearance_filter_enabled() ||
+	    is_manufacturer_data_filter_enabled()) {
+		net_buf_simple_save(ad, &state);
+		bt_data_parse(ad, adv_data_found, (void *)&scan_control);
+		net_buf_simple_restore(ad, &state);
+	}
 
 	/* In the multifilter mode, the number of the active filters must equal
 	 * the number of the filters matched to generate the notification.
 	 * If the event handler is not NULL, notify the main application.
 	 */
-	filter_state_check(&scan_control, info->addr);
+	result = filter_state_check(&scan_control, info->addr);
+
+#if CONFIG_BT_SCAN_REPORT_CACHE
+	report_cache_store(&scan_control, result);
+#else
+	ARG_UNUSED(result);
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
 }
 
 static struct bt_le_scan_cb scan_cb = {
@@ -1579,6 +2020,7 @@ int bt_scan_blocklist_device_add(const bt_addr_le_t *addr)
 {
 	int err = 0;
 	char addr_str[BT_ADDR_LE_STR_LEN];
+	int idx;
 
 	if (!addr) {
 		return -EINVAL;
@@ -1588,27 +2030,17 @@ int bt_scan_blocklist_device_add(const bt_addr_le_t *addr)
 
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 
-	/* Check if the device is already on the blocklist. */
-	for (size_t i = 0; i < ARRAY_SIZE(bt_scan.blocklist.addr); i++) {
-		if (bt_addr_le_cmp(&bt_scan.blocklist.addr[i], addr) == 0) {
-			LOG_DBG("Device %s is already on the blocklist",
-				addr_str);
-
-			goto out;
-		}
-	}
-
-	if (bt_scan.blocklist.count >= ARRAY_SIZE(bt_scan.blocklist.addr)) {
+	idx = scan_addr_set_add(&blocklist_set, addr);
+	if (idx == -EALREADY) {
+		LOG_DBG("Device %s is already on the blocklist",
+			addr_str);
+	} else if (idx == -ENOMEM) {
 		LOG_ERR("No place for the new device");
 		err = -ENOMEM;
 	} else {
-		bt_addr_le_copy(&bt_scan.blocklist.addr[bt_scan.blocklist.count],
-				addr);
-		bt_scan.blocklist.count++;
 		LOG_INF("Device %s added to the scanning blocklist", addr_str);
 	}
 
-out:
 	k_mutex_unlock(&scan_mutex);
 
 	return err;
@@ -1617,7 +2049,7 @@ out:
 void bt_scan_blocklist_clear(void)
 {
 	k_mutex_lock(&scan_mutex, K_FOREVER);
-	memset(&bt_scan.blocklist, 0, sizeof(bt_scan.blocklist));
+	scan_addr_set_clear(&blocklist_set);
 	k_mutex_unlock(&scan_mutex);
 }
 #endif /* CONFIG_BT_SCAN_BLOCKLIST */
@@ -1627,10 +2059,43 @@ void bt_scan_conn_attempts_filter_clear(void)
 {
 	k_mutex_lock(&scan_mutex, K_FOREVER);
 	memset(&bt_scan.attempts_filter, 0, sizeof(bt_scan.attempts_filter));
+	scan_addr_set_clear(&attempts_filter_set);
 	k_mutex_unlock(&scan_mutex);
 }
 #endif /* CONFIG_BT_SCAN_CONN_ATTEMPTS_FILTER */
 
+#if CONFIG_BT_SCAN_REPORT_CACHE
+int bt_scan_report_cache_stats_get(struct bt_scan_report_cache_stats *stats)
+{
+	struct report_cache *cache = &bt_scan.report_cache;
+	k_spinlock_key_t key;
+
+	if (!stats) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&cache->lock);
+	*stats = cache->stats;
+	k_spin_unlock(&cache->lock, key);
+
+	return 0;
+}
+
+void bt_scan_report_cache_clear(void)
+{
+	struct report_cache *cache = &bt_scan.report_cache;
+	k_spinlock_key_t key;
+
+	key = k_spin_lock(&cache->lock);
+
+	scan_addr_set_clear(&report_cache_set);
+	sys_dlist_init(&cache->lru);
+	memset(&cache->stats, 0, sizeof(cache->stats));
+
+	k_spin_unlock(&cache->lock, key);
+}
+#endif /* CONFIG_BT_SCAN_REPORT_CACHE */
+
 #if CONFIG_BT_CENTRAL
 void bt_scan_update_connect_if_match(bool connect_if_match)
 {
@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+
+#include "scan_addr_set.h"
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME        16777619U
+
+static uint32_t addr_hash(const bt_addr_le_t *addr)
+{
+	uint32_t hash = FNV_OFFSET_BASIS ^ addr->type;
+
+	for (size_t i = 0; i < ARRAY_SIZE(addr->a.val); i++) {
+		hash = (hash ^ addr->a.val[i]) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+/* Look up an address and return its index, or -ENOENT. The slot holding the
+ * address, or the free slot where it belongs, is stored in slot_idx.
+ */
+static int slot_find(const struct scan_addr_set *set, const bt_addr_le_t *addr,
+		     uint32_t *slot_idx)
+{
+	const uint32_t mask = set->slot_cnt - 1;
+	uint32_t i = addr_hash(addr) & mask;
+
+	/* Bounded, so a lookup racing with an update always ends. */
+	for (uint32_t n = 0; n < set->slot_cnt; n++) {
+		uint16_t entry = set->slot[i];
+
+		if (entry == 0) {
+			break;
+		}
+
+		if ((entry <= set->cap) &&
+		    (bt_addr_le_cmp(&set->addr[entry - 1], addr) == 0)) {
+			*slot_idx = i;
+
+			return entry - 1;
+		}
+
+		i = (i + 1) & mask;
+	}
+
+	*slot_idx = i;
+
+	return -ENOENT;
+}
+
+/* Free a slot, moving back the entries of the probe sequence after it so
+ * that no lookup stops early at the hole.
+ */
+static void slot_remove(struct scan_addr_set *set, uint32_t i)
+{
+	const uint32_t mask = set->slot_cnt - 1;
+	uint32_t j = i;
+
+	for (;;) {
+		uint16_t entry;
+		uint32_t home;
+
+		j = (j + 1) & mask;
+		entry = set->slot[j];
+
+		if (entry == 0) {
+			break;
+		}
+
+		/* The entry can fill the hole unless its home slot lies
+		 * between the hole and its current slot.
+		 */
+		home = addr_hash(&set->addr[entry - 1]) & mask;
+		if (((j - home) & mask) >= ((j - i) & mask)) {
+			set->slot[i] = entry;
+			i = j;
+		}
+	}
+
+	set->slot[i] = 0;
+}
+
+static k_spinlock_key_t update_begin(struct scan_addr_set *set)
+{
+	k_spinlock_key_t key = k_spin_lock(&set->lock);
+
+	atomic_inc(&set->seq);
+
+	return key;
+}
+
+static void update_end(struct scan_addr_set *set, k_spinlock_key_t key)
+{
+	atomic_inc(&set->seq);
+
+	k_spin_unlock(&set->lock, key);
+}
+
+int scan_addr_set_find(const struct scan_addr_set *set,
+		       const bt_addr_le_t *addr)
+{
+	atomic_val_t seq;
+	uint32_t slot_idx;
+	int idx;
+
+	if (set->cap == 0) {
+		return -ENOENT;
+	}
+
+	/* The update holds a spinlock, so this only spins while an update
+	 * runs on another CPU.
+	 */
+	do {
+		seq = atomic_get(&set->seq);
+		idx = slot_find(set, addr, &slot_idx);
+	} while ((seq & 1) || (seq != atomic_get(&set->seq)));
+
+	return idx;
+}
+
+int scan_addr_set_add(struct scan_addr_set *set, const bt_addr_le_t *addr)
+{
+	k_spinlock_key_t key;
+	uint32_t slot_idx;
+	int idx;
+
+	key = update_begin(set);
+
+	if (slot_find(set, addr, &slot_idx) >= 0) {
+		idx = -EALREADY;
+	} else if (set->cnt >= set->cap) {
+		idx = -ENOMEM;
+	} else {
+		idx = set->cnt;
+		bt_addr_le_copy(&set->addr[idx], addr);
+		set->slot[slot_idx] = idx + 1;
+		set->cnt++;
+	}
+
+	update_end(set, key);
+
+	return idx;
+}
+
+void scan_addr_set_replace(struct scan_addr_set *set, uint16_t idx,
+			   const bt_addr_le_t *addr)
+{
+	k_spinlock_key_t key;
+	uint32_t slot_idx;
+
+	__ASSERT_NO_MSG(idx < set->cnt);
+
+	key = update_begin(set);
+
+	if (slot_find(set, &set->addr[idx], &slot_idx) >= 0) {
+		slot_remove(set, slot_idx);
+	}
+
+	bt_addr_le_copy(&set->addr[idx], addr);
+
+	if (slot_find(set, addr, &slot_idx) < 0) {
+		set->slot[slot_idx] = idx + 1;
+	}
+
+	update_end(set, key);
+}
+
+void scan_addr_set_clear(struct scan_addr_set *set)
+{
+	k_spinlock_key_t key;
+
+	key = update_begin(set);
+
+	memset(set->slot, 0, set->slot_cnt * sizeof(set->slot[0]));
+	set->cnt = 0;
+
+	update_end(set, key);
+}
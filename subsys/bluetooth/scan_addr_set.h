@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BT_SCAN_ADDR_SET_H__
+#define BT_SCAN_ADDR_SET_H__
+
+#include <zephyr/kernel.h>
+#include <zephyr/sys/atomic.h>
+#include <zephyr/sys/util.h>
+#include <zephyr/bluetooth/addr.h>
+
+/* Set of Bluetooth LE addresses, used by the address filter, the blocklist
+ * and the connection attempts filter of the scan library.
+ *
+ * The addresses are kept in the order they were added, so their index is
+ * stable until they are replaced or the set is cleared. They are looked up
+ * through an open addressing hash table of indexes.
+ *
+ * The set is read without taking a lock. Updates are serialized by a spinlock
+ * and bump a sequence count, which is odd while an update is in progress.
+ * A reader retries the lookup if the sequence count changed under it.
+ */
+struct scan_addr_set {
+	/* Addresses in the set. */
+	bt_addr_le_t *addr;
+
+	/* Hash table of address indexes plus one, 0 marks a free slot. */
+	uint16_t *slot;
+
+	/* Number of hash table slots, a power of two. */
+	uint16_t slot_cnt;
+
+	/* Maximum number of addresses. */
+	uint16_t cap;
+
+	/* Number of addresses in the set. */
+	uint16_t cnt;
+
+	/* Update sequence count. */
+	atomic_t seq;
+
+	/* Lock serializing the updates. */
+	struct k_spinlock lock;
+};
+
+/* The hash table is kept at most half full, so a lookup rarely probes more
+ * than one or two slots.
+ */
+#define SCAN_ADDR_SET_SLOT_CNT(_cap) NHPOT(2 * (_cap))
+
+#define SCAN_ADDR_SET_DEFINE(_name, _cap)					\
+	BUILD_ASSERT((_cap) <= (UINT16_MAX / 2),				\
+		     "Too many addresses in the " #_name " set");		\
+	static bt_addr_le_t _name##_addr[_cap];					\
+	static uint16_t _name##_slot[SCAN_ADDR_SET_SLOT_CNT(_cap)];		\
+	static struct scan_addr_set _name = {					\
+		.addr = _name##_addr,						\
+		.slot = _name##_slot,						\
+		.slot_cnt = SCAN_ADDR_SET_SLOT_CNT(_cap),			\
+		.cap = (_cap),							\
+	}
+
+/* Find an address in the set.
+ *
+ * Returns the index of the address or -ENOENT if it is not in the set.
+ */
+int scan_addr_set_find(const struct scan_addr_set *set,
+		       const bt_addr_le_t *addr);
+
+/* Add an address to the set.
+ *
+ * Returns the index of the address, -EALREADY if it is already in the set or
+ * -ENOMEM if the set is full.
+ */
+int scan_addr_set_add(struct scan_addr_set *set, const bt_addr_le_t *addr);
+
+/* Replace the address at an index with an address not in the set. */
+void scan_addr_set_replace(struct scan_addr_set *set, uint16_t idx,
+			   const bt_addr_le_t *addr);
+
+/* Remove all the addresses from the set. */
+void scan_addr_set_clear(struct scan_addr_set *set);
+
+#endif /* BT_SCAN_ADDR_SET_H__ */
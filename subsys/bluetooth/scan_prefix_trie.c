@@ -0,0 +1,281 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/sys/__assert.h>
+
+#include "scan_prefix_trie.h"
+
+#define ROOT 0
+
+static const uint8_t *label_get(const struct scan_prefix_trie *trie,
+				const struct scan_prefix_trie_node *node)
+{
+	uint8_t len;
+
+	return &trie->key_get(node->key_idx, &len)[node->start];
+}
+
+static uint16_t child_find(const struct scan_prefix_trie *trie, uint16_t parent,
+			   uint8_t byte)
+{
+	for (uint16_t i = trie->node[parent].child; i != 0;
+	     i = trie->node[i].sibling) {
+		if (label_get(trie, &trie->node[i])[0] == byte) {
+			return i;
+		}
+	}
+
+	return 0;
+}
+
+static uint16_t node_alloc(struct scan_prefix_trie *trie, uint16_t parent,
+			   uint16_t key_idx, uint8_t start, uint8_t end)
+{
+	uint16_t i = trie->node_cnt++;
+	struct scan_prefix_trie_node *node = &trie->node[i];
+
+	__ASSERT_NO_MSG(i < trie->node_max);
+
+	memset(node, 0, sizeof(*node));
+	node->key_idx = key_idx;
+	node->start = start;
+	node->end = end;
+	node->parent = parent;
+	node->first = key_idx;
+
+	return i;
+}
+
+/* Split the edge into a node, so that the first len bytes of its label lead
+ * to a new node.
+ */
+static uint16_t edge_split(struct scan_prefix_trie *trie, uint16_t i, uint8_t len)
+{
+	struct scan_prefix_trie_node *node = &trie->node[i];
+	uint16_t parent = node->parent;
+	uint16_t split = node_alloc(trie, parent, node->key_idx, node->start,
+				    node->start + len);
+	uint16_t *link = &trie->node[parent].child;
+
+	/* Take the place of the node among its siblings */
+	while (*link != i) {
+		link = &trie->node[*link].sibling;
+	}
+
+	*link = split;
+	trie->node[split].sibling = node->sibling;
+	trie->node[split].child = i;
+	trie->node[split].first = node->first;
+
+	node->sibling = 0;
+	node->parent = split;
+	node->start += len;
+
+	return split;
+}
+
+/* Node at which the data ends, or 0 if the data leaves the trie or ends
+ * within a label.
+ */
+static uint16_t node_find(const struct scan_prefix_trie *trie,
+			  const uint8_t *data, uint8_t len)
+{
+	uint16_t i = ROOT;
+	uint8_t depth = 0;
+
+	while (depth < len) {
+		const struct scan_prefix_trie_node *node;
+
+		i = child_find(trie, i, data[depth]);
+		if (i == 0) {
+			return 0;
+		}
+
+		node = &trie->node[i];
+		if ((node->end > len) ||
+		    (memcmp(label_get(trie, node), &data[depth],
+			    node->end - node->start) != 0)) {
+			return 0;
+		}
+
+		depth = node->end;
+	}
+
+	return i;
+}
+
+int scan_prefix_trie_insert(struct scan_prefix_trie *trie, uint16_t key_idx)
+{
+	uint8_t len;
+	const uint8_t *key = trie->key_get(key_idx, &len);
+	uint16_t i = node_find(trie, key, len);
+	uint8_t depth = 0;
+
+	if ((i != ROOT) && (trie->node[i].terminal != 0)) {
+		return -EALREADY;
+	}
+
+	i = ROOT;
+
+	if (trie->node_cnt == 1) {
+		trie->node[ROOT].first = key_idx;
+	}
+
+	while (depth < len) {
+		uint16_t child = child_find(trie, i, key[depth]);
+		const uint8_t *label;
+		uint8_t label_len;
+		uint8_t match = 1;
+
+		trie->node[i].first = MIN(trie->node[i].first, key_idx);
+
+		if (child == 0) {
+			child = node_alloc(trie, i, key_idx, depth, len);
+			trie->node[child].sibling = trie->node[i].child;
+			trie->node[i].child = child;
+			trie->node[child].terminal = key_idx + 1;
+
+			return 0;
+		}
+
+		label = label_get(trie, &trie->node[child]);
+		label_len = trie->node[child].end - trie->node[child].start;
+
+		while ((match < label_len) && (depth + match < len) &&
+		       (label[match] == key[depth + match])) {
+			match++;
+		}
+
+		if (match < label_len) {
+			child = edge_split(trie, child, match);
+		}
+
+		i = child;
+		depth += match;
+	}
+
+	trie->node[i].first = MIN(trie->node[i].first, key_idx);
+	trie->node[i].terminal = key_idx + 1;
+
+	return 0;
+}
+
+int scan_prefix_trie_prefix_find(const struct scan_prefix_trie *trie,
+				 const uint8_t *data, uint8_t len)
+{
+	uint16_t i = ROOT;
+	uint8_t depth = 0;
+	int found = -ENOENT;
+
+	for (;;) {
+		const struct scan_prefix_trie_node *node = &trie->node[i];
+
+		if ((node->terminal != 0) &&
+		    ((found < 0) || (node->terminal - 1 < found))) {
+			found = node->terminal - 1;
+		}
+
+		if (depth == len) {
+			break;
+		}
+
+		i = child_find(trie, i, data[depth]);
+		if (i == 0) {
+			break;
+		}
+
+		node = &trie->node[i];
+		if ((node->end > len) ||
+		    (memcmp(label_get(trie, node), &data[depth],
+			    node->end - node->start) != 0)) {
+			break;
+		}
+
+		depth = node->end;
+	}
+
+	return found;
+}
+
+/* Lowest accepted key index in the subtree of a node, walked without a stack
+ * through the parent links.
+ */
+static int subtree_find(const struct scan_prefix_trie *trie, uint16_t top,
+			uint8_t len, scan_prefix_trie_key_accept_t accept)
+{
+	uint16_t i = top;
+	int found = -ENOENT;
+
+	for (;;) {
+		const struct scan_prefix_trie_node *node = &trie->node[i];
+		uint16_t key_idx = node->terminal - 1;
+
+		if ((node->terminal != 0) && ((found < 0) || (key_idx < found)) &&
+		    accept(key_idx, len)) {
+			found = key_idx;
+		}
+
+		if (node->child != 0) {
+			i = node->child;
+			continue;
+		}
+
+		while ((i != top) && (trie->node[i].sibling == 0)) {
+			i = trie->node[i].parent;
+		}
+
+		if (i == top) {
+			return found;
+		}
+
+		i = trie->node[i].sibling;
+	}
+}
+
+int scan_prefix_trie_extension_find(const struct scan_prefix_trie *trie,
+				    const uint8_t *data, uint8_t len,
+				    scan_prefix_trie_key_accept_t accept)
+{
+	uint16_t i = ROOT;
+	uint8_t depth = 0;
+
+	if (trie->node_cnt == 1) {
+		return -ENOENT;
+	}
+
+	while (depth < len) {
+		const struct scan_prefix_trie_node *node;
+		uint8_t cmp_len;
+
+		i = child_find(trie, i, data[depth]);
+		if (i == 0) {
+			return -ENOENT;
+		}
+
+		/* The data may end within the label */
+		node = &trie->node[i];
+		cmp_len = MIN(node->end, len) - depth;
+		if (memcmp(label_get(trie, node), &data[depth], cmp_len) != 0) {
+			return -ENOENT;
+		}
+
+		depth += cmp_len;
+	}
+
+	if (!accept) {
+		return trie->node[i].first;
+	}
+
+	return subtree_find(trie, i, len, accept);
+}
+
+void scan_prefix_trie_clear(struct scan_prefix_trie *trie)
+{
+	memset(&trie->node[ROOT], 0, sizeof(trie->node[ROOT]));
+	trie->node_cnt = 1;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BT_SCAN_PREFIX_TRIE_H__
+#define BT_SCAN_PREFIX_TRIE_H__
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <zephyr/sys/util.h>
+
+/* Radix trie of byte string keys, used by the name, short name and
+ * manufacturer data filters of the scan library.
+ *
+ * The keys are stored by the user of the trie and are identified by their
+ * index. The edges of the trie refer to the bytes of the keys instead of
+ * copying them, so a trie of n keys holds at most 2n + 1 nodes.
+ *
+ * The trie is not locked. As the filters it indexes, it is updated under
+ * the scan mutex and read from the scan path.
+ */
+
+/* Get the bytes and the length of a key. */
+typedef const uint8_t *(*scan_prefix_trie_key_get_t)(uint16_t key_idx,
+						     uint8_t *len);
+
+/* Check whether a key can be matched by data of a given length. */
+typedef bool (*scan_prefix_trie_key_accept_t)(uint16_t key_idx, uint8_t len);
+
+struct scan_prefix_trie_node {
+	/* Key holding the label of the edge into this node. */
+	uint16_t key_idx;
+
+	/* Offsets of the label in the key. The end is the node depth. */
+	uint8_t start;
+	uint8_t end;
+
+	/* Parent, first child and next sibling node, 0 for none. */
+	uint16_t parent;
+	uint16_t child;
+	uint16_t sibling;
+
+	/* Key ending at this node plus one, 0 for none. */
+	uint16_t terminal;
+
+	/* Lowest key index in the subtree of this node. */
+	uint16_t first;
+};
+
+struct scan_prefix_trie {
+	/* Nodes of the trie, node 0 is the root. */
+	struct scan_prefix_trie_node *node;
+
+	/* Number of nodes in use. */
+	uint16_t node_cnt;
+
+	/* Maximum number of nodes. */
+	uint16_t node_max;
+
+	/* Accessor of the keys. */
+	scan_prefix_trie_key_get_t key_get;
+};
+
+#define SCAN_PREFIX_TRIE_NODE_CNT(_key_cnt) (2 * (_key_cnt) + 1)
+
+#define SCAN_PREFIX_TRIE_DEFINE(_name, _key_cnt, _key_get)			\
+	BUILD_ASSERT(SCAN_PREFIX_TRIE_NODE_CNT(_key_cnt) < UINT16_MAX,		\
+		     "Too many keys in the " #_name " trie");			\
+	static struct scan_prefix_trie_node					\
+		_name##_node[SCAN_PREFIX_TRIE_NODE_CNT(_key_cnt)];		\
+	static struct scan_prefix_trie _name = {				\
+		.node = _name##_node,						\
+		.node_cnt = 1,							\
+		.node_max = SCAN_PREFIX_TRIE_NODE_CNT(_key_cnt),		\
+		.key_get = _key_get,						\
+	}
+
+/* Insert a key, which must already be stored by the user.
+ *
+ * Returns 0 on success or -EALREADY if an identical key is in the trie.
+ */
+int scan_prefix_trie_insert(struct scan_prefix_trie *trie, uint16_t key_idx);
+
+/* Find the lowest index of the keys that are a prefix of the data.
+ *
+ * Returns the key index or -ENOENT if there is none.
+ */
+int scan_prefix_trie_prefix_find(const struct scan_prefix_trie *trie,
+				 const uint8_t *data, uint8_t len);
+
+/* Find the lowest index of the keys that start with the data.
+ *
+ * If accept is not NULL, only the keys it accepts for the data length are
+ * considered.
+ *
+ * Returns the key index or -ENOENT if there is none.
+ */
+int scan_prefix_trie_extension_find(const struct scan_prefix_trie *trie,
+				    const uint8_t *data, uint8_t len,
+				    scan_prefix_trie_key_accept_t accept);
+
+/* Remove all the keys from the trie. */
+void scan_prefix_trie_clear(struct scan_prefix_trie *trie);
+
+#endif /* BT_SCAN_PREFIX_TRIE_H__ */
@@ -21,6 +21,15 @@ static sys_slist_t emds_dynamic_entries;
 static struct emds_fs emds_flash;
 static emds_store_cb_t app_store_cb;
 
+#if CONFIG_EMDS_PACKED_STORE
+static uint8_t packed_buf[CONFIG_EMDS_PACKED_STORE_BUF_SIZE] __aligned(4);
+static struct emds_flash_batch packed_batch;
+/* Set by emds_prepare() when the entries fit in the packed store buffer. */
+static bool packed_store;
+/* Time it took emds_prepare() to pack the entries. */
+static uint32_t packed_time_us;
+#endif
+
 static int emds_fs_init(void)
 {
 	int rc;
@@ -133,24 +142,59 @@ int emds_entry_add(struct emds_dynamic_entry *entry)
 	sys_slist_append(&emds_dynamic_entries, &entry->node);
 
 	emds_ready = false;
+#if CONFIG_EMDS_PACKED_STORE
+	packed_store = false;
+#endif
 
 	return 0;
 }
 
-int emds_store(void)
+#if CONFIG_EMDS_PACKED_STORE
+static int entries_pack(void)
 {
-	uint32_t store_key;
+	int rc;
 
-	if (!emds_ready) {
-		return -ECANCELED;
+	emds_flash_batch_init(&emds_flash, &packed_batch, packed_buf, sizeof(packed_buf));
+
+	STRUCT_SECTION_FOREACH(emds_entry, ch) {
+		rc = emds_flash_batch_add(&emds_flash, &packed_batch, ch->id, ch->data, ch->len);
+		if (rc) {
+			return rc;
+		}
 	}
 
-	/* Lock all interrupts */
-	store_key = irq_lock();
+	struct emds_dynamic_entry *ch;
 
-	/* Start the emergency data storage process. */
-	LOG_DBG("Emergency Data Storeage released");
+	SYS_SLIST_FOR_EACH_CONTAINER(&emds_dynamic_entries, ch, node) {
+		rc = emds_flash_batch_add(&emds_flash, &packed_batch, ch->entry.id,
+					  ch->entry.data, ch->entry.len);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	return 0;
+}
+
+static bool entries_packed_store(void)
+{
+	int rc;
+
+	if (!packed_store || entries_pack()) {
+		return false;
+	}
+
+	rc = emds_flash_batch_write(&emds_flash, &packed_batch);
+	if (rc) {
+		LOG_ERR("Write packed entries error (%d)", rc);
+	}
 
+	return true;
+}
+#endif
+
+static void entries_store(void)
+{
 	STRUCT_SECTION_FOREACH(emds_entry, ch) {
 		ssize_t len = emds_flash_write(&emds_flash,
 					       ch->id, ch->data, ch->len);
@@ -177,6 +221,29 @@ int emds_store(void)
 				ch->entry.id, ch->entry.len, len);
 		}
 	}
+}
+
+int emds_store(void)
+{
+	uint32_t store_key;
+
+	if (!emds_ready) {
+		return -ECANCELED;
+	}
+
+	/* Lock all interrupts */
+	store_key = irq_lock();
+
+	/* Start the emergency data storage process. */
+	LOG_DBG("Emergency Data Storeage released");
+
+#if CONFIG_EMDS_PACKED_STORE
+	if (!entries_packed_store()) {
+		entries_store();
+	}
+#else
+	entries_store();
+#endif
 
 	emds_ready = false;
 
@@ -257,6 +324,18 @@ int emds_prepare(void)
 		return rc;
 	}
 
+#if CONFIG_EMDS_PACKED_STORE
+	/* Pack the entries once, to know if they fit and how long it takes. */
+	uint32_t start = k_cycle_get_32();
+
+	packed_store = (entries_pack() == 0);
+	packed_time_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+
+	if (!packed_store) {
+		LOG_WRN("Entries do not fit in the packed store buffer, storing them one by one");
+	}
+#endif
+
 	emds_ready = true;
 
 	return 0;
@@ -267,6 +346,18 @@ uint32_t emds_store_time_get(void)
 	size_t block_size = emds_flash.flash_params->write_block_size;
 	uint32_t store_time_us = CONFIG_EMDS_FLASH_TIME_BASE_OVERHEAD_US;
 
+#if CONFIG_EMDS_PACKED_STORE
+	if (packed_store) {
+		uint32_t size;
+
+		/* The data and the allocation table entries are written in two bursts */
+		(void)emds_entries_size(&size);
+
+		return store_time_us + packed_time_us + 2 * CONFIG_EMDS_FLASH_TIME_ENTRY_OVERHEAD_US +
+		       DIV_ROUND_UP(size, block_size) * CONFIG_EMDS_FLASH_TIME_WRITE_ONE_WORD_US;
+	}
+#endif
+
 
 	STRUCT_SECTION_FOREACH(emds_entry, ch) {
 		store_time_us += DIV_ROUND_UP(ch->len, block_size) *
@@ -51,6 +51,7 @@ BUILD_ASSERT(offsetof(struct emds_ate, crc8) == sizeof(struct emds_ate) - sizeof
 	     "crc8 must be the last member");
 
 #define SOC_NV_FLASH_NODE DT_INST(0, soc_nv_flash)
+#define SOC_FLASH_CONTROLLER DT_CHOSEN(zephyr_flash_controller)
 
 #if NRF52_ERRATA_242_PRESENT
 #include <hal/nrf_power.h>
@@ -160,7 +161,12 @@ static int flash_direct_write(const struct device *dev, off_t offset, const void
 {
 	uint32_t flash_addr = offset;
 
-	ARG_UNUSED(dev);
+	/* Only the SoC flash is written directly. Other devices, such as the flash simulator,
+	 * are written through their driver.
+	 */
+	if (dev != DEVICE_DT_GET(SOC_FLASH_CONTROLLER)) {
+		return flash_write(dev, offset, data, len);
+	}
 
 	if (!is_regular_addr_valid(flash_addr, len)) {
 		return -EINVAL;
@@ -313,6 +319,73 @@ static int is_ate_valid(const struct emds_ate *entry)
 	return entry->crc8 == crc8_ccitt(0xff, entry, offsetof(struct emds_ate, crc8));
 }
 
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+/* Position of the id in the index, or of the first entry with a higher id */
+static uint16_t index_pos_find(const struct emds_fs *fs, uint16_t id)
+{
+	uint16_t low = 0;
+	uint16_t high = fs->index_cnt;
+
+	while (low < high) {
+		uint16_t mid = low + (high - low) / 2;
+
+		if (fs->index[mid].id < id) {
+			low = mid + 1;
+		} else {
+			high = mid;
+		}
+	}
+
+	return low;
+}
+
+static const struct emds_index_entry *index_find(const struct emds_fs *fs, uint16_t id)
+{
+	uint16_t pos = index_pos_find(fs, id);
+
+	if ((pos < fs->index_cnt) && (fs->index[pos].id == id)) {
+		return &fs->index[pos];
+	}
+
+	return NULL;
+}
+
+/* Entries must be added in the order they were written, so that the most recent copy of an
+ * entry replaces the older ones.
+ */
+static void index_add(struct emds_fs *fs, const struct emds_ate *entry)
+{
+	uint16_t pos = index_pos_find(fs, entry->id);
+	struct emds_index_entry *index_entry = &fs->index[pos];
+
+	if ((pos == fs->index_cnt) || (index_entry->id != entry->id)) {
+		if (fs->index_cnt == CONFIG_EMDS_FLASH_INDEX_SIZE) {
+			/* The entry is found by walking the allocation table instead */
+			fs->index_overflow = true;
+			return;
+		}
+
+		memmove(index_entry + 1, index_entry,
+			(fs->index_cnt - pos) * sizeof(struct emds_index_entry));
+		fs->index_cnt++;
+		index_entry->id = entry->id;
+	}
+
+	index_entry->offset = entry->offset;
+	index_entry->len = entry->len;
+	index_entry->crc8_data = entry->crc8_data;
+}
+
+static void index_clear(struct emds_fs *fs)
+{
+	fs->index_cnt = 0;
+	fs->index_overflow = false;
+}
+#else
+#define index_add(fs, entry)
+#define index_clear(fs)
+#endif /* CONFIG_EMDS_FLASH_INDEX_SIZE > 0 */
+
 static int entry_wrt(struct emds_fs *fs, uint16_t id, const void *data, size_t len)
 {
 	int rc;
@@ -333,6 +406,8 @@ static int entry_wrt(struct emds_fs *fs, uint16_t id, const void *data, size_t l
 		return rc;
 	}
 
+	fs->ate_rd = fs->ate_wra;
+	index_add(fs, &entry);
 	return 0;
 }
 
@@ -368,15 +443,24 @@ static int ate_last_recover(struct emds_fs *fs)
 	struct emds_ate end_ate;
 	enum ate_type type = 0;
 	uint8_t expect_field = 0xFF;
+	bool unknown_found = false;
 
 	fs->ate_wra = fs->offset + fs->sector_cnt * fs->sector_size - fs->ate_size;
 	fs->data_wra_offset = 0;
+	index_clear(fs);
+
+	/* The entries are scanned from the oldest to the most recent one */
 	while (type != ATE_TYPE_ERASED) {
 		/* Ate wra has reached the start of the data area */
 		if (fs->ate_wra < fs->offset) {
 			fs->force_erase = true;
 			fs->ate_wra = fs->offset;
 			fs->data_wra_offset = 0;
+
+			if (!unknown_found) {
+				fs->ate_rd = fs->ate_wra;
+			}
+
 			return 0;
 		}
 
@@ -389,6 +473,13 @@ static int ate_last_recover(struct emds_fs *fs)
 
 		switch (type) {
 		case ATE_TYPE_VALID:
+			/* Entries after a torn allocation table entry belong to an interrupted write
+			 * and are skipped, so that a batch is found whole or not at all.
+			 */
+			if (!unknown_found) {
+				index_add(fs, &end_ate);
+			}
+
 			fs->data_wra_offset = align_size(fs, end_ate.offset + end_ate.len);
 			fs->ate_wra -= fs->ate_size;
 			expect_field = ATE_TYPE_VALID | ATE_TYPE_ERASED;
@@ -400,7 +491,12 @@ static int ate_last_recover(struct emds_fs *fs)
 			break;
 
 		case ATE_TYPE_UNKNOWN:
+			if (!unknown_found) {
+				fs->ate_rd = fs->ate_wra;
+			}
+
 			fs->force_erase = true;
+			unknown_found = true;
 			fs->ate_wra -= fs->ate_size;
 			break;
 
@@ -411,6 +507,10 @@ static int ate_last_recover(struct emds_fs *fs)
 		}
 	}
 
+	if (!unknown_found) {
+		fs->ate_rd = fs->ate_wra;
+	}
+
 	/* Verify that flash area between ate and data pointer is writeable */
 	if (check_erased(fs, fs->offset + fs->data_wra_offset,
 			 fs->ate_wra - (fs->offset + fs->data_wra_offset) + fs->ate_size)) {
@@ -534,15 +634,110 @@ ssize_t emds_flash_write(struct emds_fs *fs, uint16_t id, const void *data, size
 	return len;
 }
 
-ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
+void emds_flash_batch_init(struct emds_fs *fs, struct emds_flash_batch *batch, uint8_t *buf,
+			   size_t size)
 {
-	if (!fs->is_initialized) {
-		LOG_ERR("EMDS flash not initialized");
+	batch->buf = buf;
+	batch->size = size & ~(fs->flash_params->write_block_size - 1U);
+	batch->data_len = 0;
+	batch->data_wra_offset = fs->data_wra_offset;
+	batch->cnt = 0;
+}
+
+int emds_flash_batch_add(struct emds_fs *fs, struct emds_flash_batch *batch, uint16_t id,
+			 const void *data, size_t len)
+{
+	size_t data_len = align_size(fs, len);
+	struct emds_ate entry;
+	uint8_t *ate;
+
+	if (len == 0) {
+		/* Nothing is written for empty entries */
+		return 0;
+	}
+
+	if (batch->data_len + data_len + (batch->cnt + 1) * fs->ate_size > batch->size) {
+		return -ENOMEM;
+	}
+
+	(void)memcpy(&batch->buf[batch->data_len], data, len);
+	(void)memset(&batch->buf[batch->data_len + len], fs->flash_params->erase_value,
+		     data_len - len);
+
+	entry.id = id;
+	entry.offset = batch->data_wra_offset + batch->data_len;
+	entry.len = (uint16_t)len;
+	entry.crc8_data = crc8_ccitt(0xff, &batch->buf[batch->data_len], len);
+	entry.crc8 = crc8_ccitt(0xff, &entry, offsetof(struct emds_ate, crc8));
+
+	/* The allocation table entries fill the buffer from its end, as they fill the flash */
+	batch->cnt++;
+	ate = &batch->buf[batch->size - batch->cnt * fs->ate_size];
+	(void)memcpy(ate, &entry, sizeof(entry));
+	(void)memset(ate + sizeof(entry), fs->flash_params->erase_value,
+		     fs->ate_size - sizeof(entry));
+
+	batch->data_len += data_len;
+
+	return 0;
+}
+
+int emds_flash_batch_write(struct emds_fs *fs, const struct emds_flash_batch *batch)
+{
+	size_t ate_len = batch->cnt * fs->ate_size;
+	int rc;
+
+	if (!fs->is_initialized || !fs->is_prepeared) {
+		LOG_ERR("EMDS flash not initialized or not ready for write");
 		return -EACCES;
 	}
 
+	if (batch->data_wra_offset != fs->data_wra_offset) {
+		return -EINVAL;
+	}
+
+	if (batch->cnt == 0) {
+		return 0;
+	}
+
+	if (batch->data_len + ate_len > emds_flash_free_space_get(fs)) {
+		return -ENOMEM;
+	}
+
+	rc = flash_direct_write(fs->flash_dev, fs->offset + fs->data_wra_offset, batch->buf,
+				batch->data_len);
+	if (rc) {
+		return rc;
+	}
+
+	fs->data_wra_offset += batch->data_len;
+
+	/* The allocation table entry of the first entry is at the highest address, so it is
+	 * written last.
+	 */
+	rc = flash_direct_write(fs->flash_dev, fs->ate_wra - ate_len + fs->ate_size,
+				&batch->buf[batch->size - ate_len], ate_len);
+	if (rc) {
+		return rc;
+	}
+
+	fs->ate_wra -= ate_len;
+	fs->ate_rd = fs->ate_wra;
+
+	for (uint16_t i = 1; i <= batch->cnt; i++) {
+		index_add(fs, (const struct emds_ate *)&batch->buf[batch->size - i * fs->ate_size]);
+	}
+
+	return 0;
+}
+
+/* Find the most recent valid entry by walking the allocation table from the last entry found
+ * by the recovery, or written since.
+ */
+static int ate_find(struct emds_fs *fs, uint16_t id, struct emds_index_entry *entry)
+{
 	int rc;
-	uint32_t wlk_addr = fs->ate_wra;
+	uint32_t wlk_addr = fs->ate_rd;
 	struct emds_ate wlk_ate;
 
 	while (true) {
@@ -561,20 +756,57 @@ ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
 		}
 	}
 
-	if (len < wlk_ate.len) {
+	entry->id = wlk_ate.id;
+	entry->offset = wlk_ate.offset;
+	entry->len = wlk_ate.len;
+	entry->crc8_data = wlk_ate.crc8_data;
+
+	return 0;
+}
+
+ssize_t emds_flash_read(struct emds_fs *fs, uint16_t id, void *data, size_t len)
+{
+	if (!fs->is_initialized) {
+		LOG_ERR("EMDS flash not initialized");
+		return -EACCES;
+	}
+
+	int rc;
+	const struct emds_index_entry *entry;
+	struct emds_index_entry wlk_entry;
+
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+	entry = index_find(fs, id);
+	if (!entry && !fs->index_overflow) {
+		return -ENXIO;
+	}
+#else
+	entry = NULL;
+#endif
+
+	if (!entry) {
+		rc = ate_find(fs, id, &wlk_entry);
+		if (rc) {
+			return rc;
+		}
+
+		entry = &wlk_entry;
+	}
+
+	if (len < entry->len) {
 		return -ENOMEM;
 	}
 
-	rc = flash_read(fs->flash_dev, fs->offset + wlk_ate.offset, data, wlk_ate.len);
+	rc = flash_read(fs->flash_dev, fs->offset + entry->offset, data, entry->len);
 	if (rc) {
 		return rc;
 	}
 
-	if (wlk_ate.crc8_data != crc8_ccitt(0xff, data, wlk_ate.len)) {
+	if (entry->crc8_data != crc8_ccitt(0xff, data, entry->len)) {
 		return -EFAULT;
 	}
 
-	return wlk_ate.len;
+	return entry->len;
 }
 
 int emds_flash_prepare(struct emds_fs *fs, int byte_size)
@@ -588,6 +820,9 @@ int emds_flash_prepare(struct emds_fs *fs, int byte_size)
 		return -ENOMEM;
 	}
 
+	/* Reads fail after this point, even if not all entries get invalidated */
+	index_clear(fs);
+
 	int rc = old_entries_invalidate(fs);
 
 	if (rc) {
@@ -15,6 +15,21 @@
 extern "C" {
 #endif
 
+/**
+ * @brief Location of the most recent valid copy of an entry in flash
+ *
+ * @param id Id of the entry
+ * @param offset Data offset from the start of the file system
+ * @param len Data length
+ * @param crc8_data crc8 check of the data
+ */
+struct emds_index_entry {
+	uint16_t id;
+	uint16_t offset;
+	uint16_t len;
+	uint8_t crc8_data;
+};
+
 /**
  * @brief Emergency data storage file system structure
  *
@@ -22,6 +37,8 @@ extern "C" {
  * @param ate_wra Allocation table entry write address. Addresses are stored as uint32_t:
  * high 2 bytes correspond to the sector, low 2 bytes are the offset in the sector
  * @param ate_size Size of allocation table entry
+ * @param ate_rd Allocation table entry address the walk for an entry starts from. Entries written
+ * after a torn allocation table entry are below it, so they are not found
  * @param data_wra_offset Data write address offset
  * @param sector_size File system is split into sectors, each sector must be multiple of pagesize
  * @param sector_cnt Number of sectors in the file systems
@@ -31,11 +48,15 @@ extern "C" {
  * @param flash_dev Pointer to flash device runtime structure
  * @param flash_params Pointer to flash memory parameters structure
  * @param force_erase Force erase flag
+ * @param index Entries found in flash, sorted by id
+ * @param index_cnt Number of entries in the index
+ * @param index_overflow Set if entries were left out of the full index
  */
 struct emds_fs {
 	off_t offset;
 	uint32_t ate_wra;
 	size_t ate_size;
+	uint32_t ate_rd;
 	uint32_t data_wra_offset;
 	uint16_t sector_size;
 	uint16_t sector_cnt;
@@ -45,6 +66,32 @@ struct emds_fs {
 	const struct device *flash_dev;
 	const struct flash_parameters *flash_params;
 	bool force_erase;
+#if CONFIG_EMDS_FLASH_INDEX_SIZE > 0
+	struct emds_index_entry index[CONFIG_EMDS_FLASH_INDEX_SIZE];
+	uint16_t index_cnt;
+	bool index_overflow;
+#endif
+};
+
+/**
+ * @brief Batch of entries written to the EMDS file system at once
+ *
+ * The entries are copied to a RAM buffer laid out as they are written to flash, with the data
+ * from the start of the buffer and the allocation table entries from its end.
+ *
+ * @param buf Buffer holding the packed entries
+ * @param size Size of the buffer, aligned to the flash write block size
+ * @param data_len Number of data bytes in the buffer
+ * @param data_wra_offset Data write address offset of the file system when the batch was
+ * initialized
+ * @param cnt Number of entries in the batch
+ */
+struct emds_flash_batch {
+	uint8_t *buf;
+	size_t size;
+	size_t data_len;
+	uint32_t data_wra_offset;
+	uint16_t cnt;
 };
 
 /**
@@ -82,10 +129,56 @@ int emds_flash_clear(struct emds_fs *fs);
  */
 ssize_t emds_flash_write(struct emds_fs *fs, uint16_t id, const void *data, size_t len);
 
+/**
+ * @brief Initialize an empty batch of entries.
+ *
+ * @param fs Pointer to file system
+ * @param batch Pointer to the batch
+ * @param buf Buffer holding the packed entries, aligned to the flash write block size
+ * @param size Size of the buffer
+ */
+void emds_flash_batch_init(struct emds_fs *fs, struct emds_flash_batch *batch, uint8_t *buf,
+			   size_t size);
+
+/**
+ * @brief Copy an entry into a batch.
+ *
+ * The data is copied, so it can change after this call without affecting the batch.
+ *
+ * @param fs Pointer to file system
+ * @param batch Pointer to the batch
+ * @param id Id of the entry
+ * @param data Pointer to the data of the entry
+ * @param len Number of bytes of data
+ *
+ * @retval 0 on success or -ENOMEM if the entry does not fit in the batch buffer
+ */
+int emds_flash_batch_add(struct emds_fs *fs, struct emds_flash_batch *batch, uint16_t id,
+			 const void *data, size_t len);
+
+/**
+ * @brief Write a batch of entries to the EMDS file system.
+ *
+ * The data of all the entries is written in a single burst, followed by a single burst of their
+ * allocation table entries in which the one of the first entry is written last. If the write is
+ * interrupted, that allocation table entry is erased or torn and none of the entries of the batch
+ * is found, so the batch is either read back whole or not at all.
+ *
+ * @note Nothing else may be written to the file system between the initialization of the batch
+ * and this call.
+ *
+ * @param fs Pointer to file system
+ * @param batch Pointer to the batch
+ *
+ * @retval 0 on success or negative error code
+ */
+int emds_flash_batch_write(struct emds_fs *fs, const struct emds_flash_batch *batch);
+
 /**
  * @brief Read an entry from the EMDS file system.
  *
- * Read an entry from the file system.
+ * Read an entry from the file system. The entry is located through the index built by
+ * @ref emds_flash_init, and through the allocation table only if it did not fit in the index.
  *
  * @param fs Pointer to file system
  * @param id Id of the entry to be read
@@ -26,6 +26,14 @@ extern "C" {
 #define NRF_RPC_OS_WAIT_FOREVER -1
 #define NRF_RPC_OS_NO_WAIT 0
 
+/* Header of a packet, as encoded by the nRF RPC core: source context ID, packet type,
+ * command or event ID, destination context ID and destination group ID.
+ */
+#define NRF_RPC_OS_PACKET_HEADER_SIZE 5
+
+/* Offset of the destination group ID, the last byte of the packet header. */
+#define NRF_RPC_OS_PACKET_GROUP_ID_OFFSET (NRF_RPC_OS_PACKET_HEADER_SIZE - 1)
+
 struct nrf_rpc_os_event {
 	struct k_sem sem;
 };
@@ -89,6 +97,27 @@ static inline void nrf_rpc_os_tls_set(void *data)
 uint32_t nrf_rpc_os_ctx_pool_reserve(void);
 void nrf_rpc_os_ctx_pool_release(uint32_t number);
 
+/* Statistics of the command context pool. */
+struct nrf_rpc_os_ctx_pool_stats {
+	/* Number of contexts reserved at the moment. */
+	uint32_t in_flight;
+	/* Maximum number of contexts reserved at the same time. */
+	uint32_t peak_in_flight;
+	/* Number of reservations. */
+	uint32_t reserve_cnt;
+	/* Number of reservations that waited for a free context. */
+	uint32_t wait_cnt;
+	/* Longest wait for a free context in microseconds. */
+	uint32_t max_wait_us;
+	/* Total time spent waiting for a free context in microseconds. */
+	uint64_t total_wait_us;
+};
+
+/* Get the statistics of the command context pool.
+ * Requires CONFIG_NRF_RPC_CMD_CTX_POOL_STATS.
+ */
+void nrf_rpc_os_ctx_pool_stats_get(struct nrf_rpc_os_ctx_pool_stats *stats);
+
 #ifdef __cplusplus
 }
 #endif
@@ -13,6 +13,7 @@
 #include <openamp/rpmsg.h>
 #endif /* CONFIG_OPENAMP */
 #include <zephyr/ipc/ipc_service.h>
+#include <zephyr/spinlock.h>
 
 #include <zephyr/logging/log.h>
 
@@ -44,6 +45,21 @@ enum {
 	NRF_RPC_IPC_STATE_ERROR
 };
 
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD)
+/* Receive buffer that is being processed by nRF RPC or held by a command handler. */
+struct rx_buf {
+	struct ipc_ept *ept;
+	const uint8_t *data;
+	size_t len;
+	/* Receive callback has not returned yet. */
+	bool active;
+	bool held;
+};
+
+static struct rx_buf rx_bufs[CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD_MAX];
+static struct k_spinlock rx_bufs_lock;
+#endif /* CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD */
+
 /* Translates error code from the lower layer to nRF RPC error code. */
 static int translate_error(int ll_err)
 {
@@ -90,6 +106,113 @@ static void ept_bound(void *priv)
 	k_event_set(&ipc_config->endpoint.ept_bond, 0x01);
 }
 
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD)
+/* Must be called with the rx_bufs_lock held. */
+static struct rx_buf *rx_buf_find(const void *data, bool held)
+{
+	const uint8_t *ptr = data;
+
+	for (size_t i = 0; i < ARRAY_SIZE(rx_bufs); i++) {
+		struct rx_buf *buf = &rx_bufs[i];
+
+		if ((buf->active || buf->held) && (buf->held == held) &&
+		    (ptr >= buf->data) && (ptr < buf->data + buf->len)) {
+			return buf;
+		}
+	}
+
+	return NULL;
+}
+
+static struct rx_buf *rx_buf_track(struct ipc_ept *ept, const void *data, size_t len)
+{
+	struct rx_buf *buf = NULL;
+	k_spinlock_key_t key = k_spin_lock(&rx_bufs_lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(rx_bufs); i++) {
+		if (!rx_bufs[i].active && !rx_bufs[i].held) {
+			buf = &rx_bufs[i];
+			buf->ept = ept;
+			buf->data = data;
+			buf->len = len;
+			buf->active = true;
+			break;
+		}
+	}
+
+	k_spin_unlock(&rx_bufs_lock, key);
+
+	if (!buf) {
+		LOG_DBG("Receive buffer not tracked, holding not possible");
+	}
+
+	return buf;
+}
+
+static void rx_buf_untrack(struct rx_buf *buf)
+{
+	k_spinlock_key_t key = k_spin_lock(&rx_bufs_lock);
+
+	/* A held buffer stays tracked until it is released. */
+	buf->active = false;
+
+	k_spin_unlock(&rx_bufs_lock, key);
+}
+
+int nrf_rpc_ipc_rx_hold(const void *data)
+{
+	struct rx_buf *buf;
+	k_spinlock_key_t key = k_spin_lock(&rx_bufs_lock);
+	int err;
+
+	buf = rx_buf_find(data, false);
+	if (!buf || !buf->active) {
+		k_spin_unlock(&rx_bufs_lock, key);
+		return -NRF_EINVAL;
+	}
+
+	/* Mark as held before unlocking, so that the buffer is not reused. */
+	buf->held = true;
+
+	k_spin_unlock(&rx_bufs_lock, key);
+
+	err = ipc_service_hold_rx_buffer(buf->ept, (void *)buf->data);
+	if (err) {
+		key = k_spin_lock(&rx_bufs_lock);
+		buf->held = false;
+		k_spin_unlock(&rx_bufs_lock, key);
+
+		return translate_error(err);
+	}
+
+	return 0;
+}
+
+int nrf_rpc_ipc_rx_release(const void *data)
+{
+	struct rx_buf *buf;
+	struct ipc_ept *ept;
+	void *buf_data;
+	k_spinlock_key_t key = k_spin_lock(&rx_bufs_lock);
+
+	buf = rx_buf_find(data, true);
+	if (!buf) {
+		k_spin_unlock(&rx_bufs_lock, key);
+		return -NRF_EINVAL;
+	}
+
+	ept = buf->ept;
+	buf_data = (void *)buf->data;
+
+	/* The receive callback might still be in progress. It frees the entry then. */
+	buf->held = false;
+
+	k_spin_unlock(&rx_bufs_lock, key);
+
+	return translate_error(ipc_service_release_rx_buffer(ept, buf_data));
+}
+#endif /* CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD */
+
 static void ept_received(const void *data, size_t len, void *priv)
 {
 	const struct nrf_rpc_tr *transport = priv;
@@ -100,7 +223,17 @@ static void ept_received(const void *data, size_t len, void *priv)
 
 	DUMP_LIMITED_DBG(data, len, "Received");
 
+#if defined(CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD)
+	struct rx_buf *buf = rx_buf_track(&ipc_config->endpoint.ept, data, len);
+
+	ipc_config->receive_cb(transport, data, len, ipc_config->context);
+
+	if (buf) {
+		rx_buf_untrack(buf);
+	}
+#else
 	ipc_config->receive_cb(transport, data, len, ipc_config->context);
+#endif
 }
 
 static void ept_error(const char *message, void *priv)
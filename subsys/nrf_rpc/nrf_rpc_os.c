@@ -8,30 +8,51 @@
 #include <nrf_rpc_log.h>
 
 #include "nrf_rpc_os.h"
-#include <zephyr/sys/math_extras.h>
 
 /* Maximum number of remote thread that this implementation allows. */
 #define MAX_REMOTE_THREADS 255
 
-/* Initial value contains ones (context free) on the
- * CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE most significant bits.
- */
-#define CONTEXT_MASK_INIT_VALUE						       \
-	(~(((atomic_val_t)1 << (8 * sizeof(atomic_val_t) -		       \
-				CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE)) - 1))
+/* Marks the end of the free context list. */
+#define CONTEXT_NONE 0xFF
+
+#define POOL_QUEUE_SIZE CONFIG_NRF_RPC_THREAD_POOL_QUEUE_SIZE
 
 struct pool_start_msg {
 	const uint8_t *data;
 	size_t len;
 };
 
+/* Bounded work queue of a thread from thread pool.
+ * Messages are always taken in the order they were put, by the owner thread or by an idle
+ * thread stealing from it, so that the packets of a group are started in the receive order.
+ */
+struct pool_queue {
+	struct pool_start_msg msgs[POOL_QUEUE_SIZE];
+	uint8_t head;
+	uint8_t count;
+	/* Free slots in the queue. */
+	struct k_sem space;
+};
+
 static nrf_rpc_os_work_t thread_pool_callback;
 
-static struct pool_start_msg pool_start_msg_buf[2];
-static struct k_msgq pool_start_msg;
+static struct pool_queue pool_queues[CONFIG_NRF_RPC_THREAD_POOL_SIZE];
+static struct k_spinlock pool_lock;
+/* Number of messages in all queues. */
+static struct k_sem pool_pending;
+static uint8_t pool_next_queue;
 
 static struct k_sem context_reserved;
-static atomic_t context_mask;
+static struct k_spinlock context_lock;
+/* Free command contexts are kept in a singly linked list. Each entry holds the number of
+ * the next free context, so that reservation and release take constant time.
+ */
+static uint8_t context_next[CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE];
+static uint8_t context_free;
+
+#if defined(CONFIG_NRF_RPC_CMD_CTX_POOL_STATS)
+static struct nrf_rpc_os_ctx_pool_stats context_stats;
+#endif
 
 static K_THREAD_STACK_ARRAY_DEFINE(pool_stacks,
 	CONFIG_NRF_RPC_THREAD_POOL_SIZE,
@@ -41,21 +62,105 @@ static struct k_thread pool_threads[CONFIG_NRF_RPC_THREAD_POOL_SIZE];
 
 BUILD_ASSERT(CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE > 0,
 	     "CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE must be greaten than zero");
-BUILD_ASSERT(CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE <= 8 * sizeof(atomic_val_t),
+BUILD_ASSERT(CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE <= MAX_REMOTE_THREADS,
 	     "CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE too big");
-BUILD_ASSERT(sizeof(uint32_t) == sizeof(atomic_val_t),
-	     "Only atomic_val_t is implemented that is the same as uint32_t");
+BUILD_ASSERT(CONFIG_NRF_RPC_THREAD_POOL_SIZE <= UINT8_MAX,
+	     "CONFIG_NRF_RPC_THREAD_POOL_SIZE too big");
+
+/* Must be called with the pool lock held. */
+static void pool_queue_push(struct pool_queue *queue, const struct pool_start_msg *msg)
+{
+	__ASSERT_NO_MSG(queue->count < POOL_QUEUE_SIZE);
+
+	queue->msgs[(queue->head + queue->count) % POOL_QUEUE_SIZE] = *msg;
+	queue->count++;
+}
+
+/* Must be called with the pool lock held. */
+static void pool_queue_pop_oldest(struct pool_queue *queue, struct pool_start_msg *msg)
+{
+	__ASSERT_NO_MSG(queue->count > 0);
+
+	*msg = queue->msgs[queue->head];
+	queue->head = (queue->head + 1) % POOL_QUEUE_SIZE;
+	queue->count--;
+}
+
+static void pool_msg_take(size_t idx, struct pool_start_msg *msg)
+{
+	struct pool_queue *queue = NULL;
+	k_spinlock_key_t key = k_spin_lock(&pool_lock);
+
+	if (pool_queues[idx].count > 0) {
+		queue = &pool_queues[idx];
+		pool_queue_pop_oldest(queue, msg);
+	} else {
+		/* Own queue is empty. Steal from the other threads. */
+		for (size_t i = 1; i < ARRAY_SIZE(pool_queues); i++) {
+			struct pool_queue *victim =
+				&pool_queues[(idx + i) % ARRAY_SIZE(pool_queues)];
+
+			if (victim->count > 0) {
+				queue = victim;
+				pool_queue_pop_oldest(queue, msg);
+				break;
+			}
+		}
+	}
+
+	k_spin_unlock(&pool_lock, key);
+
+	/* The pending semaphore guarantees that a message is available. */
+	__ASSERT_NO_MSG(queue != NULL);
+
+	k_sem_give(&queue->space);
+}
 
 static void thread_pool_entry(void *p1, void *p2, void *p3)
 {
+	size_t idx = (uintptr_t)p1;
 	struct pool_start_msg msg;
 
 	do {
-		k_msgq_get(&pool_start_msg, &msg, K_FOREVER);
+		k_sem_take(&pool_pending, K_FOREVER);
+		pool_msg_take(idx, &msg);
 		thread_pool_callback(msg.data, msg.len);
 	} while (1);
 }
 
+static struct pool_queue *pool_queue_select(const uint8_t *data, size_t len)
+{
+#if defined(CONFIG_NRF_RPC_THREAD_POOL_GROUP_AFFINITY)
+	/* Messages of a group always go to the same queue, so that a group flooding
+	 * the pool does not fill queues used by the other groups.
+	 */
+	if (len > NRF_RPC_OS_PACKET_GROUP_ID_OFFSET) {
+		uint8_t group_id = data[NRF_RPC_OS_PACKET_GROUP_ID_OFFSET];
+
+		return &pool_queues[group_id % ARRAY_SIZE(pool_queues)];
+	}
+#endif
+
+	/* Select the least loaded queue, starting from the one after the last used. */
+	struct pool_queue *queue = NULL;
+	k_spinlock_key_t key = k_spin_lock(&pool_lock);
+
+	for (size_t i = 0; i < ARRAY_SIZE(pool_queues); i++) {
+		struct pool_queue *candidate =
+			&pool_queues[(pool_next_queue + i) % ARRAY_SIZE(pool_queues)];
+
+		if (!queue || (candidate->count < queue->count)) {
+			queue = candidate;
+		}
+	}
+
+	pool_next_queue = (queue - pool_queues + 1) % ARRAY_SIZE(pool_queues);
+
+	k_spin_unlock(&pool_lock, key);
+
+	return queue;
+}
+
 int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 {
 	int err;
@@ -71,17 +176,29 @@ int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 		return err;
 	}
 
-	atomic_set(&context_mask, CONTEXT_MASK_INIT_VALUE);
+	for (i = 0; i < CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE; i++) {
+		context_next[i] = (i + 1 < CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE) ? (i + 1) : CONTEXT_NONE;
+	}
 
-	k_msgq_init(&pool_start_msg, (char *)pool_start_msg_buf,
-		    sizeof(struct pool_start_msg),
-		    ARRAY_SIZE(pool_start_msg_buf));
+	context_free = 0;
+
+	err = k_sem_init(&pool_pending, 0, K_SEM_MAX_LIMIT);
+	if (err < 0) {
+		return err;
+	}
+
+	for (i = 0; i < CONFIG_NRF_RPC_THREAD_POOL_SIZE; i++) {
+		err = k_sem_init(&pool_queues[i].space, POOL_QUEUE_SIZE, POOL_QUEUE_SIZE);
+		if (err < 0) {
+			return err;
+		}
+	}
 
 	for (i = 0; i < CONFIG_NRF_RPC_THREAD_POOL_SIZE; i++) {
 		k_thread_create(&pool_threads[i], pool_stacks[i],
 			K_THREAD_STACK_SIZEOF(pool_stacks[i]),
 			thread_pool_entry,
-			NULL, NULL, NULL,
+			(void *)(uintptr_t)i, NULL, NULL,
 			CONFIG_NRF_RPC_THREAD_PRIORITY, 0, K_NO_WAIT);
 	}
 
@@ -91,10 +208,26 @@ int nrf_rpc_os_init(nrf_rpc_os_work_t callback)
 void nrf_rpc_os_thread_pool_send(const uint8_t *data, size_t len)
 {
 	struct pool_start_msg msg;
+	struct pool_queue *queue = pool_queue_select(data, len);
+	k_spinlock_key_t key;
 
 	msg.data = data;
 	msg.len = len;
-	k_msgq_put(&pool_start_msg, &msg, K_FOREVER);
+
+	/* Only a full queue blocks the caller. Messages are taken from the queue by its
+	 * owner thread or stolen by any idle thread, so the wait ends as soon as any
+	 * thread from the pool is available.
+	 */
+	if (k_sem_take(&queue->space, K_NO_WAIT) < 0) {
+		NRF_RPC_DBG("Thread pool queue %u full", (unsigned int)(queue - pool_queues));
+		k_sem_take(&queue->space, K_FOREVER);
+	}
+
+	key = k_spin_lock(&pool_lock);
+	pool_queue_push(queue, &msg);
+	k_spin_unlock(&pool_lock, key);
+
+	k_sem_give(&pool_pending);
 }
 
 void nrf_rpc_os_msg_set(struct nrf_rpc_os_msg *msg, const uint8_t *data,
@@ -117,34 +250,85 @@ void nrf_rpc_os_msg_get(struct nrf_rpc_os_msg *msg, const uint8_t **data,
 	k_sched_unlock();
 }
 
+#if defined(CONFIG_NRF_RPC_CMD_CTX_POOL_STATS)
+static void context_stats_wait_update(int64_t wait_ticks)
+{
+	uint32_t wait_us = k_ticks_to_us_ceil32(wait_ticks);
+	k_spinlock_key_t key = k_spin_lock(&context_lock);
+
+	context_stats.wait_cnt++;
+	context_stats.total_wait_us += wait_us;
+	context_stats.max_wait_us = MAX(context_stats.max_wait_us, wait_us);
+
+	k_spin_unlock(&context_lock, key);
+}
+
+void nrf_rpc_os_ctx_pool_stats_get(struct nrf_rpc_os_ctx_pool_stats *stats)
+{
+	k_spinlock_key_t key = k_spin_lock(&context_lock);
+
+	*stats = context_stats;
+
+	k_spin_unlock(&context_lock, key);
+}
+#endif /* CONFIG_NRF_RPC_CMD_CTX_POOL_STATS */
+
 uint32_t nrf_rpc_os_ctx_pool_reserve(void)
 {
 	uint32_t number;
-	atomic_val_t old_mask;
-	atomic_val_t new_mask;
+	k_spinlock_key_t key;
 
-	k_sem_take(&context_reserved, K_FOREVER);
+	if (k_sem_take(&context_reserved, K_NO_WAIT) < 0) {
+#if defined(CONFIG_NRF_RPC_CMD_CTX_POOL_STATS)
+		int64_t start = k_uptime_ticks();
 
-	do {
-		old_mask = atomic_get(&context_mask);
-		number = u32_count_leading_zeros(old_mask);
+		k_sem_take(&context_reserved, K_FOREVER);
+		context_stats_wait_update(k_uptime_ticks() - start);
+#else
+		k_sem_take(&context_reserved, K_FOREVER);
+#endif
+	}
+
+	key = k_spin_lock(&context_lock);
+
+	number = context_free;
 
-		/* Coverity issue: 112515
-		 * This should never happen because if there is no context available,
-		 * the function waits for it.
-		 */
-		__ASSERT_NO_MSG(number < CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE);
+	/* This should never happen because if there is no context available,
+	 * the function waits for it.
+	 */
+	__ASSERT_NO_MSG(number < CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE);
+
+	context_free = context_next[number];
 
-		new_mask = old_mask & ~(0x80000000u >> number);
-	} while (!atomic_cas(&context_mask, old_mask, new_mask));
+#if defined(CONFIG_NRF_RPC_CMD_CTX_POOL_STATS)
+	context_stats.reserve_cnt++;
+	context_stats.in_flight++;
+	context_stats.peak_in_flight = MAX(context_stats.peak_in_flight,
+					   context_stats.in_flight);
+#endif
+
+	k_spin_unlock(&context_lock, key);
 
 	return number;
 }
 
 void nrf_rpc_os_ctx_pool_release(uint32_t number)
 {
+	k_spinlock_key_t key;
+
 	__ASSERT_NO_MSG(number < CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE);
 
-	atomic_or(&context_mask, 0x80000000u >> number);
+	key = k_spin_lock(&context_lock);
+
+	context_next[number] = context_free;
+	context_free = number;
+
+#if defined(CONFIG_NRF_RPC_CMD_CTX_POOL_STATS)
+	__ASSERT_NO_MSG(context_stats.in_flight > 0);
+	context_stats.in_flight--;
+#endif
+
+	k_spin_unlock(&context_lock, key);
+
 	k_sem_give(&context_reserved);
 }
@@ -94,6 +94,49 @@ void nrf_rpc_encode_buffer(struct nrf_rpc_cbor_ctx *ctx, const void *data, size_
 	}
 }
 
+void nrf_rpc_encode_buffer_frags(struct nrf_rpc_cbor_ctx *ctx,
+				 const struct nrf_rpc_buffer_frag *frags, size_t frag_cnt)
+{
+	uint8_t *data;
+	size_t offset = 0;
+	size_t size = 0;
+
+	if (is_encoder_invalid(ctx)) {
+		return;
+	}
+
+	if (!frags) {
+		zcbor_nil_put(ctx->zs, NULL);
+		return;
+	}
+
+	for (size_t i = 0; i < frag_cnt; i++) {
+		size += frags[i].size;
+	}
+
+	if (size > (size_t)(ctx->zs->payload_end - ctx->zs->payload)) {
+		set_encoder_invalid(ctx, ZCBOR_ERR_NO_PAYLOAD);
+		return;
+	}
+
+	/* Gather the fragments at the end of the free space. zcbor then writes the header and
+	 * moves the data right behind it, as it does for strings built in place.
+	 */
+	data = (uint8_t *)ctx->zs->payload_end - size;
+
+	for (size_t i = 0; i < frag_cnt; i++) {
+		if (frags[i].data) {
+			memcpy(&data[offset], frags[i].data, frags[i].size);
+		} else {
+			memset(&data[offset], 0, frags[i].size);
+		}
+
+		offset += frags[i].size;
+	}
+
+	zcbor_bstr_encode_ptr(ctx->zs, (const void *)data, size);
+}
+
 void nrf_rpc_encode_callback(struct nrf_rpc_cbor_ctx *ctx, void *callback)
 {
 	int slot;
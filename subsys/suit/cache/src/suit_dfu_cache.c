@@ -21,6 +21,34 @@ LOG_MODULE_REGISTER(dfu_cache, CONFIG_SUIT_LOG_LEVEL);
 static bool init_done;
 struct dfu_cache dfu_cache;
 
+#if CONFIG_SUIT_CACHE_DIRECTORY_SIZE > 0
+#define DIRECTORY_SLOT_COUNT (2 * CONFIG_SUIT_CACHE_DIRECTORY_SIZE)
+
+#define FNV_OFFSET_BASIS 2166136261U
+#define FNV_PRIME	 16777619U
+
+/* Location of a single cache slot, found when the cache pools are scanned. */
+struct directory_entry {
+	uint32_t uri_hash;
+	size_t uri_len;
+	uintptr_t uri_address;
+	uintptr_t payload_offset;
+	size_t payload_size;
+};
+
+/* Directory of the cache slots of all pools, in the order in which they are searched.
+ * The entries are indexed by the hash of their URI in an open addressing table, which holds
+ * the index of an entry plus one, or 0 if empty.
+ */
+static struct {
+	struct directory_entry entries[CONFIG_SUIT_CACHE_DIRECTORY_SIZE];
+	uint16_t slots[DIRECTORY_SLOT_COUNT];
+	size_t count;
+	bool valid;
+	bool overflow;
+} directory;
+#endif /* CONFIG_SUIT_CACHE_DIRECTORY_SIZE > 0 */
+
 /**
  * @brief Check if current_key is same as uri
  *
@@ -59,8 +87,8 @@ struct match_uri_ctx {
  * @brief Foreach callback for matching.
  */
 static bool match_uri(struct dfu_cache_pool *cache_pool, zcbor_state_t *state,
-		      const struct zcbor_string *uri, uintptr_t payload_offset, size_t payload_size,
-		      void *ctx)
+		      const struct zcbor_string *uri, uintptr_t uri_address, uintptr_t payload_offset,
+		      size_t payload_size, void *ctx)
 {
 	struct match_uri_ctx *cb_ctx = ctx;
 
@@ -112,6 +140,143 @@ static suit_plat_err_t search_cache_pool(struct dfu_cache_pool *cache_pool,
 	return SUIT_PLAT_ERR_INVAL;
 }
 
+#if CONFIG_SUIT_CACHE_DIRECTORY_SIZE > 0
+static uint32_t uri_hash(const uint8_t *uri, size_t uri_len)
+{
+	uint32_t hash = FNV_OFFSET_BASIS;
+
+	for (size_t i = 0; i < uri_len; i++) {
+		hash = (hash ^ uri[i]) * FNV_PRIME;
+	}
+
+	return hash;
+}
+
+/**
+ * @brief Foreach callback for adding the slots to the directory.
+ */
+static bool directory_add(struct dfu_cache_pool *cache_pool, zcbor_state_t *state,
+			  const struct zcbor_string *uri, uintptr_t uri_address,
+			  uintptr_t payload_offset, size_t payload_size, void *ctx)
+{
+	struct directory_entry *entry;
+	size_t i;
+
+	if (uri->len == 0) {
+		/* Padding between the slots, never looked up through the directory. */
+		return true;
+	}
+
+	if (directory.count >= ARRAY_SIZE(directory.entries)) {
+		directory.overflow = true;
+		return false;
+	}
+
+	entry = &directory.entries[directory.count];
+	entry->uri_hash = uri_hash(uri->value, uri->len);
+	entry->uri_len = uri->len;
+	entry->uri_address = uri_address;
+	entry->payload_offset = payload_offset;
+	entry->payload_size = payload_size;
+
+	/* The slots are never removed from the table and it is at most half full, so an entry
+	 * lands after all the earlier entries with the same hash and the probing always ends.
+	 */
+	i = entry->uri_hash % DIRECTORY_SLOT_COUNT;
+	while (directory.slots[i] != 0) {
+		i = (i + 1) % DIRECTORY_SLOT_COUNT;
+	}
+
+	directory.slots[i] = ++directory.count;
+
+	return true;
+}
+
+/**
+ * @brief Scan all cache pools and add their slots to the directory.
+ */
+static void directory_build(void)
+{
+	memset(directory.slots, 0, sizeof(directory.slots));
+	directory.count = 0;
+	directory.overflow = false;
+
+	for (size_t i = 0; i < dfu_cache.pools_count; i++) {
+		if (dfu_cache.pools[i].address == NULL) {
+			continue;
+		}
+
+		/* As in the search, the slots past a decoding error are not reachable. */
+		(void)suit_dfu_cache_partition_slot_foreach(&dfu_cache.pools[i], directory_add,
+							    NULL);
+	}
+
+	directory.valid = true;
+}
+
+/**
+ * @brief Check if the URI of a directory entry is equal to uri
+ */
+static bool directory_uri_match(const struct directory_entry *entry, const uint8_t *uri,
+				size_t uri_len)
+{
+	uint8_t buf[32];
+
+	if (entry->uri_len != uri_len) {
+		return false;
+	}
+
+	for (size_t offset = 0; offset < uri_len; offset += sizeof(buf)) {
+		size_t len = MIN(sizeof(buf), uri_len - offset);
+
+		if ((suit_dfu_cache_memcpy(buf, entry->uri_address + offset, len) !=
+		     SUIT_PLAT_SUCCESS) ||
+		    (memcmp(buf, &uri[offset], len) != 0)) {
+			return false;
+		}
+	}
+
+	return true;
+}
+
+/**
+ * @brief Look up the first slot with key equal to uri in the directory
+ *
+ * @param uri Desired URI, without the null terminator
+ * @param uri_len URI length
+ * @param payload Output pointer to data in slot
+ * @return suit_plat_err_t SUIT_PLAT_SUCCESS in case of success, otherwise error code
+ */
+static suit_plat_err_t directory_search(const uint8_t *uri, size_t uri_len,
+					struct zcbor_string *payload)
+{
+	uint32_t hash = uri_hash(uri, uri_len);
+	size_t i = hash % DIRECTORY_SLOT_COUNT;
+
+	while (directory.slots[i] != 0) {
+		const struct directory_entry *entry = &directory.entries[directory.slots[i] - 1];
+
+		if ((entry->uri_hash == hash) && directory_uri_match(entry, uri, uri_len)) {
+			payload->value = (uint8_t *)entry->payload_offset;
+			payload->len = entry->payload_size;
+
+			return SUIT_PLAT_SUCCESS;
+		}
+
+		i = (i + 1) % DIRECTORY_SLOT_COUNT;
+	}
+
+	return SUIT_PLAT_ERR_NOT_FOUND;
+}
+#endif /* CONFIG_SUIT_CACHE_DIRECTORY_SIZE > 0 */
+
+void suit_dfu_cache_directory_invalidate(void)
+{
+#if CONFIG_SUIT_CACHE_DIRECTORY_SIZE > 0
+	directory.valid = false;
+#endif
+}
+
 suit_plat_err_t suit_dfu_cache_search(const uint8_t *uri, size_t uri_size, const uint8_t **payload,
 				      size_t *payload_size)
 {
@@ -119,6 +284,31 @@ suit_plat_err_t suit_dfu_cache_search(const uint8_t *uri, size_t uri_size, const
 		struct zcbor_string tmp_payload = {.len = 0, .value = NULL};
 		struct zcbor_string tmp_uri = {.len = uri_size, .value = uri};
 
+#if CONFIG_SUIT_CACHE_DIRECTORY_SIZE > 0
+		/* Null terminated strings are matched without the terminator. */
+		size_t uri_len = (uri[uri_size - 1] == '\0') ? (uri_size - 1) : uri_size;
+
+		if (init_done && (uri_size <= CONFIG_SUIT_MAX_URI_LENGTH) && (uri_len > 0)) {
+			if (!directory.valid) {
+				directory_build();
+			}
+
+			suit_plat_err_t ret = directory_search(uri, uri_len, &tmp_payload);
+
+			if (ret == SUIT_PLAT_SUCCESS) {
+				*payload = tmp_payload.value;
+				*payload_size = tmp_payload.len;
+			}
+
+			/* Slots that did not fit in the directory are found by scanning the
+			 * cache pools.
+			 */
+			if ((ret == SUIT_PLAT_SUCCESS) || !directory.overflow) {
+				return ret;
+			}
+		}
+#endif
+
 		for (size_t i = 0; i < dfu_cache.pools_count; i++) {
 			suit_plat_err_t ret =
 				search_cache_pool(&dfu_cache.pools[i], &tmp_uri, &tmp_payload);
@@ -188,6 +378,10 @@ suit_plat_err_t suit_dfu_cache_initialize(struct dfu_cache *cache)
 		return ret;
 	}
 
+#if CONFIG_SUIT_CACHE_DIRECTORY_SIZE > 0
+	directory_build();
+#endif
+
 	init_done = true;
 
 	return SUIT_PLAT_SUCCESS;
@@ -196,5 +390,6 @@ suit_plat_err_t suit_dfu_cache_initialize(struct dfu_cache *cache)
 void suit_dfu_cache_deinitialize(void)
 {
 	suit_dfu_cache_clear(&dfu_cache);
+	suit_dfu_cache_directory_invalidate();
 	init_done = false;
 }
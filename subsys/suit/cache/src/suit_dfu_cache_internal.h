@@ -29,6 +29,8 @@ extern "C" {
  * @param cache_pool  Pointer to the SUIT cache pool structure.
  * @param state  zcbor state of the current slot.
  * @param uri  URI of the current slot
+ * @param uri_address  Address of the URI of the current slot. May be located in external storage
+ *                     area.
  * @param payload_offset  Offset of the payload. May be located in external storage area.
  * @param payload_size  Size of the payload.
  * @param ctx  Additional callback context.
@@ -36,8 +38,8 @@ extern "C" {
  * @return True continues iteration, false causes the caller to stop subsequent iterations.
  */
 typedef bool (*partition_slot_foreach_cb)(struct dfu_cache_pool *cache_pool, zcbor_state_t *state,
-					  const struct zcbor_string *uri, uintptr_t payload_offset,
-					  size_t payload_size, void *ctx);
+					  const struct zcbor_string *uri, uintptr_t uri_address,
+					  uintptr_t payload_offset, size_t payload_size, void *ctx);
 
 /**
  * @brief Iterates over cache slots and executes a provided callback.
@@ -101,6 +103,14 @@ suit_plat_err_t suit_dfu_cache_partition_find_free_space(struct dfu_cache_pool *
  */
 suit_plat_err_t suit_dfu_cache_memcpy(uint8_t *destination, uintptr_t source, size_t size);
 
+/**
+ * @brief Invalidate the directory of cache slots.
+ *
+ * Must be called whenever a slot is added to or removed from a cache partition. The directory
+ * is rebuilt by the next search.
+ */
+void suit_dfu_cache_directory_invalidate(void);
+
 #ifdef __cplusplus
 }
 #endif
@@ -656,6 +656,9 @@ suit_plat_err_t suit_dfu_cache_rw_slot_close(struct suit_cache_slot *slot, size_
 		size_t tmp_size = sizeof(uint32_t);
 		size_t end_address = (size_t)slot->slot_address + slot->data_offset + size_used;
 
+		/* The slot is added to the directory when it is rebuilt by the next search */
+		suit_dfu_cache_directory_invalidate();
+
 		/* Update byte string size */
 		if (write_to_sink(slot->slot_address + slot->size_offset, (uint8_t *)&tmp,
 				  tmp_size) != SUIT_PLAT_SUCCESS) {
@@ -789,6 +792,8 @@ suit_plat_err_t suit_dfu_cache_rw_slot_drop(struct suit_cache_slot *slot)
 			add_map_header = true;
 		}
 
+		suit_dfu_cache_directory_invalidate();
+
 		ret = erase_on_sink(erase_address, erase_size);
 		if (ret != SUIT_PLAT_SUCCESS) {
 			LOG_ERR("Erasing cache failed: %i", ret);
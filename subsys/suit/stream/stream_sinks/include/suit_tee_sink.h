@@ -0,0 +1,40 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef TEE_SINK_H__
+#define TEE_SINK_H__
+
+#include <suit_sink.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Get the tee_sink object
+ *
+ * @details The data written to the tee sink is written to the first and then to the second sink,
+ *	    so that for example a payload is written and its digest is calculated in a single pass.
+ *	    Erase and flush are passed to the sinks supporting them. Seek is supported only if
+ *	    both sinks support it. The used storage is the one of the first sink.
+ *	    The SUIT platform copies a payload and checks its digest in separate commands, so the
+ *	    tee sink is not used by it.
+ *
+ * @note Releasing the tee sink does not release the first and the second sink.
+ *
+ * @param[in] sink Pointer to sink_stream to be filled
+ * @param[in] first Sink the data is written to first
+ * @param[in] second Sink the data is written to next
+ * @return SUIT_PLAT_SUCCESS if success, error code otherwise
+ */
+suit_plat_err_t suit_tee_sink_get(struct stream_sink *sink, struct stream_sink *first,
+				  struct stream_sink *second);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* TEE_SINK_H__ */
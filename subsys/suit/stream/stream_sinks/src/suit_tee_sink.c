@@ -0,0 +1,183 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/logging/log.h>
+
+#include <suit_tee_sink.h>
+
+LOG_MODULE_REGISTER(suit_tee_sink, CONFIG_SUIT_LOG_LEVEL);
+
+struct tee_sink_context {
+	bool in_use;
+	struct stream_sink *first;
+	struct stream_sink *second;
+};
+
+static struct tee_sink_context tee_contexts[CONFIG_SUIT_STREAM_SINK_TEE_CONTEXT_COUNT];
+
+static struct tee_sink_context *get_new_context(void)
+{
+	for (size_t i = 0; i < CONFIG_SUIT_STREAM_SINK_TEE_CONTEXT_COUNT; ++i) {
+		if (!tee_contexts[i].in_use) {
+			return &tee_contexts[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct tee_sink_context *get_context(void *ctx)
+{
+	struct tee_sink_context *tee_ctx = (struct tee_sink_context *)ctx;
+
+	if (tee_ctx == NULL) {
+		LOG_ERR("Invalid argument");
+		return NULL;
+	}
+
+	if (!tee_ctx->in_use) {
+		LOG_ERR("Using uninitialized sink");
+		return NULL;
+	}
+
+	return tee_ctx;
+}
+
+static suit_plat_err_t erase(void *ctx)
+{
+	struct tee_sink_context *tee_ctx = get_context(ctx);
+	suit_plat_err_t ret = SUIT_PLAT_SUCCESS;
+
+	if (tee_ctx == NULL) {
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	if (tee_ctx->first->erase != NULL) {
+		ret = tee_ctx->first->erase(tee_ctx->first->ctx);
+	}
+
+	if ((ret == SUIT_PLAT_SUCCESS) && (tee_ctx->second->erase != NULL)) {
+		ret = tee_ctx->second->erase(tee_ctx->second->ctx);
+	}
+
+	return ret;
+}
+
+static suit_plat_err_t write(void *ctx, const uint8_t *buf, size_t size)
+{
+	struct tee_sink_context *tee_ctx = get_context(ctx);
+
+	if (tee_ctx == NULL) {
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	suit_plat_err_t ret = tee_ctx->first->write(tee_ctx->first->ctx, buf, size);
+
+	if (ret != SUIT_PLAT_SUCCESS) {
+		LOG_ERR("Failed to write to the first sink: %d", ret);
+		return ret;
+	}
+
+	ret = tee_ctx->second->write(tee_ctx->second->ctx, buf, size);
+	if (ret != SUIT_PLAT_SUCCESS) {
+		LOG_ERR("Failed to write to the second sink: %d", ret);
+	}
+
+	return ret;
+}
+
+static suit_plat_err_t seek(void *ctx, size_t offset)
+{
+	struct tee_sink_context *tee_ctx = get_context(ctx);
+
+	if (tee_ctx == NULL) {
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	suit_plat_err_t ret = tee_ctx->first->seek(tee_ctx->first->ctx, offset);
+
+	if (ret == SUIT_PLAT_SUCCESS) {
+		ret = tee_ctx->second->seek(tee_ctx->second->ctx, offset);
+	}
+
+	return ret;
+}
+
+static suit_plat_err_t flush(void *ctx)
+{
+	struct tee_sink_context *tee_ctx = get_context(ctx);
+	suit_plat_err_t ret = SUIT_PLAT_SUCCESS;
+
+	if (tee_ctx == NULL) {
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	if (tee_ctx->first->flush != NULL) {
+		ret = tee_ctx->first->flush(tee_ctx->first->ctx);
+	}
+
+	if ((ret == SUIT_PLAT_SUCCESS) && (tee_ctx->second->flush != NULL)) {
+		ret = tee_ctx->second->flush(tee_ctx->second->ctx);
+	}
+
+	return ret;
+}
+
+static suit_plat_err_t used_storage(void *ctx, size_t *size)
+{
+	struct tee_sink_context *tee_ctx = get_context(ctx);
+
+	if (tee_ctx == NULL) {
+		return SUIT_PLAT_ERR_INCORRECT_STATE;
+	}
+
+	return tee_ctx->first->used_storage(tee_ctx->first->ctx, size);
+}
+
+static suit_plat_err_t release(void *ctx)
+{
+	if (ctx == NULL) {
+		LOG_ERR("Invalid argument");
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	struct tee_sink_context *tee_ctx = (struct tee_sink_context *)ctx;
+
+	memset(tee_ctx, 0, sizeof(struct tee_sink_context));
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+suit_plat_err_t suit_tee_sink_get(struct stream_sink *sink, struct stream_sink *first,
+				  struct stream_sink *second)
+{
+	if ((sink == NULL) || (first == NULL) || (second == NULL) || (first->write == NULL) ||
+	    (second->write == NULL)) {
+		LOG_ERR("Invalid argument");
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	struct tee_sink_context *tee_ctx = get_new_context();
+
+	if (tee_ctx == NULL) {
+		LOG_ERR("Failed to get a new context");
+		return SUIT_PLAT_ERR_NO_RESOURCES;
+	}
+
+	tee_ctx->in_use = true;
+	tee_ctx->first = first;
+	tee_ctx->second = second;
+
+	sink->erase = erase;
+	sink->write = write;
+	sink->seek = ((first->seek != NULL) && (second->seek != NULL)) ? seek : NULL;
+	sink->flush = flush;
+	sink->used_storage = (first->used_storage != NULL) ? used_storage : NULL;
+	sink->release = release;
+	sink->ctx = tee_ctx;
+
+	return SUIT_PLAT_SUCCESS;
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef CHUNKED_STREAMER_H__
+#define CHUNKED_STREAMER_H__
+
+#include <suit_sink.h>
+#include <zephyr/sys/util.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief Size of the buffer needed to stream a payload in chunks of a given size.
+ *
+ * With CONFIG_SUIT_STREAM_PIPELINE the buffer holds two chunks: one is written to the sink while
+ * the next one is read into the other.
+ */
+#define SUIT_CHUNKED_STREAMER_BUF_SIZE(chunk_size)                                                 \
+	((chunk_size) * (IS_ENABLED(CONFIG_SUIT_STREAM_PIPELINE) ? 2 : 1))
+
+/**
+ * @brief Read a chunk of a payload.
+ *
+ * @param ctx Context of the source
+ * @param offset Offset of the chunk in the payload
+ * @param buf Buffer to read the chunk into
+ * @param size Size of the chunk
+ *
+ * @return SUIT_PLAT_SUCCESS if success otherwise error code
+ */
+typedef suit_plat_err_t (*suit_chunked_streamer_read_t)(void *ctx, size_t offset, uint8_t *buf,
+							size_t size);
+
+/**
+ * @brief Stream a payload, read in chunks, to sink
+ *
+ * With CONFIG_SUIT_STREAM_PIPELINE the chunks are read by the pipeline thread, so the next chunk
+ * is read while the sink consumes the current one. If the pipeline thread is busy streaming
+ * another payload, the chunks are read and written one after the other.
+ *
+ * @param read Function reading a chunk of the payload
+ * @param read_ctx Context passed to @p read
+ * @param payload_size Size of the payload
+ * @param buf Buffer of SUIT_CHUNKED_STREAMER_BUF_SIZE(@p chunk_size) bytes
+ * @param chunk_size Size of a chunk
+ * @param sink Pointer to sink to write the data to
+ *
+ * @return SUIT_PLAT_SUCCESS if success otherwise error code
+ */
+suit_plat_err_t suit_chunked_streamer_stream(suit_chunked_streamer_read_t read, void *read_ctx,
+					     size_t payload_size, uint8_t *buf, size_t chunk_size,
+					     struct stream_sink *sink);
+
+/**
+ * @brief Stream a payload, read in chunks, to sink, without the pipeline
+ *
+ * The chunks are read and written one after the other, in the calling thread. Used when the
+ * buffer for the pipeline is not available, for example to stream a payload from a sink.
+ *
+ * @param read Function reading a chunk of the payload
+ * @param read_ctx Context passed to @p read
+ * @param payload_size Size of the payload
+ * @param buf Buffer of @p chunk_size bytes
+ * @param chunk_size Size of a chunk
+ * @param sink Pointer to sink to write the data to
+ *
+ * @return SUIT_PLAT_SUCCESS if success otherwise error code
+ */
+suit_plat_err_t suit_chunked_streamer_stream_sequential(suit_chunked_streamer_read_t read,
+							void *read_ctx, size_t payload_size,
+							uint8_t *buf, size_t chunk_size,
+							struct stream_sink *sink);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* CHUNKED_STREAMER_H__ */
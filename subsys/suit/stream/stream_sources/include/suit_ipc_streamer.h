@@ -91,6 +91,43 @@ typedef struct {
 
 } suit_ipc_streamer_chunk_info_t;
 
+/**
+ * @brief Statistics of an image stream, collected by streamer requestor.
+ *
+ * @var	chunk_count		Number of chunks written to sink
+ *
+ * @var	byte_count		Number of bytes written to sink
+ *
+ * @var	chunk_latency_total_us	Sum of the time from chunk arrival until chunk is written to sink
+ *
+ * @var	chunk_latency_max_us	Longest time from chunk arrival until chunk is written to sink
+ *
+ * @var	stall_us		Time the sink waited for the next chunk after the first response of
+ *				streamer provider
+ *
+ * @var	chunks_in_flight_max	Largest number of chunks enqueued and not yet written to sink
+ */
+typedef struct {
+	uint32_t chunk_count;
+	uint32_t byte_count;
+	uint64_t chunk_latency_total_us;
+	uint32_t chunk_latency_max_us;
+	uint64_t stall_us;
+	uint32_t chunks_in_flight_max;
+} suit_ipc_streamer_stats_t;
+
+/**
+ * @brief Returns statistics of the current or last image stream. Implemented by streamer
+ *requestor only. A long stall time means that streamer provider does not deliver chunks as fast as
+ *the sink processes them, a long chunk latency means that the sink is the bottleneck.
+ *
+ * @param[out]  stats			Statistics of the image stream
+ *
+ * @retval SUIT_PLAT_SUCCESS on success
+ * @retval SUIT_PLAT_ERR_INVAL invalid parameter, i.e. null pointer
+ */
+suit_plat_err_t suit_ipc_streamer_stats_get(suit_ipc_streamer_stats_t *stats);
+
 /**
  * @brief Enqueues image chunk for future processing. Implemented by streamer requestor and exposed
  *as streamer requestor proxy to local Domain MCU. Attention! Return code SUIT_PLAT_ERR_BUSY
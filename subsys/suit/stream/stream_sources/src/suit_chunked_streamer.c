@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/logging/log.h>
+#include <suit_chunked_streamer.h>
+
+LOG_MODULE_REGISTER(suit_chunked_streamer, CONFIG_SUIT_LOG_LEVEL);
+
+static bool stream_args_valid(suit_chunked_streamer_read_t read, size_t payload_size,
+			      const uint8_t *buf, size_t chunk_size, const struct stream_sink *sink)
+{
+	return (read != NULL) && (buf != NULL) && (chunk_size != 0) && (sink != NULL) &&
+	       (sink->write != NULL) && (payload_size != 0);
+}
+
+static suit_plat_err_t sequential_stream(suit_chunked_streamer_read_t read, void *read_ctx,
+					 size_t payload_size, uint8_t *buf, size_t chunk_size,
+					 struct stream_sink *sink)
+{
+	size_t offset = 0;
+
+	while (offset < payload_size) {
+		size_t size = MIN(payload_size - offset, chunk_size);
+		suit_plat_err_t ret = read(read_ctx, offset, buf, size);
+
+		if (ret != SUIT_PLAT_SUCCESS) {
+			return ret;
+		}
+
+		ret = sink->write(sink->ctx, buf, size);
+		if (ret != SUIT_PLAT_SUCCESS) {
+			return ret;
+		}
+
+		offset += size;
+	}
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+#ifdef CONFIG_SUIT_STREAM_PIPELINE
+
+/* Chunk requested from the pipeline thread. */
+static struct {
+	suit_chunked_streamer_read_t read;
+	void *read_ctx;
+	size_t offset;
+	uint8_t *buf;
+	size_t size;
+	suit_plat_err_t result;
+} request;
+
+static atomic_t pipeline_busy;
+static K_SEM_DEFINE(request_sem, 0, 1);
+static K_SEM_DEFINE(done_sem, 0, 1);
+
+static void pipeline_thread(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		k_sem_take(&request_sem, K_FOREVER);
+		request.result = request.read(request.read_ctx, request.offset, request.buf,
+					      request.size);
+		k_sem_give(&done_sem);
+	}
+}
+
+K_THREAD_DEFINE(suit_stream_pipeline, CONFIG_SUIT_STREAM_PIPELINE_STACK_SIZE, pipeline_thread,
+		NULL, NULL, NULL, CONFIG_SUIT_STREAM_PIPELINE_THREAD_PRIORITY, 0, 0);
+
+static void read_request(size_t offset, uint8_t *buf, size_t size)
+{
+	request.offset = offset;
+	request.buf = buf;
+	request.size = size;
+	k_sem_give(&request_sem);
+}
+
+static suit_plat_err_t pipelined_stream(size_t payload_size, uint8_t *buf, size_t chunk_size,
+					struct stream_sink *sink)
+{
+	size_t offset = 0;
+	size_t size = MIN(payload_size, chunk_size);
+	uint8_t *current = buf;
+	uint8_t *next = buf + chunk_size;
+
+	read_request(offset, current, size);
+
+	while (true) {
+		k_sem_take(&done_sem, K_FOREVER);
+		if (request.result != SUIT_PLAT_SUCCESS) {
+			return request.result;
+		}
+
+		size_t next_offset = offset + size;
+		size_t next_size = MIN(payload_size - next_offset, chunk_size);
+
+		if (next_size > 0) {
+			read_request(next_offset, next, next_size);
+		}
+
+		suit_plat_err_t ret = sink->write(sink->ctx, current, size);
+
+		if (ret != SUIT_PLAT_SUCCESS) {
+			if (next_size > 0) {
+				/* The buffer may not be reused before the read is complete. */
+				k_sem_take(&done_sem, K_FOREVER);
+			}
+
+			return ret;
+		}
+
+		if (next_size == 0) {
+			return SUIT_PLAT_SUCCESS;
+		}
+
+		uint8_t *written = current;
+
+		current = next;
+		next = written;
+		offset = next_offset;
+		size = next_size;
+	}
+}
+
+#endif /* CONFIG_SUIT_STREAM_PIPELINE */
+
+suit_plat_err_t suit_chunked_streamer_stream(suit_chunked_streamer_read_t read, void *read_ctx,
+					     size_t payload_size, uint8_t *buf, size_t chunk_size,
+					     struct stream_sink *sink)
+{
+	if (!stream_args_valid(read, payload_size, buf, chunk_size, sink)) {
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+#ifdef CONFIG_SUIT_STREAM_PIPELINE
+	/* A sink may stream another payload, in which case its chunks are not pipelined. */
+	if (atomic_cas(&pipeline_busy, 0, 1)) {
+		request.read = read;
+		request.read_ctx = read_ctx;
+
+		suit_plat_err_t ret = pipelined_stream(payload_size, buf, chunk_size, sink);
+
+		atomic_clear(&pipeline_busy);
+
+		if (ret != SUIT_PLAT_SUCCESS) {
+			LOG_ERR("Pipelined streaming failed: %d", ret);
+		}
+
+		return ret;
+	}
+#endif /* CONFIG_SUIT_STREAM_PIPELINE */
+
+	return sequential_stream(read, read_ctx, payload_size, buf, chunk_size, sink);
+}
+
+suit_plat_err_t suit_chunked_streamer_stream_sequential(suit_chunked_streamer_read_t read,
+							void *read_ctx, size_t payload_size,
+							uint8_t *buf, size_t chunk_size,
+							struct stream_sink *sink)
+{
+	if (!stream_args_valid(read, payload_size, buf, chunk_size, sink)) {
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	return sequential_stream(read, read_ctx, payload_size, buf, chunk_size, sink);
+}
@@ -6,36 +6,71 @@
 
 #include <suit_memptr_streamer.h>
 #include <zephyr/logging/log.h>
+#include <zephyr/sys/atomic.h>
 #include <zephyr/drivers/flash.h>
 #include <suit_flash_streamer.h>
+#include <suit_chunked_streamer.h>
 #include <suit_memory_layout.h>
 
 LOG_MODULE_REGISTER(suit_flash_streamer, CONFIG_SUIT_LOG_LEVEL);
 
-#define READ_CHUNK_SIZE 256
+struct flash_streamer_ctx {
+	const struct device *fdev;
+	uintptr_t offset;
+};
+
+#define READ_BUFFER_SIZE SUIT_CHUNKED_STREAMER_BUF_SIZE(CONFIG_SUIT_STREAM_SOURCE_FLASH_CHUNK_SIZE)
+
+/* The buffer holds up to two chunks, too much for the stack of the streaming thread. */
+static uint8_t read_buffer[READ_BUFFER_SIZE];
+static atomic_t read_buffer_in_use;
 
 bool suit_flash_streamer_address_in_range(const uint8_t *address)
 {
 	return suit_memory_global_address_is_in_external_memory((uintptr_t)address);
 }
 
+static suit_plat_err_t chunk_read(void *ctx, size_t offset, uint8_t *buf, size_t size)
+{
+	struct flash_streamer_ctx *flash_ctx = ctx;
+
+	if (flash_read(flash_ctx->fdev, flash_ctx->offset + offset, buf, size) != 0) {
+		return SUIT_PLAT_ERR_IO;
+	}
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+/* A payload streamed while the read buffer is in use, for example by a sink, is read through a
+ * single chunk on the stack. Kept out of line, so that the stack is only used in this case.
+ */
+static __noinline suit_plat_err_t nested_stream(struct flash_streamer_ctx *flash_ctx,
+						size_t payload_size, struct stream_sink *sink)
+{
+	uint8_t chunk_buffer[CONFIG_SUIT_STREAM_SOURCE_FLASH_CHUNK_SIZE];
+
+	return suit_chunked_streamer_stream_sequential(chunk_read, flash_ctx, payload_size,
+						       chunk_buffer, sizeof(chunk_buffer), sink);
+}
+
 suit_plat_err_t suit_flash_streamer_stream(const uint8_t *payload, size_t payload_size,
 					   struct stream_sink *sink)
 {
-	const struct device *fdev = suit_memory_external_memory_device_get();
-	uintptr_t offset;
-	size_t bytes_read = 0;
-	uint8_t read_buffer[READ_CHUNK_SIZE];
+	struct flash_streamer_ctx flash_ctx = {
+		.fdev = suit_memory_external_memory_device_get(),
+	};
+	suit_plat_err_t ret;
 
-	if (fdev == NULL) {
+	if (flash_ctx.fdev == NULL) {
 		return SUIT_PLAT_ERR_IO;
 	}
 
-	if (!device_is_ready(fdev)) {
+	if (!device_is_ready(flash_ctx.fdev)) {
 		return SUIT_PLAT_ERR_HW_NOT_READY;
 	}
 
-	if (!suit_memory_global_address_to_external_memory_offset((uintptr_t)payload, &offset)) {
+	if (!suit_memory_global_address_to_external_memory_offset((uintptr_t)payload,
+								  &flash_ctx.offset)) {
 		return SUIT_PLAT_ERR_INVAL;
 	}
 
@@ -43,24 +78,14 @@ suit_plat_err_t suit_flash_streamer_stream(const uint8_t *payload, size_t payloa
 		return SUIT_PLAT_ERR_INVAL;
 	}
 
-	do {
-		size_t bytes_remaining = payload_size - bytes_read;
-		size_t read_size = MIN(bytes_remaining, READ_CHUNK_SIZE);
-
-		int result = flash_read(fdev, offset, read_buffer, read_size);
-
-		if (result != 0) {
-			return SUIT_PLAT_ERR_IO;
-		}
-
-		suit_plat_err_t ret = sink->write(sink->ctx, read_buffer, read_size);
+	if (!atomic_cas(&read_buffer_in_use, 0, 1)) {
+		return nested_stream(&flash_ctx, payload_size, sink);
+	}
 
-		if (ret != SUIT_PLAT_SUCCESS) {
-			return ret;
-		}
+	ret = suit_chunked_streamer_stream(chunk_read, &flash_ctx, payload_size, read_buffer,
+					   CONFIG_SUIT_STREAM_SOURCE_FLASH_CHUNK_SIZE, sink);
 
-		bytes_read += read_size;
-	} while (bytes_read < payload_size);
+	atomic_clear(&read_buffer_in_use);
 
-	return SUIT_PLAT_SUCCESS;
+	return ret;
 }
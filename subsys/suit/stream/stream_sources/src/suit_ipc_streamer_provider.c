@@ -47,6 +47,7 @@ typedef struct {
 	size_t current_image_offset;
 	size_t requested_image_offset;
 	uint32_t last_chunk_id;
+	uint32_t enqueued_chunk_count;
 
 	buffer_info_t buffer_info;
 } image_request_info_t;
@@ -57,6 +58,11 @@ static image_request_info_t request_info = {
 
 static K_SEM_DEFINE(chunk_status_changed_sem, 0, 1);
 
+/* Number of chunk status notifications in the current session. The streamer requestor notifies
+ * about every chunk it processed, so it is idle once this matches the number of enqueued chunks.
+ */
+static atomic_t chunk_status_notify_count;
+
 static bool chunk_released_check(image_request_info_t *ri,
 				 suit_ipc_streamer_chunk_info_t *injected_chunks,
 				 size_t chunk_info_count)
@@ -175,7 +181,10 @@ static suit_plat_err_t chunk_enqueue(image_request_info_t *ri, buffer_metadata_t
 		err = suit_ipc_streamer_chunk_enqueue(ri->stream_session_id, bm->chunk_id,
 						      bm->offset_in_image, buffer_address,
 						      bm->chunk_size, last_chunk);
-		if (err == SUIT_PLAT_ERR_BUSY) {
+		if (err == SUIT_PLAT_SUCCESS) {
+			ri->enqueued_chunk_count++;
+			return err;
+		} else if (err == SUIT_PLAT_ERR_BUSY) {
 			/* Not enough space in requestor, try again later
 			 */
 			err = wait_for_buffer_state_change(ri);
@@ -190,6 +199,14 @@ static suit_plat_err_t chunk_enqueue(image_request_info_t *ri, buffer_metadata_t
 	/* UNREACHABLE */
 }
 
+/* The notifications may be missed, in which case the streamer requestor is assumed to be busy
+ * and only full buffers are enqueued.
+ */
+static bool requestor_idle(image_request_info_t *ri)
+{
+	return (uint32_t)atomic_get(&chunk_status_notify_count) >= ri->enqueued_chunk_count;
+}
+
 static suit_plat_err_t end_of_stream(image_request_info_t *ri)
 {
 	suit_plat_err_t err = SUIT_PLAT_SUCCESS;
@@ -296,8 +313,11 @@ static suit_plat_err_t write_proxy(void *ctx, const uint8_t *source_buffer, size
 		source_remaining -= to_be_copied;
 		bm->chunk_size += to_be_copied;
 
-		if (CONFIG_SUIT_STREAM_IPC_PROVIDER_BUFFER_SIZE == bm->chunk_size) {
-			/* buffer full, it is time to enqueue
+		if ((CONFIG_SUIT_STREAM_IPC_PROVIDER_BUFFER_SIZE == bm->chunk_size) ||
+		    ((CONFIG_SUIT_STREAM_IPC_PROVIDER_MIN_CHUNK_SIZE <= bm->chunk_size) &&
+		     requestor_idle(ri))) {
+			/* buffer full, or streamer requestor waiting for data - it is time to
+			 * enqueue
 			 */
 			err = chunk_enqueue(ri, bm, buffer, false);
 			if (err != SUIT_PLAT_SUCCESS) {
@@ -402,6 +422,8 @@ static suit_plat_err_t missing_image_notify_fn(const uint8_t *resource_id,
 		ri->current_image_offset = 0;
 		ri->requested_image_offset = 0;
 		ri->last_chunk_id = 0;
+		ri->enqueued_chunk_count = 0;
+		atomic_clear(&chunk_status_notify_count);
 		memset(&ri->buffer_info, 0, sizeof(buffer_info_t));
 
 		/* Buffer 0 is utilized to pass the URI
@@ -421,6 +443,7 @@ static suit_plat_err_t missing_image_notify_fn(const uint8_t *resource_id,
 
 static suit_plat_err_t chunk_status_notify_fn(uint32_t stream_session_id, void *context)
 {
+	atomic_inc(&chunk_status_notify_count);
 	k_sem_give(&chunk_status_changed_sem);
 	return SUIT_PLAT_SUCCESS;
 }
@@ -5,6 +5,7 @@
  */
 #include <zephyr/cache.h>
 #include <zephyr/kernel.h>
+#include <string.h>
 #include <suit_ipc_streamer.h>
 
 typedef enum {
@@ -38,6 +39,8 @@ typedef enum {
  * @var	arrival_number	Assigned by ipc streamer requestor upon chunk arrival. Utilized by
  *			ipc streamer provider to pass chunks to sink in arrival order.
  *
+ * @var	arrival_ticks	Uptime at chunk arrival, used to measure the chunk latency.
+ *
  */
 typedef struct {
 	/* Initialized with CHUNK_SLOT_EMPTY at image request and modified during image download
@@ -52,6 +55,7 @@ typedef struct {
 	size_t size;
 
 	uint32_t arrival_number;
+	int64_t arrival_ticks;
 
 } chunk_processing_state_t;
 
@@ -82,6 +86,11 @@ typedef struct {
 	uint32_t last_chunk_arrival_number;
 	suit_plat_err_t completion_error_code;
 
+	/* Uptime at which the sink started waiting for the next chunk, 0 if it is not waiting
+	 */
+	int64_t stall_start_ticks;
+	suit_ipc_streamer_stats_t stats;
+
 	chunk_processing_state_t
 		chunk_processing_state[CONFIG_SUIT_STREAM_IPC_REQUESTOR_MAX_CHUNKS];
 } image_request_state_t;
@@ -182,6 +191,55 @@ static int non_empty_chunk_slot_count_get(image_request_state_t *irs)
 	return count;
 }
 
+/* Assumption - access to image_request_state locked on entry/exit
+ */
+static int pending_chunk_count_get(image_request_state_t *irs)
+{
+
+	int count = 0;
+
+	for (int i = 0; i < CONFIG_SUIT_STREAM_IPC_REQUESTOR_MAX_CHUNKS; i++) {
+		chunk_processing_state_t *cps = &irs->chunk_processing_state[i];
+
+		if (cps->status == CHUNK_PENDING) {
+			count++;
+		}
+	}
+	return count;
+}
+
+/* Assumption - access to image_request_state locked on entry/exit
+ */
+static void stall_update(image_request_state_t *irs, bool chunk_available)
+{
+	int64_t current_ticks = k_uptime_ticks();
+
+	if (chunk_available) {
+		if (irs->stall_start_ticks != 0) {
+			irs->stats.stall_us += k_ticks_to_us_floor64(current_ticks -
+								     irs->stall_start_ticks);
+			irs->stall_start_ticks = 0;
+		}
+	} else if (irs->stall_start_ticks == 0) {
+		irs->stall_start_ticks = current_ticks;
+	}
+}
+
+/* Assumption - access to image_request_state locked on entry/exit
+ */
+static void chunk_latency_update(image_request_state_t *irs, chunk_processing_state_t *cps)
+{
+	uint32_t latency_us = k_ticks_to_us_floor64(k_uptime_ticks() - cps->arrival_ticks);
+
+	irs->stats.chunk_count++;
+	irs->stats.byte_count += cps->size;
+	irs->stats.chunk_latency_total_us += latency_us;
+
+	if (latency_us > irs->stats.chunk_latency_max_us) {
+		irs->stats.chunk_latency_max_us = latency_us;
+	}
+}
+
 /* Assumption - access to image_request_state locked on entry/exit
  */
 static void chunk_status_notify(image_request_state_t *irs)
@@ -269,6 +327,8 @@ static suit_plat_err_t data_loop(image_request_state_t *irs)
 		if (irs->stage == STAGE_IN_PROGRESS) {
 			chunk_processing_state_t *cps = pending_chunk_get_next(irs);
 
+			stall_update(irs, cps != NULL);
+
 			if (cps != NULL) {
 				suit_plat_err_t sink_error = SUIT_PLAT_SUCCESS;
 
@@ -296,6 +356,7 @@ static suit_plat_err_t data_loop(image_request_state_t *irs)
 
 				if (sink_error == SUIT_PLAT_SUCCESS) {
 
+					chunk_latency_update(irs, cps);
 					irs->last_processed_number = cps->arrival_number;
 
 					/* Let's check if it is time to transit to STAGE_CLOSING */
@@ -407,6 +468,8 @@ static image_request_state_t *image_request_state_allocate(const uint8_t *resour
 	irs->current_sink_write_offset = 0;
 	irs->last_chunk_arrival_number = 0;
 	irs->completion_error_code = SUIT_PLAT_SUCCESS;
+	irs->stall_start_ticks = 0;
+	memset(&irs->stats, 0, sizeof(irs->stats));
 
 	for (int i = 0; i < CONFIG_SUIT_STREAM_IPC_REQUESTOR_MAX_CHUNKS; i++) {
 		chunk_processing_state_t *cps = &irs->chunk_processing_state[i];
@@ -536,6 +599,13 @@ suit_plat_err_t suit_ipc_streamer_chunk_enqueue(uint32_t stream_session_id, uint
 			cps->size = size;
 
 			cps->arrival_number = ++irs->last_arrival_number;
+			cps->arrival_ticks = k_uptime_ticks();
+
+			uint32_t in_flight = pending_chunk_count_get(irs);
+
+			if (in_flight > irs->stats.chunks_in_flight_max) {
+				irs->stats.chunks_in_flight_max = in_flight;
+			}
 
 			if (last_chunk) {
 				irs->last_chunk_arrival_number = cps->arrival_number;
@@ -680,6 +750,19 @@ void suit_ipc_streamer_missing_image_evt_unsubscribe(void)
 	image_request_state_unlock();
 }
 
+suit_plat_err_t suit_ipc_streamer_stats_get(suit_ipc_streamer_stats_t *stats)
+{
+	if (stats == NULL) {
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	image_request_state_lock();
+	*stats = image_request_state.stats;
+	image_request_state_unlock();
+
+	return SUIT_PLAT_SUCCESS;
+}
+
 suit_plat_err_t suit_ipc_streamer_requestor_init(void)
 {
 	return SUIT_PLAT_SUCCESS;
@@ -25,6 +25,19 @@ LOG_MODULE_REGISTER(internal_trusted_aead, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
  * - Flags+Size as additional parameter
  * - Nonce is a number that is incremented for each encryption.
  * - Tag is left at the end of output data
+ *
+ * With CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED, objects are instead split in chunks of
+ * CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNK_SIZE bytes, each encrypted on its own and stored
+ * under the "<prefix>.<generation>.<chunk index>" prefix. The chunks are encrypted with the
+ * chunk index as additional data, so that writing a chunk does not encrypt the others again.
+ * The object itself holds the header and the table of the nonces and generations of the chunks,
+ * encrypted with the header as additional data. A chunk replayed from an older version of the
+ * object does not decrypt with the nonce of the table, and a chunk swapped with another chunk
+ * does not decrypt with its index. A modified header or table is detected as well.
+ * A chunk that is written again is stored under its other generation, and the chunk it replaces
+ * is removed once the object refers to the new one. An interrupted write leaves the previous
+ * version of the object.
+ * Objects stored in the single-entry format are converted when they are next written.
  */
 
 #define AEAD_NONCE_SIZE 12
@@ -35,6 +48,9 @@ LOG_MODULE_REGISTER(internal_trusted_aead, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
 
 #define INVALID_UID 0U
 
+/* Internal create flag, set on objects stored in chunks */
+#define STORED_OBJECT_FLAG_CHUNKED (1u << 31)
+
 /** Header of stored object. Supplied as additional data when encrypting. */
 typedef struct stored_object_header {
 	psa_storage_create_flags_t create_flags;
@@ -47,12 +63,418 @@ typedef struct stored_object {
 	uint8_t data[AEAD_MAX_BUF_SIZE];
 } stored_object;
 
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+
+#define CHUNK_SIZE	CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNK_SIZE
+#define CHUNK_COUNT_MAX DIV_ROUND_UP(STORAGE_MAX_ASSET_SIZE, CHUNK_SIZE)
+
+/* Chunk prefix pattern: object prefix, chunk generation, chunk index */
+#define CHUNK_PREFIX_PATTERN "%s.%u.%u"
+
+/* Longer than any object prefix accepted by the storage backend, with a generation and index */
+#define CHUNK_PREFIX_MAX_LENGTH 20
+
+/* A chunk alternates between two generations each time it is written */
+#define CHUNK_GENERATION_COUNT 2
+
+/** Header of an object stored in chunks. */
+typedef struct chunked_object_header {
+	stored_object_header header;
+	uint32_t capacity;
+	uint32_t chunk_size;
+} chunked_object_header;
+
+/** Entry of a chunk in the table of an object stored in chunks. */
+typedef struct chunk_entry {
+	uint8_t nonce[AEAD_NONCE_SIZE];
+	uint8_t generation;
+} chunk_entry;
+
+/** Object stored in chunks, with its table of chunk entries encrypted. */
+typedef struct chunked_object {
+	chunked_object_header header;
+	uint8_t nonce[AEAD_NONCE_SIZE];
+	uint8_t table[CHUNK_COUNT_MAX * sizeof(chunk_entry) + AEAD_TAG_SIZE];
+} chunked_object;
+
+/** Object stored in chunks, with its table of chunk entries decrypted. */
+typedef struct chunk_table {
+	chunked_object_header header;
+	chunk_entry entry[CHUNK_COUNT_MAX];
+} chunk_table;
+
+#endif /* CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED */
+
+/** Header of any stored object, identified by its create flags. */
+typedef union any_stored_object_header {
+	stored_object_header header;
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+	chunked_object_header chunked;
+#endif
+} any_stored_object_header;
+
+/** Any stored object, identified by the create flags of its header. */
+typedef union any_stored_object {
+	stored_object_header header;
+	stored_object single;
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+	chunked_object chunked;
+#endif
+} any_stored_object;
+
+static bool is_chunked(const stored_object_header *header)
+{
+	return (header->create_flags & STORED_OBJECT_FLAG_CHUNKED) != 0;
+}
+
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+
+static size_t chunk_count(size_t data_size)
+{
+	return DIV_ROUND_UP(data_size, CHUNK_SIZE);
+}
+
+static size_t chunk_length(size_t data_size, size_t index)
+{
+	return MIN(CHUNK_SIZE, data_size - index * CHUNK_SIZE);
+}
+
+static size_t chunk_table_length(const chunked_object_header *header)
+{
+	return chunk_count(header->header.data_size) * sizeof(chunk_entry);
+}
+
+static size_t chunked_object_length(const chunked_object_header *header)
+{
+	return offsetof(chunked_object, table) + chunk_table_length(header) + AEAD_TAG_SIZE;
+}
+
+static psa_status_t chunked_object_check(const chunked_object *object, size_t object_length)
+{
+	const chunked_object_header *header = &object->header;
+
+	if (object_length < sizeof(*header)) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	if (header->chunk_size != CHUNK_SIZE) {
+		LOG_ERR("Object stored in chunks of %u bytes", header->chunk_size);
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	if (header->capacity > STORAGE_MAX_ASSET_SIZE ||
+	    header->header.data_size > header->capacity ||
+	    object_length < chunked_object_length(header)) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	return PSA_SUCCESS;
+}
+
+/* Checks an object stored in chunks and decrypts its table of chunk entries. */
+static psa_status_t chunk_table_read(const uint8_t *key_buf, const chunked_object *object,
+				     size_t object_length, chunk_table *table)
+{
+	psa_status_t status;
+	size_t table_length;
+
+	status = chunked_object_check(object, object_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = trusted_storage_aead_decrypt(
+		key_buf, AEAD_KEY_SIZE, object->nonce, AEAD_NONCE_SIZE, (void *)&object->header,
+		sizeof(object->header), object->table,
+		chunk_table_length(&object->header) + AEAD_TAG_SIZE, table->entry,
+		sizeof(table->entry), &table_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (table_length != chunk_table_length(&object->header)) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	table->header = object->header;
+
+	for (size_t i = 0; i < chunk_count(table->header.header.data_size); i++) {
+		if (table->entry[i].generation >= CHUNK_GENERATION_COUNT) {
+			return PSA_ERROR_DATA_CORRUPT;
+		}
+	}
+
+	return PSA_SUCCESS;
+}
+
+/* Encrypts the table of chunk entries with a new nonce and writes the object. */
+static psa_status_t chunk_table_write(const psa_storage_uid_t uid, const char *prefix,
+				      const uint8_t *key_buf, const chunk_table *table,
+				      chunked_object *object)
+{
+	psa_status_t status;
+	size_t table_length;
+
+	object->header = table->header;
+
+	status = trusted_storage_get_nonce(object->nonce, AEAD_NONCE_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = trusted_storage_aead_encrypt(
+		key_buf, AEAD_KEY_SIZE, object->nonce, AEAD_NONCE_SIZE, (void *)&object->header,
+		sizeof(object->header), table->entry, chunk_table_length(&table->header),
+		object->table, sizeof(object->table), &table_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	return storage_set_object(uid, prefix, object, offsetof(chunked_object, table) + table_length);
+}
+
+static psa_status_t chunk_prefix_create(char *chunk_prefix, const char *prefix,
+					uint8_t generation, size_t index)
+{
+	int ret;
+
+	ret = snprintf(chunk_prefix, CHUNK_PREFIX_MAX_LENGTH + 1, CHUNK_PREFIX_PATTERN, prefix,
+		       (unsigned int)generation, (unsigned int)index);
+	if (ret < 0 || ret > CHUNK_PREFIX_MAX_LENGTH) {
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+
+	return PSA_SUCCESS;
+}
+
+/* Reads and decrypts the chunk of the given index, as sealed with the given entry. The length
+ * of the chunk is checked against the data size of the header.
+ */
+static psa_status_t chunk_read(const psa_storage_uid_t uid, const char *prefix,
+			       const uint8_t *key_buf, const chunked_object_header *header,
+			       const chunk_entry *entry, size_t index, uint8_t *chunk)
+{
+	psa_status_t status;
+	char chunk_prefix[CHUNK_PREFIX_MAX_LENGTH + 1];
+	uint32_t chunk_index = index;
+	uint8_t sealed[CHUNK_SIZE + AEAD_TAG_SIZE];
+	size_t sealed_length;
+	size_t out_length;
+
+	status = chunk_prefix_create(chunk_prefix, prefix, entry->generation, index);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = storage_get_object(uid, chunk_prefix, sealed, sizeof(sealed), &sealed_length);
+	if (status == PSA_ERROR_DOES_NOT_EXIST) {
+		/* The object refers to the chunk, so it must exist */
+		return PSA_ERROR_DATA_CORRUPT;
+	} else if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = trusted_storage_aead_decrypt(key_buf, AEAD_KEY_SIZE, entry->nonce,
+					      AEAD_NONCE_SIZE, (void *)&chunk_index,
+					      sizeof(chunk_index), sealed, sealed_length, chunk,
+					      CHUNK_SIZE, &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (out_length != chunk_length(header->header.data_size, index)) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	return PSA_SUCCESS;
+}
+
+/*
+ * Encrypts the chunk of the given index with a new nonce, and writes it under its other
+ * generation, so that the chunk it replaces is kept until the object refers to the new one.
+ */
+static psa_status_t chunk_write(const psa_storage_uid_t uid, const char *prefix,
+				const uint8_t *key_buf, chunk_table *table, size_t index,
+				const uint8_t *chunk)
+{
+	psa_status_t status;
+	char chunk_prefix[CHUNK_PREFIX_MAX_LENGTH + 1];
+	uint32_t chunk_index = index;
+	chunk_entry *entry = &table->entry[index];
+	uint8_t sealed[CHUNK_SIZE + AEAD_TAG_SIZE];
+	size_t sealed_length;
+
+	entry->generation = (entry->generation + 1) % CHUNK_GENERATION_COUNT;
+
+	status = chunk_prefix_create(chunk_prefix, prefix, entry->generation, index);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = trusted_storage_get_nonce(entry->nonce, AEAD_NONCE_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	status = trusted_storage_aead_encrypt(
+		key_buf, AEAD_KEY_SIZE, entry->nonce, AEAD_NONCE_SIZE, (void *)&chunk_index,
+		sizeof(chunk_index), chunk, chunk_length(table->header.header.data_size, index),
+		sealed, sizeof(sealed), &sealed_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	return storage_set_object(uid, chunk_prefix, sealed, sealed_length);
+}
+
+static void chunk_remove(const psa_storage_uid_t uid, const char *prefix, uint8_t generation,
+			 size_t index)
+{
+	char chunk_prefix[CHUNK_PREFIX_MAX_LENGTH + 1];
+
+	if (chunk_prefix_create(chunk_prefix, prefix, generation, index) == PSA_SUCCESS) {
+		storage_remove_object(uid, chunk_prefix);
+	}
+}
+
+/* Removes the chunks of indexes from first up to, not including, last, of both generations. */
+static void chunks_remove(const psa_storage_uid_t uid, const char *prefix, size_t first,
+			  size_t last)
+{
+	for (size_t i = first; i < MIN(last, CHUNK_COUNT_MAX); i++) {
+		for (uint8_t generation = 0; generation < CHUNK_GENERATION_COUNT; generation++) {
+			chunk_remove(uid, prefix, generation, i);
+		}
+	}
+}
+
+/* Removes the chunks of indexes from first up to, not including, last, written by chunk_write. */
+static void new_chunks_remove(const psa_storage_uid_t uid, const char *prefix,
+			      const chunk_table *table, size_t first, size_t last)
+{
+	for (size_t i = first; i < last; i++) {
+		chunk_remove(uid, prefix, table->entry[i].generation, i);
+	}
+}
+
+/*
+ * Writes the object once the chunks of indexes from first up to, not including, last are written.
+ * The chunks they replace, and the chunks left over from the previous version of the object, are
+ * then removed. If the object cannot be written, the new chunks are removed instead, which leaves
+ * the previous version of the object.
+ */
+static psa_status_t chunked_commit(const psa_storage_uid_t uid, const char *prefix,
+				   const uint8_t *key_buf, const chunk_table *table,
+				   chunked_object *object, size_t first, size_t last,
+				   size_t previous_chunk_count)
+{
+	psa_status_t status;
+
+	status = chunk_table_write(uid, prefix, key_buf, table, object);
+	if (status != PSA_SUCCESS) {
+		new_chunks_remove(uid, prefix, table, first, last);
+		return status;
+	}
+
+	for (size_t i = first; i < MIN(last, previous_chunk_count); i++) {
+		chunk_remove(uid, prefix, (table->entry[i].generation + 1) % CHUNK_GENERATION_COUNT,
+			     i);
+	}
+
+	chunks_remove(uid, prefix, chunk_count(table->header.header.data_size),
+		      previous_chunk_count);
+
+	return PSA_SUCCESS;
+}
+
+static psa_status_t chunked_get(const psa_storage_uid_t uid, const char *prefix,
+				const uint8_t *key_buf, const chunk_table *table,
+				size_t data_offset, size_t data_length, uint8_t *p_data,
+				size_t *p_data_length)
+{
+	psa_status_t status = PSA_SUCCESS;
+	uint8_t chunk[CHUNK_SIZE];
+	size_t data_size = table->header.header.data_size;
+	size_t end;
+	size_t out_length = 0;
+
+	if (data_offset > data_size) {
+		*p_data_length = 0;
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	end = MIN(data_offset + data_length, data_size);
+
+	/* Only decrypt the chunks holding the requested data */
+	for (size_t i = data_offset / CHUNK_SIZE; i * CHUNK_SIZE < end; i++) {
+		size_t start = MAX(data_offset, i * CHUNK_SIZE);
+		size_t length = MIN(end, (i + 1) * CHUNK_SIZE) - start;
+
+		status = chunk_read(uid, prefix, key_buf, &table->header, &table->entry[i], i,
+				    chunk);
+		if (status != PSA_SUCCESS) {
+			break;
+		}
+
+		memcpy(p_data + out_length, chunk + (start - i * CHUNK_SIZE), length);
+		out_length += length;
+	}
+
+	mbedtls_platform_zeroize(chunk, sizeof(chunk));
+
+	if (status != PSA_SUCCESS) {
+		mbedtls_platform_zeroize(p_data, out_length);
+		return status;
+	}
+
+	*p_data_length = out_length;
+
+	return PSA_SUCCESS;
+}
+
+/*
+ * Writes all the data of an object in chunks, then the object. The chunks of the previous version
+ * of the object are given by the table entries and previous_chunk_count. On failure, the previous
+ * version of the object is left.
+ */
+static psa_status_t chunked_set(const psa_storage_uid_t uid, const char *prefix,
+				const uint8_t *key_buf, chunk_table *table, chunked_object *object,
+				size_t previous_chunk_count, const uint8_t *p_data)
+{
+	psa_status_t status;
+	size_t count = chunk_count(table->header.header.data_size);
+
+	for (size_t i = 0; i < count; i++) {
+		status = chunk_write(uid, prefix, key_buf, table, i, p_data + i * CHUNK_SIZE);
+		if (status != PSA_SUCCESS) {
+			new_chunks_remove(uid, prefix, table, 0, i + 1);
+			return status;
+		}
+	}
+
+	return chunked_commit(uid, prefix, key_buf, table, object, 0, count, previous_chunk_count);
+}
+
+static void chunked_header_fill(chunked_object_header *header,
+				psa_storage_create_flags_t create_flags, size_t data_size,
+				size_t capacity)
+{
+	/* Clear the padding, which is authenticated as well */
+	memset(header, 0, sizeof(*header));
+	header->header.create_flags = create_flags | STORED_OBJECT_FLAG_CHUNKED;
+	header->header.data_size = data_size;
+	header->capacity = capacity;
+	header->chunk_size = CHUNK_SIZE;
+}
+
+#endif /* CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED */
+
 psa_status_t trusted_get_info(const psa_storage_uid_t uid, const char *prefix,
 			      struct psa_storage_info_t *p_info)
 {
 	psa_status_t status;
 	size_t out_length;
-	stored_object_header header;
+	any_stored_object_header header;
 
 	if (p_info == NULL || uid == INVALID_UID) {
 		return PSA_ERROR_INVALID_ARGUMENT;
@@ -64,9 +486,54 @@ psa_status_t trusted_get_info(const psa_storage_uid_t uid, const char *prefix,
 		return status;
 	}
 
-	p_info->capacity = header.data_size;
-	p_info->size = header.data_size;
-	p_info->flags = header.create_flags;
+	p_info->capacity = header.header.data_size;
+	p_info->size = header.header.data_size;
+	p_info->flags = header.header.create_flags & ~STORED_OBJECT_FLAG_CHUNKED;
+
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+	if (is_chunked(&header.header)) {
+		p_info->capacity = header.chunked.capacity;
+	}
+#endif
+
+	return PSA_SUCCESS;
+}
+
+/* Decrypts an object stored in a single entry and copies the requested part of its data. */
+static psa_status_t single_get(const uint8_t *key_buf, stored_object *object_data,
+			       size_t object_length, size_t data_offset, size_t data_length,
+			       void *p_data, size_t *p_data_length)
+{
+	psa_status_t status;
+	size_t out_length;
+
+	if (object_length < offsetof(stored_object, data)) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	status = trusted_storage_aead_decrypt(
+		key_buf, AEAD_KEY_SIZE, object_data->nonce, AEAD_NONCE_SIZE,
+		(void *)&object_data->header, sizeof(object_data->header), object_data->data,
+		object_length - offsetof(stored_object, data), object_data->data,
+		STORAGE_MAX_ASSET_SIZE, &out_length);
+
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (data_offset > out_length) {
+		*p_data_length = 0;
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if ((data_offset + data_length) > out_length) {
+		out_length -= data_offset;
+	} else {
+		out_length = data_length;
+	}
+
+	memcpy(p_data, object_data->data + data_offset, out_length);
+	*p_data_length = out_length;
 
 	return PSA_SUCCESS;
 }
@@ -77,7 +544,10 @@ psa_status_t trusted_get(const psa_storage_uid_t uid, const char *prefix, size_t
 	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
 	uint8_t key_buf[AEAD_KEY_SIZE + 1];
 	size_t out_length;
-	stored_object object_data;
+	any_stored_object object_data;
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+	chunk_table table;
+#endif
 
 	if ((p_data == NULL && data_length != 0) || p_data_length == NULL || uid == INVALID_UID) {
 		return PSA_ERROR_INVALID_ARGUMENT;
@@ -98,38 +568,32 @@ psa_status_t trusted_get(const psa_storage_uid_t uid, const char *prefix, size_t
 		return status;
 	}
 
-	/* Retrieve object from storage */
+	/* Retrieve object from storage, which only holds the table of the chunks if chunked */
 	status = storage_get_object(uid, prefix, (void *)&object_data, sizeof(object_data),
 				    &out_length);
 	if (status != PSA_SUCCESS) {
-		return status;
-	}
-
-	status = trusted_storage_aead_decrypt(
-		key_buf, AEAD_KEY_SIZE, object_data.nonce, AEAD_NONCE_SIZE,
-		(void *)&object_data.header, sizeof(object_data.header), object_data.data,
-		out_length - offsetof(stored_object, data), object_data.data,
-		STORAGE_MAX_ASSET_SIZE, &out_length);
-
-	if (status != PSA_SUCCESS) {
-		goto clean_up;
-	}
-
-	if (data_offset > out_length) {
-		*p_data_length = 0;
-		status = PSA_ERROR_INVALID_ARGUMENT;
 		goto clean_up;
 	}
 
-	if ((data_offset + data_length) > out_length) {
-		out_length -= data_offset;
+	if (out_length < sizeof(object_data.header)) {
+		status = PSA_ERROR_DATA_CORRUPT;
+	} else if (!is_chunked(&object_data.header)) {
+		status = single_get(key_buf, &object_data.single, out_length, data_offset,
+				    data_length, p_data, p_data_length);
 	} else {
-		out_length = data_length;
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+		status = chunk_table_read(key_buf, &object_data.chunked, out_length, &table);
+		if (status == PSA_SUCCESS) {
+			status = chunked_get(uid, prefix, key_buf, &table, data_offset, data_length,
+					     p_data, p_data_length);
+		}
+
+		mbedtls_platform_zeroize(&table, sizeof(table));
+#else
+		status = PSA_ERROR_NOT_SUPPORTED;
+#endif
 	}
 
-	memcpy(p_data, object_data.data + data_offset, out_length);
-	*p_data_length = out_length;
-
 clean_up:
 	/* Clean up */
 	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
@@ -144,7 +608,11 @@ psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t
 	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
 	uint8_t key_buf[AEAD_KEY_SIZE + 1];
 	size_t out_length = 0;
-	stored_object object_data;
+	any_stored_object object_data;
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+	size_t previous_chunk_count = 0;
+	chunk_table table;
+#endif
 
 	if (uid == INVALID_UID || (p_data == NULL && data_length != 0)) {
 		return PSA_ERROR_INVALID_ARGUMENT;
@@ -158,16 +626,16 @@ psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t
 		return PSA_ERROR_INVALID_ARGUMENT;
 	}
 
-	/* Get flags */
-	status = storage_get_object(uid, prefix, (void *)&object_data.header,
-				    sizeof(object_data.header), &out_length);
+	/* Get flags, and the table of the chunks if chunked */
+	status = storage_get_object(uid, prefix, (void *)&object_data, sizeof(object_data),
+				    &out_length);
 
 	if (status != PSA_SUCCESS && status != PSA_ERROR_DOES_NOT_EXIST) {
 		return status;
 	}
 
 	/* Do not allow to write new values if WRITE_ONCE flag is set */
-	if (status == PSA_SUCCESS &&
+	if (status == PSA_SUCCESS && out_length >= sizeof(object_data.header) &&
 	    (object_data.header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
 		return PSA_ERROR_NOT_PERMITTED;
 	}
@@ -178,19 +646,44 @@ psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t
 		goto cleanup_objects;
 	}
 
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+	memset(&table, 0, sizeof(table));
+
+	if (out_length >= sizeof(object_data.chunked.header) && is_chunked(&object_data.header)) {
+		previous_chunk_count = chunk_count(object_data.header.data_size);
+
+		/* The chunks of a corrupted object are replaced, whatever their generation */
+		if (chunk_table_read(key_buf, &object_data.chunked, out_length, &table) !=
+		    PSA_SUCCESS) {
+			memset(&table, 0, sizeof(table));
+		}
+	}
+
+	chunked_header_fill(&table.header, create_flags, data_length, data_length);
+
+	status = chunked_set(uid, prefix, key_buf, &table, &object_data.chunked,
+			     previous_chunk_count, p_data);
+
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+	mbedtls_platform_zeroize(&table, sizeof(table));
+
+	/* On failure, the previous version of the object is left */
+	goto cleanup;
+#else
 	/* Get new nonce at each set */
-	status = trusted_storage_get_nonce(object_data.nonce, AEAD_NONCE_SIZE);
+	status = trusted_storage_get_nonce(object_data.single.nonce, AEAD_NONCE_SIZE);
 	if (status != PSA_SUCCESS) {
 		goto cleanup_objects;
 	}
 
-	object_data.header.create_flags = create_flags;
-	object_data.header.data_size = data_length;
+	object_data.single.header.create_flags = create_flags;
+	object_data.single.header.data_size = data_length;
 
-	status = trusted_storage_aead_encrypt(key_buf, AEAD_KEY_SIZE, object_data.nonce,
-					      AEAD_NONCE_SIZE, (void *)&object_data.header,
-					      sizeof(object_data.header), p_data, data_length,
-					      object_data.data, AEAD_MAX_BUF_SIZE, &out_length);
+	status = trusted_storage_aead_encrypt(key_buf, AEAD_KEY_SIZE, object_data.single.nonce,
+					      AEAD_NONCE_SIZE, (void *)&object_data.single.header,
+					      sizeof(object_data.single.header), p_data,
+					      data_length, object_data.single.data,
+					      AEAD_MAX_BUF_SIZE, &out_length);
 
 	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
 
@@ -199,13 +692,14 @@ psa_status_t trusted_set(const psa_storage_uid_t uid, const char *prefix, size_t
 	}
 
 	/* Write data */
-	status = storage_set_object(uid, prefix, &object_data,
+	status = storage_set_object(uid, prefix, &object_data.single,
 				    offsetof(stored_object, data) + out_length);
 	if (status != PSA_SUCCESS) {
 		goto cleanup_objects;
 	}
 
 	goto cleanup;
+#endif
 
 cleanup_objects:
 	/* Remove object if an error occurs */
@@ -222,7 +716,7 @@ psa_status_t trusted_remove(const psa_storage_uid_t uid, const char *prefix)
 {
 	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
 	size_t out_length;
-	stored_object_header header;
+	any_stored_object_header header;
 
 	if (uid == INVALID_UID) {
 		return PSA_ERROR_INVALID_ARGUMENT;
@@ -234,34 +728,260 @@ psa_status_t trusted_remove(const psa_storage_uid_t uid, const char *prefix)
 		return status;
 	}
 
-	if (status == PSA_SUCCESS && (header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+	if (status == PSA_SUCCESS &&
+	    (header.header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
 		return PSA_ERROR_NOT_PERMITTED;
 	}
 
-	return storage_remove_object(uid, prefix);
+	status = storage_remove_object(uid, prefix);
+
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+	/* Also remove the chunks left over by an interrupted write, up to the capacity */
+	if (status == PSA_SUCCESS && out_length >= sizeof(header.chunked) &&
+	    is_chunked(&header.header)) {
+		chunks_remove(uid, prefix, 0, chunk_count(header.chunked.capacity));
+	}
+#endif
+
+	return status;
 }
 
 uint32_t trusted_get_support(void)
 {
+	if (IS_ENABLED(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)) {
+		return PSA_STORAGE_SUPPORT_SET_EXTENDED;
+	}
+
 	return 0;
 }
 
-psa_status_t trusted_create(const psa_storage_uid_t uid, size_t capacity,
+#if defined(CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED)
+
+psa_status_t trusted_create(const psa_storage_uid_t uid, const char *prefix, size_t capacity,
 			    psa_storage_create_flags_t create_flags)
 {
+	psa_status_t status;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	size_t out_length;
+	chunk_table table;
+	chunked_object object;
+
+	if (uid == INVALID_UID) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (create_flags != PSA_STORAGE_FLAG_NONE && create_flags != PSA_STORAGE_FLAG_WRITE_ONCE) {
+		return PSA_ERROR_NOT_SUPPORTED;
+	}
+
+	if (capacity > STORAGE_MAX_ASSET_SIZE) {
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	}
 
+	status = storage_get_object(uid, prefix, (void *)&object.header, sizeof(object.header),
+				    &out_length);
+	if (status == PSA_SUCCESS) {
+		return PSA_ERROR_ALREADY_EXISTS;
+	} else if (status != PSA_ERROR_DOES_NOT_EXIST) {
+		return status;
+	}
+
+	/* Get AEAD key */
+	status = trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	/* An empty object has no chunks, so its table is empty */
+	memset(&table, 0, sizeof(table));
+	chunked_header_fill(&table.header, create_flags, 0, capacity);
+
+	status = chunk_table_write(uid, prefix, key_buf, &table, &object);
+
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+
+	return status;
+}
+
+/* Converts an object stored in a single entry to an object stored in chunks. */
+static psa_status_t single_to_chunked(const psa_storage_uid_t uid, const char *prefix,
+				      const uint8_t *key_buf, any_stored_object *object_data,
+				      size_t object_length, chunk_table *table)
+{
+	psa_status_t status;
+	psa_storage_create_flags_t create_flags = object_data->header.create_flags;
+	uint8_t data[STORAGE_MAX_ASSET_SIZE];
+	size_t data_length;
+
+	status = single_get(key_buf, &object_data->single, object_length, 0,
+			    STORAGE_MAX_ASSET_SIZE, data, &data_length);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	LOG_DBG("Converting object to chunks, size %zd", data_length);
+
+	/* The object is left in a single entry on failure */
+	memset(table, 0, sizeof(*table));
+	chunked_header_fill(&table->header, create_flags, data_length, data_length);
+
+	status = chunked_set(uid, prefix, key_buf, table, &object_data->chunked, 0, data);
+
+cleanup:
+	mbedtls_platform_zeroize(data, sizeof(data));
+
+	return status;
+}
+
+psa_status_t trusted_set_extended(const psa_storage_uid_t uid, const char *prefix,
+				  size_t data_offset, size_t data_length, const void *p_data)
+{
+	psa_status_t status = PSA_ERROR_CORRUPTION_DETECTED;
+	uint8_t key_buf[AEAD_KEY_SIZE + 1];
+	uint8_t chunk[CHUNK_SIZE];
+	size_t out_length;
+	size_t data_size;
+	size_t capacity;
+	size_t data_end;
+	size_t previous_chunk_count;
+	size_t first;
+	size_t last;
+	chunked_object_header previous_header;
+	chunk_table table;
+	any_stored_object object_data;
+	const uint8_t *data = p_data;
+
+	if (uid == INVALID_UID || (p_data == NULL && data_length != 0)) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	status = storage_get_object(uid, prefix, (void *)&object_data, sizeof(object_data),
+				    &out_length);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	if (out_length < sizeof(object_data.header)) {
+		return PSA_ERROR_DATA_CORRUPT;
+	}
+
+	if ((object_data.header.create_flags & PSA_STORAGE_FLAG_WRITE_ONCE) != 0) {
+		return PSA_ERROR_NOT_PERMITTED;
+	}
+
+	/* The arguments are checked before the object is converted or written. The header is
+	 * authenticated once the object is decrypted.
+	 */
+	if (is_chunked(&object_data.header)) {
+		status = chunked_object_check(&object_data.chunked, out_length);
+		if (status != PSA_SUCCESS) {
+			return status;
+		}
+
+		data_size = object_data.chunked.header.header.data_size;
+		capacity = object_data.chunked.header.capacity;
+	} else {
+		data_size = object_data.header.data_size;
+		capacity = data_size;
+	}
+
+	if (data_offset > data_size || data_length > capacity - data_offset) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	if (data_length == 0) {
+		return PSA_SUCCESS;
+	}
+
+	/* Get AEAD key */
+	status = trusted_storage_get_key(uid, key_buf, AEAD_KEY_SIZE);
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	if (!is_chunked(&object_data.header)) {
+		status = single_to_chunked(uid, prefix, key_buf, &object_data, out_length, &table);
+	} else {
+		status = chunk_table_read(key_buf, &object_data.chunked, out_length, &table);
+	}
+	if (status != PSA_SUCCESS) {
+		goto cleanup;
+	}
+
+	previous_header = table.header;
+	data_end = data_offset + data_length;
+	previous_chunk_count = chunk_count(previous_header.header.data_size);
+
+	/* Only the written chunks are encrypted again, the table holds the data size */
+	if (data_end > previous_header.header.data_size) {
+		table.header.header.data_size = data_end;
+	}
+	first = data_offset / CHUNK_SIZE;
+	last = chunk_count(data_end);
+
+	for (size_t i = first; i < last; i++) {
+		size_t chunk_start = i * CHUNK_SIZE;
+		size_t chunk_end = chunk_start + CHUNK_SIZE;
+
+		/* Keep the data of the chunk that is not written */
+		if (i < previous_chunk_count && (data_offset > chunk_start ||
+		    data_end < MIN(chunk_end, previous_header.header.data_size))) {
+			status = chunk_read(uid, prefix, key_buf, &previous_header, &table.entry[i],
+					    i, chunk);
+			if (status != PSA_SUCCESS) {
+				new_chunks_remove(uid, prefix, &table, first, i);
+				goto cleanup;
+			}
+		}
+
+		if (data_offset < chunk_end && data_end > chunk_start) {
+			size_t start = MAX(data_offset, chunk_start);
+
+			memcpy(chunk + (start - chunk_start), data + (start - data_offset),
+			       MIN(data_end, chunk_end) - start);
+		}
+
+		status = chunk_write(uid, prefix, key_buf, &table, i, chunk);
+		if (status != PSA_SUCCESS) {
+			new_chunks_remove(uid, prefix, &table, first, i + 1);
+			goto cleanup;
+		}
+	}
+
+	/* On failure, the previous version of the object is left */
+	status = chunked_commit(uid, prefix, key_buf, &table, &object_data.chunked, first, last,
+				previous_chunk_count);
+
+cleanup:
+	mbedtls_platform_zeroize(key_buf, sizeof(key_buf));
+	mbedtls_platform_zeroize(chunk, sizeof(chunk));
+	mbedtls_platform_zeroize(&table, sizeof(table));
+	mbedtls_platform_zeroize(&object_data, sizeof(object_data));
+
+	return status;
+}
+
+#else
+
+psa_status_t trusted_create(const psa_storage_uid_t uid, const char *prefix, size_t capacity,
+			    psa_storage_create_flags_t create_flags)
+{
 	ARG_UNUSED(uid);
+	ARG_UNUSED(prefix);
 	ARG_UNUSED(capacity);
 	ARG_UNUSED(create_flags);
 	return PSA_ERROR_NOT_SUPPORTED;
 }
 
-psa_status_t trusted_set_extended(const psa_storage_uid_t uid, size_t data_offset,
-				  size_t data_length, const void *p_data)
+psa_status_t trusted_set_extended(const psa_storage_uid_t uid, const char *prefix,
+				  size_t data_offset, size_t data_length, const void *p_data)
 {
 	ARG_UNUSED(uid);
+	ARG_UNUSED(prefix);
 	ARG_UNUSED(data_offset);
 	ARG_UNUSED(data_length);
 	ARG_UNUSED(p_data);
 	return PSA_ERROR_NOT_SUPPORTED;
 }
+
+#endif /* CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED */
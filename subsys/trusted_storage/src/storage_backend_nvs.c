@@ -0,0 +1,326 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/kernel.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/fs/nvs.h>
+#include <zephyr/logging/log.h>
+#include <zephyr/storage/flash_map.h>
+
+#include "storage_backend.h"
+
+LOG_MODULE_REGISTER(internal_trusted_storage_nvs, CONFIG_TRUSTED_STORAGE_LOG_LEVEL);
+
+/*
+ * Objects are stored directly in NVS records, instead of being looked up by name.
+ *
+ * The record slot of an object is derived from a hash of its prefix and UID. If the slot is used
+ * by another object, the following slots are probed, up to
+ * CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_NVS_PROBES slots. A slot is made of two records:
+ * - The key record, with the ID of the slot, holds the prefix and the UID of the object.
+ * - The data record, with the ID of the slot plus the number of slots, holds the object.
+ *
+ * Removing an object leaves an empty slot, so the probing does not stop at empty slots.
+ */
+
+#define SLOT_COUNT  CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_NVS_SLOTS
+#define PROBE_COUNT CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_NVS_PROBES
+
+#define KEY_RECORD_ID(slot)  ((uint16_t)(slot))
+#define DATA_RECORD_ID(slot) ((uint16_t)((slot) + SLOT_COUNT))
+
+#if defined(CONFIG_NVS_LOOKUP_CACHE)
+/* The cache reduces the NVS walks when reading the records, but does not remove them. The cache
+ * positions are a hash of the record IDs, so records can evict each other. A cache smaller than
+ * the number of records would make this the common case.
+ */
+BUILD_ASSERT(CONFIG_NVS_LOOKUP_CACHE_SIZE >= 2 * SLOT_COUNT,
+	     "CONFIG_NVS_LOOKUP_CACHE_SIZE must be at least twice the number of slots");
+#endif
+
+/* Max prefix length aligned with the filename length of the settings storage backend */
+#define PREFIX_MAX_LENGTH 15
+
+#define INVALID_SLOT (-1)
+
+#define TRUSTED_STORAGE_PARTITION trusted_storage_partition
+
+/** Content of the key record of a slot. */
+struct key_record {
+	psa_storage_uid_t uid;
+	char prefix[PREFIX_MAX_LENGTH + 1];
+};
+
+static struct nvs_fs fs;
+static bool mounted;
+static K_MUTEX_DEFINE(storage_mutex);
+
+static psa_status_t error_to_psa_error(int errorno)
+{
+
+	switch (errorno) {
+	case 0:
+		return PSA_SUCCESS;
+	case -ENOSPC:
+		return PSA_ERROR_INSUFFICIENT_STORAGE;
+	case -ENOENT:
+		return PSA_ERROR_DOES_NOT_EXIST;
+	case -ENODATA:
+		return PSA_ERROR_DATA_CORRUPT;
+	default:
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+}
+
+static psa_status_t storage_mount(void)
+{
+	struct flash_pages_info info;
+	int ret;
+
+	if (mounted) {
+		return PSA_SUCCESS;
+	}
+
+	fs.flash_device = FIXED_PARTITION_DEVICE(TRUSTED_STORAGE_PARTITION);
+	if (!device_is_ready(fs.flash_device)) {
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+
+	fs.offset = FIXED_PARTITION_OFFSET(TRUSTED_STORAGE_PARTITION);
+	ret = flash_get_page_info_by_offs(fs.flash_device, fs.offset, &info);
+	if (ret != 0) {
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+
+	fs.sector_size = info.size;
+	fs.sector_count = FIXED_PARTITION_SIZE(TRUSTED_STORAGE_PARTITION) / info.size;
+
+	ret = nvs_mount(&fs);
+	if (ret != 0) {
+		LOG_ERR("Failed to mount NVS, ret: %d", ret);
+		return error_to_psa_error(ret);
+	}
+
+	mounted = true;
+
+	return PSA_SUCCESS;
+}
+
+static psa_status_t key_record_fill(struct key_record *key, const psa_storage_uid_t uid,
+				    const char *prefix)
+{
+	size_t prefix_length = strlen(prefix);
+
+	if (prefix_length > PREFIX_MAX_LENGTH) {
+		return PSA_ERROR_STORAGE_FAILURE;
+	}
+
+	/* Clear the padding, which is compared as well */
+	memset(key, 0, sizeof(*key));
+	key->uid = uid;
+	memcpy(key->prefix, prefix, prefix_length);
+
+	return PSA_SUCCESS;
+}
+
+/* FNV-1a hash of the key, spreading the objects of consecutive UIDs over the slots */
+static uint32_t key_hash(const struct key_record *key)
+{
+	const uint8_t *bytes = (const uint8_t *)key;
+	uint32_t hash = 2166136261u;
+
+	for (size_t i = 0; i < sizeof(*key); i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+/*
+ * Finds the slot of an object.
+ * If the object is not stored, the first empty slot found for it is returned in free_slot.
+ */
+static psa_status_t slot_find(const struct key_record *key, int *slot, int *free_slot)
+{
+	struct key_record stored;
+	uint32_t first = key_hash(key) % SLOT_COUNT;
+	ssize_t ret;
+
+	*slot = INVALID_SLOT;
+	*free_slot = INVALID_SLOT;
+
+	for (size_t i = 0; i < PROBE_COUNT; i++) {
+		int probed = (first + i) % SLOT_COUNT;
+
+		ret = nvs_read(&fs, KEY_RECORD_ID(probed), &stored, sizeof(stored));
+		if (ret == -ENOENT) {
+			if (*free_slot == INVALID_SLOT) {
+				*free_slot = probed;
+			}
+			continue;
+		} else if (ret < 0) {
+			return error_to_psa_error(ret);
+		}
+
+		if ((size_t)ret == sizeof(stored) && memcmp(&stored, key, sizeof(stored)) == 0) {
+			*slot = probed;
+			return PSA_SUCCESS;
+		}
+	}
+
+	return PSA_ERROR_DOES_NOT_EXIST;
+}
+
+psa_status_t storage_get_object(const psa_storage_uid_t uid, const char *prefix, void *object_data,
+				const size_t object_size, size_t *object_length)
+{
+	psa_status_t status;
+	struct key_record key;
+	int slot;
+	int free_slot;
+	ssize_t ret;
+
+	if (object_size == 0 || object_data == NULL || prefix == NULL) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	status = key_record_fill(&key, uid, prefix);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	k_mutex_lock(&storage_mutex, K_FOREVER);
+
+	status = storage_mount();
+	if (status != PSA_SUCCESS) {
+		goto unlock;
+	}
+
+	status = slot_find(&key, &slot, &free_slot);
+	if (status != PSA_SUCCESS) {
+		goto unlock;
+	}
+
+	ret = nvs_read(&fs, DATA_RECORD_ID(slot), object_data, object_size);
+	if (ret < 0) {
+		status = error_to_psa_error(ret);
+		goto unlock;
+	}
+
+	*object_length = MIN((size_t)ret, object_size);
+
+unlock:
+	k_mutex_unlock(&storage_mutex);
+
+	LOG_DBG("Get object %s/%08x%08x (max_size: %zd), status: %d", prefix,
+		(unsigned int)(uid >> 32), (unsigned int)(uid & 0xffffffff), object_size, status);
+
+	return status;
+}
+
+psa_status_t storage_set_object(const psa_storage_uid_t uid, const char *prefix,
+				const void *object_data, const size_t object_size)
+{
+	psa_status_t status;
+	struct key_record key;
+	int slot;
+	int free_slot;
+	ssize_t ret;
+
+	if (object_size == 0 || object_data == NULL || prefix == NULL) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	status = key_record_fill(&key, uid, prefix);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	k_mutex_lock(&storage_mutex, K_FOREVER);
+
+	status = storage_mount();
+	if (status != PSA_SUCCESS) {
+		goto unlock;
+	}
+
+	status = slot_find(&key, &slot, &free_slot);
+	if (status == PSA_ERROR_DOES_NOT_EXIST) {
+		if (free_slot == INVALID_SLOT) {
+			LOG_ERR("No free slot for object, increase the number of slots");
+			status = PSA_ERROR_INSUFFICIENT_STORAGE;
+			goto unlock;
+		}
+
+		/* The key is written first, a data record without a key would not be found */
+		slot = free_slot;
+		ret = nvs_write(&fs, KEY_RECORD_ID(slot), &key, sizeof(key));
+		if (ret < 0) {
+			status = error_to_psa_error(ret);
+			goto unlock;
+		}
+	} else if (status != PSA_SUCCESS) {
+		goto unlock;
+	}
+
+	ret = nvs_write(&fs, DATA_RECORD_ID(slot), object_data, object_size);
+	status = (ret < 0) ? error_to_psa_error(ret) : PSA_SUCCESS;
+
+unlock:
+	k_mutex_unlock(&storage_mutex);
+
+	LOG_DBG("Set object %s/%08x%08x. Size: %zd, status: %d", prefix,
+		(unsigned int)(uid >> 32), (unsigned int)(uid & 0xffffffff), object_size, status);
+
+	return status;
+}
+
+psa_status_t storage_remove_object(const psa_storage_uid_t uid, const char *prefix)
+{
+	psa_status_t status;
+	struct key_record key;
+	int slot;
+	int free_slot;
+	int ret;
+
+	if (prefix == NULL) {
+		return PSA_ERROR_INVALID_ARGUMENT;
+	}
+
+	status = key_record_fill(&key, uid, prefix);
+	if (status != PSA_SUCCESS) {
+		return status;
+	}
+
+	k_mutex_lock(&storage_mutex, K_FOREVER);
+
+	status = storage_mount();
+	if (status != PSA_SUCCESS) {
+		goto unlock;
+	}
+
+	status = slot_find(&key, &slot, &free_slot);
+	if (status != PSA_SUCCESS) {
+		goto unlock;
+	}
+
+	/* The data is removed first, a key without a data record is reported as not existing */
+	ret = nvs_delete(&fs, DATA_RECORD_ID(slot));
+	if (ret == 0) {
+		ret = nvs_delete(&fs, KEY_RECORD_ID(slot));
+	}
+	status = error_to_psa_error(ret);
+
+unlock:
+	k_mutex_unlock(&storage_mutex);
+
+	LOG_DBG("Remove object %s/%08x%08x, status %d", prefix, (unsigned int)(uid >> 32),
+		(unsigned int)(uid & 0xffffffff), status);
+
+	return status;
+}
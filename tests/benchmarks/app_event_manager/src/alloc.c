@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark comparing the event allocation cost and the system heap fragmentation
+ * of the memory slab event allocator and the default k_malloc allocator.
+ *
+ * Events of different sizes with interleaved lifetimes are allocated and freed together
+ * with long-living application buffers allocated from the system heap. After the events
+ * are freed, the largest block that can still be allocated from the heap is measured.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <app_event_manager.h>
+
+#define ITERATION_CNT		2000
+#define LIVE_EVENT_CNT		6
+#define APP_BUF_PERIOD		64
+#define APP_BUF_SIZE		24
+#define APP_BUF_CNT		(ITERATION_CNT / APP_BUF_PERIOD)
+#define HEAP_PROBE_STEP		8
+
+struct bench_small_event {
+	struct app_event_header header;
+
+	uint8_t val;
+};
+
+APP_EVENT_TYPE_DECLARE(bench_small_event);
+APP_EVENT_TYPE_DEFINE(bench_small_event, NULL, NULL, APP_EVENT_FLAGS_CREATE());
+
+struct bench_medium_event {
+	struct app_event_header header;
+
+	uint32_t val[6];
+};
+
+APP_EVENT_TYPE_DECLARE(bench_medium_event);
+APP_EVENT_TYPE_DEFINE(bench_medium_event, NULL, NULL, APP_EVENT_FLAGS_CREATE());
+
+struct bench_large_event {
+	struct app_event_header header;
+
+	uint32_t val[20];
+};
+
+APP_EVENT_TYPE_DECLARE(bench_large_event);
+APP_EVENT_TYPE_DEFINE(bench_large_event, NULL, NULL, APP_EVENT_FLAGS_CREATE());
+
+static void *live_events[LIVE_EVENT_CNT];
+static void *app_bufs[APP_BUF_CNT];
+static uint32_t rnd_state = 1;
+
+
+/* Deterministic pseudo-random sequence ensures that all configurations are fed the same way. */
+static uint32_t rnd_get(void)
+{
+	rnd_state = (rnd_state * 1103515245U) + 12345U;
+
+	return rnd_state >> 8;
+}
+
+static void *event_alloc(uint32_t kind)
+{
+	switch (kind % 3) {
+	case 0:
+		return new_bench_small_event();
+	case 1:
+		return new_bench_medium_event();
+	default:
+		return new_bench_large_event();
+	}
+}
+
+static size_t heap_largest_free_block(void)
+{
+	size_t size = HEAP_PROBE_STEP;
+	void *buf;
+
+	while ((buf = k_malloc(size)) != NULL) {
+		k_free(buf);
+		size += HEAP_PROBE_STEP;
+	}
+
+	return size - HEAP_PROBE_STEP;
+}
+
+ZTEST(app_event_manager_alloc_bench, test_alloc_cost_and_fragmentation)
+{
+	uint64_t alloc_cycles = 0;
+	uint64_t free_cycles = 0;
+	size_t app_buf_cnt = 0;
+	size_t largest_before = heap_largest_free_block();
+
+	timing_init();
+	timing_start();
+
+	for (uint32_t i = 0; i < ITERATION_CNT; i++) {
+		uint32_t rnd = rnd_get();
+		size_t idx = rnd % LIVE_EVENT_CNT;
+		timing_t start;
+		timing_t end;
+
+		if (live_events[idx]) {
+			start = timing_counter_get();
+			app_event_manager_free(live_events[idx]);
+			end = timing_counter_get();
+			free_cycles += timing_cycles_get(&start, &end);
+		}
+
+		start = timing_counter_get();
+		live_events[idx] = event_alloc(rnd / LIVE_EVENT_CNT);
+		end = timing_counter_get();
+		alloc_cycles += timing_cycles_get(&start, &end);
+
+		zassert_not_null(live_events[idx], "Event allocation failed");
+
+		if ((i % APP_BUF_PERIOD) == 0) {
+			app_bufs[app_buf_cnt] = k_malloc(APP_BUF_SIZE);
+			zassert_not_null(app_bufs[app_buf_cnt], "Heap allocation failed");
+			app_buf_cnt++;
+		}
+	}
+
+	for (size_t i = 0; i < ARRAY_SIZE(live_events); i++) {
+		app_event_manager_free(live_events[i]);
+		live_events[i] = NULL;
+	}
+
+	size_t largest_after = heap_largest_free_block();
+
+	for (size_t i = 0; i < app_buf_cnt; i++) {
+		k_free(app_bufs[i]);
+	}
+
+	timing_stop();
+
+	printk("Slab allocator: %s\n",
+	       IS_ENABLED(CONFIG_APP_EVENT_MANAGER_ALLOC_SLAB) ? "enabled" : "disabled");
+	printk("alloc: %u ns/op, free: %u ns/op\n",
+	       (uint32_t)(timing_cycles_to_ns(alloc_cycles) / ITERATION_CNT),
+	       (uint32_t)(timing_cycles_to_ns(free_cycles) / ITERATION_CNT));
+	printk("Largest free heap block: %zu B before, %zu B after (%zu B held by application)\n",
+	       largest_before, largest_after, app_buf_cnt * APP_BUF_SIZE);
+}
+
+ZTEST_SUITE(app_event_manager_alloc_bench, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark measuring the time between submitting an event and delivering it to the listener.
+ *
+ * Bursts of low priority sensor events, which are slow to process, are mixed with latency
+ * critical HID report events. The HID report event is submitted at a different position of
+ * the burst in every round.
+ */
+
+#include <zephyr/ztest.h>
+#include <app_event_manager.h>
+
+#define ROUND_CNT		200
+#define SENSOR_BURST_LEN	8
+#define SENSOR_PROCESS_TIME_US	100
+#define HID_PROCESS_TIME_US	20
+#define ROUND_INTERVAL		K_MSEC(5)
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+#define EVENT_QUEUE_CNT		CONFIG_APP_EVENT_MANAGER_EVENT_QUEUE_COUNT
+#else
+#define EVENT_QUEUE_CNT		1
+#endif
+
+#define HID_EVENT_CNT		ROUND_CNT
+#define SENSOR_EVENT_CNT	(ROUND_CNT * SENSOR_BURST_LEN)
+
+struct bench_hid_event {
+	struct app_event_header header;
+
+	uint32_t seq;
+	uint32_t submit_cycles;
+};
+
+APP_EVENT_TYPE_DECLARE(bench_hid_event);
+APP_EVENT_TYPE_DEFINE(bench_hid_event, NULL, NULL, APP_EVENT_FLAGS_CREATE());
+APP_EVENT_TYPE_QUEUE_ASSIGN(bench_hid_event, EVENT_QUEUE_CNT - 1);
+
+struct bench_sensor_event {
+	struct app_event_header header;
+
+	uint32_t seq;
+	uint32_t submit_cycles;
+};
+
+APP_EVENT_TYPE_DECLARE(bench_sensor_event);
+APP_EVENT_TYPE_DEFINE(bench_sensor_event, NULL, NULL, APP_EVENT_FLAGS_CREATE());
+
+struct latency_stats {
+	uint32_t samples[SENSOR_EVENT_CNT];
+	size_t cnt;
+	bool order_broken;
+};
+
+static struct latency_stats hid_stats;
+static struct latency_stats sensor_stats;
+static K_SEM_DEFINE(bench_done_sem, 0, 1);
+
+
+static void latency_record(struct latency_stats *stats, uint32_t seq, uint32_t submit_cycles)
+{
+	__ASSERT_NO_MSG(stats->cnt < ARRAY_SIZE(stats->samples));
+
+	if (seq != stats->cnt) {
+		stats->order_broken = true;
+	}
+
+	stats->samples[stats->cnt] = k_cycle_get_32() - submit_cycles;
+	stats->cnt++;
+
+	if ((hid_stats.cnt == HID_EVENT_CNT) && (sensor_stats.cnt == SENSOR_EVENT_CNT)) {
+		k_sem_give(&bench_done_sem);
+	}
+}
+
+static uint32_t percentile_us(const uint32_t *sorted, size_t cnt, unsigned int pct)
+{
+	size_t idx = (cnt * pct) / 100;
+
+	if (idx >= cnt) {
+		idx = cnt - 1;
+	}
+
+	return k_cyc_to_us_ceil32(sorted[idx]);
+}
+
+static void latency_report(const char *name, struct latency_stats *stats)
+{
+	uint32_t *s = stats->samples;
+
+	/* Insertion sort is good enough for the number of samples. */
+	for (size_t i = 1; i < stats->cnt; i++) {
+		uint32_t val = s[i];
+		size_t j = i;
+
+		for (; (j > 0) && (s[j - 1] > val); j--) {
+			s[j] = s[j - 1];
+		}
+		s[j] = val;
+	}
+
+	printk("%s: samples=%zu p50=%uus p90=%uus p99=%uus max=%uus\n", name, stats->cnt,
+	       percentile_us(s, stats->cnt, 50), percentile_us(s, stats->cnt, 90),
+	       percentile_us(s, stats->cnt, 99), percentile_us(s, stats->cnt, 100));
+}
+
+static void submit_hid_event(uint32_t seq)
+{
+	struct bench_hid_event *event = new_bench_hid_event();
+
+	event->seq = seq;
+	event->submit_cycles = k_cycle_get_32();
+	APP_EVENT_SUBMIT(event);
+}
+
+static void submit_sensor_event(uint32_t seq)
+{
+	struct bench_sensor_event *event = new_bench_sensor_event();
+
+	event->seq = seq;
+	event->submit_cycles = k_cycle_get_32();
+	APP_EVENT_SUBMIT(event);
+}
+
+static void *bench_setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+	return NULL;
+}
+
+ZTEST(app_event_manager_bench, test_submit_to_delivery_latency)
+{
+	uint32_t sensor_seq = 0;
+
+	for (uint32_t round = 0; round < ROUND_CNT; round++) {
+		size_t hid_pos = round % (SENSOR_BURST_LEN + 1);
+
+		for (size_t i = 0; i <= SENSOR_BURST_LEN; i++) {
+			if (i == hid_pos) {
+				submit_hid_event(round);
+			} else {
+				submit_sensor_event(sensor_seq++);
+			}
+		}
+
+		k_sleep(ROUND_INTERVAL);
+	}
+
+	zassert_ok(k_sem_take(&bench_done_sem, K_SECONDS(10)), "Not all events delivered");
+	zassert_false(hid_stats.order_broken, "HID events delivered out of order");
+	zassert_false(sensor_stats.order_broken, "Sensor events delivered out of order");
+
+	printk("Event queues: %d\n", EVENT_QUEUE_CNT);
+	latency_report("hid_event", &hid_stats);
+	latency_report("sensor_event", &sensor_stats);
+}
+
+ZTEST_SUITE(app_event_manager_bench, NULL, bench_setup, NULL, NULL, NULL);
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_bench_hid_event(aeh)) {
+		const struct bench_hid_event *event = cast_bench_hid_event(aeh);
+
+		k_busy_wait(HID_PROCESS_TIME_US);
+		latency_record(&hid_stats, event->seq, event->submit_cycles);
+		return false;
+	}
+
+	if (is_bench_sensor_event(aeh)) {
+		const struct bench_sensor_event *event = cast_bench_sensor_event(aeh);
+
+		k_busy_wait(SENSOR_PROCESS_TIME_US);
+		latency_record(&sensor_stats, event->seq, event->submit_cycles);
+		return false;
+	}
+
+	zassert_true(false, "Wrong event type received");
+	return false;
+}
+
+APP_EVENT_LISTENER(bench, app_event_handler);
+APP_EVENT_SUBSCRIBE(bench, bench_hid_event);
+APP_EVENT_SUBSCRIBE(bench, bench_sensor_event);
@@ -0,0 +1,208 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of parsing AT notifications.
+ *
+ * Notifications captured from the modem are parsed into parameter lists allocated on the heap and
+ * into parameter lists backed by an arena, and by the LTE link control parsers. The number of heap
+ * allocations and the time of a single parse are reported.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/heap_listener.h>
+#include <modem/at_cmd_parser.h>
+#include <modem/at_params.h>
+
+#include "lte_lc_helpers.h"
+
+#define PARSE_CNT		500
+#define PARAMS_COUNT_MAX	64
+#define ARENA_SIZE		256
+
+struct parse_stats {
+	uint32_t allocs;
+	uint64_t cycles;
+};
+
+static const char cereg_notif[] =
+	"+CEREG: 5,\"4E60\",\"0102E0A1\",7,,,\"11100000\",\"11100000\"\r\n";
+
+static const char ncellmeas_notif[] =
+	"%NCELLMEAS: 0,\"021D140C\",\"24201\",\"0821\",65535,5300,449,50,15,10891,"
+	"5300,194,46,8,0,1650,292,60,27,24,6300,35,-100,-10,24,1650,301,55,22,31,"
+	"8061152878017748\r\n";
+
+static const char ncellmeas_gci_notif[] =
+	"%NCELLMEAS: 0,\"00011B07\",\"26295\",\"00B7\",10,24202,6400,1,58,27,24202,1,2,"
+	"6400,1,53,23,0,6400,2,48,15,12,"
+	"\"00011B08\",\"26295\",\"00B7\",65535,0,6400,2,48,15,24202,0,0,"
+	"\"00011B09\",\"26295\",\"00B7\",65535,0,6400,3,45,12,24202,0,0\r\n";
+
+static const char *const notifs[] = {
+	cereg_notif,
+	ncellmeas_notif,
+	ncellmeas_gci_notif,
+};
+
+/* The system heap is defined by the kernel. */
+extern struct k_heap _system_heap;
+
+static uint32_t alloc_cnt;
+
+static void on_heap_alloc(uintptr_t heap_id, void *mem, size_t bytes)
+{
+	ARG_UNUSED(heap_id);
+	ARG_UNUSED(mem);
+	ARG_UNUSED(bytes);
+
+	alloc_cnt++;
+}
+
+static HEAP_LISTENER_ALLOC_DEFINE(heap_alloc_listener,
+				  HEAP_ID_FROM_POINTER(&_system_heap.heap),
+				  on_heap_alloc);
+
+static void stats_report(const char *name, const struct parse_stats *stats)
+{
+	printk("%s: parses=%d allocs_per_parse=%u avg=%uns\n", name, PARSE_CNT,
+	       stats->allocs / PARSE_CNT,
+	       (uint32_t)(timing_cycles_to_ns(stats->cycles) / PARSE_CNT));
+}
+
+static void parse_heap(const char *notif, struct parse_stats *stats)
+{
+	struct at_param_list list;
+	uint32_t allocs = alloc_cnt;
+	timing_t start = timing_counter_get();
+
+	zassert_ok(at_params_list_init(&list, PARAMS_COUNT_MAX));
+	zassert_ok(at_parser_params_from_str(notif, NULL, &list));
+	at_params_list_free(&list);
+
+	timing_t end = timing_counter_get();
+
+	stats->cycles += timing_cycles_get(&start, &end);
+	stats->allocs += alloc_cnt - allocs;
+}
+
+static void parse_arena(const char *notif, struct parse_stats *stats)
+{
+	static struct at_param params[PARAMS_COUNT_MAX];
+	static uint8_t arena_buf[ARENA_SIZE];
+	struct at_param_arena arena = {
+		.buf = arena_buf,
+		.size = sizeof(arena_buf),
+	};
+	struct at_param_list list;
+	uint32_t allocs = alloc_cnt;
+	timing_t start = timing_counter_get();
+
+	zassert_ok(at_params_list_init_arena(&list, params, ARRAY_SIZE(params), &arena));
+	zassert_ok(at_parser_params_from_str(notif, NULL, &list));
+	at_params_list_free(&list);
+
+	timing_t end = timing_counter_get();
+
+	stats->cycles += timing_cycles_get(&start, &end);
+	stats->allocs += alloc_cnt - allocs;
+}
+
+ZTEST(at_cmd_parser_bench, test_parser_heap_vs_arena)
+{
+	struct parse_stats heap_stats = {0};
+	struct parse_stats arena_stats = {0};
+
+	for (size_t i = 0; i < PARSE_CNT; i++) {
+		parse_heap(notifs[i % ARRAY_SIZE(notifs)], &heap_stats);
+		parse_arena(notifs[i % ARRAY_SIZE(notifs)], &arena_stats);
+	}
+
+	stats_report("parser_heap", &heap_stats);
+	stats_report("parser_arena", &arena_stats);
+
+	zassert_equal(arena_stats.allocs, 0, "Arena parameter list allocated on the heap");
+}
+
+ZTEST(at_cmd_parser_bench, test_lte_lc_parsers)
+{
+	struct parse_stats cereg_stats = {0};
+	struct parse_stats ncellmeas_stats = {0};
+	struct parse_stats gci_stats = {0};
+	enum lte_lc_nw_reg_status reg_status;
+	enum lte_lc_lte_mode lte_mode;
+	struct lte_lc_psm_cfg psm_cfg;
+	struct lte_lc_cell cell;
+	struct lte_lc_ncell ncells[CONFIG_LTE_NEIGHBOR_CELLS_MAX];
+	struct lte_lc_cell gci_cells[4];
+	struct lte_lc_cells_info cells;
+	struct lte_lc_ncellmeas_params ncellmeas_params = {
+		.search_type = LTE_LC_NEIGHBOR_SEARCH_TYPE_GCI_EXTENDED_LIGHT,
+		.gci_count = ARRAY_SIZE(gci_cells),
+	};
+	uint32_t allocs;
+	timing_t start, end;
+
+	for (size_t i = 0; i < PARSE_CNT; i++) {
+		allocs = alloc_cnt;
+		start = timing_counter_get();
+
+		zassert_ok(parse_cereg(cereg_notif, true, &reg_status, &cell, &lte_mode,
+				       &psm_cfg));
+
+		end = timing_counter_get();
+		cereg_stats.cycles += timing_cycles_get(&start, &end);
+		cereg_stats.allocs += alloc_cnt - allocs;
+
+		cells.neighbor_cells = ncells;
+		allocs = alloc_cnt;
+		start = timing_counter_get();
+
+		zassert_ok(parse_ncellmeas(ncellmeas_notif, &cells));
+
+		end = timing_counter_get();
+		ncellmeas_stats.cycles += timing_cycles_get(&start, &end);
+		ncellmeas_stats.allocs += alloc_cnt - allocs;
+		zassert_equal(cells.ncells_count, 4, "Wrong number of neighbor cells");
+
+		cells.neighbor_cells = NULL;
+		cells.gci_cells = gci_cells;
+		allocs = alloc_cnt;
+		start = timing_counter_get();
+
+		zassert_ok(parse_ncellmeas_gci(&ncellmeas_params, ncellmeas_gci_notif, &cells));
+
+		end = timing_counter_get();
+		gci_stats.cycles += timing_cycles_get(&start, &end);
+		gci_stats.allocs += alloc_cnt - allocs;
+		zassert_equal(cells.gci_cells_count, 2, "Wrong number of GCI cells");
+		zassert_equal(cells.ncells_count, 2, "Wrong number of neighbor cells");
+
+		/* The neighbor cells of the serving cell are allocated for the caller. */
+		k_free(cells.neighbor_cells);
+	}
+
+	stats_report("parse_cereg", &cereg_stats);
+	stats_report("parse_ncellmeas", &ncellmeas_stats);
+	stats_report("parse_ncellmeas_gci", &gci_stats);
+
+	zassert_equal(cereg_stats.allocs, 0, "parse_cereg() allocated on the heap");
+	zassert_equal(ncellmeas_stats.allocs, 0, "parse_ncellmeas() allocated on the heap");
+	zassert_equal(gci_stats.allocs, PARSE_CNT,
+		      "parse_ncellmeas_gci() allocated more than the neighbor cells");
+}
+
+static void *bench_setup(void)
+{
+	heap_listener_register(&heap_alloc_listener);
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(at_cmd_parser_bench, NULL, bench_setup, NULL, NULL, NULL);
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark measuring the time of dispatching AT notifications to AT monitors.
+ *
+ * The set of AT monitors mirrors a typical cellular application using the LTE link control,
+ * PDN, SMS, location, date-time and modem battery libraries. A trace of AT notifications
+ * captured during network registration, PDN activation and normal operation is replayed.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <nrf_modem_at.h>
+#include <modem/at_monitor.h>
+
+#define TRACE_PASS_CNT	200
+
+#define MONITOR_LIST(X)						\
+	X(lte_lc_cereg, "+CEREG")				\
+	X(lte_lc_cscon, "+CSCON")				\
+	X(lte_lc_cesq, "%CESQ")					\
+	X(lte_lc_xt3412, "%XT3412")				\
+	X(lte_lc_ncellmeas, "%NCELLMEAS")			\
+	X(lte_lc_xmodemsleep, "%XMODEMSLEEP")			\
+	X(lte_lc_mdmev, "%MDMEV")				\
+	X(lte_lc_cedrxp, "+CEDRXP")				\
+	X(date_time_xtime, "%XTIME")				\
+	X(pdn_cgev, "+CGEV")					\
+	X(pdn_cnec_esm, "+CNEC_ESM")				\
+	X(sms_cmt, "+CMT")					\
+	X(sms_cds, "+CDS")					\
+	X(modem_battery_low, "%XVBATLOWLVL")			\
+	X(location_ncellmeas, "%NCELLMEAS")			\
+	X(location_xmodemsleep, "%XMODEMSLEEP")			\
+	X(app_cereg, "+CEREG")					\
+	X(fota_mdmev, "%MDMEV")					\
+	X(app_pdn_act, "PDN ACT")				\
+	X(modem_trace, ANY)
+
+#define MONITOR_DEFINE(name, filter)				\
+	AT_MONITOR(name##_mon, filter, name##_handler);		\
+	static void name##_handler(const char *notif)		\
+	{							\
+		ARG_UNUSED(notif);				\
+		atomic_inc(&delivered_cnt);			\
+	}
+
+#define MONITOR_FILTER_GET(name, filter) filter,
+
+/* at_monitor_dispatch() is implemented in the AT monitor library. */
+extern void at_monitor_dispatch(const char *notif);
+
+static atomic_t delivered_cnt;
+
+MONITOR_LIST(MONITOR_DEFINE)
+
+static const char *const filters[] = {
+	MONITOR_LIST(MONITOR_FILTER_GET)
+};
+
+static const char *const trace[] = {
+	"%MDMEV: SEARCH STATUS 1\r\n",
+	"+CEREG: 2,\"4E60\",\"0102E0A1\",7\r\n",
+	"%CESQ: 54,2,21,3\r\n",
+	"+CSCON: 1\r\n",
+	"+CEREG: 5,\"4E60\",\"0102E0A1\",7,,,\"11100000\",\"11100000\"\r\n",
+	"%XTIME: \"80\",\"42900121404080\",\"01\"\r\n",
+	"+CGEV: ME PDN ACT 0\r\n",
+	"+CGEV: IPV6 0\r\n",
+	"+CEDRXP: 4,\"1000\",\"0101\",\"1000\"\r\n",
+	"%XT3412: 2400000\r\n",
+	"+CSCON: 0\r\n",
+	"%XMODEMSLEEP: 1,3599999\r\n",
+	"%NCELLMEAS: 0,\"0102E0A1\",\"24201\",\"4E60\",65535,3750,6300,34,22,1234567,1,0,"
+	"6300,35,-100,-10,24,1\r\n",
+	"%MDMEV: PRACH CE-LEVEL 0\r\n",
+	"+CMT: \"+358401234567\",22\r\n0791534850020290040C915348101234560000420190"
+	"41547180034EE7F3\r\n",
+	"+CNEC_ESM: 50,0\r\n",
+	"%CESQ: 49,1,18,2\r\n",
+	"%XVBATLOWLVL: 3300\r\n",
+};
+
+int nrf_modem_at_notif_handler_set(nrf_modem_at_notif_handler_t callback)
+{
+	ARG_UNUSED(callback);
+
+	return 0;
+}
+
+static size_t expected_deliveries_per_pass(void)
+{
+	size_t cnt = 0;
+
+	for (size_t i = 0; i < ARRAY_SIZE(trace); i++) {
+		for (size_t j = 0; j < ARRAY_SIZE(filters); j++) {
+			if (filters[j] == ANY || strstr(trace[i], filters[j])) {
+				cnt++;
+			}
+		}
+	}
+
+	return cnt;
+}
+
+ZTEST(at_monitor_bench, test_dispatch_trace)
+{
+	uint64_t dispatch_cycles = 0;
+
+	atomic_clear(&delivered_cnt);
+
+	timing_init();
+	timing_start();
+
+	for (size_t pass = 0; pass < TRACE_PASS_CNT; pass++) {
+		for (size_t i = 0; i < ARRAY_SIZE(trace); i++) {
+			timing_t start = timing_counter_get();
+
+			at_monitor_dispatch(trace[i]);
+
+			timing_t end = timing_counter_get();
+
+			dispatch_cycles += timing_cycles_get(&start, &end);
+		}
+
+		/* Let the system workqueue deliver the notifications and free the heap. */
+		k_sleep(K_MSEC(1));
+	}
+
+	timing_stop();
+
+	zassert_equal(atomic_get(&delivered_cnt), TRACE_PASS_CNT * expected_deliveries_per_pass(),
+		      "Wrong number of delivered notifications");
+
+	printk("Filter index: %s, monitors: %zu\n",
+	       IS_ENABLED(CONFIG_AT_MONITOR_FILTER_INDEX) ? "enabled" : "disabled",
+	       ARRAY_SIZE(filters));
+	printk("dispatch: notifications=%zu avg=%uns\n", TRACE_PASS_CNT * ARRAY_SIZE(trace),
+	       (uint32_t)(timing_cycles_to_ns(dispatch_cycles) /
+			  (TRACE_PASS_CNT * ARRAY_SIZE(trace))));
+}
+
+ZTEST_SUITE(at_monitor_bench, NULL, NULL, NULL, NULL, NULL);
@@ -0,0 +1,351 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of the data passing between audio modules.
+ *
+ * A pipeline of a decoder, a sample rate converter and a mixer feeds two sinks. The modules only
+ * stand in for the real processing, so the time measured is spent in the audio module framework.
+ * Each frame is released by the test and the end-to-end latency is measured until both sinks
+ * have consumed it. The number of payload copies in the fan-out to the sinks and the peak number
+ * of buffers used by each module are reported.
+ *
+ * The pipeline is run with a thread per module and then by the scheduler thread of a graph. The
+ * number of threads and the stack memory used are reported for both.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <data_fifo.h>
+#include <audio_module/audio_module.h>
+
+#define FRAME_CNT		 200
+#define FRAME_SAMPLES		 480
+#define FRAME_SIZE_MONO		 (FRAME_SAMPLES * sizeof(int16_t))
+#define FRAME_SIZE_STEREO	 (FRAME_SIZE_MONO * 2)
+#define BUFFER_CNT		 4
+#define SINK_CNT		 2
+#define MODULE_STACK_SIZE	 1024
+#define MODULE_PRIORITY		 4
+#define MODULE_CNT		 (3 + SINK_CNT)
+#define GRAPH_STACK_SIZE	 2048
+#define FRAME_TIMEOUT		 K_MSEC(100)
+
+/* Configuration and context shared by all the modules in the benchmark. */
+struct bench_module_configuration {
+	size_t data_size;
+};
+
+struct bench_module_context {
+	struct bench_module_configuration config;
+	/* Payload of the last frame consumed, used by the sinks. */
+	void const *last_data;
+};
+
+static K_SEM_DEFINE(decode_sem, 0, 1);
+static K_SEM_DEFINE(sink_sem, 0, SINK_CNT);
+
+static timing_t frame_start[FRAME_CNT];
+static uint64_t latency_cycles_total;
+static uint64_t latency_cycles_max;
+static uint32_t frame_num;
+
+static struct audio_module_handle decoder, src, mixer, sinks[SINK_CNT];
+static struct bench_module_context decoder_ctx, src_ctx, mixer_ctx, sinks_ctx[SINK_CNT];
+
+K_THREAD_STACK_DEFINE(decoder_stack, MODULE_STACK_SIZE);
+K_THREAD_STACK_DEFINE(src_stack, MODULE_STACK_SIZE);
+K_THREAD_STACK_DEFINE(mixer_stack, MODULE_STACK_SIZE);
+K_THREAD_STACK_ARRAY_DEFINE(sink_stacks, SINK_CNT, MODULE_STACK_SIZE);
+K_THREAD_STACK_DEFINE(graph_stack, GRAPH_STACK_SIZE);
+
+static struct audio_module_graph graph;
+
+DATA_FIFO_DEFINE(src_fifo_rx, BUFFER_CNT, sizeof(struct audio_module_message));
+DATA_FIFO_DEFINE(mixer_fifo_rx, BUFFER_CNT, sizeof(struct audio_module_message));
+DATA_FIFO_DEFINE(sink_0_fifo_rx, BUFFER_CNT, sizeof(struct audio_module_message));
+DATA_FIFO_DEFINE(sink_1_fifo_rx, BUFFER_CNT, sizeof(struct audio_module_message));
+
+K_MEM_SLAB_DEFINE_STATIC(decoder_slab, FRAME_SIZE_MONO, BUFFER_CNT, 4);
+K_MEM_SLAB_DEFINE_STATIC(src_slab, FRAME_SIZE_MONO, BUFFER_CNT, 4);
+K_MEM_SLAB_DEFINE_STATIC(mixer_slab, FRAME_SIZE_STEREO, BUFFER_CNT, 4);
+
+static struct data_fifo *const sink_fifos_rx[SINK_CNT] = {&sink_0_fifo_rx, &sink_1_fifo_rx};
+
+static struct bench_module_context *context_get(struct audio_module_handle_private *handle)
+{
+	return (struct bench_module_context *)((struct audio_module_handle *)handle)->context;
+}
+
+static int bench_configuration_set(struct audio_module_handle_private *handle,
+				   struct audio_module_configuration const *const configuration)
+{
+	memcpy(&context_get(handle)->config, configuration,
+	       sizeof(struct bench_module_configuration));
+
+	return 0;
+}
+
+static int bench_configuration_get(struct audio_module_handle_private const *const handle,
+				   struct audio_module_configuration *configuration)
+{
+	struct bench_module_context *ctx = (struct bench_module_context *)(
+		(struct audio_module_handle const *)handle)->context;
+
+	memcpy(configuration, &ctx->config, sizeof(struct bench_module_configuration));
+
+	return 0;
+}
+
+/* Waits for the test to release a frame and tags it with the frame number. */
+static int decoder_data_process(struct audio_module_handle_private *handle,
+				struct audio_data const *const audio_data_rx,
+				struct audio_data *audio_data_tx)
+{
+	int16_t *samples = audio_data_tx->data;
+
+	/* Time out to let a graph stop when no more frames are released */
+	if (k_sem_take(&decode_sem, FRAME_TIMEOUT)) {
+		return -EAGAIN;
+	}
+
+	samples[0] = (int16_t)frame_num;
+	for (size_t i = 1; i < FRAME_SAMPLES; i++) {
+		samples[i] = (int16_t)i;
+	}
+
+	memset(&audio_data_tx->meta, 0, sizeof(struct audio_metadata));
+	audio_data_tx->meta.data_coding = PCM;
+	audio_data_tx->meta.sample_rate_hz = 48000;
+	audio_data_tx->meta.bits_per_sample = 16;
+	audio_data_tx->meta.carried_bits_pr_sample = 16;
+	audio_data_tx->meta.locations = 0x1;
+	audio_data_tx->data_size = FRAME_SIZE_MONO;
+
+	return 0;
+}
+
+/* Stands in for a 48 kHz to 48 kHz conversion. */
+static int src_data_process(struct audio_module_handle_private *handle,
+			    struct audio_data const *const audio_data_rx,
+			    struct audio_data *audio_data_tx)
+{
+	memcpy(audio_data_tx->data, audio_data_rx->data, audio_data_rx->data_size);
+	memcpy(&audio_data_tx->meta, &audio_data_rx->meta, sizeof(struct audio_metadata));
+	audio_data_tx->data_size = audio_data_rx->data_size;
+
+	return 0;
+}
+
+/* Mixes the mono input into both channels of the stereo output. */
+static int mixer_data_process(struct audio_module_handle_private *handle,
+			      struct audio_data const *const audio_data_rx,
+			      struct audio_data *audio_data_tx)
+{
+	int16_t const *in = audio_data_rx->data;
+	int16_t *out = audio_data_tx->data;
+
+	for (size_t i = 0; i < audio_data_rx->data_size / sizeof(int16_t); i++) {
+		out[i * 2] = in[i];
+		out[i * 2 + 1] = in[i];
+	}
+
+	memcpy(&audio_data_tx->meta, &audio_data_rx->meta, sizeof(struct audio_metadata));
+	audio_data_tx->meta.locations = 0x3;
+	audio_data_tx->data_size = audio_data_rx->data_size * 2;
+
+	return 0;
+}
+
+static int sink_data_process(struct audio_module_handle_private *handle,
+			     struct audio_data const *const audio_data_rx,
+			     struct audio_data *audio_data_tx)
+{
+	int16_t const *samples = audio_data_rx->data;
+	timing_t end = timing_counter_get();
+	uint64_t cycles = timing_cycles_get(&frame_start[(uint16_t)samples[0]], &end);
+
+	/* The latency of a frame is given by the last sink to consume it */
+	if (k_sem_count_get(&sink_sem) == SINK_CNT - 1) {
+		latency_cycles_total += cycles;
+		latency_cycles_max = MAX(latency_cycles_max, cycles);
+	}
+
+	context_get(handle)->last_data = audio_data_rx->data;
+
+	k_sem_give(&sink_sem);
+
+	return 0;
+}
+
+static const struct audio_module_functions decoder_functions = {
+	.configuration_set = bench_configuration_set,
+	.configuration_get = bench_configuration_get,
+	.data_process = decoder_data_process};
+
+static const struct audio_module_functions src_functions = {
+	.configuration_set = bench_configuration_set,
+	.configuration_get = bench_configuration_get,
+	.data_process = src_data_process};
+
+static const struct audio_module_functions mixer_functions = {
+	.configuration_set = bench_configuration_set,
+	.configuration_get = bench_configuration_get,
+	.data_process = mixer_data_process};
+
+static const struct audio_module_functions sink_functions = {
+	.configuration_set = bench_configuration_set,
+	.configuration_get = bench_configuration_get,
+	.data_process = sink_data_process};
+
+static struct audio_module_description decoder_description = {
+	.name = "Decoder", .type = AUDIO_MODULE_TYPE_INPUT, .functions = &decoder_functions};
+static struct audio_module_description src_description = {
+	.name = "SRC", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &src_functions};
+static struct audio_module_description mixer_description = {
+	.name = "Mixer", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &mixer_functions};
+static struct audio_module_description sink_description = {
+	.name = "Sink", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &sink_functions};
+
+static void module_open(struct audio_module_description *description, k_thread_stack_t *stack,
+			struct data_fifo *msg_rx, struct k_mem_slab *data_slab, size_t data_size,
+			char const *name, struct bench_module_context *ctx,
+			struct audio_module_handle *handle, struct audio_module_graph *graph)
+{
+	struct bench_module_configuration config = {.data_size = data_size};
+	struct audio_module_parameters parameters = {
+		.description = description,
+		.thread = {.stack = stack,
+			   .stack_size = MODULE_STACK_SIZE,
+			   .priority = MODULE_PRIORITY,
+			   .msg_rx = msg_rx,
+			   .data_slab = data_slab,
+			   .data_size = data_size},
+		.graph = graph};
+
+	/* A module run in a graph needs neither a thread nor an RX FIFO */
+	if (graph != NULL) {
+		parameters.thread.stack = NULL;
+		parameters.thread.stack_size = 0;
+		parameters.thread.msg_rx = NULL;
+	} else if (msg_rx != NULL) {
+		zassert_ok(data_fifo_init(msg_rx));
+	}
+
+	memset(handle, 0, sizeof(struct audio_module_handle));
+
+	zassert_ok(audio_module_open(&parameters, (struct audio_module_configuration *)&config,
+				     name, (struct audio_module_context *)ctx, handle));
+}
+
+static void pipeline_run(struct audio_module_graph *graph)
+{
+	struct audio_module_handle *handles[MODULE_CNT] = {&decoder, &src, &mixer, &sinks[0],
+							   &sinks[1]};
+	uint32_t copies = 0;
+
+	latency_cycles_total = 0;
+	latency_cycles_max = 0;
+
+	module_open(&decoder_description, decoder_stack, NULL, &decoder_slab, FRAME_SIZE_MONO,
+		    "decoder", &decoder_ctx, &decoder, graph);
+	module_open(&src_description, src_stack, &src_fifo_rx, &src_slab, FRAME_SIZE_MONO, "src",
+		    &src_ctx, &src, graph);
+	module_open(&mixer_description, mixer_stack, &mixer_fifo_rx, &mixer_slab,
+		    FRAME_SIZE_STEREO, "mixer", &mixer_ctx, &mixer, graph);
+
+	for (int i = 0; i < SINK_CNT; i++) {
+		module_open(&sink_description, sink_stacks[i], sink_fifos_rx[i], NULL, 0,
+			    i == 0 ? "sink 0" : "sink 1", &sinks_ctx[i], &sinks[i], graph);
+	}
+
+	zassert_ok(audio_module_connect(&decoder, &src, false));
+	zassert_ok(audio_module_connect(&src, &mixer, false));
+
+	for (int i = 0; i < SINK_CNT; i++) {
+		zassert_ok(audio_module_connect(&mixer, &sinks[i], false));
+	}
+
+	for (int i = MODULE_CNT - 1; i >= 0; i--) {
+		zassert_ok(audio_module_start(handles[i]));
+	}
+
+	if (graph != NULL) {
+		zassert_ok(audio_module_graph_start(graph));
+	}
+
+	for (frame_num = 0; frame_num < FRAME_CNT; frame_num++) {
+		frame_start[frame_num] = timing_counter_get();
+		k_sem_give(&decode_sem);
+
+		for (int i = 0; i < SINK_CNT; i++) {
+			zassert_ok(k_sem_take(&sink_sem, FRAME_TIMEOUT), "Frame %d not received",
+				   frame_num);
+		}
+
+		/* Each sink must have been given the same payload */
+		if (sinks_ctx[0].last_data != sinks_ctx[1].last_data) {
+			copies++;
+		}
+	}
+
+	/* Let the sinks release the last frame */
+	k_sleep(K_MSEC(10));
+
+	printk("%s: threads=%d stack_bytes=%d\n", graph != NULL ? "graph" : "thread per module",
+	       graph != NULL ? 1 : MODULE_CNT,
+	       graph != NULL ? GRAPH_STACK_SIZE : MODULE_CNT * MODULE_STACK_SIZE);
+	printk("frames=%d copies_per_frame=%d latency_ns=%llu latency_max_ns=%llu\n", FRAME_CNT,
+	       copies / FRAME_CNT, timing_cycles_to_ns(latency_cycles_total / FRAME_CNT),
+	       timing_cycles_to_ns(latency_cycles_max));
+	printk("buffers_max_used: decoder=%u src=%u mixer=%u\n",
+	       k_mem_slab_max_used_get(&decoder_slab), k_mem_slab_max_used_get(&src_slab),
+	       k_mem_slab_max_used_get(&mixer_slab));
+
+	zassert_equal(copies, 0, "The fan-out copied the payload for %d frames", copies);
+	zassert_equal(k_mem_slab_num_used_get(&decoder_slab), 0, "Decoder buffers not released");
+	zassert_equal(k_mem_slab_num_used_get(&src_slab), 0, "SRC buffers not released");
+	zassert_equal(k_mem_slab_num_used_get(&mixer_slab), 0, "Mixer buffers not released");
+
+	if (graph != NULL) {
+		struct audio_module_graph_stats stats;
+
+		zassert_ok(audio_module_graph_stop(graph, K_MSEC(500)));
+		zassert_ok(audio_module_graph_stats_get(graph, NULL, &stats));
+
+		printk("graph: frame_time_us=%llu frame_time_max_us=%u\n",
+		       stats.process_time_total_us / stats.frame_count,
+		       stats.process_time_max_us);
+	}
+
+	for (int i = 0; i < MODULE_CNT; i++) {
+		zassert_ok(audio_module_stop(handles[i]));
+		zassert_ok(audio_module_close(handles[i]));
+	}
+}
+
+ZTEST(audio_module_bench, test_pipeline)
+{
+	pipeline_run(NULL);
+}
+
+ZTEST(audio_module_bench, test_pipeline_graph)
+{
+	zassert_ok(audio_module_graph_init(&graph, graph_stack, GRAPH_STACK_SIZE, MODULE_PRIORITY,
+					   0));
+
+	pipeline_run(&graph);
+}
+
+static void *bench_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(audio_module_bench, NULL, bench_setup, NULL, NULL, NULL);
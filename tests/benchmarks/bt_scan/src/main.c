@@ -0,0 +1,450 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of the processing of advertising reports by the scan library.
+ *
+ * Synthetic advertising reports are fed to the scan library through a mock of the Bluetooth
+ * host. A quarter of the reports come from devices on the address filter, a quarter from devices
+ * on the blocklist, a quarter from devices that used up their connection attempts and the rest
+ * from unknown devices. The time per report is measured with a growing number of devices on
+ * each of the lists.
+ *
+ * The advertising data filters are measured with reports that carry a name, a 128-bit UUID and
+ * manufacturer data. A quarter of the reports match one of the name filters, a quarter one of the
+ * UUID filters, a quarter one of the manufacturer data filters and the rest match none of them.
+ *
+ * The report cache is measured with a fixed set of devices advertising the same data in every
+ * round of reports. The reports of the devices that match none of the filters are served from the
+ * cache after the first round.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/byteorder.h>
+#include <bluetooth/scan.h>
+
+#include "bt_mock.h"
+
+#define REPORT_CNT	20000
+#define LIST_LEN_MAX	1024
+#define FILTER_CNT_MAX	256
+
+/* Company identifier followed by a model number. */
+#define MANUFACTURER_DATA_FILTER_LEN	4
+#define COMPANY_ID			0x0059
+
+#define NAME_LEN	11
+
+#define DEVICE_CNT_MAX	CONFIG_BT_SCAN_REPORT_CACHE_SIZE
+
+enum device_list {
+	DEVICE_ACCEPTED,
+	DEVICE_BLOCKED,
+	DEVICE_ATTEMPTS_EXCEEDED,
+	DEVICE_UNKNOWN,
+	DEVICE_LIST_CNT
+};
+
+enum adv_filter {
+	ADV_FILTER_NAME,
+	ADV_FILTER_UUID,
+	ADV_FILTER_MANUFACTURER_DATA,
+	ADV_FILTER_NONE,
+	ADV_FILTER_CNT
+};
+
+static const size_t list_lens[] = {4, 64, LIST_LEN_MAX};
+static const size_t filter_cnts[] = {4, 64, FILTER_CNT_MAX};
+static const size_t device_cnts[] = {16, 64, DEVICE_CNT_MAX};
+
+static uint32_t match_cnt;
+static uint32_t no_match_cnt;
+
+static uint8_t adv_data[] = {
+	0x02, BT_DATA_FLAGS, BT_LE_AD_GENERAL | BT_LE_AD_NO_BREDR,
+	0x08, BT_DATA_NAME_COMPLETE, 'S', 'e', 'n', 's', 'o', 'r', '1',
+};
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	match_cnt++;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	no_match_cnt++;
+}
+
+BT_SCAN_CB_INIT(scan_cb, scan_filter_match, scan_filter_no_match, NULL, NULL);
+
+static void addr_get(enum device_list list, uint32_t i, bt_addr_le_t *addr)
+{
+	addr->type = BT_ADDR_LE_RANDOM;
+	addr->a.val[0] = i & 0xFF;
+	addr->a.val[1] = (i >> 8) & 0xFF;
+	addr->a.val[2] = list;
+	addr->a.val[3] = 0x5A;
+	addr->a.val[4] = 0xA5;
+	/* Static random address */
+	addr->a.val[5] = 0xC0;
+}
+
+/* Linear congruential generator, so every run feeds the same reports */
+static uint32_t rand_next(uint32_t *state)
+{
+	*state = *state * 1664525U + 1013904223U;
+
+	return *state >> 8;
+}
+
+static void lists_fill(size_t list_len)
+{
+	bt_addr_le_t addr;
+	struct bt_conn conn;
+
+	bt_scan_filter_remove_all();
+	bt_scan_blocklist_clear();
+	bt_scan_conn_attempts_filter_clear();
+
+	for (uint32_t i = 0; i < list_len; i++) {
+		addr_get(DEVICE_ACCEPTED, i, &addr);
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_ADDR, &addr));
+
+		addr_get(DEVICE_BLOCKED, i, &addr);
+		zassert_ok(bt_scan_blocklist_device_add(&addr));
+
+		/* Every connection attempt ends with a disconnection */
+		addr_get(DEVICE_ATTEMPTS_EXCEEDED, i, &conn.dst);
+		bt_mock_connected(&conn, 0);
+
+		for (int j = 0; j < CONFIG_BT_SCAN_CONN_ATTEMPTS_COUNT; j++) {
+			bt_mock_disconnected(&conn, BT_HCI_ERR_REMOTE_USER_TERM_CONN);
+		}
+	}
+
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_ADDR_FILTER, false));
+}
+
+static void name_get(bool known, uint32_t i, char *name)
+{
+	snprintk(name, NAME_LEN + 1, "%s-%04u", known ? "Sensor" : "Beacon",
+		 (unsigned int)(i % 10000));
+}
+
+static void uuid_get(bool known, uint32_t i, struct bt_uuid_128 *uuid)
+{
+	*uuid = (struct bt_uuid_128)BT_UUID_INIT_128(
+		BT_UUID_128_ENCODE(0x00000000, 0xb5a3, 0xf393, 0xe0a9, 0xe50e24dcca9e));
+
+	sys_put_le32((known ? 0x6e400000 : 0x7e400000) + i, &uuid->val[12]);
+}
+
+static void manufacturer_data_get(bool known, uint32_t i, uint8_t *data)
+{
+	sys_put_le16(COMPANY_ID, &data[0]);
+	sys_put_le16((known ? 0x1000 : 0x2000) + i, &data[2]);
+}
+
+static void adv_filters_fill(size_t filter_cnt)
+{
+	char name[NAME_LEN + 1];
+	struct bt_uuid_128 uuid;
+	uint8_t data[MANUFACTURER_DATA_FILTER_LEN];
+	struct bt_scan_manufacturer_data manufacturer_data = {
+		.data = data,
+		.data_len = sizeof(data),
+	};
+
+	bt_scan_filter_remove_all();
+	bt_scan_blocklist_clear();
+	bt_scan_conn_attempts_filter_clear();
+
+	for (uint32_t i = 0; i < filter_cnt; i++) {
+		name_get(true, i, name);
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, name));
+
+		uuid_get(true, i, &uuid);
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &uuid));
+
+		manufacturer_data_get(true, i, data);
+		zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA,
+					      &manufacturer_data));
+	}
+
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER | BT_SCAN_UUID_FILTER |
+					 BT_SCAN_MANUFACTURER_DATA_FILTER, false));
+}
+
+/* Build a report with a name, a UUID and manufacturer data, of which at most one is known to
+ * the filters.
+ */
+static size_t adv_data_build(uint8_t *buf, enum adv_filter filter, uint32_t i)
+{
+	struct bt_uuid_128 uuid;
+	char name[NAME_LEN + 1];
+	size_t len = 0;
+
+	buf[len++] = NAME_LEN + 1;
+	buf[len++] = BT_DATA_NAME_COMPLETE;
+	name_get(filter == ADV_FILTER_NAME, i, name);
+	memcpy(&buf[len], name, NAME_LEN);
+	len += NAME_LEN;
+
+	buf[len++] = sizeof(uuid.val) + 1;
+	buf[len++] = BT_DATA_UUID128_ALL;
+	uuid_get(filter == ADV_FILTER_UUID, i, &uuid);
+	memcpy(&buf[len], uuid.val, sizeof(uuid.val));
+	len += sizeof(uuid.val);
+
+	/* Payload after the company identifier and the model number. */
+	buf[len++] = MANUFACTURER_DATA_FILTER_LEN + 2 + 1;
+	buf[len++] = BT_DATA_MANUFACTURER_DATA;
+	manufacturer_data_get(filter == ADV_FILTER_MANUFACTURER_DATA, i, &buf[len]);
+	len += MANUFACTURER_DATA_FILTER_LEN;
+	buf[len++] = i & 0xFF;
+	buf[len++] = 0x64;
+
+	return len;
+}
+
+static uint32_t hit_count_sum(size_t filter_cnt)
+{
+	static const enum bt_scan_filter_type types[] = {
+		BT_SCAN_FILTER_TYPE_NAME,
+		BT_SCAN_FILTER_TYPE_UUID,
+		BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA,
+	};
+	uint32_t sum = 0;
+	uint32_t hit_cnt;
+
+	for (size_t i = 0; i < ARRAY_SIZE(types); i++) {
+		for (uint16_t j = 0; j < filter_cnt; j++) {
+			zassert_ok(bt_scan_filter_hit_count_get(types[i], j, &hit_cnt));
+			sum += hit_cnt;
+		}
+
+		zassert_equal(bt_scan_filter_hit_count_get(types[i], filter_cnt, &hit_cnt),
+			      -EINVAL, "Hit count of a missing filter");
+	}
+
+	return sum;
+}
+
+static void bench_run(size_t list_len)
+{
+	struct bt_le_scan_recv_info info = {
+		.adv_type = BT_GAP_ADV_TYPE_ADV_IND,
+		.adv_props = BT_GAP_ADV_PROP_CONNECTABLE | BT_GAP_ADV_PROP_SCANNABLE,
+		.rssi = -60,
+	};
+	struct net_buf_simple ad = {
+		.data = adv_data,
+		.len = sizeof(adv_data),
+		.size = sizeof(adv_data),
+		.__buf = adv_data,
+	};
+	uint32_t report_cnt[DEVICE_LIST_CNT] = {0};
+	uint32_t rand_state = 1;
+	uint64_t cycles = 0;
+	timing_t start, end;
+	bt_addr_le_t addr;
+	uint64_t ns;
+
+	lists_fill(list_len);
+
+	match_cnt = 0;
+	no_match_cnt = 0;
+	info.addr = &addr;
+
+	for (uint32_t i = 0; i < REPORT_CNT; i++) {
+		uint32_t rand = rand_next(&rand_state);
+		enum device_list list = rand % DEVICE_LIST_CNT;
+
+		addr_get(list, (rand / DEVICE_LIST_CNT) % list_len, &addr);
+		report_cnt[list]++;
+
+		start = timing_counter_get();
+		bt_mock_scan_recv(&info, &ad);
+		end = timing_counter_get();
+		cycles += timing_cycles_get(&start, &end);
+	}
+
+	ns = timing_cycles_to_ns(cycles);
+
+	printk("list_len=%zu reports=%d ns_per_report=%llu reports_per_second=%llu\n", list_len,
+	       REPORT_CNT, ns / REPORT_CNT, (uint64_t)REPORT_CNT * NSEC_PER_SEC / MAX(ns, 1));
+
+	/* Reports from the blocked devices and the devices out of connection attempts are
+	 * dropped before the callbacks.
+	 */
+	zassert_equal(match_cnt, report_cnt[DEVICE_ACCEPTED], "Wrong number of filter matches");
+	zassert_equal(no_match_cnt, report_cnt[DEVICE_UNKNOWN], "Wrong number of filter no matches");
+}
+
+ZTEST(bt_scan_bench, test_address_lists)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(list_lens); i++) {
+		bench_run(list_lens[i]);
+	}
+}
+
+static void adv_filters_bench_run(size_t filter_cnt)
+{
+	struct bt_le_scan_recv_info info = {
+		.adv_type = BT_GAP_ADV_TYPE_EXT_ADV,
+		.adv_props = BT_GAP_ADV_PROP_CONNECTABLE | BT_GAP_ADV_PROP_EXT_ADV,
+		.rssi = -60,
+	};
+	uint8_t buf[64];
+	struct net_buf_simple ad = {
+		.size = sizeof(buf),
+		.__buf = buf,
+	};
+	uint32_t report_cnt[ADV_FILTER_CNT] = {0};
+	uint32_t rand_state = 1;
+	uint64_t cycles = 0;
+	timing_t start, end;
+	bt_addr_le_t addr;
+	uint64_t ns;
+
+	adv_filters_fill(filter_cnt);
+
+	match_cnt = 0;
+	no_match_cnt = 0;
+	info.addr = &addr;
+
+	for (uint32_t i = 0; i < REPORT_CNT; i++) {
+		uint32_t rand = rand_next(&rand_state);
+		enum adv_filter filter = rand % ADV_FILTER_CNT;
+
+		addr_get(DEVICE_UNKNOWN, rand % LIST_LEN_MAX, &addr);
+		ad.data = buf;
+		ad.len = adv_data_build(buf, filter, (rand / ADV_FILTER_CNT) % filter_cnt);
+		report_cnt[filter]++;
+
+		start = timing_counter_get();
+		bt_mock_scan_recv(&info, &ad);
+		end = timing_counter_get();
+		cycles += timing_cycles_get(&start, &end);
+	}
+
+	ns = timing_cycles_to_ns(cycles);
+
+	printk("filter_cnt=%zu reports=%d ns_per_report=%llu reports_per_second=%llu\n",
+	       filter_cnt, REPORT_CNT, ns / REPORT_CNT,
+	       (uint64_t)REPORT_CNT * NSEC_PER_SEC / MAX(ns, 1));
+
+	zassert_equal(no_match_cnt, report_cnt[ADV_FILTER_NONE], "Wrong number of filter no matches");
+	zassert_equal(match_cnt, REPORT_CNT - report_cnt[ADV_FILTER_NONE],
+		      "Wrong number of filter matches");
+
+	/* Each of the reports matching is counted by exactly one filter. */
+	zassert_equal(hit_count_sum(filter_cnt), match_cnt, "Wrong filter hit counts");
+}
+
+ZTEST(bt_scan_bench, test_adv_filters)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(filter_cnts); i++) {
+		adv_filters_bench_run(filter_cnts[i]);
+	}
+}
+
+static void report_cache_bench_run(size_t device_cnt)
+{
+	struct bt_le_scan_recv_info info = {
+		.adv_type = BT_GAP_ADV_TYPE_EXT_ADV,
+		.adv_props = BT_GAP_ADV_PROP_CONNECTABLE | BT_GAP_ADV_PROP_EXT_ADV,
+		.rssi = -60,
+	};
+	uint8_t buf[64];
+	struct net_buf_simple ad = {
+		.size = sizeof(buf),
+		.__buf = buf,
+	};
+	const uint32_t round_cnt = REPORT_CNT / device_cnt;
+	struct bt_scan_report_cache_stats stats;
+	uint32_t device_no_match_cnt = 0;
+	uint64_t miss_cycles = 0;
+	uint64_t cycles = 0;
+	timing_t start, end;
+	bt_addr_le_t addr;
+	uint64_t miss_ns;
+	uint64_t ns;
+
+	adv_filters_fill(FILTER_CNT_MAX);
+	bt_scan_report_cache_clear();
+
+	match_cnt = 0;
+	no_match_cnt = 0;
+	info.addr = &addr;
+
+	for (uint32_t round = 0; round < round_cnt; round++) {
+		for (uint32_t i = 0; i < device_cnt; i++) {
+			enum adv_filter filter = i % ADV_FILTER_CNT;
+
+			addr_get(DEVICE_UNKNOWN, i, &addr);
+			ad.data = buf;
+			ad.len = adv_data_build(buf, filter, i % FILTER_CNT_MAX);
+
+			if ((round == 0) && (filter == ADV_FILTER_NONE)) {
+				device_no_match_cnt++;
+			}
+
+			start = timing_counter_get();
+			bt_mock_scan_recv(&info, &ad);
+			end = timing_counter_get();
+
+			if (round == 0) {
+				miss_cycles += timing_cycles_get(&start, &end);
+			} else {
+				cycles += timing_cycles_get(&start, &end);
+			}
+		}
+	}
+
+	miss_ns = timing_cycles_to_ns(miss_cycles);
+	ns = timing_cycles_to_ns(cycles);
+
+	zassert_ok(bt_scan_report_cache_stats_get(&stats));
+
+	printk("device_cnt=%zu rounds=%u miss_ns_per_report=%llu ns_per_report=%llu "
+	       "hits=%u misses=%u evictions=%u\n",
+	       device_cnt, round_cnt, miss_ns / device_cnt,
+	       ns / (device_cnt * (round_cnt - 1)), stats.hits, stats.misses, stats.evictions);
+
+	zassert_equal(no_match_cnt, round_cnt * device_no_match_cnt,
+		      "Wrong number of filter no matches");
+	zassert_equal(match_cnt, round_cnt * (device_cnt - device_no_match_cnt),
+		      "Wrong number of filter matches");
+
+	/* Only the reports matching none of the filters are served from the cache. */
+	zassert_equal(stats.hits, (round_cnt - 1) * device_no_match_cnt, "Wrong cache hits");
+	zassert_equal(stats.misses, round_cnt * device_cnt - stats.hits, "Wrong cache misses");
+	zassert_equal(stats.evictions, 0, "Unexpected cache evictions");
+}
+
+ZTEST(bt_scan_bench, test_report_cache)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(device_cnts); i++) {
+		report_cache_bench_run(device_cnts[i]);
+	}
+}
+
+static void *bench_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&scan_cb);
+
+	return NULL;
+}
+
+ZTEST_SUITE(bt_scan_bench, NULL, bench_setup, NULL, NULL, NULL);
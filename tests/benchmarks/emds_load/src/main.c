@@ -0,0 +1,182 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of loading the emergency data storage entries at boot.
+ *
+ * The entries are written to a flash simulator in the layout left by emds_store(). The file
+ * system is then initialized and every entry is read back in the order it was stored, as done by
+ * emds_load(). The flash reads and the time are measured separately for the initialization, which
+ * scans the allocation table, and for the entry reads.
+ *
+ * The benchmark is also built with CONFIG_EMDS_FLASH_INDEX_SIZE=0, which walks the allocation
+ * table for every entry read.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/drivers/flash.h>
+#include <zephyr/stats/stats.h>
+#include <zephyr/sys/crc.h>
+#include <emds_flash.h>
+
+#define SIM_FLASH_NODE		DT_NODELABEL(flash_sim0)
+#define SIM_FLASH_SIZE		DT_REG_SIZE(SIM_FLASH_NODE)
+#define SIM_FLASH_SECTOR_SIZE	DT_PROP(SIM_FLASH_NODE, erase_block_size)
+#define SIM_FLASH_BLOCK_SIZE	DT_PROP(SIM_FLASH_NODE, write_block_size)
+
+#define ENTRY_LEN	16
+#define ENTRY_CNT_MAX	128
+
+/* Allocation Table Entry */
+struct bench_ate {
+	uint16_t id;       /* data id */
+	uint16_t offset;   /* data offset within sector */
+	uint16_t len;      /* data len within sector */
+	uint8_t crc8_data; /* crc8 check of the entry */
+	uint8_t crc8;      /* crc8 check of the entry */
+} __packed;
+
+BUILD_ASSERT(ENTRY_CNT_MAX * (ENTRY_LEN + sizeof(struct bench_ate)) < SIM_FLASH_SIZE,
+	     "The entries do not fit in the flash simulator");
+
+static const struct device *const flash_dev = DEVICE_DT_GET(DT_PARENT(SIM_FLASH_NODE));
+static const size_t entry_cnts[] = {8, 32, ENTRY_CNT_MAX};
+
+static struct emds_fs fs;
+
+static inline size_t align_size(size_t len)
+{
+	return (len + (SIM_FLASH_BLOCK_SIZE - 1U)) & ~(SIM_FLASH_BLOCK_SIZE - 1U);
+}
+
+static int flash_read_calls_cb(struct stats_hdr *hdr, void *arg, const char *name, uint16_t off)
+{
+	if (strcmp(name, "flash_read_calls") == 0) {
+		*(uint32_t *)arg = *(uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static uint32_t flash_read_calls_get(void)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+	uint32_t calls = 0;
+
+	zassert_not_null(hdr, "No flash simulator statistics");
+	zassert_ok(stats_walk(hdr, flash_read_calls_cb, &calls));
+
+	return calls;
+}
+
+static void entry_data_get(uint16_t id, uint8_t *data)
+{
+	for (size_t i = 0; i < ENTRY_LEN; i++) {
+		data[i] = id + i;
+	}
+}
+
+/* Write the entries as emds_store() does, the data from the start of the flash and the
+ * allocation table entries from its end.
+ */
+static void entries_write(size_t entry_cnt)
+{
+	uint32_t ate_addr = SIM_FLASH_SIZE - align_size(sizeof(struct bench_ate));
+	uint32_t data_addr = 0;
+	uint8_t data[ENTRY_LEN];
+
+	zassert_ok(flash_erase(flash_dev, 0, SIM_FLASH_SIZE));
+
+	for (uint16_t id = 0; id < entry_cnt; id++) {
+		struct bench_ate entry = {
+			.id = id,
+			.offset = data_addr,
+			.len = sizeof(data),
+		};
+
+		entry_data_get(id, data);
+		entry.crc8_data = crc8_ccitt(0xff, data, sizeof(data));
+		entry.crc8 = crc8_ccitt(0xff, &entry, offsetof(struct bench_ate, crc8));
+
+		zassert_ok(flash_write(flash_dev, data_addr, data, sizeof(data)));
+		zassert_ok(flash_write(flash_dev, ate_addr, &entry, sizeof(entry)));
+
+		data_addr += align_size(sizeof(data));
+		ate_addr -= align_size(sizeof(entry));
+	}
+}
+
+static void load_bench_run(size_t entry_cnt)
+{
+	uint8_t expected[ENTRY_LEN];
+	uint8_t data[ENTRY_LEN];
+	uint32_t init_reads;
+	uint32_t load_reads;
+	uint64_t load_cycles = 0;
+	uint64_t init_cycles;
+	timing_t start, end;
+	uint32_t reads;
+
+	entries_write(entry_cnt);
+
+	memset(&fs, 0, sizeof(fs));
+	fs.offset = 0;
+	fs.sector_size = SIM_FLASH_SECTOR_SIZE;
+	fs.sector_cnt = SIM_FLASH_SIZE / SIM_FLASH_SECTOR_SIZE;
+	fs.flash_dev = flash_dev;
+
+	reads = flash_read_calls_get();
+	start = timing_counter_get();
+	zassert_ok(emds_flash_init(&fs), "Error when initializing");
+	end = timing_counter_get();
+	init_cycles = timing_cycles_get(&start, &end);
+	init_reads = flash_read_calls_get() - reads;
+
+	reads = flash_read_calls_get();
+
+	for (uint16_t id = 0; id < entry_cnt; id++) {
+		ssize_t len;
+
+		start = timing_counter_get();
+		len = emds_flash_read(&fs, id, data, sizeof(data));
+		end = timing_counter_get();
+		load_cycles += timing_cycles_get(&start, &end);
+
+		zassert_equal(len, sizeof(data), "Could not read entry %u", id);
+		entry_data_get(id, expected);
+		zassert_mem_equal(data, expected, sizeof(data), "Wrong data in entry %u", id);
+	}
+
+	load_reads = flash_read_calls_get() - reads;
+
+	printk("entries=%zu init_flash_reads=%u init_us=%llu load_flash_reads=%u load_us=%llu\n",
+	       entry_cnt, init_reads, timing_cycles_to_ns(init_cycles) / NSEC_PER_USEC,
+	       load_reads, timing_cycles_to_ns(load_cycles) / NSEC_PER_USEC);
+
+	/* With the index, each entry is read without reading its allocation table entry. */
+	if (entry_cnt <= CONFIG_EMDS_FLASH_INDEX_SIZE) {
+		zassert_equal(load_reads, entry_cnt, "Expected one flash read per entry");
+	}
+}
+
+ZTEST(emds_load_bench, test_load)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(entry_cnts); i++) {
+		load_bench_run(entry_cnts[i]);
+	}
+}
+
+static void *bench_setup(void)
+{
+	zassert_true(device_is_ready(flash_dev), "Flash simulator not ready");
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(emds_load_bench, NULL, bench_setup, NULL, NULL, NULL);
@@ -0,0 +1,221 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of the nRF RPC thread pool.
+ *
+ * A loopback transport receives packets in a dedicated thread and passes them to the thread pool,
+ * the same way the IPC Service transport does. The traffic mimics the Bluetooth RPC path: bursts
+ * of Bluetooth host packets, which are slow to process, are mixed with packets of another group.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/spinlock.h>
+#include <zephyr/sys/byteorder.h>
+#include <nrf_rpc_os.h>
+
+#define HEADER_SIZE		NRF_RPC_OS_PACKET_HEADER_SIZE
+#define GROUP_ID_OFFSET		NRF_RPC_OS_PACKET_GROUP_ID_OFFSET
+#define BT_GROUP_ID		0
+#define OTHER_GROUP_ID		1
+#define GROUP_CNT		2
+
+#define PACKET_CNT_MAX		32
+#define BT_PROCESS_TIME_US	200
+#define OTHER_PROCESS_TIME_US	20
+
+#define THROUGHPUT_PACKET_CNT	1000
+
+#define ROUND_CNT		200
+#define BT_BURST_LEN		8
+#define ROUND_INTERVAL		K_MSEC(5)
+#define SAMPLE_CNT_MAX		(ROUND_CNT * BT_BURST_LEN)
+
+#define LOOPBACK_STACK_SIZE	1024
+#define LOOPBACK_PRIORITY	K_PRIO_COOP(1)
+
+struct packet {
+	uint8_t data[HEADER_SIZE + sizeof(uint32_t)];
+	uint32_t submit_cycles;
+};
+
+struct latency_stats {
+	uint32_t samples[SAMPLE_CNT_MAX];
+	size_t cnt;
+};
+
+static struct latency_stats stats[GROUP_CNT];
+static size_t expected_cnt;
+static size_t received_cnt;
+static struct k_spinlock stats_lock;
+static K_SEM_DEFINE(bench_done_sem, 0, 1);
+
+K_MEM_SLAB_DEFINE_STATIC(packet_slab, sizeof(struct packet), PACKET_CNT_MAX, 4);
+K_MSGQ_DEFINE(loopback_rx_msgq, sizeof(struct packet *), PACKET_CNT_MAX, 4);
+
+
+static void loopback_rx_fn(void *p1, void *p2, void *p3)
+{
+	struct packet *packet;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	do {
+		k_msgq_get(&loopback_rx_msgq, &packet, K_FOREVER);
+		nrf_rpc_os_thread_pool_send(packet->data, sizeof(packet->data));
+	} while (1);
+}
+
+K_THREAD_DEFINE(loopback_rx_thread, LOOPBACK_STACK_SIZE, loopback_rx_fn, NULL, NULL, NULL,
+		LOOPBACK_PRIORITY, 0, 0);
+
+static void loopback_send(uint8_t group_id, uint32_t seq)
+{
+	struct packet *packet;
+
+	zassert_ok(k_mem_slab_alloc(&packet_slab, (void **)&packet, K_FOREVER));
+
+	memset(packet->data, 0, HEADER_SIZE);
+	packet->data[GROUP_ID_OFFSET] = group_id;
+	sys_put_le32(seq, &packet->data[HEADER_SIZE]);
+	packet->submit_cycles = k_cycle_get_32();
+
+	zassert_ok(k_msgq_put(&loopback_rx_msgq, &packet, K_FOREVER));
+}
+
+static void packet_handler(const uint8_t *data, size_t len)
+{
+	struct packet *packet = CONTAINER_OF(data, struct packet, data);
+	uint8_t group_id = data[GROUP_ID_OFFSET];
+	uint32_t latency = k_cycle_get_32() - packet->submit_cycles;
+
+	__ASSERT_NO_MSG(len == sizeof(packet->data));
+	__ASSERT_NO_MSG(group_id < GROUP_CNT);
+
+	k_busy_wait((group_id == BT_GROUP_ID) ? BT_PROCESS_TIME_US : OTHER_PROCESS_TIME_US);
+
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+	struct latency_stats *s = &stats[group_id];
+
+	if (s->cnt < ARRAY_SIZE(s->samples)) {
+		s->samples[s->cnt] = latency;
+		s->cnt++;
+	}
+
+	received_cnt++;
+	bool done = (received_cnt == expected_cnt);
+
+	k_spin_unlock(&stats_lock, key);
+
+	k_mem_slab_free(&packet_slab, packet);
+
+	if (done) {
+		k_sem_give(&bench_done_sem);
+	}
+}
+
+static uint32_t percentile_us(const uint32_t *sorted, size_t cnt, unsigned int pct)
+{
+	size_t idx = (cnt * pct) / 100;
+
+	if (idx >= cnt) {
+		idx = cnt - 1;
+	}
+
+	return k_cyc_to_us_ceil32(sorted[idx]);
+}
+
+static void latency_report(const char *name, struct latency_stats *s)
+{
+	uint32_t *v = s->samples;
+
+	zassert_true(s->cnt > 0, "No samples");
+
+	/* Insertion sort is good enough for the number of samples. */
+	for (size_t i = 1; i < s->cnt; i++) {
+		uint32_t val = v[i];
+		size_t j = i;
+
+		for (; (j > 0) && (v[j - 1] > val); j--) {
+			v[j] = v[j - 1];
+		}
+		v[j] = val;
+	}
+
+	printk("%s: samples=%zu p50=%uus p90=%uus p99=%uus max=%uus\n", name, s->cnt,
+	       percentile_us(v, s->cnt, 50), percentile_us(v, s->cnt, 90),
+	       percentile_us(v, s->cnt, 99), percentile_us(v, s->cnt, 100));
+}
+
+static void bench_reset(size_t packet_cnt)
+{
+	k_spinlock_key_t key = k_spin_lock(&stats_lock);
+
+	memset(stats, 0, sizeof(stats));
+	received_cnt = 0;
+	expected_cnt = packet_cnt;
+
+	k_spin_unlock(&stats_lock, key);
+
+	k_sem_reset(&bench_done_sem);
+}
+
+static void *bench_setup(void)
+{
+	zassert_ok(nrf_rpc_os_init(packet_handler), "Error when initializing");
+	return NULL;
+}
+
+ZTEST(nrf_rpc_bench, test_bt_throughput)
+{
+	bench_reset(THROUGHPUT_PACKET_CNT);
+
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < THROUGHPUT_PACKET_CNT; i++) {
+		loopback_send(BT_GROUP_ID, i);
+	}
+
+	zassert_ok(k_sem_take(&bench_done_sem, K_SECONDS(10)), "Not all packets handled");
+
+	uint32_t time_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+
+	printk("Thread pool size: %d, queue size: %d\n", CONFIG_NRF_RPC_THREAD_POOL_SIZE,
+	       CONFIG_NRF_RPC_THREAD_POOL_QUEUE_SIZE);
+	printk("bt_throughput: packets=%d time=%uus packets_per_s=%llu\n", THROUGHPUT_PACKET_CNT,
+	       time_us, ((uint64_t)THROUGHPUT_PACKET_CNT * USEC_PER_SEC) / MAX(time_us, 1));
+}
+
+ZTEST(nrf_rpc_bench, test_latency_under_bt_burst)
+{
+	uint32_t bt_seq = 0;
+
+	bench_reset(ROUND_CNT * (BT_BURST_LEN + 1));
+
+	for (uint32_t round = 0; round < ROUND_CNT; round++) {
+		size_t other_pos = round % (BT_BURST_LEN + 1);
+
+		for (size_t i = 0; i <= BT_BURST_LEN; i++) {
+			if (i == other_pos) {
+				loopback_send(OTHER_GROUP_ID, round);
+			} else {
+				loopback_send(BT_GROUP_ID, bt_seq++);
+			}
+		}
+
+		k_sleep(ROUND_INTERVAL);
+	}
+
+	zassert_ok(k_sem_take(&bench_done_sem, K_SECONDS(10)), "Not all packets handled");
+
+	printk("Group affinity: %s\n",
+	       IS_ENABLED(CONFIG_NRF_RPC_THREAD_POOL_GROUP_AFFINITY) ? "enabled" : "disabled");
+	latency_report("bt_group", &stats[BT_GROUP_ID]);
+	latency_report("other_group", &stats[OTHER_GROUP_ID]);
+}
+
+ZTEST_SUITE(nrf_rpc_bench, NULL, bench_setup, NULL, NULL, NULL);
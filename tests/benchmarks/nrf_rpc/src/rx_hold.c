@@ -0,0 +1,268 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of copying received payloads versus holding the receive buffer.
+ *
+ * GATT notification sized packets are delivered through the IPC Service transport of nRF RPC,
+ * built against a fake IPC Service backend with a fixed number of shared memory slots. The backend
+ * reuses a slot once the receive callback returns, unless the slot is held. In the copy mode, the
+ * receive handler copies the payload before returning. In the hold mode, the handler holds the
+ * receive buffer and the payload is released after it is processed.
+ */
+
+#include <string.h>
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+
+#include <nrf_rpc/nrf_rpc_ipc.h>
+
+#define SHM_SLOT_CNT		CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD_MAX
+#define PAYLOAD_SIZE		244
+#define MSG_CNT			2000
+#define PROCESS_TIME_US		20
+
+#define HANDLER_STACK_SIZE	1024
+#define HANDLER_PRIORITY	K_PRIO_PREEMPT(1)
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, ipc_service_open_instance, const struct device *);
+FAKE_VALUE_FUNC(int, ipc_service_register_endpoint, const struct device *, struct ipc_ept *,
+		const struct ipc_ept_cfg *);
+FAKE_VALUE_FUNC(int, ipc_service_send, struct ipc_ept *, const void *, size_t);
+FAKE_VALUE_FUNC(int, ipc_service_hold_rx_buffer, struct ipc_ept *, void *);
+FAKE_VALUE_FUNC(int, ipc_service_release_rx_buffer, struct ipc_ept *, void *);
+
+NRF_RPC_IPC_TRANSPORT(bench_tr, NULL, "bench_ept");
+
+struct shm_slot {
+	uint8_t payload[PAYLOAD_SIZE];
+	bool used;
+	/* Receive callback has not returned yet. */
+	bool active;
+	bool held;
+};
+
+/* Payload passed to the handler thread, either copied or in a held slot. */
+struct rx_item {
+	const uint8_t *payload;
+	struct shm_slot *held_slot;
+};
+
+static struct shm_slot shm_slots[SHM_SLOT_CNT];
+static struct k_spinlock shm_lock;
+static K_SEM_DEFINE(shm_free_sem, SHM_SLOT_CNT, SHM_SLOT_CNT);
+static K_SEM_DEFINE(bench_done_sem, 0, 1);
+K_MEM_SLAB_DEFINE_STATIC(copy_slab, PAYLOAD_SIZE, SHM_SLOT_CNT, 4);
+K_MSGQ_DEFINE(rx_msgq, sizeof(struct rx_item), SHM_SLOT_CNT, 4);
+
+static bool hold_mode;
+static size_t bytes_copied;
+static size_t handled_cnt;
+
+static void shm_slot_free(struct shm_slot *slot)
+{
+	slot->held = false;
+	slot->used = false;
+	k_sem_give(&shm_free_sem);
+}
+
+static int shm_slot_hold(struct ipc_ept *ept, void *data)
+{
+	struct shm_slot *slot = CONTAINER_OF(data, struct shm_slot, payload);
+
+	ARG_UNUSED(ept);
+
+	slot->held = true;
+
+	return 0;
+}
+
+static int shm_slot_release(struct ipc_ept *ept, void *data)
+{
+	struct shm_slot *slot = CONTAINER_OF(data, struct shm_slot, payload);
+	k_spinlock_key_t key = k_spin_lock(&shm_lock);
+	bool active = slot->active;
+
+	ARG_UNUSED(ept);
+
+	slot->held = false;
+
+	k_spin_unlock(&shm_lock, key);
+
+	/* A slot released before the receive callback returns is freed by the backend. */
+	if (!active) {
+		shm_slot_free(slot);
+	}
+
+	return 0;
+}
+
+static void receive_handler(const struct nrf_rpc_tr *transport, const uint8_t *packet, size_t len,
+			    void *context)
+{
+	struct rx_item item;
+	void *copy;
+
+	ARG_UNUSED(transport);
+	ARG_UNUSED(context);
+
+	zassert_equal(len, PAYLOAD_SIZE);
+
+	if (hold_mode) {
+		zassert_ok(nrf_rpc_ipc_rx_hold(packet));
+		item.payload = packet;
+		item.held_slot = CONTAINER_OF(packet, struct shm_slot, payload);
+	} else {
+		zassert_ok(k_mem_slab_alloc(&copy_slab, &copy, K_FOREVER));
+		memcpy(copy, packet, len);
+		bytes_copied += len;
+		item.payload = copy;
+		item.held_slot = NULL;
+	}
+
+	zassert_ok(k_msgq_put(&rx_msgq, &item, K_FOREVER));
+}
+
+static void payload_process(const uint8_t *payload, size_t len)
+{
+	/* Emulate passing the notification to the Bluetooth host. */
+	zassert_equal(payload[0], payload[len - 1], "Payload corrupted");
+	k_busy_wait(PROCESS_TIME_US);
+}
+
+static void handler_fn(void *p1, void *p2, void *p3)
+{
+	struct rx_item item;
+
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	do {
+		k_msgq_get(&rx_msgq, &item, K_FOREVER);
+		payload_process(item.payload, PAYLOAD_SIZE);
+
+		if (item.held_slot) {
+			zassert_ok(nrf_rpc_ipc_rx_release(item.payload));
+		} else {
+			k_mem_slab_free(&copy_slab, (void *)item.payload);
+		}
+
+		handled_cnt++;
+		if (handled_cnt == MSG_CNT) {
+			k_sem_give(&bench_done_sem);
+		}
+	} while (1);
+}
+
+K_THREAD_DEFINE(rx_hold_handler_thread, HANDLER_STACK_SIZE, handler_fn, NULL, NULL, NULL,
+		HANDLER_PRIORITY, 0, 0);
+
+static struct shm_slot *shm_slot_get(void)
+{
+	zassert_ok(k_sem_take(&shm_free_sem, K_FOREVER));
+
+	for (size_t i = 0; i < ARRAY_SIZE(shm_slots); i++) {
+		if (!shm_slots[i].used) {
+			shm_slots[i].used = true;
+			return &shm_slots[i];
+		}
+	}
+
+	zassert_unreachable("No free slot");
+	return NULL;
+}
+
+/* Deliver a packet the way the IPC Service backend does. */
+static void backend_receive(uint32_t seq)
+{
+	const struct ipc_ept_cfg *cfg = &bench_tr_instance.endpoint.ept_cfg;
+	struct shm_slot *slot = shm_slot_get();
+	k_spinlock_key_t key;
+	bool held;
+
+	memset(slot->payload, (uint8_t)seq, sizeof(slot->payload));
+	slot->active = true;
+
+	cfg->cb.received(slot->payload, sizeof(slot->payload), cfg->priv);
+
+	key = k_spin_lock(&shm_lock);
+	slot->active = false;
+	held = slot->held;
+	k_spin_unlock(&shm_lock, key);
+
+	/* A held slot is freed when it is released. */
+	if (!held) {
+		shm_slot_free(slot);
+	}
+}
+
+static void rx_bench_run(bool hold)
+{
+	hold_mode = hold;
+	bytes_copied = 0;
+	handled_cnt = 0;
+	k_sem_reset(&bench_done_sem);
+
+	uint32_t start = k_cycle_get_32();
+
+	for (uint32_t i = 0; i < MSG_CNT; i++) {
+		backend_receive(i);
+	}
+
+	zassert_ok(k_sem_take(&bench_done_sem, K_SECONDS(10)), "Not all messages handled");
+
+	uint32_t time_us = k_cyc_to_us_ceil32(k_cycle_get_32() - start);
+
+	printk("rx_%s: msgs=%d bytes_copied=%zu time=%uus msgs_per_s=%llu\n",
+	       hold ? "hold" : "copy", MSG_CNT, bytes_copied, time_us,
+	       ((uint64_t)MSG_CNT * USEC_PER_SEC) / MAX(time_us, 1));
+
+	/* All the slots are back in the backend. */
+	for (size_t i = 0; i < SHM_SLOT_CNT; i++) {
+		zassert_ok(k_sem_take(&shm_free_sem, K_MSEC(100)), "Slot %zu not freed", i);
+	}
+
+	k_sem_reset(&shm_free_sem);
+	for (size_t i = 0; i < SHM_SLOT_CNT; i++) {
+		k_sem_give(&shm_free_sem);
+	}
+}
+
+ZTEST(nrf_rpc_rx_hold_bench, test_rx_copy)
+{
+	rx_bench_run(false);
+	zassert_equal(bytes_copied, MSG_CNT * PAYLOAD_SIZE);
+	zassert_equal(ipc_service_hold_rx_buffer_fake.call_count, 0);
+}
+
+ZTEST(nrf_rpc_rx_hold_bench, test_rx_hold)
+{
+	rx_bench_run(true);
+	zassert_equal(bytes_copied, 0);
+	zassert_equal(ipc_service_hold_rx_buffer_fake.call_count, MSG_CNT);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, MSG_CNT);
+}
+
+static void *rx_hold_bench_setup(void)
+{
+	zassert_ok(bench_tr.api->init(&bench_tr, receive_handler, NULL));
+
+	return NULL;
+}
+
+static void rx_hold_bench_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	RESET_FAKE(ipc_service_hold_rx_buffer);
+	RESET_FAKE(ipc_service_release_rx_buffer);
+	ipc_service_hold_rx_buffer_fake.custom_fake = shm_slot_hold;
+	ipc_service_release_rx_buffer_fake.custom_fake = shm_slot_release;
+}
+
+ZTEST_SUITE(nrf_rpc_rx_hold_bench, NULL, rx_hold_bench_setup, rx_hold_bench_before, NULL, NULL);
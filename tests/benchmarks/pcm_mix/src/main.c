@@ -0,0 +1,159 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of the PCM mixer.
+ *
+ * Random 16-bit PCM frames of typical sizes are mixed in all modes by the library and by a
+ * reference copy of the original one sample at a time implementation. The output of the library
+ * must be bit-exact with the reference. The average number of cycles per mix is reported.
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <pcm_mix.h>
+
+#define ITERATION_CNT		100
+#define FRAME_SAMPLES_MAX	960
+
+struct bench_mode {
+	const char *name;
+	enum pcm_mix_mode mode;
+	bool b_mono_a_stereo;
+};
+
+static const struct bench_mode modes[] = {
+	{"mono", B_MONO_INTO_A_MONO, false},
+	{"mono_into_stereo_lr", B_MONO_INTO_A_STEREO_LR, true},
+	{"mono_into_stereo_l", B_MONO_INTO_A_STEREO_L, true},
+	{"mono_into_stereo_r", B_MONO_INTO_A_STEREO_R, true},
+};
+
+/* Number of samples in buffer B. 10 ms of audio at 16, 24 and 48 kHz, and 20 ms at 48 kHz. */
+static const size_t frame_samples[] = {160, 240, 480, 960};
+
+static int16_t pcm_a[FRAME_SAMPLES_MAX * 2];
+static int16_t pcm_b[FRAME_SAMPLES_MAX];
+static int16_t pcm_ref[FRAME_SAMPLES_MAX * 2];
+static uint32_t rand_state = 1;
+
+static int16_t rand_sample(void)
+{
+	/* Fixed seed linear congruential generator to make the runs comparable. */
+	rand_state = rand_state * 1103515245 + 12345;
+
+	return (int16_t)(rand_state >> 16);
+}
+
+static void ref_hard_limiter(int32_t *const pcm)
+{
+	if (*pcm < INT16_MIN) {
+		*pcm = INT16_MIN;
+	} else if (*pcm > INT16_MAX) {
+		*pcm = INT16_MAX;
+	}
+}
+
+/* Original scalar implementation of pcm_mix(). */
+static void ref_mix(int16_t *pcm_a, const int16_t *pcm_b, size_t cnt, enum pcm_mix_mode mode)
+{
+	int32_t res;
+
+	for (uint32_t i = 0; i < cnt; i++) {
+		switch (mode) {
+		case B_MONO_INTO_A_MONO:
+			res = pcm_a[i] + pcm_b[i];
+			ref_hard_limiter(&res);
+			pcm_a[i] = (int16_t)res;
+			break;
+		case B_MONO_INTO_A_STEREO_LR:
+			res = pcm_a[i * 2] + pcm_b[i];
+			ref_hard_limiter(&res);
+			pcm_a[i * 2] = (int16_t)res;
+			res = pcm_a[i * 2 + 1] + pcm_b[i];
+			ref_hard_limiter(&res);
+			pcm_a[i * 2 + 1] = (int16_t)res;
+			break;
+		case B_MONO_INTO_A_STEREO_L:
+			res = pcm_a[i * 2] + pcm_b[i];
+			ref_hard_limiter(&res);
+			pcm_a[i * 2] = (int16_t)res;
+			break;
+		case B_MONO_INTO_A_STEREO_R:
+			res = pcm_a[i * 2 + 1] + pcm_b[i];
+			ref_hard_limiter(&res);
+			pcm_a[i * 2 + 1] = (int16_t)res;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+static void frame_fill(size_t a_samples, size_t b_samples)
+{
+	for (size_t i = 0; i < a_samples; i++) {
+		pcm_a[i] = rand_sample();
+	}
+
+	for (size_t i = 0; i < b_samples; i++) {
+		pcm_b[i] = rand_sample();
+	}
+
+	memcpy(pcm_ref, pcm_a, a_samples * sizeof(int16_t));
+}
+
+static void bench_run(const struct bench_mode *mode, size_t b_samples)
+{
+	size_t a_samples = mode->b_mono_a_stereo ? (b_samples * 2) : b_samples;
+	uint64_t lib_cycles = 0;
+	uint64_t ref_cycles = 0;
+	timing_t start, end;
+
+	for (size_t i = 0; i < ITERATION_CNT; i++) {
+		frame_fill(a_samples, b_samples);
+
+		start = timing_counter_get();
+		zassert_ok(pcm_mix(pcm_a, a_samples * sizeof(int16_t), pcm_b,
+				   b_samples * sizeof(int16_t), mode->mode));
+		end = timing_counter_get();
+		lib_cycles += timing_cycles_get(&start, &end);
+
+		start = timing_counter_get();
+		ref_mix(pcm_ref, pcm_b, b_samples, mode->mode);
+		end = timing_counter_get();
+		ref_cycles += timing_cycles_get(&start, &end);
+
+		zassert_mem_equal(pcm_a, pcm_ref, a_samples * sizeof(int16_t),
+				  "Output of %s with %zu samples is not bit-exact", mode->name,
+				  b_samples);
+	}
+
+	printk("%s: samples=%zu cycles=%llu ref_cycles=%llu\n", mode->name, b_samples,
+	       lib_cycles / ITERATION_CNT, ref_cycles / ITERATION_CNT);
+}
+
+ZTEST(pcm_mix_bench, test_mix_16_bit)
+{
+	printk("Packed saturating instructions: %s\n",
+	       IS_ENABLED(CONFIG_PCM_MIX_SIMD) ? "enabled" : "disabled");
+
+	for (size_t i = 0; i < ARRAY_SIZE(modes); i++) {
+		for (size_t j = 0; j < ARRAY_SIZE(frame_samples); j++) {
+			bench_run(&modes[i], frame_samples[j]);
+		}
+	}
+}
+
+static void *bench_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(pcm_mix_bench, NULL, bench_setup, NULL, NULL, NULL);
@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of the sample rate converter filters.
+ *
+ * A 1 kHz sine at -6 dBFS is converted in blocks of 10 ms by the simple filters and by the
+ * polyphase filter. The THD+N is measured on 100 ms of output after the filter has settled, by
+ * removing a least squares fit of the sine. The average number of cycles per input sample is
+ * reported.
+ */
+
+#include <math.h>
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <sample_rate_converter.h>
+
+#define TONE_FREQ_HZ		1000
+#define TONE_AMPLITUDE		16384.0f
+#define BLOCK_CNT		25
+#define SETTLE_BLOCK_CNT	10
+#define ANALYSIS_BLOCK_CNT	10
+#define BLOCK_SAMPLES_MAX	480
+#define POLYPHASE_THD_N_MAX_DB	-70.0f
+
+struct bench_case {
+	uint32_t sample_rate_input;
+	uint32_t sample_rate_output;
+	enum sample_rate_converter_filter filter;
+	int32_t drift_ppm;
+};
+
+static const struct bench_case cases[] = {
+	{48000, 24000, SAMPLE_RATE_FILTER_SIMPLE},
+	{24000, 48000, SAMPLE_RATE_FILTER_SIMPLE},
+	{48000, 16000, SAMPLE_RATE_FILTER_SIMPLE},
+	{16000, 48000, SAMPLE_RATE_FILTER_SIMPLE},
+	{48000, 24000, SAMPLE_RATE_FILTER_POLYPHASE},
+	{24000, 48000, SAMPLE_RATE_FILTER_POLYPHASE},
+	{48000, 16000, SAMPLE_RATE_FILTER_POLYPHASE},
+	{16000, 48000, SAMPLE_RATE_FILTER_POLYPHASE},
+	{32000, 48000, SAMPLE_RATE_FILTER_POLYPHASE},
+	{48000, 32000, SAMPLE_RATE_FILTER_POLYPHASE},
+	{44100, 48000, SAMPLE_RATE_FILTER_POLYPHASE},
+	{48000, 44100, SAMPLE_RATE_FILTER_POLYPHASE},
+};
+
+static struct sample_rate_converter_ctx ctx;
+static int16_t input[BLOCK_SAMPLES_MAX];
+/* Room for the polyphase filter producing one sample more than the nominal block */
+static int16_t output[BLOCK_SAMPLES_MAX + 1];
+static int16_t analysis[BLOCK_SAMPLES_MAX * ANALYSIS_BLOCK_CNT];
+
+static void tone_fill(int16_t *samples, size_t cnt, uint32_t sample_rate, uint32_t *n)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		/* Wrap the phase exactly to keep the precision of sinf() */
+		float phase = 2.0f * (float)M_PI * ((*n * TONE_FREQ_HZ) % sample_rate) / sample_rate;
+
+		samples[i] = (int16_t)lrintf(TONE_AMPLITUDE * sinf(phase));
+		*n += 1;
+	}
+}
+
+/* Ratio in dB of the residual to the sine fitted at the tone frequency */
+static float thd_n_get(const int16_t *samples, size_t cnt, uint32_t sample_rate)
+{
+	/* Double precision to keep the fit accurate over the whole window */
+	const double omega = 2.0 * M_PI * TONE_FREQ_HZ / sample_rate;
+	double dc = 0.0;
+	double sin_amp = 0.0;
+	double cos_amp = 0.0;
+	double fit_energy = 0.0;
+	double residual_energy = 0.0;
+
+	for (size_t i = 0; i < cnt; i++) {
+		dc += samples[i];
+	}
+	dc /= cnt;
+
+	/* The window holds an integer number of periods */
+	for (size_t i = 0; i < cnt; i++) {
+		sin_amp += (samples[i] - dc) * sin(omega * i);
+		cos_amp += (samples[i] - dc) * cos(omega * i);
+	}
+	sin_amp *= 2.0 / cnt;
+	cos_amp *= 2.0 / cnt;
+
+	for (size_t i = 0; i < cnt; i++) {
+		double fit = sin_amp * sin(omega * i) + cos_amp * cos(omega * i);
+		double residual = samples[i] - dc - fit;
+
+		fit_energy += fit * fit;
+		residual_energy += residual * residual;
+	}
+
+	return (float)(10.0 * log10(residual_energy / fit_energy));
+}
+
+static float bench_run(const struct bench_case *bench)
+{
+	const size_t block_samples = bench->sample_rate_input / 100;
+	const size_t analysis_samples = (bench->sample_rate_output / 100) * ANALYSIS_BLOCK_CNT;
+	size_t analysis_cnt = 0;
+	uint64_t cycles = 0;
+	uint32_t n = 0;
+	size_t output_written;
+	timing_t start, end;
+	float thd_n;
+
+	zassert_ok(sample_rate_converter_open(&ctx));
+	zassert_ok(sample_rate_converter_drift_set(&ctx, bench->drift_ppm));
+
+	for (size_t block = 0; block < BLOCK_CNT; block++) {
+		tone_fill(input, block_samples, bench->sample_rate_input, &n);
+
+		start = timing_counter_get();
+		zassert_ok(sample_rate_converter_process(
+			&ctx, bench->filter, input, block_samples * sizeof(int16_t),
+			bench->sample_rate_input, output, sizeof(output), &output_written,
+			bench->sample_rate_output));
+		end = timing_counter_get();
+		cycles += timing_cycles_get(&start, &end);
+
+		if (block < SETTLE_BLOCK_CNT) {
+			continue;
+		}
+
+		for (size_t i = 0; (i < output_written / sizeof(int16_t)) &&
+				   (analysis_cnt < analysis_samples);
+		     i++) {
+			analysis[analysis_cnt++] = output[i];
+		}
+	}
+
+	zassert_equal(analysis_cnt, analysis_samples, "Not enough output samples");
+
+	thd_n = thd_n_get(analysis, analysis_samples, bench->sample_rate_output);
+
+	printk("%s %u->%u: thd_n=%ddB cycles_per_sample=%llu\n",
+	       bench->filter == SAMPLE_RATE_FILTER_POLYPHASE ? "polyphase" : "simple",
+	       bench->sample_rate_input, bench->sample_rate_output, (int)thd_n,
+	       cycles / (BLOCK_CNT * block_samples));
+
+	return thd_n;
+}
+
+ZTEST(sample_rate_converter_bench, test_thd_n_and_cycles)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(cases); i++) {
+		float thd_n = bench_run(&cases[i]);
+
+		if (cases[i].filter == SAMPLE_RATE_FILTER_POLYPHASE) {
+			zassert_true(thd_n < POLYPHASE_THD_N_MAX_DB,
+				     "THD+N of the polyphase filter too high for %u->%u",
+				     cases[i].sample_rate_input, cases[i].sample_rate_output);
+		}
+	}
+}
+
+ZTEST(sample_rate_converter_bench, test_drift_cycles)
+{
+	const struct bench_case bench = {48000, 48000, SAMPLE_RATE_FILTER_POLYPHASE, 100};
+
+	/* The tone is shifted by the drift, so only the cycles are of interest */
+	bench_run(&bench);
+}
+
+static void *bench_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(sample_rate_converter_bench, NULL, bench_setup, NULL, NULL, NULL);
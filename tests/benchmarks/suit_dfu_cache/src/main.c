@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of the lookup of payloads in the SUIT DFU cache.
+ *
+ * A synthetic cache is spread over two cache pools in RAM, with a growing number of slots.
+ * The cache is initialized and the payload of every slot is searched by its URI, starting from
+ * the last slot, as done for each component of a manifest with many cached payloads. The time
+ * of the initialization and the average time of a search are measured.
+ *
+ * The benchmark is also built with CONFIG_SUIT_CACHE_DIRECTORY_SIZE=0, which decodes the slots
+ * of the cache pools on every search.
+ */
+
+#include <stdio.h>
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/sys/byteorder.h>
+#include <suit_dfu_cache.h>
+
+#define POOL_CNT	 2
+#define POOL_SIZE	 8192
+#define PAYLOAD_SIZE	 64
+#define SLOT_CNT_MAX	 64
+#define URI_FORMAT	 "http://databucket.com/payloads/component_%03u.bin"
+#define URI_BUF_SIZE	 sizeof("http://databucket.com/payloads/component_000.bin")
+#define SEARCH_ROUND_CNT 10
+
+static uint8_t pools[POOL_CNT][POOL_SIZE];
+static const size_t slot_cnts[] = {8, 32, SLOT_CNT_MAX};
+
+static void uri_get(unsigned int slot, char *uri)
+{
+	snprintf(uri, URI_BUF_SIZE, URI_FORMAT, slot);
+}
+
+static void payload_get(unsigned int slot, uint8_t *payload)
+{
+	for (size_t i = 0; i < PAYLOAD_SIZE; i++) {
+		payload[i] = slot + i;
+	}
+}
+
+/* Write the slots as an indefinite CBOR map in each pool, as left by the cache sink. */
+static void cache_write(size_t slot_cnt, struct dfu_cache *cache)
+{
+	size_t offset[POOL_CNT];
+
+	memset(pools, 0xFF, sizeof(pools));
+
+	for (size_t i = 0; i < POOL_CNT; i++) {
+		pools[i][0] = 0xBF;
+		offset[i] = 1;
+	}
+
+	for (unsigned int slot = 0; slot < slot_cnt; slot++) {
+		uint8_t *pool = pools[slot % POOL_CNT];
+		size_t *off = &offset[slot % POOL_CNT];
+		char uri[URI_BUF_SIZE];
+		size_t uri_len;
+
+		uri_get(slot, uri);
+		uri_len = strlen(uri);
+
+		zassert_true(*off + 2 + uri_len + 5 + PAYLOAD_SIZE < POOL_SIZE,
+			     "The slots do not fit in the cache pool");
+
+		/* Text string with a one-byte length */
+		pool[(*off)++] = 0x78;
+		pool[(*off)++] = uri_len;
+		memcpy(&pool[*off], uri, uri_len);
+		*off += uri_len;
+
+		/* Byte string with a four-byte length */
+		pool[(*off)++] = 0x5A;
+		sys_put_be32(PAYLOAD_SIZE, &pool[*off]);
+		*off += sizeof(uint32_t);
+		payload_get(slot, &pool[*off]);
+		*off += PAYLOAD_SIZE;
+	}
+
+	cache->pools_count = POOL_CNT;
+	for (size_t i = 0; i < POOL_CNT; i++) {
+		cache->pools[i].address = pools[i];
+		cache->pools[i].size = offset[i] + 1;
+	}
+}
+
+static void search_bench_run(size_t slot_cnt)
+{
+	uint8_t expected[PAYLOAD_SIZE];
+	struct dfu_cache cache;
+	uint64_t search_cycles = 0;
+	uint64_t init_cycles;
+	timing_t start, end;
+
+	cache_write(slot_cnt, &cache);
+
+	start = timing_counter_get();
+	zassert_equal(suit_dfu_cache_initialize(&cache), SUIT_PLAT_SUCCESS,
+		      "Failed to initialize cache");
+	end = timing_counter_get();
+	init_cycles = timing_cycles_get(&start, &end);
+
+	for (int round = 0; round < SEARCH_ROUND_CNT; round++) {
+		for (int slot = slot_cnt - 1; slot >= 0; slot--) {
+			const uint8_t *payload = NULL;
+			size_t payload_size = 0;
+			char uri[URI_BUF_SIZE];
+			suit_plat_err_t ret;
+
+			uri_get(slot, uri);
+
+			start = timing_counter_get();
+			ret = suit_dfu_cache_search((const uint8_t *)uri, strlen(uri) + 1, &payload,
+						    &payload_size);
+			end = timing_counter_get();
+			search_cycles += timing_cycles_get(&start, &end);
+
+			zassert_equal(ret, SUIT_PLAT_SUCCESS, "Slot %d not found", slot);
+			zassert_equal(payload_size, PAYLOAD_SIZE, "Wrong size of slot %d", slot);
+			payload_get(slot, expected);
+			zassert_mem_equal(payload, expected, PAYLOAD_SIZE, "Wrong payload in slot %d",
+					  slot);
+		}
+	}
+
+	suit_dfu_cache_deinitialize();
+
+	printk("slots=%zu init_ns=%llu search_ns=%llu\n", slot_cnt,
+	       timing_cycles_to_ns(init_cycles),
+	       timing_cycles_to_ns(search_cycles) / (slot_cnt * SEARCH_ROUND_CNT));
+}
+
+ZTEST(suit_dfu_cache_bench, test_search)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(slot_cnts); i++) {
+		search_bench_run(slot_cnts[i]);
+	}
+}
+
+static void *bench_setup(void)
+{
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(suit_dfu_cache_bench, NULL, bench_setup, NULL, NULL, NULL);
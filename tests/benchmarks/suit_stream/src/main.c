@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of the verification and the installation of a large image streamed from flash.
+ *
+ * A pseudo-random image is written to the flash simulator of the board and streamed in chunks,
+ * as done by the flash source, with a growing chunk size. The time to verify the image, which
+ * streams it to a digest sink, and the time to install it, which copies it to RAM and checks its
+ * digest, are measured. The installation is measured with a tee sink, which writes and hashes the
+ * image in a single pass, and with a pass for the copy followed by a pass for the digest.
+ *
+ * The flash simulator is not mapped as external memory on native_sim, so the chunks are read
+ * from the flash device by the benchmark, through the same chunked streamer as the flash source.
+ *
+ * The benchmark is also built with CONFIG_SUIT_STREAM_PIPELINE=n, which reads and consumes the
+ * chunks one after the other.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/drivers/flash.h>
+#include <psa/crypto.h>
+#include <suit_chunked_streamer.h>
+#include <suit_digest_sink.h>
+#include <suit_ram_sink.h>
+#include <suit_tee_sink.h>
+
+#define FLASH_NODE	 DT_NODELABEL(flash0)
+#define IMAGE_SIZE	 (4 * 1024 * 1024)
+#define CHUNK_SIZE_MAX	 4096
+
+BUILD_ASSERT(IMAGE_SIZE <= DT_REG_SIZE(FLASH_NODE), "The image does not fit in the flash");
+
+static const struct device *const flash_dev = DEVICE_DT_GET(DT_PARENT(FLASH_NODE));
+static const size_t chunk_sizes[] = {256, 1024, CHUNK_SIZE_MAX};
+
+static uint8_t image[IMAGE_SIZE];
+static uint8_t image_digest[PSA_HASH_LENGTH(PSA_ALG_SHA_256)];
+static uint8_t buf[SUIT_CHUNKED_STREAMER_BUF_SIZE(CHUNK_SIZE_MAX)];
+
+/* Fill the image with a pseudo-random xorshift sequence. */
+static void image_fill(void)
+{
+	uint32_t x = 0x12345678;
+
+	for (size_t i = 0; i < sizeof(image); i += sizeof(x)) {
+		x ^= x << 13;
+		x ^= x >> 17;
+		x ^= x << 5;
+		memcpy(&image[i], &x, sizeof(x));
+	}
+}
+
+static suit_plat_err_t chunk_read(void *ctx, size_t offset, uint8_t *chunk, size_t size)
+{
+	ARG_UNUSED(ctx);
+
+	if (flash_read(flash_dev, offset, chunk, size) != 0) {
+		return SUIT_PLAT_ERR_IO;
+	}
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+static void image_stream(size_t chunk_size, struct stream_sink *sink)
+{
+	suit_plat_err_t ret;
+
+	ret = suit_chunked_streamer_stream(chunk_read, NULL, IMAGE_SIZE, buf, chunk_size, sink);
+	zassert_equal(ret, SUIT_PLAT_SUCCESS, "Failed to stream the image: %d", ret);
+}
+
+static void digest_sink_get(struct stream_sink *sink)
+{
+	zassert_equal(suit_digest_sink_get(sink, PSA_ALG_SHA_256, image_digest),
+		      SUIT_PLAT_SUCCESS, "Failed to get the digest sink");
+}
+
+static void digest_check(struct stream_sink *sink)
+{
+	zassert_equal(suit_digest_sink_digest_match(sink->ctx), SUIT_PLAT_SUCCESS,
+		      "Digest mismatch");
+	zassert_equal(release_sink(sink), SUIT_PLAT_SUCCESS, "Failed to release the digest sink");
+}
+
+static void ram_sink_get(struct stream_sink *sink)
+{
+	memset(image, 0, sizeof(image));
+	zassert_equal(suit_ram_sink_get(sink, image, sizeof(image)), SUIT_PLAT_SUCCESS,
+		      "Failed to get the RAM sink");
+}
+
+static void copy_check(struct stream_sink *sink)
+{
+	zassert_equal(release_sink(sink), SUIT_PLAT_SUCCESS, "Failed to release the RAM sink");
+	zassert_ok(flash_read(flash_dev, 0, buf, CHUNK_SIZE_MAX));
+	zassert_mem_equal(image, buf, CHUNK_SIZE_MAX, "Incorrect copy of the image");
+	zassert_ok(flash_read(flash_dev, IMAGE_SIZE - CHUNK_SIZE_MAX, buf, CHUNK_SIZE_MAX));
+	zassert_mem_equal(&image[IMAGE_SIZE - CHUNK_SIZE_MAX], buf, CHUNK_SIZE_MAX,
+			  "Incorrect copy of the image");
+}
+
+static uint64_t verify_run(size_t chunk_size)
+{
+	struct stream_sink digest;
+	timing_t start, end;
+
+	start = timing_counter_get();
+	digest_sink_get(&digest);
+	image_stream(chunk_size, &digest);
+	end = timing_counter_get();
+
+	digest_check(&digest);
+
+	return timing_cycles_get(&start, &end);
+}
+
+static uint64_t install_two_pass_run(size_t chunk_size)
+{
+	struct stream_sink digest, ram;
+	timing_t start, end;
+
+	ram_sink_get(&ram);
+
+	start = timing_counter_get();
+	image_stream(chunk_size, &ram);
+	digest_sink_get(&digest);
+	image_stream(chunk_size, &digest);
+	end = timing_counter_get();
+
+	digest_check(&digest);
+	copy_check(&ram);
+
+	return timing_cycles_get(&start, &end);
+}
+
+static uint64_t install_tee_run(size_t chunk_size)
+{
+	struct stream_sink digest, ram, tee;
+	timing_t start, end;
+
+	ram_sink_get(&ram);
+
+	start = timing_counter_get();
+	digest_sink_get(&digest);
+	zassert_equal(suit_tee_sink_get(&tee, &ram, &digest), SUIT_PLAT_SUCCESS,
+		      "Failed to get the tee sink");
+	image_stream(chunk_size, &tee);
+	end = timing_counter_get();
+
+	zassert_equal(release_sink(&tee), SUIT_PLAT_SUCCESS, "Failed to release the tee sink");
+	digest_check(&digest);
+	copy_check(&ram);
+
+	return timing_cycles_get(&start, &end);
+}
+
+ZTEST(suit_stream_bench, test_stream)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(chunk_sizes); i++) {
+		uint64_t verify_cycles = verify_run(chunk_sizes[i]);
+		uint64_t two_pass_cycles = install_two_pass_run(chunk_sizes[i]);
+		uint64_t tee_cycles = install_tee_run(chunk_sizes[i]);
+
+		printk("chunk=%zu verify_us=%llu install_two_pass_us=%llu install_tee_us=%llu\n",
+		       chunk_sizes[i], timing_cycles_to_ns(verify_cycles) / NSEC_PER_USEC,
+		       timing_cycles_to_ns(two_pass_cycles) / NSEC_PER_USEC,
+		       timing_cycles_to_ns(tee_cycles) / NSEC_PER_USEC);
+	}
+}
+
+static void *bench_setup(void)
+{
+	size_t digest_len;
+
+	zassert_true(device_is_ready(flash_dev), "Flash simulator not ready");
+
+	image_fill();
+	zassert_equal(psa_crypto_init(), PSA_SUCCESS, "Failed to init PSA crypto");
+	zassert_equal(psa_hash_compute(PSA_ALG_SHA_256, image, sizeof(image), image_digest,
+				       sizeof(image_digest), &digest_len),
+		      PSA_SUCCESS, "Failed to compute the image digest");
+
+	zassert_ok(flash_erase(flash_dev, 0, IMAGE_SIZE));
+	zassert_ok(flash_write(flash_dev, 0, image, IMAGE_SIZE));
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(suit_stream_bench, NULL, bench_setup, NULL, NULL, NULL);
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of the partial reads and writes of assets in the protected storage.
+ *
+ * Assets of a growing size are stored, then a few bytes are read and written at the start, in
+ * the middle and at the end of each asset. The time of the reads and the writes is averaged over
+ * a number of iterations. An asset is also built by appending to it, a few bytes at a time.
+ *
+ * The benchmark is also built with CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNKED=n, which stores
+ * each asset in a single object. As psa_ps_set_extended() is not supported then, the asset is
+ * written as a whole instead, and so it is when it is appended to.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/settings/settings.h>
+#include <psa/protected_storage.h>
+
+#define ASSET_SIZE_MAX CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_MAX_DATA_SIZE
+#define ACCESS_SIZE    16
+#define ITERATIONS     20
+#define ASSET_UID      0x1234
+
+static const size_t asset_sizes[] = {64, 256, ASSET_SIZE_MAX};
+
+static uint8_t asset[ASSET_SIZE_MAX];
+static uint8_t buf[ASSET_SIZE_MAX];
+
+static bool set_extended_supported(void)
+{
+	return (psa_ps_get_support() & PSA_STORAGE_SUPPORT_SET_EXTENDED) != 0;
+}
+
+static uint64_t get_run(size_t offset)
+{
+	timing_t start, end;
+	size_t length;
+
+	start = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		zassert_equal(psa_ps_get(ASSET_UID, offset, ACCESS_SIZE, buf, &length),
+			      PSA_SUCCESS, "Failed to get the asset");
+	}
+	end = timing_counter_get();
+
+	zassert_equal(length, ACCESS_SIZE, "Incorrect length");
+	zassert_mem_equal(buf, &asset[offset], ACCESS_SIZE, "Incorrect data");
+
+	return timing_cycles_get(&start, &end) / ITERATIONS;
+}
+
+static uint64_t set_run(size_t size, size_t offset)
+{
+	timing_t start, end;
+	psa_status_t status;
+
+	start = timing_counter_get();
+	for (int i = 0; i < ITERATIONS; i++) {
+		asset[offset] = i;
+
+		if (set_extended_supported()) {
+			status = psa_ps_set_extended(ASSET_UID, offset, ACCESS_SIZE,
+						     &asset[offset]);
+		} else {
+			status = psa_ps_set(ASSET_UID, size, asset, PSA_STORAGE_FLAG_NONE);
+		}
+		zassert_equal(status, PSA_SUCCESS, "Failed to set the asset");
+	}
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end) / ITERATIONS;
+}
+
+ZTEST(trusted_storage_bench, test_partial_access)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(asset_sizes); i++) {
+		size_t size = asset_sizes[i];
+		const size_t offsets[] = {0, size / 2, size - ACCESS_SIZE};
+
+		zassert_equal(psa_ps_set(ASSET_UID, size, asset, PSA_STORAGE_FLAG_NONE),
+			      PSA_SUCCESS, "Failed to set the asset");
+
+		for (size_t j = 0; j < ARRAY_SIZE(offsets); j++) {
+			uint64_t set_cycles = set_run(size, offsets[j]);
+			uint64_t get_cycles = get_run(offsets[j]);
+
+			printk("size=%zu offset=%zu get_us=%llu set_us=%llu\n", size, offsets[j],
+			       timing_cycles_to_ns(get_cycles) / NSEC_PER_USEC,
+			       timing_cycles_to_ns(set_cycles) / NSEC_PER_USEC);
+		}
+
+		zassert_equal(psa_ps_remove(ASSET_UID), PSA_SUCCESS, "Failed to remove the asset");
+	}
+}
+
+ZTEST(trusted_storage_bench, test_append)
+{
+	timing_t start, end;
+	uint64_t set_cycles;
+	psa_status_t status;
+	size_t length;
+
+	if (set_extended_supported()) {
+		zassert_equal(psa_ps_create(ASSET_UID, ASSET_SIZE_MAX, PSA_STORAGE_FLAG_NONE),
+			      PSA_SUCCESS, "Failed to create the asset");
+	}
+
+	start = timing_counter_get();
+	for (size_t size = 0; size < ASSET_SIZE_MAX; size += ACCESS_SIZE) {
+		if (set_extended_supported()) {
+			status = psa_ps_set_extended(ASSET_UID, size, ACCESS_SIZE, &asset[size]);
+		} else {
+			status = psa_ps_set(ASSET_UID, size + ACCESS_SIZE, asset,
+					    PSA_STORAGE_FLAG_NONE);
+		}
+		zassert_equal(status, PSA_SUCCESS, "Failed to append to the asset");
+	}
+	end = timing_counter_get();
+	set_cycles = timing_cycles_get(&start, &end) / (ASSET_SIZE_MAX / ACCESS_SIZE);
+
+	zassert_equal(psa_ps_get(ASSET_UID, 0, ASSET_SIZE_MAX, buf, &length), PSA_SUCCESS,
+		      "Failed to get the asset");
+	zassert_mem_equal(buf, asset, ASSET_SIZE_MAX, "Incorrect data");
+
+	printk("append=%d size=%d set_us=%llu\n", ACCESS_SIZE, ASSET_SIZE_MAX,
+	       timing_cycles_to_ns(set_cycles) / NSEC_PER_USEC);
+
+	zassert_equal(psa_ps_remove(ASSET_UID), PSA_SUCCESS, "Failed to remove the asset");
+}
+
+static void *bench_setup(void)
+{
+	for (size_t i = 0; i < sizeof(asset); i++) {
+		asset[i] = i;
+	}
+
+	zassert_ok(settings_subsys_init(), "Failed to init the settings subsystem");
+
+	/* Remove a leftover of an interrupted run */
+	(void)psa_ps_remove(ASSET_UID);
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(trusted_storage_bench, NULL, bench_setup, NULL, NULL, NULL);
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Benchmark of the internal trusted storage as the number of stored assets grows.
+ *
+ * A growing number of assets is stored, then each asset is read, written again and removed.
+ * The average time of each operation is measured.
+ *
+ * The benchmark is built with the settings storage backend, which looks the objects up by name,
+ * and with CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_NVS, which finds them from a hash of their UID.
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/timing/timing.h>
+#include <zephyr/settings/settings.h>
+#include <psa/internal_trusted_storage.h>
+
+#define ASSET_SIZE 32
+#define UID_BASE   0x1000
+
+static const size_t asset_counts[] = {16, 64, 256};
+
+static uint8_t asset[ASSET_SIZE];
+static uint8_t buf[ASSET_SIZE];
+
+static uint64_t set_run(size_t count)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+	for (size_t i = 0; i < count; i++) {
+		asset[0] = i;
+		zassert_equal(psa_its_set(UID_BASE + i, sizeof(asset), asset,
+					  PSA_STORAGE_FLAG_NONE),
+			      PSA_SUCCESS, "Failed to set asset %zu", i);
+	}
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end) / count;
+}
+
+static uint64_t get_run(size_t count)
+{
+	timing_t start, end;
+	size_t length;
+
+	start = timing_counter_get();
+	for (size_t i = 0; i < count; i++) {
+		zassert_equal(psa_its_get(UID_BASE + i, 0, sizeof(buf), buf, &length), PSA_SUCCESS,
+			      "Failed to get asset %zu", i);
+		zassert_equal(buf[0], (uint8_t)i, "Incorrect asset %zu", i);
+	}
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end) / count;
+}
+
+static uint64_t remove_run(size_t count)
+{
+	timing_t start, end;
+
+	start = timing_counter_get();
+	for (size_t i = 0; i < count; i++) {
+		zassert_equal(psa_its_remove(UID_BASE + i), PSA_SUCCESS,
+			      "Failed to remove asset %zu", i);
+	}
+	end = timing_counter_get();
+
+	return timing_cycles_get(&start, &end) / count;
+}
+
+ZTEST(trusted_storage_its_bench, test_asset_count)
+{
+	for (size_t i = 0; i < ARRAY_SIZE(asset_counts); i++) {
+		size_t count = asset_counts[i];
+		uint64_t create_cycles = set_run(count);
+		uint64_t get_cycles = get_run(count);
+		uint64_t set_cycles = set_run(count);
+		uint64_t remove_cycles = remove_run(count);
+
+		printk("assets=%zu create_us=%llu get_us=%llu set_us=%llu remove_us=%llu\n", count,
+		       timing_cycles_to_ns(create_cycles) / NSEC_PER_USEC,
+		       timing_cycles_to_ns(get_cycles) / NSEC_PER_USEC,
+		       timing_cycles_to_ns(set_cycles) / NSEC_PER_USEC,
+		       timing_cycles_to_ns(remove_cycles) / NSEC_PER_USEC);
+	}
+}
+
+static void *bench_setup(void)
+{
+	memset(asset, 0xa5, sizeof(asset));
+
+	zassert_ok(settings_subsys_init(), "Failed to init the settings subsystem");
+
+	timing_init();
+	timing_start();
+
+	return NULL;
+}
+
+ZTEST_SUITE(trusted_storage_its_bench, NULL, bench_setup, NULL, NULL, NULL);
@@ -442,5 +442,92 @@ ZTEST(at_params, test_params_list_management)
 		      "Params int get should return -EINVAL");
 }
 
+ZTEST(at_params_arena, test_params_arena)
+{
+	struct at_param params[TEST_PARAMS];
+	struct at_param_list list;
+	uint8_t buf[24];
+	struct at_param_arena arena = {
+		.buf = buf,
+		.size = sizeof(buf),
+	};
+	const char test_str[] = "Hello World!";
+	const uint32_t test_array[] = {1, 2, 3};
+	uint32_t test_buf[4];
+	size_t test_buf_len = sizeof(test_buf);
+	const char *str_ptr;
+	size_t len;
+
+	zassert_equal(-EINVAL, at_params_list_init_arena(&list, NULL, TEST_PARAMS, &arena),
+		      "Init function initializes with NULL parameter");
+	zassert_equal(0, at_params_list_init_arena(&list, params, TEST_PARAMS, &arena),
+		      "Not able to initialize params list");
+	zassert_equal(TEST_PARAMS, list.param_count,
+		      "Params count should be the same as TEST_PARAMS");
+
+	zassert_equal(0, at_params_string_put(&list, 0, test_str, strlen(test_str)),
+		      "String put should return 0");
+	zassert_equal(0, at_params_string_ptr_get(&list, 0, &str_ptr, &len),
+		      "String pointer get should return 0");
+	zassert_between_inclusive((uintptr_t)str_ptr, (uintptr_t)buf,
+				  (uintptr_t)&buf[sizeof(buf) - 1],
+				  "String should be stored in the arena");
+	zassert_equal(strlen(test_str), len, "Wrong string length");
+	zassert_equal(0, strcmp(test_str, str_ptr), "String should be null-terminated");
+
+	zassert_equal(-ENOMEM, at_params_array_put(&list, 1, test_array, sizeof(test_array)),
+		      "Array put should return -ENOMEM");
+	zassert_equal(AT_PARAM_TYPE_INVALID, at_params_type_get(&list, 1),
+		      "Get type should return AT_PARAM_TYPE_INVALID");
+
+	/* Clearing the list reclaims the arena. */
+	at_params_list_clear(&list);
+	zassert_equal(0, arena.used, "Arena should be empty after clear");
+
+	zassert_equal(0, at_params_array_put(&list, 1, test_array, sizeof(test_array)),
+		      "Array put should return 0");
+	zassert_equal(0, at_params_array_get(&list, 1, test_buf, &test_buf_len),
+		      "Array get should return 0");
+	zassert_equal(sizeof(test_array), test_buf_len,
+		      "test_buf_len should be equal to sizeof(test_array)");
+	zassert_equal(0, memcmp(test_array, test_buf, sizeof(test_array)),
+		      "test_array and test_buf should be equal");
+
+	at_params_list_free(&list);
+
+	zassert_equal(0, list.param_count, "Params list count is not 0 after free");
+	zassert_equal_ptr(NULL, list.params, "Params is not NULL after free");
+}
+
+ZTEST(at_params_arena, test_parser_arena)
+{
+	const char *str = "+CEREG: 5,\"0A0B\",\"01020304\",9,0,0,\"11100000\",\"11100000\"";
+	struct at_param params[10];
+	struct at_param_list list;
+	uint8_t buf[64];
+	struct at_param_arena arena = {
+		.buf = buf,
+		.size = sizeof(buf),
+	};
+	char test_buf[16];
+	size_t test_buf_len = sizeof(test_buf);
+
+	zassert_ok(at_params_list_init_arena(&list, params, ARRAY_SIZE(params), &arena));
+	zassert_ok(at_parser_params_from_str(str, NULL, &list));
+
+	zassert_equal(9, at_params_valid_count_get(&list), "Wrong valid count");
+	zassert_ok(at_params_string_get(&list, 3, test_buf, &test_buf_len));
+	zassert_equal(8, test_buf_len, "Wrong string length");
+	zassert_equal(0, memcmp("01020304", test_buf, test_buf_len), "Wrong string");
+
+	/* The arena is too small for all of the strings. */
+	arena.size = 16;
+	zassert_equal(-ENOMEM, at_parser_params_from_str(str, NULL, &list),
+		      "Parser should return -ENOMEM");
+
+	at_params_list_free(&list);
+}
+
 ZTEST_SUITE(at_params_noinit, NULL, NULL, NULL, NULL, NULL);
+ZTEST_SUITE(at_params_arena, NULL, NULL, NULL, NULL, NULL);
 ZTEST_SUITE(at_params, NULL, NULL, test_params_before, test_params_after, NULL);
@@ -127,4 +127,74 @@ ZTEST(suite_pcm_mix, test_mono_into_stereo_r)
 	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
 }
 
+ZTEST(suite_pcm_mix, test_mono_into_stereo_l_too_large)
+{
+	int ret;
+	int16_t sample_a[] = { 10, 10, 10, 10 };
+	int16_t sample_b[] = { -5, 5, 5 };
+	int16_t sample_r[] = { 10, 10, 10, 10 };
+
+	ret = pcm_mix(sample_a, sizeof(sample_a), sample_b, sizeof(sample_b),
+		      B_MONO_INTO_A_STEREO_L);
+	ZEQ(ret, -EPERM);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_ext_invalid_bit_depth)
+{
+	int ret;
+	int16_t sample_a[] = { 0, 1 };
+
+	ret = pcm_mix_ext(sample_a, sizeof(sample_a), PCM_MIX_GAIN_UNITY, sample_a,
+			  sizeof(sample_a), PCM_MIX_GAIN_UNITY, B_MONO_INTO_A_MONO, 8);
+	ZEQ(ret, -EINVAL);
+}
+
+ZTEST(suite_pcm_mix, test_ext_24_bit)
+{
+	int ret;
+	/* Packed little-endian: 0x7FFFFE, -2, 0x000100 */
+	uint8_t sample_a[] = { 0xFE, 0xFF, 0x7F, 0xFE, 0xFF, 0xFF, 0x00, 0x01, 0x00 };
+	/* 16, -3, 0x000001 */
+	uint8_t sample_b[] = { 0x10, 0x00, 0x00, 0xFD, 0xFF, 0xFF, 0x01, 0x00, 0x00 };
+	/* 0x7FFFFF (clipped), -5, 0x000101 */
+	uint8_t sample_r[] = { 0xFF, 0xFF, 0x7F, 0xFB, 0xFF, 0xFF, 0x01, 0x01, 0x00 };
+
+	ret = pcm_mix_ext(sample_a, sizeof(sample_a), PCM_MIX_GAIN_UNITY, sample_b,
+			  sizeof(sample_b), PCM_MIX_GAIN_UNITY, B_MONO_INTO_A_MONO, 24);
+	ZEQ(ret, 0);
+
+	zassert_mem_equal(sample_a, sample_r, sizeof(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_ext_32_bit_mono_into_stereo_r)
+{
+	int ret;
+	int32_t sample_a[] = { 10, INT32_MAX - 1, 10, INT32_MIN + 1 };
+	int32_t sample_b[] = { 5, -5 };
+	int32_t sample_r[] = { 10, INT32_MAX, 10, INT32_MIN };
+
+	ret = pcm_mix_ext(sample_a, sizeof(sample_a), PCM_MIX_GAIN_UNITY, sample_b,
+			  sizeof(sample_b), PCM_MIX_GAIN_UNITY, B_MONO_INTO_A_STEREO_R, 32);
+	ZEQ(ret, 0);
+
+	zassert_mem_equal(sample_a, sample_r, sizeof(sample_r));
+}
+
+ZTEST(suite_pcm_mix, test_ext_gain)
+{
+	int ret;
+	int16_t sample_a[] = { 1000, 1000, -1000, INT16_MAX };
+	int16_t sample_b[] = { 400, 20000 };
+	/* A at half gain and B at double gain into both channels, the second frame is clipped. */
+	int16_t sample_r[] = { 1300, 1300, INT16_MAX, INT16_MAX };
+
+	ret = pcm_mix_ext(sample_a, sizeof(sample_a), PCM_MIX_GAIN_UNITY / 2, sample_b,
+			  sizeof(sample_b), PCM_MIX_GAIN_UNITY * 2, B_MONO_INTO_A_STEREO_LR, 16);
+	ZEQ(ret, 0);
+
+	verify_array_eq(sample_a, sample_r, ARRAY_SIZE(sample_r));
+}
+
 ZTEST_SUITE(suite_pcm_mix, NULL, NULL, NULL, NULL, NULL);
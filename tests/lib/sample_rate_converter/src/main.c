@@ -1152,4 +1152,176 @@ ZTEST(suite_sample_rate_converter, test_invalid_process_output_buf_too_small)
 		      "Sample rate conversion process did not fail when output buffer is to small");
 }
 
+#if CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE && CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16
+ZTEST(suite_sample_rate_converter, test_valid_polyphase_44100_to_48000_dc)
+{
+	int ret;
+
+	uint32_t input_sample_rate = 44100;
+	uint32_t output_sample_rate = 48000;
+	enum sample_rate_converter_filter filter = SAMPLE_RATE_FILTER_POLYPHASE;
+
+	/* 10 ms blocks */
+	int16_t input_samples[441];
+	int16_t output_samples[480];
+	size_t output_written;
+
+	for (int i = 0; i < ARRAY_SIZE(input_samples); i++) {
+		input_samples[i] = 10000;
+	}
+
+	for (int block = 0; block < 4; block++) {
+		ret = sample_rate_converter_process(&conv_ctx, filter, input_samples,
+						    sizeof(input_samples), input_sample_rate,
+						    output_samples, sizeof(output_samples),
+						    &output_written, output_sample_rate);
+
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+		zassert_equal(conv_ctx.conversion_ratio, 0, "Conversion ratio not as expected");
+		zassert_equal(conv_ctx.filter_type, filter, "Filter set incorrectly");
+		zassert_equal(output_written, sizeof(output_samples),
+			      "Output size was not as expected (%d)", output_written);
+	}
+
+	/* The filter delay has passed, the output must have unity gain */
+	for (int i = 0; i < ARRAY_SIZE(output_samples); i++) {
+		zassert_within(output_samples[i], 10000, 10,
+			       "Output sample %d not within expected range (%d)", i,
+			       output_samples[i]);
+	}
+}
+
+#define POLYPHASE_STREAM_NUM_SAMPLES 1000
+ZTEST(suite_sample_rate_converter, test_valid_polyphase_block_size_independent)
+{
+	int ret;
+
+	static struct sample_rate_converter_ctx chunk_ctx;
+	static int16_t input_samples[POLYPHASE_STREAM_NUM_SAMPLES];
+	static int16_t output_one_block[POLYPHASE_STREAM_NUM_SAMPLES * 2];
+	static int16_t output_chunks[POLYPHASE_STREAM_NUM_SAMPLES * 2];
+	const size_t chunk_sizes[] = {1, 2, 17, 480, 500};
+
+	uint32_t input_sample_rate = 44100;
+	uint32_t output_sample_rate = 48000;
+	enum sample_rate_converter_filter filter = SAMPLE_RATE_FILTER_POLYPHASE;
+	uint32_t rand_state = 1;
+	size_t output_written;
+	size_t output_one_block_size;
+	size_t input_offset = 0;
+	size_t output_offset = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(input_samples); i++) {
+		rand_state = rand_state * 1103515245 + 12345;
+		input_samples[i] = (int16_t)(rand_state >> 16);
+	}
+
+	ret = sample_rate_converter_process(&conv_ctx, filter, input_samples,
+					    sizeof(input_samples), input_sample_rate,
+					    output_one_block, sizeof(output_one_block),
+					    &output_one_block_size, output_sample_rate);
+	zassert_equal(ret, 0, "Sample rate conversion process failed");
+	zassert_within(output_one_block_size / sizeof(int16_t),
+		       POLYPHASE_STREAM_NUM_SAMPLES * output_sample_rate / input_sample_rate, 1,
+		       "Output size was not as expected (%d)", output_one_block_size);
+
+	sample_rate_converter_open(&chunk_ctx);
+
+	for (int i = 0; input_offset < ARRAY_SIZE(input_samples); i++) {
+		size_t num_samples = MIN(chunk_sizes[i % ARRAY_SIZE(chunk_sizes)],
+					 ARRAY_SIZE(input_samples) - input_offset);
+
+		ret = sample_rate_converter_process(
+			&chunk_ctx, filter, &input_samples[input_offset],
+			num_samples * sizeof(int16_t), input_sample_rate,
+			&output_chunks[output_offset],
+			sizeof(output_chunks) - (output_offset * sizeof(int16_t)), &output_written,
+			output_sample_rate);
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+
+		input_offset += num_samples;
+		output_offset += output_written / sizeof(int16_t);
+	}
+
+	zassert_equal(output_offset * sizeof(int16_t), output_one_block_size,
+		      "Number of output samples depends on the block size");
+	zassert_mem_equal(output_chunks, output_one_block, output_one_block_size,
+			  "Output samples depend on the block size");
+}
+
+ZTEST(suite_sample_rate_converter, test_valid_polyphase_drift)
+{
+	int ret;
+
+	uint32_t sample_rate = 48000;
+	enum sample_rate_converter_filter filter = SAMPLE_RATE_FILTER_POLYPHASE;
+
+	int16_t input_samples[480] = {0};
+	int16_t output_samples[481];
+	size_t output_written;
+	size_t output_total = 0;
+
+	ret = sample_rate_converter_drift_set(&conv_ctx, SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX);
+	zassert_equal(ret, 0, "Failed to set drift");
+
+	/* One second of audio */
+	for (int block = 0; block < 100; block++) {
+		ret = sample_rate_converter_process(&conv_ctx, filter, input_samples,
+						    sizeof(input_samples), sample_rate,
+						    output_samples, sizeof(output_samples),
+						    &output_written, sample_rate);
+		zassert_equal(ret, 0, "Sample rate conversion process failed");
+
+		output_total += output_written / sizeof(int16_t);
+	}
+
+	/* 48000 / 1.001 output samples */
+	zassert_within(output_total, 47952, 1, "Drift not compensated (%d)", output_total);
+}
+
+ZTEST(suite_sample_rate_converter, test_invalid_polyphase_drift_out_of_range)
+{
+	int ret;
+
+	ret = sample_rate_converter_drift_set(&conv_ctx, SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX + 1);
+	zassert_equal(ret, -EINVAL, "Drift out of range was accepted");
+
+	ret = sample_rate_converter_drift_set(&conv_ctx, -SAMPLE_RATE_CONVERTER_DRIFT_PPM_MAX - 1);
+	zassert_equal(ret, -EINVAL, "Drift out of range was accepted");
+
+	ret = sample_rate_converter_drift_set(NULL, 0);
+	zassert_equal(ret, -EINVAL, "NULL context was accepted");
+}
+
+ZTEST(suite_sample_rate_converter, test_invalid_polyphase_sample_rate)
+{
+	int ret;
+
+	int16_t input_samples[441] = {0};
+	int16_t output_samples[480];
+	size_t output_written;
+
+	ret = sample_rate_converter_process(&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE,
+					    input_samples, sizeof(input_samples), 22050,
+					    output_samples, sizeof(output_samples), &output_written,
+					    48000);
+	zassert_equal(ret, -EINVAL, "Unsupported sample rate was accepted");
+}
+
+ZTEST(suite_sample_rate_converter, test_invalid_polyphase_output_buf_too_small)
+{
+	int ret;
+
+	int16_t input_samples[441] = {0};
+	int16_t output_samples[479];
+	size_t output_written;
+
+	ret = sample_rate_converter_process(&conv_ctx, SAMPLE_RATE_FILTER_POLYPHASE,
+					    input_samples, sizeof(input_samples), 44100,
+					    output_samples, sizeof(output_samples), &output_written,
+					    48000);
+	zassert_equal(ret, -EINVAL, "Output buffer too small was accepted");
+}
+#endif /* CONFIG_SAMPLE_RATE_CONVERTER_FILTER_POLYPHASE && CONFIG_SAMPLE_RATE_CONVERTER_BIT_DEPTH_16 */
+
 ZTEST_SUITE(suite_sample_rate_converter, NULL, NULL, test_setup, NULL, NULL);
@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include "coalesce_event.h"
+
+
+static bool merge_coalesce_event(struct app_event_header *pending,
+				 const struct app_event_header *aeh)
+{
+	struct coalesce_event *pending_event = cast_coalesce_event(pending);
+	const struct coalesce_event *event = cast_coalesce_event(aeh);
+
+	if (pending_event->cnt == UINT8_MAX) {
+		return false;
+	}
+
+	pending_event->dx += event->dx;
+	pending_event->dy += event->dy;
+	pending_event->cnt += event->cnt;
+
+	return true;
+}
+
+APP_EVENT_TYPE_DEFINE(coalesce_event,
+		  NULL,
+		  NULL,
+		  APP_EVENT_FLAGS_CREATE());
+
+APP_EVENT_TYPE_COALESCE(coalesce_event, merge_coalesce_event);
+
+APP_EVENT_TYPE_DEFINE(batch_event,
+		  NULL,
+		  NULL,
+		  APP_EVENT_FLAGS_CREATE());
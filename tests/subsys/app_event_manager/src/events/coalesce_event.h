@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _COALESCE_EVENT_H_
+#define _COALESCE_EVENT_H_
+
+/**
+ * @brief Coalesce Event
+ * @defgroup coalesce_event Coalesce Event
+ * @{
+ */
+
+#include <app_event_manager.h>
+#include <app_event_manager_profiler_tracer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct coalesce_event {
+	struct app_event_header header;
+
+	int16_t dx;
+	int16_t dy;
+	uint8_t cnt;
+};
+
+APP_EVENT_TYPE_DECLARE(coalesce_event);
+
+struct batch_event {
+	struct app_event_header header;
+
+	int val;
+};
+
+APP_EVENT_TYPE_DECLARE(batch_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _COALESCE_EVENT_H_ */
@@ -0,0 +1,42 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef _FILTER_EVENT_H_
+#define _FILTER_EVENT_H_
+
+/**
+ * @brief Filter Event
+ * @defgroup filter_event Filter Event
+ * @{
+ */
+
+#include <app_event_manager.h>
+#include <app_event_manager_profiler_tracer.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+struct filter_event {
+	struct app_event_header header;
+
+	uint8_t id;
+	int16_t val;
+	const void *ptr;
+	bool last;
+};
+
+APP_EVENT_TYPE_DECLARE(filter_event);
+
+#ifdef __cplusplus
+}
+#endif
+
+/**
+ * @}
+ */
+
+#endif /* _FILTER_EVENT_H_ */
@@ -29,6 +29,9 @@ enum test_id {
 	TEST_OOM,
 	TEST_MULTICONTEXT,
 	TEST_NAME_STYLE_SORTING,
+	TEST_SUBSCRIBER_FILTER,
+	TEST_COALESCE,
+	TEST_BATCH_SUBMIT,
 
 	TEST_CNT
 };
@@ -184,6 +184,25 @@ ZTEST(suite0, test_name_style_events_sorting)
 	test_start(TEST_NAME_STYLE_SORTING);
 }
 
+ZTEST(suite0, test_subs_filter)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_APP_EVENT_MANAGER_SUBSCRIBER_FILTERS);
+	test_start(TEST_SUBSCRIBER_FILTER);
+}
+
+ZTEST(suite0, test_coalesce)
+{
+	Z_TEST_SKIP_IFNDEF(CONFIG_APP_EVENT_MANAGER_COALESCING);
+	test_start(TEST_COALESCE);
+}
+
+ZTEST(suite0, test_batch_submit)
+{
+	/* The batch event is defined and handled along with the coalescing test */
+	Z_TEST_SKIP_IFNDEF(CONFIG_APP_EVENT_MANAGER_COALESCING);
+	test_start(TEST_BATCH_SUBMIT);
+}
+
 ZTEST_SUITE(suite0, NULL, test_init, NULL, NULL, NULL);
 
 static bool app_event_handler(const struct app_event_header *aeh)
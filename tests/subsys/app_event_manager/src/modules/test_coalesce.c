@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_events.h"
+#include "coalesce_event.h"
+
+#define COALESCE_EVENT_CNT	10
+#define BATCH_EVENT_CNT		8
+
+static enum test_id cur_test_id;
+static int coalesce_cnt;
+static int batch_cnt;
+
+
+static struct coalesce_event *coalesce_event_create(void)
+{
+	struct coalesce_event *event = new_coalesce_event();
+
+	event->dx = 1;
+	event->dy = -2;
+	event->cnt = 1;
+
+	return event;
+}
+
+static void test_coalesce_start(void)
+{
+	struct app_event_manager_coalesce_stats stats_before;
+	struct app_event_manager_coalesce_stats stats;
+
+	zassert_true(_app_event_manager_coalesce_stats_get(APP_EVENT_ID(coalesce_event),
+							   &stats_before),
+		     "Event type should be coalescing");
+	zassert_false(_app_event_manager_coalesce_stats_get(APP_EVENT_ID(batch_event), &stats),
+		      "Event type should not be coalescing");
+
+	/* The events are submitted from the event handler, so the first event is
+	 * still pending when the others are submitted.
+	 */
+	for (size_t i = 0; i < COALESCE_EVENT_CNT; i++) {
+		struct coalesce_event *event = coalesce_event_create();
+
+		APP_EVENT_SUBMIT(event);
+	}
+
+	zassert_true(_app_event_manager_coalesce_stats_get(APP_EVENT_ID(coalesce_event), &stats),
+		     "Event type should be coalescing");
+	zassert_equal(stats.merged - stats_before.merged, COALESCE_EVENT_CNT - 1,
+		      "Wrong number of merged events");
+}
+
+static void test_batch_submit_start(void)
+{
+	struct app_event_header *aehs[2 * BATCH_EVENT_CNT];
+
+	for (size_t i = 0; i < BATCH_EVENT_CNT; i++) {
+		struct batch_event *event = new_batch_event();
+
+		event->val = i;
+		aehs[2 * i] = &event->header;
+		aehs[2 * i + 1] = &coalesce_event_create()->header;
+	}
+
+	APP_EVENT_SUBMIT_BATCH(aehs, ARRAY_SIZE(aehs));
+}
+
+static void test_end(void)
+{
+	struct test_end_event *te = new_test_end_event();
+
+	te->test_id = cur_test_id;
+	APP_EVENT_SUBMIT(te);
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	if (is_test_start_event(aeh)) {
+		struct test_start_event *event = cast_test_start_event(aeh);
+
+		cur_test_id = event->test_id;
+		coalesce_cnt = 0;
+		batch_cnt = 0;
+
+		if (cur_test_id == TEST_COALESCE) {
+			test_coalesce_start();
+		} else if (cur_test_id == TEST_BATCH_SUBMIT) {
+			test_batch_submit_start();
+		}
+
+		return false;
+	}
+
+	if (is_coalesce_event(aeh)) {
+		struct coalesce_event *event = cast_coalesce_event(aeh);
+		int expected_cnt = (cur_test_id == TEST_COALESCE) ?
+				   COALESCE_EVENT_CNT : BATCH_EVENT_CNT;
+
+		zassert_equal(coalesce_cnt, 0, "Events not merged");
+		zassert_equal(event->cnt, expected_cnt, "Wrong number of merged events");
+		zassert_equal(event->dx, expected_cnt, "Wrong merged value");
+		zassert_equal(event->dy, -2 * expected_cnt, "Wrong merged value");
+		coalesce_cnt++;
+
+		if (cur_test_id == TEST_COALESCE) {
+			test_end();
+		}
+
+		return false;
+	}
+
+	if (is_batch_event(aeh)) {
+		struct batch_event *event = cast_batch_event(aeh);
+
+		zassert_equal(cur_test_id, TEST_BATCH_SUBMIT, "Unexpected event");
+		zassert_equal(event->val, batch_cnt, "Incorrect event order");
+		batch_cnt++;
+
+		if (batch_cnt == BATCH_EVENT_CNT) {
+			zassert_equal(coalesce_cnt, 1, "Merged event not delivered");
+			test_end();
+		}
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+
+	return false;
+}
+
+APP_EVENT_LISTENER(test_coalesce, app_event_handler);
+APP_EVENT_SUBSCRIBE(test_coalesce, coalesce_event);
+APP_EVENT_SUBSCRIBE(test_coalesce, batch_event);
+APP_EVENT_SUBSCRIBE(test_coalesce, test_start_event);
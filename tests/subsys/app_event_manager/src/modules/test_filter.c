@@ -0,0 +1,153 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/kernel.h>
+#include <zephyr/ztest.h>
+
+#include "test_events.h"
+#include "filter_event.h"
+
+#define FILTER_EVENT_CNT	12
+#define FILTER_ID		3
+#define FILTER_VAL		-7
+
+static enum test_id cur_test_id;
+static const int filter_marker;
+
+static int id_cnt;
+static int val_cnt;
+static int ptr_cnt;
+
+static int expected_id_cnt;
+static int expected_val_cnt;
+static int expected_ptr_cnt;
+
+static bool app_event_handler_source(const struct app_event_header *aeh)
+{
+	if (is_test_start_event(aeh)) {
+		struct test_start_event *event = cast_test_start_event(aeh);
+
+		cur_test_id = event->test_id;
+		if (cur_test_id != TEST_SUBSCRIBER_FILTER) {
+			return false;
+		}
+
+		id_cnt = 0;
+		val_cnt = 0;
+		ptr_cnt = 0;
+		expected_id_cnt = 0;
+		expected_val_cnt = 0;
+		expected_ptr_cnt = 0;
+
+		for (size_t i = 0; i < FILTER_EVENT_CNT; i++) {
+			struct filter_event *fe = new_filter_event();
+
+			fe->id = i % 4;
+			fe->val = ((i % 3) == 0) ? FILTER_VAL : i;
+			fe->ptr = ((i % 2) == 0) ? &filter_marker : NULL;
+			fe->last = (i == (FILTER_EVENT_CNT - 1));
+
+			expected_id_cnt += (fe->id == FILTER_ID);
+			expected_val_cnt += (fe->val == FILTER_VAL);
+			expected_ptr_cnt += (fe->ptr == &filter_marker);
+
+			APP_EVENT_SUBMIT(fe);
+		}
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+	return false;
+}
+
+APP_EVENT_LISTENER(filter_source, app_event_handler_source);
+APP_EVENT_SUBSCRIBE(filter_source, test_start_event);
+
+
+static bool app_event_handler_id(const struct app_event_header *aeh)
+{
+	if (is_filter_event(aeh)) {
+		struct filter_event *event = cast_filter_event(aeh);
+
+		zassert_equal(event->id, FILTER_ID, "Filter on uint8_t field not applied");
+		id_cnt++;
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+	return false;
+}
+
+APP_EVENT_LISTENER(filter_id, app_event_handler_id);
+APP_EVENT_SUBSCRIBE_EARLY_FILTER(filter_id, filter_event, id, FILTER_ID);
+
+
+static bool app_event_handler_val(const struct app_event_header *aeh)
+{
+	if (is_filter_event(aeh)) {
+		struct filter_event *event = cast_filter_event(aeh);
+
+		zassert_equal(event->val, FILTER_VAL, "Filter on int16_t field not applied");
+		val_cnt++;
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+	return false;
+}
+
+APP_EVENT_LISTENER(filter_val, app_event_handler_val);
+APP_EVENT_SUBSCRIBE_FILTER(filter_val, filter_event, val, FILTER_VAL);
+
+
+static bool app_event_handler_ptr(const struct app_event_header *aeh)
+{
+	if (is_filter_event(aeh)) {
+		struct filter_event *event = cast_filter_event(aeh);
+
+		zassert_equal_ptr(event->ptr, &filter_marker, "Filter on pointer field not applied");
+		ptr_cnt++;
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+	return false;
+}
+
+APP_EVENT_LISTENER(filter_ptr, app_event_handler_ptr);
+APP_EVENT_SUBSCRIBE_FILTER(filter_ptr, filter_event, ptr, &filter_marker);
+
+
+static bool app_event_handler_final(const struct app_event_header *aeh)
+{
+	if (is_filter_event(aeh)) {
+		struct filter_event *event = cast_filter_event(aeh);
+
+		if ((cur_test_id == TEST_SUBSCRIBER_FILTER) && event->last) {
+			zassert_equal(id_cnt, expected_id_cnt, "Wrong number of events");
+			zassert_equal(val_cnt, expected_val_cnt, "Wrong number of events");
+			zassert_equal(ptr_cnt, expected_ptr_cnt, "Wrong number of events");
+
+			struct test_end_event *te = new_test_end_event();
+
+			te->test_id = TEST_SUBSCRIBER_FILTER;
+			APP_EVENT_SUBMIT(te);
+		}
+
+		return false;
+	}
+
+	zassert_true(false, "Event unhandled");
+	return false;
+}
+
+/* Listener without filter is notified about all events. */
+APP_EVENT_LISTENER(filter_final, app_event_handler_final);
+APP_EVENT_SUBSCRIBE_FINAL(filter_final, filter_event);
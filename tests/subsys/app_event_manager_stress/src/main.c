@@ -0,0 +1,185 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Stress test of event submission.
+ *
+ * Many preemptive threads and a timer interrupt submit sequence numbered events concurrently.
+ * The listener verifies that no event is lost or duplicated and that events from every
+ * producer are delivered in the submission order.
+ */
+
+#include <zephyr/ztest.h>
+#include <app_event_manager.h>
+
+#define THREAD_CNT		8
+#define THREAD_EVENT_CNT	2000
+#define THREAD_STACK_SIZE	1024
+#define THREAD_PRIORITY		K_PRIO_PREEMPT(1)
+#define ISR_EVENT_CNT		100
+#define ISR_PERIOD		K_USEC(500)
+#define PRODUCER_CNT		(THREAD_CNT + 1)
+#define ISR_PRODUCER_ID		THREAD_CNT
+#define EVENT_CNT		(THREAD_CNT * THREAD_EVENT_CNT + ISR_EVENT_CNT)
+/* Limit of events allocated at the same time. Prevents running out of heap. */
+#define IN_FLIGHT_MAX		32
+#define TEST_TIMEOUT		K_SECONDS(30)
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+#define EVENT_QUEUE_CNT		CONFIG_APP_EVENT_MANAGER_EVENT_QUEUE_COUNT
+#else
+#define EVENT_QUEUE_CNT		1
+#endif
+
+struct stress_event {
+	struct app_event_header header;
+
+	uint8_t producer;
+	uint32_t seq;
+};
+
+APP_EVENT_TYPE_DECLARE(stress_event);
+APP_EVENT_TYPE_DEFINE(stress_event, NULL, NULL, APP_EVENT_FLAGS_CREATE());
+
+#if IS_ENABLED(CONFIG_APP_EVENT_MANAGER_EVENT_QUEUES)
+APP_EVENT_TYPE_QUEUE_ASSIGN(stress_event, EVENT_QUEUE_CNT - 1);
+#endif
+
+static K_THREAD_STACK_ARRAY_DEFINE(producer_stacks, THREAD_CNT, THREAD_STACK_SIZE);
+static struct k_thread producer_threads[THREAD_CNT];
+static K_SEM_DEFINE(in_flight_sem, IN_FLIGHT_MAX, IN_FLIGHT_MAX);
+static K_SEM_DEFINE(test_done_sem, 0, 1);
+
+static uint32_t next_seq[PRODUCER_CNT];
+static uint32_t isr_seq;
+static size_t received_cnt;
+static size_t order_error_cnt;
+static bool test_running;
+
+
+static void stress_event_submit(uint8_t producer, uint32_t seq)
+{
+	struct stress_event *event = new_stress_event();
+
+	event->producer = producer;
+	event->seq = seq;
+
+	APP_EVENT_SUBMIT(event);
+}
+
+static void timer_handler(struct k_timer *timer)
+{
+	if (isr_seq == ISR_EVENT_CNT) {
+		k_timer_stop(timer);
+		return;
+	}
+
+	/* Interrupt cannot wait for the heap to be released. Retry on the next period. */
+	if (k_sem_take(&in_flight_sem, K_NO_WAIT)) {
+		return;
+	}
+
+	stress_event_submit(ISR_PRODUCER_ID, isr_seq);
+	isr_seq++;
+}
+
+static K_TIMER_DEFINE(producer_timer, timer_handler, NULL);
+
+static void producer_fn(void *p1, void *p2, void *p3)
+{
+	uint8_t producer = (uintptr_t)p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t seq = 0; seq < THREAD_EVENT_CNT; seq++) {
+		(void)k_sem_take(&in_flight_sem, K_FOREVER);
+		stress_event_submit(producer, seq);
+
+		/* Let the simulated time pass to allow the timer interrupt and time slicing to
+		 * preempt the submitter.
+		 */
+		if ((seq % 8) == (producer % 8)) {
+			k_busy_wait(10);
+		} else if ((seq % 4) == 0) {
+			k_yield();
+		}
+	}
+}
+
+static bool app_event_handler(const struct app_event_header *aeh)
+{
+	const struct stress_event *event = cast_stress_event(aeh);
+
+	zassert_true(test_running, "Event received outside of the test");
+	zassert_true(event->producer < PRODUCER_CNT, "Invalid producer");
+
+	if (event->seq != next_seq[event->producer]) {
+		order_error_cnt++;
+	}
+
+	next_seq[event->producer] = event->seq + 1;
+	received_cnt++;
+
+	k_sem_give(&in_flight_sem);
+
+	if (received_cnt == EVENT_CNT) {
+		k_sem_give(&test_done_sem);
+	}
+
+	return false;
+}
+
+APP_EVENT_LISTENER(test_stress, app_event_handler);
+APP_EVENT_SUBSCRIBE(test_stress, stress_event);
+
+ZTEST(app_event_manager_stress, test_concurrent_submit)
+{
+	test_running = true;
+
+	k_timer_start(&producer_timer, ISR_PERIOD, ISR_PERIOD);
+
+	for (size_t i = 0; i < THREAD_CNT; i++) {
+		char name[sizeof("producer_XX")];
+
+		k_thread_create(&producer_threads[i], producer_stacks[i],
+				K_THREAD_STACK_SIZEOF(producer_stacks[i]),
+				producer_fn, (void *)i, NULL, NULL,
+				THREAD_PRIORITY, 0, K_NO_WAIT);
+
+		(void)snprintf(name, sizeof(name), "producer_%zu", i);
+		(void)k_thread_name_set(&producer_threads[i], name);
+	}
+
+	int err = k_sem_take(&test_done_sem, TEST_TIMEOUT);
+
+	zassert_ok(err, "Received %zu out of %u events", received_cnt, EVENT_CNT);
+
+	for (size_t i = 0; i < THREAD_CNT; i++) {
+		zassert_ok(k_thread_join(&producer_threads[i], K_SECONDS(1)),
+			   "Producer not finished");
+	}
+
+	/* Make sure no event is delivered after all of them were received. */
+	k_sleep(K_MSEC(10));
+	test_running = false;
+
+	zassert_equal(received_cnt, EVENT_CNT, "Event duplicated");
+	zassert_equal(order_error_cnt, 0, "Events delivered out of order");
+
+	for (size_t i = 0; i < THREAD_CNT; i++) {
+		zassert_equal(next_seq[i], THREAD_EVENT_CNT, "Events of producer %zu lost", i);
+	}
+	zassert_equal(next_seq[ISR_PRODUCER_ID], ISR_EVENT_CNT, "Events of interrupt lost");
+}
+
+static void *setup(void)
+{
+	zassert_ok(app_event_manager_init(), "Error when initializing");
+
+	return NULL;
+}
+
+ZTEST_SUITE(app_event_manager_stress, NULL, setup, NULL, NULL, NULL);
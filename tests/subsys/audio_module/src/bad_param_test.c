@@ -31,6 +31,10 @@ static struct data_fifo mod_fifo_tx, mod_fifo_rx;
 static struct audio_data test_block, test_block_tx, test_block_rx;
 static char mod_thread_stack[TEST_MOD_THREAD_STACK_SIZE];
 
+/* A data slab with more buffers than can be reference counted by a module. */
+K_MEM_SLAB_DEFINE_STATIC(large_data_slab, TEST_MOD_DATA_SIZE,
+			 CONFIG_AUDIO_MODULE_BUFFER_POOL_SIZE + 1, 4);
+
 /**
  * @brief Function to initialize a module's handle.
  *
@@ -1025,6 +1029,35 @@ ZTEST(suite_audio_module_bad_param, test_open_bad_thread)
 		      -ECANCELED, ret);
 }
 
+ZTEST(suite_audio_module_bad_param, test_open_bad_data_slab)
+{
+	int ret;
+	char *inst_name = "TEST open";
+	struct audio_module_functions test_functions = {
+		.configuration_set = test_config_set_function,
+		.configuration_get = test_config_get_function,
+		.data_process = test_data_process_function};
+	struct audio_module_parameters test_params_slab = {0};
+
+	test_initialize_description(&test_description, "Module Test", AUDIO_MODULE_TYPE_IN_OUT,
+				    &test_functions);
+	test_params_slab.description = &test_description;
+	test_params_slab.thread.stack = (k_thread_stack_t *)&mod_thread_stack;
+	test_params_slab.thread.stack_size = TEST_MOD_THREAD_STACK_SIZE;
+	test_params_slab.thread.priority = TEST_MOD_THREAD_PRIORITY;
+	test_params_slab.thread.data_slab = &large_data_slab;
+	test_params_slab.thread.data_size = TEST_MOD_DATA_SIZE;
+
+	memset(&handle, 0, sizeof(struct audio_module_handle));
+
+	ret = audio_module_open(&test_params_slab, config, inst_name,
+				(struct audio_module_context *)&context, &handle);
+	zassert_equal(ret, -EINVAL, "Open function did not return -EINVAL (%d): ret %d", -EINVAL,
+		      ret);
+	zassert_equal(handle.state, AUDIO_MODULE_STATE_UNDEFINED,
+		      "Open with a too large data slab changed the state to %d", handle.state);
+}
+
 ZTEST(suite_audio_module_bad_param, test_open_bad_description)
 {
 	int ret;
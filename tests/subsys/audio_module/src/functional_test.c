@@ -48,6 +48,8 @@ struct audio_module_parameters test_mod_parameters;
 static struct audio_module_handle handle;
 static struct mod_context *handle_context;
 static struct data_fifo mod_fifo_tx, mod_fifo_rx;
+static int release_cb_count;
+static void const *release_cb_data;
 
 /**
  * @brief Set the minimum for a handle.
@@ -110,6 +112,19 @@ static int thread_start(struct audio_module_handle *test_handle)
 	return 0;
 }
 
+/**
+ * @brief Test response callback counting the released audio data.
+ *
+ * @param handle      [in/out]  The handle of the module that sent the audio data.
+ * @param audio_data  [in]      The audio data released.
+ */
+static void test_release_cb(struct audio_module_handle_private *handle,
+			    struct audio_data const *const audio_data)
+{
+	release_cb_count++;
+	release_cb_data = audio_data->data;
+}
+
 /**
  * @brief Initialize a handle.
  *
@@ -1035,3 +1050,62 @@ ZTEST(suite_audio_module_functional, test_data_rx_fnct)
 		      "Data RX function failed to free item, data FIFO free called %d times",
 		      data_fifo_block_free_fake.call_count);
 }
+
+ZTEST(suite_audio_module_functional, test_data_rx_release_fnct)
+{
+	int ret;
+	char *test_inst_name = "TEST instance 1";
+	char test_data[TEST_MOD_DATA_SIZE];
+	char data[TEST_MOD_DATA_SIZE] = {0};
+	struct audio_data audio_data_out = {0};
+	struct audio_module_message *data_msg_tx;
+
+	test_context_set(&mod_context, &mod_config);
+
+	/* Fake internal empty data FIFO success */
+	data_fifo_init_fake.custom_fake = fake_data_fifo_init__succeeds;
+	data_fifo_pointer_first_vacant_get_fake.custom_fake =
+		fake_data_fifo_pointer_first_vacant_get__succeeds;
+	data_fifo_block_lock_fake.custom_fake = fake_data_fifo_block_lock__succeeds;
+	data_fifo_pointer_last_filled_get_fake.custom_fake =
+		fake_data_fifo_pointer_last_filled_get__succeeds;
+	data_fifo_block_free_fake.custom_fake = fake_data_fifo_block_free__succeeds;
+
+	data_fifo_deinit(&mod_fifo_tx);
+
+	data_fifo_init(&mod_fifo_tx);
+
+	memcpy(&handle.name, test_inst_name, sizeof(*test_inst_name));
+	handle.description = &mod_description;
+	handle.thread.msg_rx = NULL;
+	handle.thread.msg_tx = &mod_fifo_tx;
+	handle.thread.data_slab = &data_slab;
+	handle.thread.data_size = TEST_MOD_DATA_SIZE;
+	handle.state = AUDIO_MODULE_STATE_RUNNING;
+	handle.context = (struct audio_module_context *)&mod_context;
+
+	release_cb_count = 0;
+	release_cb_data = NULL;
+
+	ret = data_fifo_pointer_first_vacant_get(handle.thread.msg_tx, (void **)&data_msg_tx,
+						 K_NO_WAIT);
+
+	data_msg_tx->audio_data.data = &test_data[0];
+	data_msg_tx->audio_data.data_size = TEST_MOD_DATA_SIZE;
+	data_msg_tx->tx_handle = &handle;
+	data_msg_tx->response_cb = test_release_cb;
+
+	ret = data_fifo_block_lock(handle.thread.msg_tx, (void **)&data_msg_tx,
+				   sizeof(struct audio_module_message));
+
+	audio_data_out.data = &data[0];
+	audio_data_out.data_size = TEST_MOD_DATA_SIZE;
+
+	ret = audio_module_data_rx(&handle, &audio_data_out, K_NO_WAIT);
+	zassert_equal(ret, 0, "Data RX function did not return successfully: ret %d", ret);
+	zassert_equal(release_cb_count, 1,
+		      "Data RX function released the audio data %d times, not once",
+		      release_cb_count);
+	zassert_equal_ptr(release_cb_data, &test_data[0],
+			  "Data RX function released the wrong audio data");
+}
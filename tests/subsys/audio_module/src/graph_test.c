@@ -0,0 +1,420 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <errno.h>
+
+#include "audio_module/audio_module.h"
+#include "audio_module_test_common.h"
+#include "fakes.h"
+
+#define TEST_GRAPH_MODULES_NUM (3)
+#define TEST_GRAPH_FRAMES_NUM  (3)
+#define TEST_GRAPH_TIMEOUT     (K_MSEC(100))
+#define TEST_GRAPH_RUN_LOG_MAX (TEST_GRAPH_MODULES_NUM * TEST_GRAPH_FRAMES_NUM)
+
+K_THREAD_STACK_DEFINE(graph_stack, TEST_MOD_THREAD_STACK_SIZE);
+K_MEM_SLAB_DEFINE_STATIC(graph_source_slab, TEST_MOD_DATA_SIZE, FAKE_FIFO_MSG_QUEUE_SIZE, 4);
+K_MEM_SLAB_DEFINE_STATIC(graph_filter_slab, TEST_MOD_DATA_SIZE, FAKE_FIFO_MSG_QUEUE_SIZE, 4);
+
+static K_SEM_DEFINE(frame_sem, 0, TEST_GRAPH_FRAMES_NUM);
+static K_SEM_DEFINE(frame_done_sem, 0, TEST_GRAPH_FRAMES_NUM);
+
+static struct audio_module_graph graph;
+static struct audio_module_handle source, filter, sink;
+static struct mod_context source_ctx, filter_ctx, sink_ctx;
+static struct mod_config graph_config;
+static struct data_fifo graph_msg_rx;
+static struct audio_module_handle *run_log[TEST_GRAPH_RUN_LOG_MAX];
+static int run_log_count;
+static uint32_t filter_busy_us;
+static uint8_t external_data[TEST_MOD_DATA_SIZE];
+static struct audio_module_message external_msg;
+static bool external_pending;
+static int external_release_count;
+
+static void run_log_add(struct audio_module_handle_private *handle)
+{
+	if (run_log_count < TEST_GRAPH_RUN_LOG_MAX) {
+		run_log[run_log_count++] = (struct audio_module_handle *)handle;
+	}
+}
+
+static int source_data_process(struct audio_module_handle_private *handle,
+			       struct audio_data const *const audio_data_rx,
+			       struct audio_data *audio_data_tx)
+{
+	if (k_sem_take(&frame_sem, K_MSEC(10))) {
+		return -EAGAIN;
+	}
+
+	run_log_add(handle);
+	memset(audio_data_tx->data, 0x5A, audio_data_tx->data_size);
+
+	return 0;
+}
+
+static int filter_data_process(struct audio_module_handle_private *handle,
+			       struct audio_data const *const audio_data_rx,
+			       struct audio_data *audio_data_tx)
+{
+	run_log_add(handle);
+	k_busy_wait(filter_busy_us);
+	memcpy(audio_data_tx->data, audio_data_rx->data, audio_data_rx->data_size);
+	audio_data_tx->data_size = audio_data_rx->data_size;
+
+	return 0;
+}
+
+static int sink_data_process(struct audio_module_handle_private *handle,
+			     struct audio_data const *const audio_data_rx,
+			     struct audio_data *audio_data_tx)
+{
+	run_log_add(handle);
+	k_sem_give(&frame_done_sem);
+
+	return 0;
+}
+
+/* Wait for audio data from the application, which never comes. */
+static int msg_rx_wait_timeout(struct data_fifo *data_fifo, void **data, size_t *size,
+			       k_timeout_t timeout)
+{
+	ARG_UNUSED(data_fifo);
+	ARG_UNUSED(data);
+	ARG_UNUSED(size);
+
+	k_sleep(timeout);
+
+	return -EAGAIN;
+}
+
+/* Give audio data from the application once, as if it was put on the RX FIFO. */
+static int msg_rx_external_get(struct data_fifo *data_fifo, void **data, size_t *size,
+			       k_timeout_t timeout)
+{
+	ARG_UNUSED(timeout);
+
+	if (data_fifo != &graph_msg_rx || !external_pending) {
+		return -EAGAIN;
+	}
+
+	external_pending = false;
+	*data = &external_msg;
+	*size = sizeof(external_msg);
+
+	return 0;
+}
+
+static void external_release_cb(struct audio_module_handle_private *handle,
+				struct audio_data const *const audio_data)
+{
+	ARG_UNUSED(handle);
+
+	zassert_equal_ptr(audio_data->data, external_data, "Wrong audio data released");
+	external_release_count++;
+}
+
+static const struct audio_module_functions source_functions = {
+	.configuration_set = test_config_set_function,
+	.configuration_get = test_config_get_function,
+	.data_process = source_data_process};
+static const struct audio_module_functions filter_functions = {
+	.configuration_set = test_config_set_function,
+	.configuration_get = test_config_get_function,
+	.data_process = filter_data_process};
+static const struct audio_module_functions sink_functions = {
+	.configuration_set = test_config_set_function,
+	.configuration_get = test_config_get_function,
+	.data_process = sink_data_process};
+
+static struct audio_module_description source_description = {
+	.name = "Source", .type = AUDIO_MODULE_TYPE_INPUT, .functions = &source_functions};
+static struct audio_module_description filter_description = {
+	.name = "Filter", .type = AUDIO_MODULE_TYPE_IN_OUT, .functions = &filter_functions};
+static struct audio_module_description sink_description = {
+	.name = "Sink", .type = AUDIO_MODULE_TYPE_OUTPUT, .functions = &sink_functions};
+
+/**
+ * @brief Open a module in the graph.
+ *
+ * @param description  [in]   Pointer to the module's description.
+ * @param slab         [in]   The module's data slab. This can be NULL.
+ * @param msg_rx       [in]   The module's RX FIFO for audio data from the application. This can
+ *                            be NULL.
+ * @param deadline_us  [in]   Processing time budget of the module.
+ * @param name         [in]   The module's instance name.
+ * @param context      [in]   Pointer to the module's context.
+ * @param handle       [out]  The handle to the module instance.
+ */
+static void test_graph_module_open(struct audio_module_description *description,
+				   struct k_mem_slab *slab, struct data_fifo *msg_rx,
+				   uint32_t deadline_us, char *name, struct mod_context *context,
+				   struct audio_module_handle *handle)
+{
+	int ret;
+	struct audio_module_parameters parameters = {
+		.description = description,
+		.thread = {.data_slab = slab, .data_size = TEST_MOD_DATA_SIZE, .msg_rx = msg_rx},
+		.graph = &graph,
+		.deadline_us = deadline_us};
+
+	memset(handle, 0, sizeof(struct audio_module_handle));
+
+	ret = audio_module_open(&parameters, (struct audio_module_configuration *)&graph_config,
+				name, (struct audio_module_context *)context, handle);
+	zassert_equal(ret, 0, "Open function did not return successfully: ret %d", ret);
+}
+
+/**
+ * @brief Open a source, a filter and a sink in the graph and connect them in a chain.
+ *
+ * @note The modules are opened in the reverse order of the chain, so the graph must order them.
+ *
+ * @param filter_deadline_us  [in]  Processing time budget of the filter.
+ * @param sink_msg_rx         [in]  The sink's RX FIFO for audio data from the application. This
+ *                                  can be NULL.
+ */
+static void test_graph_chain_open(uint32_t filter_deadline_us, struct data_fifo *sink_msg_rx)
+{
+	int ret;
+
+	ret = audio_module_graph_init(&graph, graph_stack, TEST_MOD_THREAD_STACK_SIZE,
+				      TEST_MOD_THREAD_PRIORITY, 0);
+	zassert_equal(ret, 0, "Graph init did not return successfully: ret %d", ret);
+
+	test_graph_module_open(&sink_description, NULL, sink_msg_rx, 0, "sink", &sink_ctx, &sink);
+	test_graph_module_open(&filter_description, &graph_filter_slab, NULL, filter_deadline_us,
+			       "filter", &filter_ctx, &filter);
+	test_graph_module_open(&source_description, &graph_source_slab, NULL, 0, "source",
+			       &source_ctx, &source);
+
+	zassert_equal(audio_module_connect(&source, &filter, false), 0, "Connect failed");
+	zassert_equal(audio_module_connect(&filter, &sink, false), 0, "Connect failed");
+	zassert_equal(audio_module_start(&sink), 0, "Start failed");
+	zassert_equal(audio_module_start(&filter), 0, "Start failed");
+	zassert_equal(audio_module_start(&source), 0, "Start failed");
+
+	run_log_count = 0;
+	k_sem_reset(&frame_sem);
+	k_sem_reset(&frame_done_sem);
+}
+
+/**
+ * @brief Stop the graph and close the modules of the chain.
+ */
+static void test_graph_chain_close(void)
+{
+	int ret;
+
+	ret = audio_module_graph_stop(&graph, TEST_GRAPH_TIMEOUT);
+	zassert_equal(ret, 0, "Graph stop did not return successfully: ret %d", ret);
+
+	zassert_equal(audio_module_stop(&source), 0, "Stop failed");
+	zassert_equal(audio_module_stop(&filter), 0, "Stop failed");
+	zassert_equal(audio_module_stop(&sink), 0, "Stop failed");
+	zassert_equal(audio_module_close(&source), 0, "Close failed");
+	zassert_equal(audio_module_close(&filter), 0, "Close failed");
+	zassert_equal(audio_module_close(&sink), 0, "Close failed");
+
+	zassert_equal(k_mem_slab_num_used_get(&graph_source_slab), 0,
+		      "Source data buffers not released");
+	zassert_equal(k_mem_slab_num_used_get(&graph_filter_slab), 0,
+		      "Filter data buffers not released");
+}
+
+/**
+ * @brief Run frames through the chain.
+ *
+ * @param frames  [in]  The number of frames to run.
+ */
+static void test_graph_frames_run(int frames)
+{
+	int ret;
+
+	for (int i = 0; i < frames; i++) {
+		k_sem_give(&frame_sem);
+
+		ret = k_sem_take(&frame_done_sem, TEST_GRAPH_TIMEOUT);
+		zassert_equal(ret, 0, "Frame %d did not reach the sink", i);
+	}
+}
+
+ZTEST(suite_audio_module_graph, test_graph_order_fnct)
+{
+	int ret;
+	struct audio_module_graph_stats stats;
+	struct audio_module_handle *expected[] = {&source, &filter, &sink};
+
+	test_graph_chain_open(0, NULL);
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	test_graph_frames_run(TEST_GRAPH_FRAMES_NUM);
+
+	zassert_equal(run_log_count, TEST_GRAPH_RUN_LOG_MAX, "Modules ran %d times, not %d",
+		      run_log_count, TEST_GRAPH_RUN_LOG_MAX);
+
+	for (int i = 0; i < run_log_count; i++) {
+		zassert_equal_ptr(run_log[i], expected[i % TEST_GRAPH_MODULES_NUM],
+				  "Module %s ran out of order at %d", run_log[i]->name, i);
+	}
+
+	ret = audio_module_graph_stats_get(&graph, &filter, &stats);
+	zassert_equal(ret, 0, "Stats get did not return successfully: ret %d", ret);
+	zassert_equal(stats.frame_count, TEST_GRAPH_FRAMES_NUM,
+		      "Filter processed %d frames, not %d", stats.frame_count,
+		      TEST_GRAPH_FRAMES_NUM);
+	zassert_equal(stats.deadline_miss_count, 0, "Filter has no deadline but missed %d",
+		      stats.deadline_miss_count);
+
+	ret = audio_module_graph_stats_get(&graph, NULL, &stats);
+	zassert_equal(ret, 0, "Stats get did not return successfully: ret %d", ret);
+	zassert_equal(stats.frame_count, TEST_GRAPH_FRAMES_NUM,
+		      "Graph processed %d frames, not %d", stats.frame_count,
+		      TEST_GRAPH_FRAMES_NUM);
+
+	test_graph_chain_close();
+}
+
+ZTEST(suite_audio_module_graph, test_graph_deadline_fnct)
+{
+	int ret;
+	struct audio_module_graph_stats stats;
+
+	filter_busy_us = 500;
+	test_graph_chain_open(100, NULL);
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	test_graph_frames_run(TEST_GRAPH_FRAMES_NUM);
+
+	ret = audio_module_graph_stats_get(&graph, &filter, &stats);
+	zassert_equal(ret, 0, "Stats get did not return successfully: ret %d", ret);
+	zassert_equal(stats.deadline_miss_count, TEST_GRAPH_FRAMES_NUM,
+		      "Filter missed %d deadlines, not %d", stats.deadline_miss_count,
+		      TEST_GRAPH_FRAMES_NUM);
+	zassert_true(stats.process_time_max_us >= filter_busy_us,
+		     "Filter processing time %d us shorter than %d us", stats.process_time_max_us,
+		     filter_busy_us);
+
+	filter_busy_us = 0;
+
+	test_graph_chain_close();
+}
+
+ZTEST(suite_audio_module_graph, test_graph_external_data_fnct)
+{
+	int ret;
+	struct audio_module_handle *expected[] = {&source, &filter, &sink, &sink};
+
+	data_fifo_pointer_last_filled_get_fake.custom_fake = msg_rx_external_get;
+
+	external_msg.audio_data.data = external_data;
+	external_msg.audio_data.data_size = sizeof(external_data);
+	external_msg.tx_handle = NULL;
+	external_msg.response_cb = external_release_cb;
+	external_release_count = 0;
+
+	/* The sink gets audio data from the filter and from the application. */
+	test_graph_chain_open(0, &graph_msg_rx);
+	external_pending = true;
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	k_sem_give(&frame_sem);
+
+	/* Both the audio data items are processed in the same frame. */
+	for (int i = 0; i < 2; i++) {
+		ret = k_sem_take(&frame_done_sem, TEST_GRAPH_TIMEOUT);
+		zassert_equal(ret, 0, "Audio data %d did not reach the sink", i);
+	}
+
+	zassert_equal(run_log_count, ARRAY_SIZE(expected), "Modules ran %d times, not %d",
+		      run_log_count, ARRAY_SIZE(expected));
+
+	for (int i = 0; i < run_log_count; i++) {
+		zassert_equal_ptr(run_log[i], expected[i], "Module %s ran out of order at %d",
+				  run_log[i]->name, i);
+	}
+
+	zassert_equal(external_release_count, 1,
+		      "Audio data from the application released %d times, not once",
+		      external_release_count);
+
+	/* The order of the modules is built when the graph starts. */
+	ret = audio_module_connect(&source, &sink, false);
+	zassert_equal(ret, -EBUSY, "Connect did not return -EBUSY (%d): ret %d", -EBUSY, ret);
+	ret = audio_module_disconnect(&filter, &sink, false);
+	zassert_equal(ret, -EBUSY, "Disconnect did not return -EBUSY (%d): ret %d", -EBUSY, ret);
+
+	test_graph_chain_close();
+}
+
+ZTEST(suite_audio_module_graph, test_graph_loop_fnct)
+{
+	int ret;
+
+	ret = audio_module_graph_init(&graph, graph_stack, TEST_MOD_THREAD_STACK_SIZE,
+				      TEST_MOD_THREAD_PRIORITY, 0);
+	zassert_equal(ret, 0, "Graph init did not return successfully: ret %d", ret);
+
+	/* Two processing modules sending to each other. */
+	test_graph_module_open(&filter_description, &graph_source_slab, NULL, 0, "loop 1",
+			       &source_ctx, &source);
+	test_graph_module_open(&filter_description, &graph_filter_slab, NULL, 0, "loop 2",
+			       &filter_ctx, &filter);
+	zassert_equal(audio_module_connect(&source, &filter, false), 0, "Connect failed");
+	zassert_equal(audio_module_connect(&filter, &source, false), 0, "Connect failed");
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, -EINVAL, "Graph start did not return -EINVAL (%d): ret %d", -EINVAL,
+		      ret);
+
+	zassert_equal(audio_module_close(&source), 0, "Close failed");
+	zassert_equal(audio_module_close(&filter), 0, "Close failed");
+}
+
+ZTEST(suite_audio_module_graph, test_graph_stop_waiting_fnct)
+{
+	int ret;
+
+	data_fifo_pointer_last_filled_get_fake.custom_fake = msg_rx_wait_timeout;
+
+	ret = audio_module_graph_init(&graph, graph_stack, TEST_MOD_THREAD_STACK_SIZE,
+				      TEST_MOD_THREAD_PRIORITY, 0);
+	zassert_equal(ret, 0, "Graph init did not return successfully: ret %d", ret);
+
+	/* The filter waits for audio data from the application, which never comes. */
+	test_graph_module_open(&filter_description, &graph_filter_slab, &graph_msg_rx, 0, "filter",
+			       &filter_ctx, &filter);
+	test_graph_module_open(&sink_description, NULL, NULL, 0, "sink", &sink_ctx, &sink);
+	zassert_equal(audio_module_connect(&filter, &sink, false), 0, "Connect failed");
+	zassert_equal(audio_module_start(&sink), 0, "Start failed");
+	zassert_equal(audio_module_start(&filter), 0, "Start failed");
+
+	ret = audio_module_graph_start(&graph);
+	zassert_equal(ret, 0, "Graph start did not return successfully: ret %d", ret);
+
+	k_sleep(K_MSEC(5 * CONFIG_AUDIO_MODULE_GRAPH_WAIT_MS));
+	zassert_true(data_fifo_pointer_last_filled_get_fake.call_count > 0,
+		     "The filter did not wait for audio data");
+
+	ret = audio_module_graph_stop(&graph, K_MSEC(2 * CONFIG_AUDIO_MODULE_GRAPH_WAIT_MS));
+	zassert_equal(ret, 0, "Graph stop did not return successfully: ret %d", ret);
+
+	ret = audio_module_graph_stop(&graph, TEST_GRAPH_TIMEOUT);
+	zassert_equal(ret, -EALREADY, "Graph stop did not return -EALREADY (%d): ret %d",
+		      -EALREADY, ret);
+
+	zassert_equal(audio_module_stop(&filter), 0, "Stop failed");
+	zassert_equal(audio_module_stop(&sink), 0, "Stop failed");
+	zassert_equal(audio_module_close(&filter), 0, "Close failed");
+	zassert_equal(audio_module_close(&sink), 0, "Close failed");
+}
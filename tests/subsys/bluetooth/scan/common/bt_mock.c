@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+/* Minimal Bluetooth host for running the scan library without a controller. */
+
+#include "bt_mock.h"
+
+static struct bt_le_scan_cb *scan_cb;
+static struct bt_conn_cb *conn_cb;
+
+void bt_le_scan_cb_register(struct bt_le_scan_cb *cb)
+{
+	scan_cb = cb;
+}
+
+int bt_le_scan_start(const struct bt_le_scan_param *param, bt_le_scan_cb_t cb)
+{
+	return 0;
+}
+
+int bt_le_scan_stop(void)
+{
+	return 0;
+}
+
+int bt_conn_cb_register(struct bt_conn_cb *cb)
+{
+	conn_cb = cb;
+
+	return 0;
+}
+
+const bt_addr_le_t *bt_conn_get_dst(const struct bt_conn *conn)
+{
+	return &conn->dst;
+}
+
+void bt_data_parse(struct net_buf_simple *ad,
+		   bool (*func)(struct bt_data *data, void *user_data),
+		   void *user_data)
+{
+	size_t i = 0;
+
+	while (i + 1 < ad->len) {
+		struct bt_data data;
+		uint8_t len = ad->data[i];
+
+		if ((len == 0) || (i + 1 + len > ad->len)) {
+			return;
+		}
+
+		data.type = ad->data[i + 1];
+		data.data_len = len - 1;
+		data.data = &ad->data[i + 2];
+
+		if (!func(&data, user_data)) {
+			return;
+		}
+
+		i += 1 + len;
+	}
+}
+
+void bt_mock_scan_recv(const struct bt_le_scan_recv_info *info,
+		       struct net_buf_simple *ad)
+{
+	scan_cb->recv(info, ad);
+}
+
+void bt_mock_connected(struct bt_conn *conn, uint8_t err)
+{
+	conn_cb->connected(conn, err);
+}
+
+void bt_mock_disconnected(struct bt_conn *conn, uint8_t reason)
+{
+	conn_cb->disconnected(conn, reason);
+}
@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef BT_MOCK_H__
+#define BT_MOCK_H__
+
+#include <zephyr/bluetooth/bluetooth.h>
+#include <zephyr/bluetooth/conn.h>
+
+/* Connection object of the mocked Bluetooth host. */
+struct bt_conn {
+	bt_addr_le_t dst;
+};
+
+/* Feed an advertising report to the scan callbacks registered in the host. */
+void bt_mock_scan_recv(const struct bt_le_scan_recv_info *info,
+		       struct net_buf_simple *ad);
+
+/* Notify the connection callbacks registered in the host. */
+void bt_mock_connected(struct bt_conn *conn, uint8_t err);
+void bt_mock_disconnected(struct bt_conn *conn, uint8_t reason);
+
+#endif /* BT_MOCK_H__ */
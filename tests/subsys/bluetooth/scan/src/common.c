@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "bt_mock.h"
+#include "common.h"
+
+uint32_t match_cnt;
+uint32_t no_match_cnt;
+struct bt_scan_filter_match last_match;
+
+static void scan_filter_match(struct bt_scan_device_info *device_info,
+			      struct bt_scan_filter_match *filter_match,
+			      bool connectable)
+{
+	match_cnt++;
+	last_match = *filter_match;
+}
+
+static void scan_filter_no_match(struct bt_scan_device_info *device_info,
+				 bool connectable)
+{
+	no_match_cnt++;
+}
+
+BT_SCAN_CB_INIT(scan_cb, scan_filter_match, scan_filter_no_match, NULL, NULL);
+
+void scan_test_init(void)
+{
+	static bool initialized;
+
+	if (initialized) {
+		return;
+	}
+
+	bt_scan_init(NULL);
+	bt_scan_cb_register(&scan_cb);
+
+	initialized = true;
+}
+
+void ad_add(struct ad_builder *ad, uint8_t type, const void *data, size_t len)
+{
+	zassert_true(ad->len + 2 + len <= sizeof(ad->buf), "Advertising data too long");
+
+	ad->buf[ad->len++] = len + 1;
+	ad->buf[ad->len++] = type;
+	memcpy(&ad->buf[ad->len], data, len);
+	ad->len += len;
+}
+
+void ad_name_add(struct ad_builder *ad, uint8_t type, const char *name)
+{
+	ad_add(ad, type, name, strlen(name));
+}
+
+void device_addr_get(uint16_t idx, bt_addr_le_t *addr)
+{
+	memset(addr, 0, sizeof(*addr));
+	addr->type = BT_ADDR_LE_RANDOM;
+	sys_put_le16(idx, addr->a.val);
+	/* Static random address */
+	addr->a.val[5] = 0xC0;
+}
+
+void report_feed(const bt_addr_le_t *addr, struct ad_builder *ad)
+{
+	struct bt_le_scan_recv_info info = {
+		.addr = addr,
+		.adv_type = BT_GAP_ADV_TYPE_ADV_IND,
+		.adv_props = BT_GAP_ADV_PROP_CONNECTABLE | BT_GAP_ADV_PROP_SCANNABLE,
+		.rssi = -60,
+	};
+	struct net_buf_simple buf = {
+		.data = ad->buf,
+		.len = ad->len,
+		.size = sizeof(ad->buf),
+		.__buf = ad->buf,
+	};
+
+	memset(&last_match, 0, sizeof(last_match));
+
+	bt_mock_scan_recv(&info, &buf);
+}
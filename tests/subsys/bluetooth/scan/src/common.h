@@ -0,0 +1,37 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef SCAN_TEST_COMMON_H__
+#define SCAN_TEST_COMMON_H__
+
+#include <bluetooth/scan.h>
+
+#define AD_LEN_MAX 64
+
+/* Advertising data built one structure at a time. */
+struct ad_builder {
+	uint8_t buf[AD_LEN_MAX];
+	size_t len;
+};
+
+/* Filter callbacks made by the scan library. */
+extern uint32_t match_cnt;
+extern uint32_t no_match_cnt;
+extern struct bt_scan_filter_match last_match;
+
+/* Initialize the scan library and register the callbacks, once for all the suites. */
+void scan_test_init(void);
+
+void ad_add(struct ad_builder *ad, uint8_t type, const void *data, size_t len);
+void ad_name_add(struct ad_builder *ad, uint8_t type, const char *name);
+
+/* Get the static random address of a test device. */
+void device_addr_get(uint16_t idx, bt_addr_le_t *addr);
+
+/* Feed the advertising data to the scan library as a report of a device. */
+void report_feed(const bt_addr_le_t *addr, struct ad_builder *ad);
+
+#endif /* SCAN_TEST_COMMON_H__ */
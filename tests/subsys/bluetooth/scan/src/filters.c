@@ -0,0 +1,258 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zephyr/sys/byteorder.h>
+
+#include "common.h"
+
+#define COMPANY_ID 0x0059
+
+/* Devices of this suite, each report comes from a new one. */
+#define DEVICE_IDX_FIRST 0x1000
+
+static uint16_t device_idx = DEVICE_IDX_FIRST;
+
+/* Feed the advertising data to the scan library as a report of a new device, and check
+ * whether a filter matched.
+ */
+static bool report_matches(struct ad_builder *ad)
+{
+	uint32_t prev_match_cnt = match_cnt;
+	uint32_t prev_no_match_cnt = no_match_cnt;
+	bt_addr_le_t addr;
+
+	device_addr_get(device_idx++, &addr);
+	report_feed(&addr, ad);
+
+	zassert_equal(match_cnt + no_match_cnt, prev_match_cnt + prev_no_match_cnt + 1,
+		      "Report not notified once");
+
+	return match_cnt != prev_match_cnt;
+}
+
+static uint32_t hit_count(enum bt_scan_filter_type type, uint16_t index)
+{
+	uint32_t hit_cnt;
+
+	zassert_ok(bt_scan_filter_hit_count_get(type, index, &hit_cnt));
+
+	return hit_cnt;
+}
+
+ZTEST(bt_scan_filters, test_short_name_min_len)
+{
+	struct bt_scan_short_name thingy = {.name = "Thingy", .min_len = 6};
+	struct bt_scan_short_name thingy52 = {.name = "Thingy52", .min_len = 3};
+	struct ad_builder ad = {0};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_SHORT_NAME, &thingy));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_SHORT_NAME, &thingy52));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_SHORT_NAME_FILTER, false));
+
+	/* Only the second filter accepts a shortened name of this length. */
+	ad_name_add(&ad, BT_DATA_NAME_SHORTENED, "Thi");
+	zassert_true(report_matches(&ad));
+	zassert_true(last_match.short_name.match);
+	zassert_equal(strcmp(last_match.short_name.name, "Thingy52"), 0);
+	zassert_equal(last_match.short_name.len, 3);
+
+	/* Both filters accept it, the first one is reported. */
+	ad.len = 0;
+	ad_name_add(&ad, BT_DATA_NAME_SHORTENED, "Thingy");
+	zassert_true(report_matches(&ad));
+	zassert_equal(strcmp(last_match.short_name.name, "Thingy"), 0);
+
+	/* Too short for both filters. */
+	ad.len = 0;
+	ad_name_add(&ad, BT_DATA_NAME_SHORTENED, "Th");
+	zassert_false(report_matches(&ad));
+
+	/* The complete name is not checked against the short name filters. */
+	ad.len = 0;
+	ad_name_add(&ad, BT_DATA_NAME_COMPLETE, "Thingy");
+	zassert_false(report_matches(&ad));
+
+	zassert_equal(hit_count(BT_SCAN_FILTER_TYPE_SHORT_NAME, 0), 1);
+	zassert_equal(hit_count(BT_SCAN_FILTER_TYPE_SHORT_NAME, 1), 1);
+}
+
+ZTEST(bt_scan_filters, test_name_overlap)
+{
+	struct ad_builder ad = {0};
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Sensor-B"));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Sensor-A1"));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Sensor"));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER, false));
+
+	ad_name_add(&ad, BT_DATA_NAME_COMPLETE, "Sensor-A1");
+	zassert_true(report_matches(&ad));
+	zassert_equal(strcmp(last_match.name.name, "Sensor-A1"), 0);
+
+	/* The name is a prefix of all the filters, the first one added is reported. */
+	ad.len = 0;
+	ad_name_add(&ad, BT_DATA_NAME_COMPLETE, "Sensor");
+	zassert_true(report_matches(&ad));
+	zassert_equal(strcmp(last_match.name.name, "Sensor-B"), 0);
+
+	ad.len = 0;
+	ad_name_add(&ad, BT_DATA_NAME_COMPLETE, "Sensor-C");
+	zassert_false(report_matches(&ad));
+
+	zassert_equal(hit_count(BT_SCAN_FILTER_TYPE_NAME, 0), 1);
+	zassert_equal(hit_count(BT_SCAN_FILTER_TYPE_NAME, 1), 1);
+	zassert_equal(hit_count(BT_SCAN_FILTER_TYPE_NAME, 2), 0);
+}
+
+ZTEST(bt_scan_filters, test_manufacturer_data_overlap)
+{
+	uint8_t model_data[] = {0, 0, 0x01, 0x02};
+	uint8_t company_data[] = {0, 0};
+	struct bt_scan_manufacturer_data model = {.data = model_data,
+						  .data_len = sizeof(model_data)};
+	struct bt_scan_manufacturer_data company = {.data = company_data,
+						    .data_len = sizeof(company_data)};
+	uint8_t data[] = {0, 0, 0x01, 0x02, 0x64};
+	struct ad_builder ad = {0};
+
+	sys_put_le16(COMPANY_ID, model_data);
+	sys_put_le16(COMPANY_ID, company_data);
+	sys_put_le16(COMPANY_ID, data);
+
+	/* The filter of the company is added after the one of the model. */
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA, &model));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA, &company));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_MANUFACTURER_DATA_FILTER, false));
+
+	/* Both filters start the data, the one with the lowest index is reported. */
+	ad_add(&ad, BT_DATA_MANUFACTURER_DATA, data, sizeof(data));
+	zassert_true(report_matches(&ad));
+	zassert_true(last_match.manufacturer_data.match);
+	zassert_equal(last_match.manufacturer_data.len, sizeof(model_data));
+	zassert_mem_equal(last_match.manufacturer_data.data, model_data, sizeof(model_data));
+
+	/* Another model of the company. */
+	data[3] = 0x03;
+	ad.len = 0;
+	ad_add(&ad, BT_DATA_MANUFACTURER_DATA, data, sizeof(data));
+	zassert_true(report_matches(&ad));
+	zassert_equal(last_match.manufacturer_data.len, sizeof(company_data));
+
+	/* Another company. */
+	data[0]++;
+	ad.len = 0;
+	ad_add(&ad, BT_DATA_MANUFACTURER_DATA, data, sizeof(data));
+	zassert_false(report_matches(&ad));
+
+	zassert_equal(hit_count(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA, 0), 1);
+	zassert_equal(hit_count(BT_SCAN_FILTER_TYPE_MANUFACTURER_DATA, 1), 1);
+}
+
+ZTEST(bt_scan_filters, test_uuid_16_in_128)
+{
+	struct bt_uuid_16 hrs = BT_UUID_INIT_16(BT_UUID_HRS_VAL);
+	struct bt_uuid_128 hrs_128 = BT_UUID_INIT_128(
+		BT_UUID_128_ENCODE(BT_UUID_HRS_VAL, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB));
+	struct bt_uuid_128 bas_128 = BT_UUID_INIT_128(
+		BT_UUID_128_ENCODE(BT_UUID_BAS_VAL, 0x0000, 0x1000, 0x8000, 0x00805F9B34FB));
+	uint8_t bas[sizeof(uint16_t)];
+	struct ad_builder ad = {0};
+
+	/* A 16-bit filter matches the 128-bit form of the UUID. */
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &hrs));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_UUID_FILTER, false));
+
+	ad_add(&ad, BT_DATA_UUID128_ALL, hrs_128.val, sizeof(hrs_128.val));
+	zassert_true(report_matches(&ad));
+	zassert_true(last_match.uuid.match);
+	zassert_equal(last_match.uuid.count, 1);
+	zassert_equal(bt_uuid_cmp(last_match.uuid.uuid[0], &hrs.uuid), 0);
+
+	/* The 128-bit form of a filter is a duplicate. */
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &hrs_128));
+	zassert_equal(hit_count(BT_SCAN_FILTER_TYPE_UUID, 0), 1);
+	zassert_equal(bt_scan_filter_hit_count_get(BT_SCAN_FILTER_TYPE_UUID, 1, &(uint32_t){0}),
+		      -EINVAL);
+
+	/* A 128-bit filter matches the 16-bit form of the UUID. */
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &bas_128));
+
+	sys_put_le16(BT_UUID_BAS_VAL, bas);
+	ad.len = 0;
+	ad_add(&ad, BT_DATA_UUID16_ALL, bas, sizeof(bas));
+	zassert_true(report_matches(&ad));
+	zassert_equal(bt_uuid_cmp(last_match.uuid.uuid[0], &bas_128.uuid), 0);
+
+	/* The 128-bit UUID with another base does not match. */
+	hrs_128.val[0] ^= 0x01;
+	ad.len = 0;
+	ad_add(&ad, BT_DATA_UUID128_ALL, hrs_128.val, sizeof(hrs_128.val));
+	zassert_false(report_matches(&ad));
+}
+
+ZTEST(bt_scan_filters, test_all_mode)
+{
+	struct bt_uuid_16 hrs = BT_UUID_INIT_16(BT_UUID_HRS_VAL);
+	struct bt_uuid_16 bas = BT_UUID_INIT_16(BT_UUID_BAS_VAL);
+	uint8_t uuids[2 * sizeof(uint16_t)];
+	struct ad_builder ad = {0};
+
+	sys_put_le16(BT_UUID_HRS_VAL, &uuids[0]);
+	sys_put_le16(BT_UUID_BAS_VAL, &uuids[2]);
+
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Sensor"));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &hrs));
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_UUID, &bas));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER | BT_SCAN_UUID_FILTER, true));
+
+	/* A match of one filter type is not enough. */
+	ad_name_add(&ad, BT_DATA_NAME_COMPLETE, "Sensor");
+	zassert_false(report_matches(&ad));
+
+	/* All the UUID filters must match. */
+	ad_add(&ad, BT_DATA_UUID16_ALL, uuids, sizeof(uint16_t));
+	zassert_false(report_matches(&ad));
+
+	ad.len = 0;
+	ad_name_add(&ad, BT_DATA_NAME_COMPLETE, "Sensor");
+	ad_add(&ad, BT_DATA_UUID16_ALL, uuids, sizeof(uuids));
+	zassert_true(report_matches(&ad));
+	zassert_true(last_match.name.match);
+	zassert_true(last_match.uuid.match);
+	zassert_equal(last_match.uuid.count, 2);
+	zassert_equal(bt_uuid_cmp(last_match.uuid.uuid[0], &hrs.uuid), 0);
+	zassert_equal(bt_uuid_cmp(last_match.uuid.uuid[1], &bas.uuid), 0);
+
+	/* In the normal mode, one filter match is enough. */
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER | BT_SCAN_UUID_FILTER, false));
+
+	ad.len = 0;
+	ad_add(&ad, BT_DATA_UUID16_SOME, &uuids[2], sizeof(uint16_t));
+	zassert_true(report_matches(&ad));
+	zassert_false(last_match.name.match);
+	zassert_equal(bt_uuid_cmp(last_match.uuid.uuid[0], &bas.uuid), 0);
+}
+
+static void *filters_setup(void)
+{
+	scan_test_init();
+
+	return NULL;
+}
+
+static void filters_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	bt_scan_filter_remove_all();
+	bt_scan_filter_disable();
+	match_cnt = 0;
+	no_match_cnt = 0;
+}
+
+ZTEST_SUITE(bt_scan_filters, NULL, filters_setup, filters_before, NULL, NULL);
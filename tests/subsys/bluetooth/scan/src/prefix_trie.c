@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <string.h>
+#include <zephyr/ztest.h>
+
+#include "scan_prefix_trie.h"
+
+#define KEY_CNT 6
+
+struct test_key {
+	const char *data;
+	uint8_t min_len;
+};
+
+static struct test_key keys[KEY_CNT];
+
+static const uint8_t *test_key_get(uint16_t key_idx, uint8_t *len)
+{
+	*len = strlen(keys[key_idx].data);
+
+	return (const uint8_t *)keys[key_idx].data;
+}
+
+static bool test_key_accept(uint16_t key_idx, uint8_t len)
+{
+	return len >= keys[key_idx].min_len;
+}
+
+SCAN_PREFIX_TRIE_DEFINE(test_trie, KEY_CNT, test_key_get);
+
+/* Store the keys and insert them into the trie in the given order. */
+static void keys_insert(const struct test_key *new_keys, const uint16_t *order, size_t cnt)
+{
+	for (size_t i = 0; i < cnt; i++) {
+		keys[order[i]] = new_keys[order[i]];
+		zassert_ok(scan_prefix_trie_insert(&test_trie, order[i]), "Key %u not inserted",
+			   order[i]);
+	}
+
+	zassert_true(test_trie.node_cnt <= SCAN_PREFIX_TRIE_NODE_CNT(cnt), "%u nodes for %zu keys",
+		     test_trie.node_cnt, cnt);
+}
+
+static int prefix_find(const char *data)
+{
+	return scan_prefix_trie_prefix_find(&test_trie, (const uint8_t *)data, strlen(data));
+}
+
+static int extension_find(const char *data, scan_prefix_trie_key_accept_t accept)
+{
+	return scan_prefix_trie_extension_find(&test_trie, (const uint8_t *)data, strlen(data),
+					       accept);
+}
+
+ZTEST(bt_scan_prefix_trie, test_edge_split)
+{
+	static const struct test_key names[] = {
+		{"Sensor-A1"}, {"Sensor-B"}, {"Sensor"}, {"Sen"}, {"Beacon"},
+	};
+	/* Each key after the first splits an edge made by an earlier one. */
+	static const uint16_t order[] = {0, 1, 2, 3, 4};
+
+	keys_insert(names, order, ARRAY_SIZE(order));
+
+	zassert_equal(extension_find("Sensor-A1", NULL), 0);
+	zassert_equal(extension_find("Sensor-B", NULL), 1);
+	zassert_equal(extension_find("Sensor-", NULL), 0);
+	zassert_equal(extension_find("Sens", NULL), 0);
+	zassert_equal(extension_find("S", NULL), 0);
+	zassert_equal(extension_find("Beac", NULL), 4);
+	zassert_equal(extension_find("Sensor-C", NULL), -ENOENT);
+	zassert_equal(extension_find("Sensor-A12", NULL), -ENOENT);
+	zassert_equal(extension_find("Sx", NULL), -ENOENT);
+
+	zassert_equal(prefix_find("Sensor-A1 kitchen"), 0);
+	zassert_equal(prefix_find("Sensor-B"), 1);
+	zassert_equal(prefix_find("Sensor-C"), 2);
+	zassert_equal(prefix_find("Sense"), 3);
+	zassert_equal(prefix_find("Se"), -ENOENT);
+
+	/* An identical key is found at the end of the split edges. */
+	keys[5] = names[2];
+	zassert_equal(scan_prefix_trie_insert(&test_trie, 5), -EALREADY);
+	keys[5] = names[3];
+	zassert_equal(scan_prefix_trie_insert(&test_trie, 5), -EALREADY);
+}
+
+ZTEST(bt_scan_prefix_trie, test_edge_split_lowest_index)
+{
+	static const struct test_key names[] = {
+		{"abcz"}, {"ab"}, {"abxy"}, {"b"}, {"abcd"},
+	};
+	/* The keys are inserted in the reverse order of their indexes, so the lowest index of a
+	 * subtree changes as edges are split.
+	 */
+	static const uint16_t order[] = {4, 3, 2, 1, 0};
+
+	keys_insert(names, order, ARRAY_SIZE(order));
+
+	zassert_equal(extension_find("abcd", NULL), 4);
+	zassert_equal(extension_find("abc", NULL), 0);
+	zassert_equal(extension_find("abx", NULL), 2);
+	zassert_equal(extension_find("ab", NULL), 0);
+	zassert_equal(extension_find("a", NULL), 0);
+	zassert_equal(extension_find("", NULL), 0);
+
+	zassert_equal(prefix_find("abczz"), 0);
+	zassert_equal(prefix_find("abcd"), 1);
+	zassert_equal(prefix_find("abxyz"), 1);
+}
+
+ZTEST(bt_scan_prefix_trie, test_accept_min_len)
+{
+	static const struct test_key names[] = {
+		{"Thingy", 6}, {"Thingy52", 3}, {"Thin", 2}, {"Thingy91", 4},
+	};
+	static const uint16_t order[] = {0, 1, 2, 3};
+
+	keys_insert(names, order, ARRAY_SIZE(order));
+
+	/* The shortened name must be as long as the minimum length of the key. */
+	zassert_equal(extension_find("Th", test_key_accept), 2);
+	zassert_equal(extension_find("Thi", test_key_accept), 1);
+	zassert_equal(extension_find("Thing", test_key_accept), 1);
+	zassert_equal(extension_find("Thingy", test_key_accept), 0);
+	zassert_equal(extension_find("Thingy9", test_key_accept), 3);
+	zassert_equal(extension_find("Thingy5", test_key_accept), 1);
+	zassert_equal(extension_find("T", test_key_accept), -ENOENT);
+	zassert_equal(extension_find("Thingy6", test_key_accept), -ENOENT);
+
+	/* Without the check, the lowest index is found whatever the length. */
+	zassert_equal(extension_find("T", NULL), 0);
+	zassert_equal(extension_find("Thi", NULL), 0);
+}
+
+ZTEST(bt_scan_prefix_trie, test_manufacturer_data_overlap)
+{
+	/* Company identifier 0x0059 followed by model numbers. */
+	static const struct test_key data[] = {
+		{"\x59\x01\x02\x03"}, {"\x59\x01"}, {"\x59\x01\x02"}, {"\x59\x02"},
+	};
+	static const uint16_t order[] = {2, 1, 3, 0};
+
+	keys_insert(data, order, ARRAY_SIZE(order));
+
+	/* All the keys that start the data are found, the lowest index is returned. */
+	zassert_equal(prefix_find("\x59\x01\x02\x03\x04"), 0);
+	zassert_equal(prefix_find("\x59\x01\x02\x04"), 1);
+	zassert_equal(prefix_find("\x59\x01\x03"), 1);
+	zassert_equal(prefix_find("\x59\x02\x01"), 3);
+	zassert_equal(prefix_find("\x59\x03"), -ENOENT);
+	zassert_equal(prefix_find("\x59"), -ENOENT);
+}
+
+ZTEST(bt_scan_prefix_trie, test_clear)
+{
+	static const struct test_key names[] = {{"Sensor"}};
+	static const uint16_t order[] = {0};
+
+	zassert_equal(extension_find("", NULL), -ENOENT);
+	zassert_equal(prefix_find("Sensor"), -ENOENT);
+
+	keys_insert(names, order, ARRAY_SIZE(order));
+	zassert_equal(prefix_find("Sensor"), 0);
+
+	scan_prefix_trie_clear(&test_trie);
+
+	zassert_equal(test_trie.node_cnt, 1);
+	zassert_equal(extension_find("Sen", NULL), -ENOENT);
+	zassert_equal(prefix_find("Sensor"), -ENOENT);
+}
+
+static void prefix_trie_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	scan_prefix_trie_clear(&test_trie);
+	memset(keys, 0, sizeof(keys));
+}
+
+ZTEST_SUITE(bt_scan_prefix_trie, NULL, NULL, prefix_trie_before, NULL, NULL);
@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+
+#include "common.h"
+
+#define CACHE_SIZE    CONFIG_BT_SCAN_REPORT_CACHE_SIZE
+#define RATE_LIMIT_MS CONFIG_BT_SCAN_REPORT_RATE_LIMIT_MS
+
+BUILD_ASSERT(CACHE_SIZE >= 3, "The eviction test needs at least 3 devices in the cache");
+BUILD_ASSERT(RATE_LIMIT_MS > 0, "The rate limit test needs a rate limit");
+
+static void device_report_feed(uint16_t idx, const char *name)
+{
+	struct ad_builder ad = {0};
+	bt_addr_le_t addr;
+
+	ad_name_add(&ad, BT_DATA_NAME_COMPLETE, name);
+	device_addr_get(idx, &addr);
+	report_feed(&addr, &ad);
+}
+
+static void stats_check(uint32_t hits, uint32_t misses, uint32_t evictions,
+			uint32_t rate_limited)
+{
+	struct bt_scan_report_cache_stats stats;
+
+	zassert_ok(bt_scan_report_cache_stats_get(&stats));
+	zassert_equal(stats.hits, hits, "%u hits, not %u", stats.hits, hits);
+	zassert_equal(stats.misses, misses, "%u misses, not %u", stats.misses, misses);
+	zassert_equal(stats.evictions, evictions, "%u evictions, not %u", stats.evictions,
+		      evictions);
+	zassert_equal(stats.rate_limited, rate_limited, "%u rate limited, not %u",
+		      stats.rate_limited, rate_limited);
+}
+
+ZTEST(bt_scan_report_cache, test_eviction)
+{
+	/* Fill the cache with devices matching none of the filters. */
+	for (uint16_t i = 0; i < CACHE_SIZE; i++) {
+		device_report_feed(i, "Beacon");
+	}
+
+	stats_check(0, CACHE_SIZE, 0, 0);
+	zassert_equal(no_match_cnt, CACHE_SIZE);
+
+	/* Device 1 becomes the device seen least recently. */
+	device_report_feed(0, "Beacon");
+	stats_check(1, CACHE_SIZE, 0, 1);
+
+	/* A new device replaces device 1, and device 1 then replaces device 2. */
+	device_report_feed(CACHE_SIZE, "Beacon");
+	stats_check(1, CACHE_SIZE + 1, 1, 1);
+
+	device_report_feed(1, "Beacon");
+	stats_check(1, CACHE_SIZE + 2, 2, 1);
+
+	/* The replaced devices lost their rate limit state. */
+	zassert_equal(no_match_cnt, CACHE_SIZE + 2);
+
+	/* The devices that were not replaced are still served from the cache. */
+	device_report_feed(0, "Beacon");
+	device_report_feed(CACHE_SIZE - 1, "Beacon");
+	stats_check(3, CACHE_SIZE + 2, 2, 3);
+
+	device_report_feed(2, "Beacon");
+	stats_check(3, CACHE_SIZE + 3, 3, 3);
+	zassert_equal(no_match_cnt, CACHE_SIZE + 3);
+	zassert_equal(match_cnt, 0);
+}
+
+ZTEST(bt_scan_report_cache, test_rate_limit)
+{
+	device_report_feed(0, "Sensor");
+	zassert_equal(match_cnt, 1);
+
+	/* A repeated report within the rate limit interval is suppressed. */
+	device_report_feed(0, "Sensor");
+	zassert_equal(match_cnt, 1);
+	stats_check(0, 2, 0, 1);
+
+	/* Whatever the filter callback it would get. */
+	device_report_feed(0, "Beacon");
+	zassert_equal(no_match_cnt, 0);
+	stats_check(0, 3, 0, 2);
+
+	/* Other devices are not limited. */
+	device_report_feed(1, "Sensor");
+	device_report_feed(2, "Beacon");
+	zassert_equal(match_cnt, 2);
+	zassert_equal(no_match_cnt, 1);
+
+	/* A report served from the cache is suppressed too. */
+	device_report_feed(2, "Beacon");
+	zassert_equal(no_match_cnt, 1);
+	stats_check(1, 5, 0, 3);
+
+	k_sleep(K_MSEC(RATE_LIMIT_MS));
+
+	device_report_feed(0, "Sensor");
+	device_report_feed(2, "Beacon");
+	zassert_equal(match_cnt, 3);
+	zassert_equal(no_match_cnt, 2);
+	stats_check(2, 6, 0, 3);
+
+	/* The interval starts again with the last callback. */
+	device_report_feed(0, "Sensor");
+	zassert_equal(match_cnt, 3);
+	stats_check(2, 7, 0, 4);
+}
+
+static void *report_cache_setup(void)
+{
+	scan_test_init();
+
+	return NULL;
+}
+
+static void report_cache_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	bt_scan_filter_remove_all();
+	zassert_ok(bt_scan_filter_add(BT_SCAN_FILTER_TYPE_NAME, "Sensor"));
+	zassert_ok(bt_scan_filter_enable(BT_SCAN_NAME_FILTER, false));
+	bt_scan_report_cache_clear();
+	match_cnt = 0;
+	no_match_cnt = 0;
+}
+
+ZTEST_SUITE(bt_scan_report_cache, NULL, report_cache_setup, report_cache_before, NULL, NULL);
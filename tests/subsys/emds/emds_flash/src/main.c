@@ -252,6 +252,82 @@ static void device_reset(void)
 	ctx.flash_dev = m_fa->fa_dev;
 }
 
+static const char batch_data[3][8] = {"Deadbee", "Beafded", "Faceoff"};
+
+/* Entries written one by one before a batch, enough to fill the index */
+#define SINGLE_ID_START 100
+#define SINGLE_CNT_MAX	(CONFIG_EMDS_FLASH_INDEX_SIZE + 1)
+
+/* Initialize the file system, write single entries and fill a batch of entries, ready to be
+ * written.
+ */
+static void batch_prepare(struct emds_flash_batch *batch, uint8_t *buf, size_t size,
+			  size_t single_cnt)
+{
+	zassert_false(emds_flash_init(&ctx), "Error when initializing");
+	zassert_false(emds_flash_prepare(&ctx, (3 + single_cnt) *
+					 (sizeof(batch_data[0]) + ctx.ate_size)),
+		      "Prepare failed");
+
+	for (uint16_t i = 0; i < single_cnt; i++) {
+		zassert_equal(emds_flash_write(&ctx, SINGLE_ID_START + i, batch_data[0],
+					       sizeof(batch_data[0])),
+			      sizeof(batch_data[0]), "Error when writing");
+	}
+
+	emds_flash_batch_init(&ctx, batch, buf, size);
+	for (uint16_t i = 0; i < ARRAY_SIZE(batch_data); i++) {
+		zassert_false(emds_flash_batch_add(&ctx, batch, i + 1, batch_data[i],
+						   sizeof(batch_data[i])),
+			      "Error when adding to batch");
+	}
+}
+
+/* Write the first write blocks of the data and allocation table entry bursts of a batch, the
+ * way a power loss during emds_flash_batch_write leaves them.
+ */
+static void batch_write_cut(const struct emds_flash_batch *batch, size_t block_cnt)
+{
+	size_t cut_len = block_cnt * ctx.flash_params->write_block_size;
+	size_t ate_len = batch->cnt * ctx.ate_size;
+	size_t data_len = MIN(batch->data_len, cut_len);
+
+	if (data_len) {
+		zassert_false(flash_write(m_test_fd.fd, ctx.offset + ctx.data_wra_offset,
+					  batch->buf, data_len), "Error when writing data");
+	}
+
+	cut_len -= data_len;
+	if (cut_len) {
+		zassert_false(flash_write(m_test_fd.fd, ctx.ate_wra - ate_len + ctx.ate_size,
+					  &batch->buf[batch->size - ate_len],
+					  MIN(ate_len, cut_len)),
+			      "Error when writing allocation table entries");
+	}
+}
+
+/* Read the entries of the batch, and return how many are found with the right data. */
+static size_t batch_found_cnt(void)
+{
+	char data_out[8] = {0};
+	size_t found = 0;
+	int rc;
+
+	for (uint16_t i = 0; i < ARRAY_SIZE(batch_data); i++) {
+		rc = emds_flash_read(&ctx, i + 1, data_out, sizeof(data_out));
+		if (rc < 0) {
+			continue;
+		}
+
+		zassert_equal(rc, sizeof(batch_data[i]), "Error when read");
+		zassert_false(memcmp(data_out, batch_data[i], sizeof(data_out)),
+			      "Retrived wrong value");
+		found++;
+	}
+
+	return found;
+}
+
 /** End Local functions *******************************************************/
 
 ZTEST(emds_flash_tests, test_initialize)
@@ -629,6 +705,119 @@ ZTEST(emds_flash_tests, test_corrupted_data)
 				     "Should not be able to read");
 }
 
+ZTEST(emds_flash_tests, test_batch_rd_wr)
+{
+	static uint8_t batch_buf[256] __aligned(4);
+	char data_in1[9] = "Deadbeef";
+	char data_in2[13] = "Deadbeefface";
+	char data_out[16] = {0};
+	struct emds_flash_batch batch;
+
+	flash_clear();
+	device_reset();
+
+	zassert_false(emds_flash_init(&ctx), "Error when initializing");
+	zassert_false(emds_flash_prepare(&ctx, sizeof(data_in1) + sizeof(data_in2) +
+					 2 * ctx.ate_size), "Prepare failed");
+
+	emds_flash_batch_init(&ctx, &batch, batch_buf, sizeof(batch_buf));
+	zassert_false(emds_flash_batch_add(&ctx, &batch, 1, data_in1, sizeof(data_in1)),
+		      "Error when adding to batch");
+	zassert_false(emds_flash_batch_add(&ctx, &batch, 2, data_in2, sizeof(data_in2)),
+		      "Error when adding to batch");
+
+	/* The data is copied, so the entries can change before the batch is written */
+	memset(data_in1, 0, sizeof(data_in1));
+	zassert_false(emds_flash_batch_write(&ctx, &batch), "Error when writing batch");
+
+	zassert_equal(emds_flash_read(&ctx, 1, data_out, sizeof(data_out)), 9, "Error when read");
+	zassert_false(strcmp(data_out, "Deadbeef"), "Retrived wrong value");
+	zassert_equal(emds_flash_read(&ctx, 2, data_out, sizeof(data_out)), sizeof(data_in2),
+		      "Error when read");
+	zassert_false(strcmp(data_out, data_in2), "Retrived wrong value");
+
+	/* Reset and check that the entries are found by the recovery */
+	device_reset();
+	zassert_false(emds_flash_init(&ctx), "Error when initializing");
+	zassert_equal(emds_flash_read(&ctx, 1, data_out, sizeof(data_out)), 9, "Error when read");
+	zassert_false(strcmp(data_out, "Deadbeef"), "Retrived wrong value");
+	zassert_equal(emds_flash_read(&ctx, 2, data_out, sizeof(data_out)), sizeof(data_in2),
+		      "Error when read");
+	zassert_false(strcmp(data_out, data_in2), "Retrived wrong value");
+
+	/* A batch that does not fit in its buffer is rejected */
+	emds_flash_batch_init(&ctx, &batch, batch_buf, 32);
+	zassert_equal(emds_flash_batch_add(&ctx, &batch, 1, batch_buf, 32), -ENOMEM,
+		      "Batch should be full");
+}
+
+/* Emulate a power loss after each write block of a batch written after single entries. The
+ * entries of the batch are found all together, and only once the last block is written. The
+ * single entries are always found.
+ */
+static void batch_cut_check(uint8_t *batch_buf, size_t size, size_t single_cnt)
+{
+	struct emds_flash_batch batch;
+	char data_out[8];
+	size_t block_cnt;
+	size_t found;
+
+	flash_clear();
+	device_reset();
+	batch_prepare(&batch, batch_buf, size, single_cnt);
+	block_cnt = (batch.data_len + batch.cnt * ctx.ate_size) /
+		    ctx.flash_params->write_block_size;
+
+	for (size_t cut = 0; cut <= block_cnt; cut++) {
+		flash_clear();
+		device_reset();
+		batch_prepare(&batch, batch_buf, size, single_cnt);
+		batch_write_cut(&batch, cut);
+
+		device_reset();
+		zassert_false(emds_flash_init(&ctx), "Error when initializing");
+
+		found = batch_found_cnt();
+		zassert_equal(found, cut == block_cnt ? ARRAY_SIZE(batch_data) : 0,
+			      "%zu entries found after %zu of %zu write blocks", found, cut,
+			      block_cnt);
+
+		for (uint16_t i = 0; i < single_cnt; i++) {
+			zassert_equal(emds_flash_read(&ctx, SINGLE_ID_START + i, data_out,
+						      sizeof(data_out)),
+				      sizeof(batch_data[0]), "Single entry %u not found", i);
+		}
+	}
+}
+
+ZTEST(emds_flash_tests, test_batch_interrupted)
+{
+	static uint8_t batch_buf[256] __aligned(4);
+	struct emds_flash_batch batch;
+	size_t block_cnt;
+
+	batch_cut_check(batch_buf, sizeof(batch_buf), 0);
+
+	/* The index overflows, so the entries are also looked for in the allocation table */
+	batch_cut_check(batch_buf, sizeof(batch_buf), SINGLE_CNT_MAX);
+
+	/* The storage is usable after an interrupted write */
+	flash_clear();
+	device_reset();
+	batch_prepare(&batch, batch_buf, sizeof(batch_buf), 0);
+	block_cnt = (batch.data_len + batch.cnt * ctx.ate_size) /
+		    ctx.flash_params->write_block_size;
+	batch_write_cut(&batch, block_cnt - 1);
+
+	device_reset();
+	batch_prepare(&batch, batch_buf, sizeof(batch_buf), 0);
+	zassert_false(emds_flash_batch_write(&ctx, &batch), "Error when writing batch");
+
+	device_reset();
+	zassert_false(emds_flash_init(&ctx), "Error when initializing");
+	zassert_equal(batch_found_cnt(), ARRAY_SIZE(batch_data), "Entries not found");
+}
+
 ZTEST(emds_flash_tests, test_write_speed)
 {
 	char data_in[4] = "bee";
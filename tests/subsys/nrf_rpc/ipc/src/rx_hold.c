@@ -0,0 +1,211 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <errno.h>
+#include <zephyr/fff.h>
+#include <zephyr/ztest.h>
+
+#include <nrf_rpc_errno.h>
+#include <nrf_rpc/nrf_rpc_ipc.h>
+
+#define PACKET_SIZE 16
+#define HOLD_MAX    CONFIG_NRF_RPC_IPC_SERVICE_RX_HOLD_MAX
+
+DEFINE_FFF_GLOBALS;
+
+FAKE_VALUE_FUNC(int, ipc_service_open_instance, const struct device *);
+FAKE_VALUE_FUNC(int, ipc_service_register_endpoint, const struct device *, struct ipc_ept *,
+		const struct ipc_ept_cfg *);
+FAKE_VALUE_FUNC(int, ipc_service_send, struct ipc_ept *, const void *, size_t);
+FAKE_VALUE_FUNC(int, ipc_service_hold_rx_buffer, struct ipc_ept *, void *);
+FAKE_VALUE_FUNC(int, ipc_service_release_rx_buffer, struct ipc_ept *, void *);
+
+NRF_RPC_IPC_TRANSPORT(test_tr, NULL, "test_ept");
+
+static uint8_t packets[HOLD_MAX + 1][PACKET_SIZE];
+
+/* Action of the nRF RPC receive handler, called before the decoding of the packet is done. */
+typedef void (*rx_action_t)(const uint8_t *packet);
+
+static rx_action_t rx_action;
+
+static void receive_handler(const struct nrf_rpc_tr *transport, const uint8_t *packet, size_t len,
+			    void *context)
+{
+	ARG_UNUSED(transport);
+	ARG_UNUSED(context);
+
+	zassert_equal(len, PACKET_SIZE);
+
+	if (rx_action) {
+		rx_action(packet);
+	}
+}
+
+/* Deliver a packet the way the IPC Service backend does. */
+static void packet_receive(const uint8_t *packet, rx_action_t action)
+{
+	const struct ipc_ept_cfg *cfg = &test_tr_instance.endpoint.ept_cfg;
+
+	rx_action = action;
+	cfg->cb.received(packet, PACKET_SIZE, cfg->priv);
+	rx_action = NULL;
+}
+
+static void hold_expect_ok(const uint8_t *packet)
+{
+	zassert_ok(nrf_rpc_ipc_rx_hold(&packet[PACKET_SIZE / 2]));
+}
+
+static void hold_expect_einval(const uint8_t *packet)
+{
+	zassert_equal(nrf_rpc_ipc_rx_hold(packet), -NRF_EINVAL);
+}
+
+static void hold_expect_eio(const uint8_t *packet)
+{
+	zassert_equal(nrf_rpc_ipc_rx_hold(packet), -NRF_EIO);
+}
+
+static void hold_outside_packet(const uint8_t *packet)
+{
+	zassert_equal(nrf_rpc_ipc_rx_hold(packet + PACKET_SIZE), -NRF_EINVAL);
+}
+
+/* A handler that fails to decode the packet releases the buffer before the decoding is done. */
+static void hold_and_release(const uint8_t *packet)
+{
+	zassert_ok(nrf_rpc_ipc_rx_hold(packet));
+	zassert_ok(nrf_rpc_ipc_rx_release(packet));
+}
+
+ZTEST(nrf_rpc_ipc_rx_hold, test_hold_release)
+{
+	packet_receive(packets[0], hold_expect_ok);
+
+	zassert_equal(ipc_service_hold_rx_buffer_fake.call_count, 1);
+	zassert_equal(ipc_service_hold_rx_buffer_fake.arg0_val, &test_tr_instance.endpoint.ept);
+	zassert_equal(ipc_service_hold_rx_buffer_fake.arg1_val, packets[0]);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, 0);
+
+	/* The data is still valid, so the buffer is released only when asked for. */
+	zassert_ok(nrf_rpc_ipc_rx_release(&packets[0][PACKET_SIZE - 1]));
+
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, 1);
+	zassert_equal(ipc_service_release_rx_buffer_fake.arg0_val, &test_tr_instance.endpoint.ept);
+	zassert_equal(ipc_service_release_rx_buffer_fake.arg1_val, packets[0]);
+
+	zassert_equal(nrf_rpc_ipc_rx_release(packets[0]), -NRF_EINVAL);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, 1);
+}
+
+ZTEST(nrf_rpc_ipc_rx_hold, test_hold_not_received)
+{
+	/* Holding is possible only while the packet is being received. */
+	hold_expect_einval(packets[0]);
+	packet_receive(packets[0], hold_outside_packet);
+	hold_expect_einval(packets[0]);
+
+	zassert_equal(nrf_rpc_ipc_rx_release(packets[0]), -NRF_EINVAL);
+
+	zassert_equal(ipc_service_hold_rx_buffer_fake.call_count, 0);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, 0);
+}
+
+ZTEST(nrf_rpc_ipc_rx_hold, test_hold_error)
+{
+	ipc_service_hold_rx_buffer_fake.return_val = -ENOTSUP;
+
+	packet_receive(packets[0], hold_expect_eio);
+
+	zassert_equal(ipc_service_hold_rx_buffer_fake.call_count, 1);
+
+	/* A buffer that failed to be held must not be released. */
+	zassert_equal(nrf_rpc_ipc_rx_release(packets[0]), -NRF_EINVAL);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, 0);
+
+	/* The tracking entry is free again. */
+	ipc_service_hold_rx_buffer_fake.return_val = 0;
+
+	for (size_t i = 0; i < HOLD_MAX; i++) {
+		packet_receive(packets[i], hold_expect_ok);
+	}
+
+	for (size_t i = 0; i < HOLD_MAX; i++) {
+		zassert_ok(nrf_rpc_ipc_rx_release(packets[i]));
+	}
+
+	zassert_equal(ipc_service_hold_rx_buffer_fake.call_count, 1 + HOLD_MAX);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, HOLD_MAX);
+}
+
+ZTEST(nrf_rpc_ipc_rx_hold, test_release_on_decoding_error)
+{
+	packet_receive(packets[0], hold_and_release);
+
+	zassert_equal(ipc_service_hold_rx_buffer_fake.call_count, 1);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, 1);
+	zassert_equal(ipc_service_release_rx_buffer_fake.arg1_val, packets[0]);
+
+	/* The buffer is not held anymore once the receive callback returns. */
+	zassert_equal(nrf_rpc_ipc_rx_release(packets[0]), -NRF_EINVAL);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, 1);
+}
+
+ZTEST(nrf_rpc_ipc_rx_hold, test_hold_limit)
+{
+	for (size_t i = 0; i < HOLD_MAX; i++) {
+		packet_receive(packets[i], hold_expect_ok);
+	}
+
+	/* All the tracking entries are held, the packet must be copied. */
+	packet_receive(packets[HOLD_MAX], hold_expect_einval);
+
+	zassert_equal(ipc_service_hold_rx_buffer_fake.call_count, HOLD_MAX);
+
+	for (size_t i = 0; i < HOLD_MAX; i++) {
+		zassert_ok(nrf_rpc_ipc_rx_release(packets[i]));
+	}
+
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, HOLD_MAX);
+
+	packet_receive(packets[HOLD_MAX], hold_expect_ok);
+	zassert_ok(nrf_rpc_ipc_rx_release(packets[HOLD_MAX]));
+
+	zassert_equal(ipc_service_hold_rx_buffer_fake.call_count, HOLD_MAX + 1);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, HOLD_MAX + 1);
+}
+
+ZTEST(nrf_rpc_ipc_rx_hold, test_release_error)
+{
+	ipc_service_release_rx_buffer_fake.return_val = -EIO;
+
+	packet_receive(packets[0], hold_expect_ok);
+	zassert_equal(nrf_rpc_ipc_rx_release(packets[0]), -NRF_EIO);
+
+	/* The buffer is not tracked anymore, even though the backend failed to release it. */
+	zassert_equal(nrf_rpc_ipc_rx_release(packets[0]), -NRF_EINVAL);
+	zassert_equal(ipc_service_release_rx_buffer_fake.call_count, 1);
+}
+
+static void *rx_hold_setup(void)
+{
+	zassert_ok(test_tr.api->init(&test_tr, receive_handler, NULL));
+	zassert_equal(ipc_service_register_endpoint_fake.call_count, 1);
+
+	return NULL;
+}
+
+static void rx_hold_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	RESET_FAKE(ipc_service_hold_rx_buffer);
+	RESET_FAKE(ipc_service_release_rx_buffer);
+	FFF_RESET_HISTORY();
+}
+
+ZTEST_SUITE(nrf_rpc_ipc_rx_hold, NULL, rx_hold_setup, rx_hold_before, NULL, NULL);
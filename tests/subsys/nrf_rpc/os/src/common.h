@@ -0,0 +1,13 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#ifndef NRF_RPC_OS_TEST_COMMON_H_
+#define NRF_RPC_OS_TEST_COMMON_H_
+
+/* Initializes the nRF RPC OS layer once for all the test suites. */
+void nrf_rpc_os_test_init(void);
+
+#endif /* NRF_RPC_OS_TEST_COMMON_H_ */
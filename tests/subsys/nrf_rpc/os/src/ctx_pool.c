@@ -0,0 +1,151 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <nrf_rpc_os.h>
+
+#include "common.h"
+
+#define POOL_SIZE CONFIG_NRF_RPC_CMD_CTX_POOL_SIZE
+#define WAIT_MS	  20
+
+#define WAITER_STACK_SIZE 1024
+#define WAITER_PRIORITY	  K_PRIO_PREEMPT(0)
+
+static K_THREAD_STACK_DEFINE(waiter_stack, WAITER_STACK_SIZE);
+static struct k_thread waiter_thread;
+static K_SEM_DEFINE(waiter_done_sem, 0, 1);
+static uint32_t waiter_number;
+
+static void waiter_fn(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	waiter_number = nrf_rpc_os_ctx_pool_reserve();
+	k_sem_give(&waiter_done_sem);
+}
+
+static void reserve_all(uint32_t numbers[POOL_SIZE])
+{
+	uint32_t reserved = 0;
+
+	for (size_t i = 0; i < POOL_SIZE; i++) {
+		numbers[i] = nrf_rpc_os_ctx_pool_reserve();
+		zassert_true(numbers[i] < POOL_SIZE, "Invalid context %u", numbers[i]);
+		zassert_false(reserved & BIT(numbers[i]), "Context %u reserved twice",
+			      numbers[i]);
+		reserved |= BIT(numbers[i]);
+	}
+}
+
+static void release_all(const uint32_t numbers[POOL_SIZE])
+{
+	for (size_t i = 0; i < POOL_SIZE; i++) {
+		nrf_rpc_os_ctx_pool_release(numbers[i]);
+	}
+}
+
+/* Starts a thread that waits for a context, while all the contexts are reserved. */
+static void waiter_start(void)
+{
+	k_thread_create(&waiter_thread, waiter_stack, K_THREAD_STACK_SIZEOF(waiter_stack),
+			waiter_fn, NULL, NULL, NULL, WAITER_PRIORITY, 0, K_NO_WAIT);
+
+	k_sleep(K_MSEC(WAIT_MS));
+	zassert_not_ok(k_sem_take(&waiter_done_sem, K_NO_WAIT), "Reserved from an empty pool");
+}
+
+ZTEST(nrf_rpc_ctx_pool, test_exhaustion)
+{
+	uint32_t numbers[POOL_SIZE];
+
+	reserve_all(numbers);
+	waiter_start();
+
+	/* The released context is handed to the waiting thread. */
+	nrf_rpc_os_ctx_pool_release(numbers[0]);
+
+	zassert_ok(k_sem_take(&waiter_done_sem, K_SECONDS(1)), "Waiter not woken up");
+	zassert_equal(waiter_number, numbers[0]);
+	zassert_ok(k_thread_join(&waiter_thread, K_SECONDS(1)));
+
+	numbers[0] = waiter_number;
+	release_all(numbers);
+}
+
+ZTEST(nrf_rpc_ctx_pool, test_reuse)
+{
+	uint32_t numbers[POOL_SIZE];
+	uint32_t number;
+
+	reserve_all(numbers);
+	release_all(numbers);
+
+	/* All the contexts are free again and the last released one is reused first. */
+	reserve_all(numbers);
+
+	nrf_rpc_os_ctx_pool_release(numbers[POOL_SIZE - 1]);
+	number = nrf_rpc_os_ctx_pool_reserve();
+	zassert_equal(number, numbers[POOL_SIZE - 1]);
+
+	release_all(numbers);
+}
+
+#if defined(CONFIG_NRF_RPC_CMD_CTX_POOL_STATS)
+ZTEST(nrf_rpc_ctx_pool, test_stats)
+{
+	struct nrf_rpc_os_ctx_pool_stats before;
+	struct nrf_rpc_os_ctx_pool_stats stats;
+	uint32_t numbers[POOL_SIZE];
+
+	nrf_rpc_os_ctx_pool_stats_get(&before);
+	zassert_equal(before.in_flight, 0);
+
+	reserve_all(numbers);
+
+	nrf_rpc_os_ctx_pool_stats_get(&stats);
+	zassert_equal(stats.in_flight, POOL_SIZE);
+	zassert_equal(stats.peak_in_flight, POOL_SIZE);
+	zassert_equal(stats.reserve_cnt, before.reserve_cnt + POOL_SIZE);
+	zassert_equal(stats.wait_cnt, before.wait_cnt);
+
+	waiter_start();
+	nrf_rpc_os_ctx_pool_release(numbers[0]);
+	zassert_ok(k_sem_take(&waiter_done_sem, K_SECONDS(1)), "Waiter not woken up");
+	zassert_ok(k_thread_join(&waiter_thread, K_SECONDS(1)));
+	numbers[0] = waiter_number;
+
+	nrf_rpc_os_ctx_pool_stats_get(&stats);
+	zassert_equal(stats.in_flight, POOL_SIZE);
+	zassert_equal(stats.peak_in_flight, POOL_SIZE);
+	zassert_equal(stats.reserve_cnt, before.reserve_cnt + POOL_SIZE + 1);
+	zassert_equal(stats.wait_cnt, before.wait_cnt + 1);
+
+	/* The waiter may start waiting a tick after the sleep of the test thread started. */
+	zassert_true(stats.max_wait_us >= (WAIT_MS - 1) * USEC_PER_MSEC, "Wait of %u us",
+		     stats.max_wait_us);
+	zassert_true(stats.total_wait_us - before.total_wait_us >= (WAIT_MS - 1) * USEC_PER_MSEC);
+
+	release_all(numbers);
+
+	nrf_rpc_os_ctx_pool_stats_get(&stats);
+	zassert_equal(stats.in_flight, 0);
+	zassert_equal(stats.peak_in_flight, POOL_SIZE);
+}
+#endif /* CONFIG_NRF_RPC_CMD_CTX_POOL_STATS */
+
+static void *ctx_pool_setup(void)
+{
+	BUILD_ASSERT(POOL_SIZE <= 32, "Test supports up to 32 contexts");
+
+	nrf_rpc_os_test_init();
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_rpc_ctx_pool, NULL, ctx_pool_setup, NULL, NULL, NULL);
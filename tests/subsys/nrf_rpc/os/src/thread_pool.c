@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/spinlock.h>
+#include <nrf_rpc_os.h>
+
+#include "common.h"
+
+#define GROUP_ID_OFFSET NRF_RPC_OS_PACKET_GROUP_ID_OFFSET
+#define SEQ_OFFSET	NRF_RPC_OS_PACKET_HEADER_SIZE
+#define PACKET_SIZE	(SEQ_OFFSET + 1)
+
+/* All the threads are busy and all the queues of a group are full. */
+#define PACKET_CNT (CONFIG_NRF_RPC_THREAD_POOL_SIZE + CONFIG_NRF_RPC_THREAD_POOL_QUEUE_SIZE)
+
+static uint8_t packets[PACKET_CNT][PACKET_SIZE];
+static uint8_t start_order[PACKET_CNT];
+static size_t start_cnt;
+static struct k_spinlock start_lock;
+static K_SEM_DEFINE(handler_gate_sem, 0, PACKET_CNT);
+static K_SEM_DEFINE(handler_done_sem, 0, PACKET_CNT);
+
+static void packet_handler(const uint8_t *data, size_t len)
+{
+	k_spinlock_key_t key = k_spin_lock(&start_lock);
+
+	__ASSERT_NO_MSG(len == PACKET_SIZE);
+	start_order[start_cnt++] = data[SEQ_OFFSET];
+
+	k_spin_unlock(&start_lock, key);
+
+	/* Keep the thread busy, so that the other threads steal the next packets. */
+	k_sem_take(&handler_gate_sem, K_FOREVER);
+	k_sem_give(&handler_done_sem);
+}
+
+void nrf_rpc_os_test_init(void)
+{
+	static bool initialized;
+
+	if (!initialized) {
+		zassert_ok(nrf_rpc_os_init(packet_handler), "Error when initializing");
+		initialized = true;
+	}
+}
+
+static void *thread_pool_setup(void)
+{
+	nrf_rpc_os_test_init();
+
+	return NULL;
+}
+
+ZTEST(nrf_rpc_thread_pool, test_group_start_order)
+{
+	/* Without the group affinity, the packets of a group are spread over the queues. */
+	Z_TEST_SKIP_IFNDEF(CONFIG_NRF_RPC_THREAD_POOL_GROUP_AFFINITY);
+
+	for (uint8_t i = 0; i < PACKET_CNT; i++) {
+		memset(packets[i], 0, PACKET_SIZE);
+		packets[i][GROUP_ID_OFFSET] = 1;
+		packets[i][SEQ_OFFSET] = i;
+		nrf_rpc_os_thread_pool_send(packets[i], PACKET_SIZE);
+	}
+
+	for (size_t i = 0; i < PACKET_CNT; i++) {
+		k_sem_give(&handler_gate_sem);
+		zassert_ok(k_sem_take(&handler_done_sem, K_SECONDS(1)), "Packet not handled");
+	}
+
+	zassert_equal(start_cnt, PACKET_CNT);
+
+	for (uint8_t i = 0; i < PACKET_CNT; i++) {
+		zassert_equal(start_order[i], i, "Packet %u started at position %u",
+			      start_order[i], i);
+	}
+}
+
+ZTEST_SUITE(nrf_rpc_thread_pool, NULL, thread_pool_setup, NULL, NULL, NULL);
@@ -0,0 +1,186 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <string.h>
+#include <zephyr/ztest.h>
+#include <zcbor_encode.h>
+#include <zcbor_decode.h>
+
+#include <nrf_rpc/nrf_rpc_serialize.h>
+
+#define DATA_SIZE_MAX 65536
+#define CBOR_SIZE_MAX NRF_RPC_BUFFER_ENCODED_SIZE_MAX(DATA_SIZE_MAX + 8)
+#define TRAILER	      0x1234
+/* Buffer and trailer */
+#define ELEM_CNT      2
+
+static uint8_t data[DATA_SIZE_MAX];
+static uint8_t cbor[CBOR_SIZE_MAX];
+static uint8_t cbor_expected[CBOR_SIZE_MAX];
+
+static void encode_start(struct nrf_rpc_cbor_ctx *ctx, uint8_t *buffer, size_t size)
+{
+	zcbor_new_encode_state(ctx->zs, ARRAY_SIZE(ctx->zs), buffer, size, 0);
+}
+
+static void decode_start(struct nrf_rpc_cbor_ctx *ctx, const uint8_t *buffer, size_t size)
+{
+	zcbor_new_decode_state(ctx->zs, ARRAY_SIZE(ctx->zs), buffer, size, ELEM_CNT, NULL, 0);
+}
+
+static size_t header_size(size_t size)
+{
+	if (size < 24) {
+		return 1;
+	} else if (size <= UINT8_MAX) {
+		return 2;
+	} else if (size <= UINT16_MAX) {
+		return 3;
+	}
+
+	return 5;
+}
+
+/* Encodes the fragments followed by a trailer, and checks the result against the encoding of
+ * the whole buffer with nrf_rpc_encode_buffer.
+ */
+static void frags_check(const struct nrf_rpc_buffer_frag *frags, size_t frag_cnt, size_t size)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	size_t cbor_size;
+	size_t decoded_size = 0;
+	const uint8_t *decoded;
+
+	encode_start(&ctx, cbor_expected, sizeof(cbor_expected));
+	nrf_rpc_encode_buffer(&ctx, data, size);
+	nrf_rpc_encode_uint(&ctx, TRAILER);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+
+	encode_start(&ctx, cbor, sizeof(cbor));
+	nrf_rpc_encode_buffer_frags(&ctx, frags, frag_cnt);
+	nrf_rpc_encode_uint(&ctx, TRAILER);
+	zassert_true(nrf_rpc_decode_valid(&ctx), "Encoding of %zu bytes failed", size);
+
+	cbor_size = ctx.zs->payload - cbor;
+	zassert_equal(cbor_size, header_size(size) + size + 3);
+	zassert_mem_equal(cbor, cbor_expected, cbor_size);
+
+	decode_start(&ctx, cbor, cbor_size);
+	decoded = nrf_rpc_decode_buffer_ptr_and_size(&ctx, &decoded_size);
+	zassert_not_null(decoded);
+	zassert_equal(decoded_size, size);
+	zassert_mem_equal(decoded, data, size);
+	zassert_equal(nrf_rpc_decode_uint(&ctx), TRAILER);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+}
+
+ZTEST(nrf_rpc_buffer_frags, test_header_sizes)
+{
+	static const size_t sizes[] = {0, 23, 24, 255, 256, 65535, 65536};
+	struct nrf_rpc_buffer_frag frag = {.data = data};
+
+	for (size_t i = 0; i < ARRAY_SIZE(sizes); i++) {
+		frag.size = sizes[i];
+		frags_check(&frag, 1, sizes[i]);
+	}
+}
+
+ZTEST(nrf_rpc_buffer_frags, test_multiple_frags)
+{
+	struct nrf_rpc_buffer_frag frags[] = {
+		{.data = &data[0], .size = 1},
+		{.data = &data[1], .size = 0},
+		{.data = &data[1], .size = 22},
+		{.data = &data[23], .size = 233},
+		{.data = &data[256], .size = 65280},
+	};
+
+	/* The byte string header grows as fragments are added. */
+	for (size_t cnt = 1; cnt <= ARRAY_SIZE(frags); cnt++) {
+		size_t size = 0;
+
+		for (size_t i = 0; i < cnt; i++) {
+			size += frags[i].size;
+		}
+
+		frags_check(frags, cnt, size);
+	}
+}
+
+ZTEST(nrf_rpc_buffer_frags, test_no_space)
+{
+	struct nrf_rpc_buffer_frag frags[] = {
+		{.data = &data[0], .size = 100},
+		{.data = &data[100], .size = 156},
+	};
+	struct nrf_rpc_cbor_ctx ctx;
+	size_t cbor_size = header_size(256) + 256;
+
+	encode_start(&ctx, cbor, cbor_size);
+	nrf_rpc_encode_buffer_frags(&ctx, frags, ARRAY_SIZE(frags));
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+	zassert_equal(ctx.zs->payload - cbor, cbor_size);
+
+	/* The data fits, but the header does not. */
+	encode_start(&ctx, cbor, cbor_size - 1);
+	nrf_rpc_encode_buffer_frags(&ctx, frags, ARRAY_SIZE(frags));
+	zassert_false(nrf_rpc_decode_valid(&ctx));
+
+	encode_start(&ctx, cbor, 255);
+	nrf_rpc_encode_buffer_frags(&ctx, frags, ARRAY_SIZE(frags));
+	zassert_false(nrf_rpc_decode_valid(&ctx));
+}
+
+ZTEST(nrf_rpc_buffer_frags, test_zero_frag)
+{
+	struct nrf_rpc_buffer_frag frags[] = {
+		{.data = &data[0], .size = 10},
+		{.data = NULL, .size = 20},
+	};
+	struct nrf_rpc_cbor_ctx ctx;
+	const uint8_t *decoded;
+	size_t decoded_size = 0;
+
+	encode_start(&ctx, cbor, sizeof(cbor));
+	nrf_rpc_encode_buffer_frags(&ctx, frags, ARRAY_SIZE(frags));
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+
+	/* The fragment without data is encoded as zeros. */
+	decode_start(&ctx, cbor, ctx.zs->payload - cbor);
+	decoded = nrf_rpc_decode_buffer_ptr_and_size(&ctx, &decoded_size);
+	zassert_not_null(decoded);
+	zassert_equal(decoded_size, 30);
+	zassert_mem_equal(decoded, data, 10);
+
+	for (size_t i = 10; i < decoded_size; i++) {
+		zassert_equal(decoded[i], 0, "Byte %zu is not zero", i);
+	}
+}
+
+ZTEST(nrf_rpc_buffer_frags, test_null)
+{
+	struct nrf_rpc_cbor_ctx ctx;
+	size_t cbor_size;
+
+	encode_start(&ctx, cbor, sizeof(cbor));
+	nrf_rpc_encode_buffer_frags(&ctx, NULL, 0);
+	zassert_true(nrf_rpc_decode_valid(&ctx));
+	cbor_size = ctx.zs->payload - cbor;
+
+	decode_start(&ctx, cbor, cbor_size);
+	zassert_true(nrf_rpc_decode_is_null(&ctx));
+}
+
+static void *buffer_frags_setup(void)
+{
+	for (size_t i = 0; i < sizeof(data); i++) {
+		data[i] = (uint8_t)(i * 7 + (i >> 8));
+	}
+
+	return NULL;
+}
+
+ZTEST_SUITE(nrf_rpc_buffer_frags, NULL, buffer_frags_setup, NULL, NULL, NULL);
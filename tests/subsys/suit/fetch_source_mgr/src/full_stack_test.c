@@ -18,11 +18,43 @@ static uint32_t expected_checksum;
 static uint8_t test_buf[32 * 1024 - 3];
 #define ITERATIONS 16
 
+#define BUFFER_SIZE    CONFIG_SUIT_STREAM_IPC_PROVIDER_BUFFER_SIZE
+#define MIN_CHUNK_SIZE CONFIG_SUIT_STREAM_IPC_PROVIDER_MIN_CHUNK_SIZE
+#define CHUNK_CNT_MAX  64
+
 static const char *requested_resource_id = "ExampleImageName.img";
 static void *stream_sink_requested_ctx = (void *)0xabcd0001;
 
 static K_SEM_DEFINE(delay_simulator_sem_1, 0, 1);
 static K_SEM_DEFINE(delay_simulator_sem_2, 0, 1);
+
+typedef struct {
+	size_t chunk_size;
+	uint32_t sleep_ms;
+
+} access_pattern_t;
+
+static const access_pattern_t default_ap_table[] = {
+	{.chunk_size = 16000, .sleep_ms = 40}, {.chunk_size = 3, .sleep_ms = 10},
+	{.chunk_size = 7000, .sleep_ms = 50},  {.chunk_size = 120, .sleep_ms = 10},
+	{.chunk_size = 8192, .sleep_ms = 100}, {.chunk_size = 4096, .sleep_ms = 200},
+	{.chunk_size = 4096, .sleep_ms = 10},  {.chunk_size = 4096, .sleep_ms = 10}};
+
+/* Fetch source writing small pieces of the image, slower than the sink processes them */
+static const access_pattern_t slow_source_ap_table[] = {{.chunk_size = 512, .sleep_ms = 20}};
+
+/* Fetch source writing small pieces of the image, faster than the sink processes them */
+static const access_pattern_t fast_source_ap_table[] = {{.chunk_size = 512, .sleep_ms = 0}};
+
+static const access_pattern_t *ap_table;
+static size_t ap_count;
+static int iterations;
+static uint32_t sink_delay_ms;
+
+/* Sizes of the chunks written to the sink */
+static size_t chunk_sizes[CHUNK_CNT_MAX];
+static size_t chunk_cnt;
+
 static suit_plat_err_t ipc_stream_write_chunk(void *ctx, const uint8_t *buf, size_t size)
 {
 	received_bytes += size;
@@ -31,39 +63,32 @@ static suit_plat_err_t ipc_stream_write_chunk(void *ctx, const uint8_t *buf, siz
 		received_checksum += buf[i];
 	}
 
-	/* let's simulate 10 ms lasting operation.
+	if (chunk_cnt < CHUNK_CNT_MAX) {
+		chunk_sizes[chunk_cnt] = size;
+	}
+	chunk_cnt++;
+
+	/* let's simulate lasting operation.
 	 *  cannot use k_sleep in posix tests!
 	 */
-	k_sem_take(&delay_simulator_sem_1, K_MSEC(10));
+	k_sem_take(&delay_simulator_sem_1, K_MSEC(sink_delay_ms));
 	return SUIT_PLAT_SUCCESS;
 }
 
-typedef struct {
-	size_t chunk_size;
-	uint32_t sleep_ms;
-
-} access_pattern_t;
-
 int fetch_request_fn(const uint8_t *uri, size_t uri_length, uint32_t session_id)
 {
 	zassert_equal(uri_length, strlen(requested_resource_id), "uri_length (%d)", uri_length);
 	zassert_mem_equal(uri, requested_resource_id, strlen(requested_resource_id));
 
-	access_pattern_t ap_table[] = {
-		{.chunk_size = 16000, .sleep_ms = 40}, {.chunk_size = 3, .sleep_ms = 10},
-		{.chunk_size = 7000, .sleep_ms = 50},  {.chunk_size = 120, .sleep_ms = 10},
-		{.chunk_size = 8192, .sleep_ms = 100}, {.chunk_size = 4096, .sleep_ms = 200},
-		{.chunk_size = 4096, .sleep_ms = 10},  {.chunk_size = 4096, .sleep_ms = 10}};
-
 	int rc = 0;
 	int pattern_idx = 0;
 
-	for (int buf_iter = 0; buf_iter < ITERATIONS; buf_iter++) {
+	for (int buf_iter = 0; buf_iter < iterations; buf_iter++) {
 
 		size_t offset_in_buffer = 0;
 
 		while (offset_in_buffer < sizeof(test_buf)) {
-			access_pattern_t *ap = &ap_table[pattern_idx];
+			const access_pattern_t *ap = &ap_table[pattern_idx];
 
 			size_t to_be_copied = sizeof(test_buf) - offset_in_buffer;
 
@@ -84,21 +109,35 @@ int fetch_request_fn(const uint8_t *uri, size_t uri_length, uint32_t session_id)
 			k_sem_take(&delay_simulator_sem_2, K_MSEC(ap->sleep_ms));
 
 			pattern_idx++;
-			pattern_idx = pattern_idx % (sizeof(ap_table) / sizeof(access_pattern_t));
+			pattern_idx = pattern_idx % ap_count;
 		}
 	}
 
 	return 0;
 }
 
-void test_full_stack(void)
+static void full_stack_run(const access_pattern_t *pattern, size_t pattern_count, int iter_count,
+			   uint32_t sink_delay)
 {
+	static bool provider_initialized;
+	suit_plat_err_t rc = SUIT_PLAT_SUCCESS;
+
+	ap_table = pattern;
+	ap_count = pattern_count;
+	iterations = iter_count;
+	sink_delay_ms = sink_delay;
+
+	received_bytes = 0;
+	received_checksum = 0;
+	expected_bytes = 0;
+	expected_checksum = 0;
+	chunk_cnt = 0;
 
 	for (int i = 0; i < sizeof(test_buf); ++i) {
 		test_buf[i] = (uint8_t)i;
 	}
 
-	for (int buf_iter = 0; buf_iter < ITERATIONS; buf_iter++) {
+	for (int buf_iter = 0; buf_iter < iterations; buf_iter++) {
 
 		for (int i = 0; i < sizeof(test_buf); ++i) {
 			expected_bytes++;
@@ -106,16 +145,19 @@ void test_full_stack(void)
 		}
 	}
 
-	suit_ipc_streamer_chunk_status_evt_unsubscribe();
-	suit_ipc_streamer_missing_image_evt_unsubscribe();
+	if (!provider_initialized) {
+		suit_ipc_streamer_chunk_status_evt_unsubscribe();
+		suit_ipc_streamer_missing_image_evt_unsubscribe();
 
-	suit_plat_err_t rc = SUIT_PLAT_SUCCESS;
+		rc = suit_ipc_streamer_provider_init();
+		zassert_equal(rc, SUIT_PLAT_SUCCESS,
+			      "suit_ipc_streamer_provider_init returned (%d)", rc);
 
-	rc = suit_ipc_streamer_provider_init();
-	zassert_equal(rc, SUIT_PLAT_SUCCESS, "suit_ipc_streamer_provider_init returned (%d)", rc);
+		rc = suit_dfu_fetch_source_register(fetch_request_fn);
+		zassert_equal(rc, SUIT_PLAT_SUCCESS, "fetch_source_register returned (%d)", rc);
 
-	rc = suit_dfu_fetch_source_register(fetch_request_fn);
-	zassert_equal(rc, SUIT_PLAT_SUCCESS, "fetch_source_register returned (%d)", rc);
+		provider_initialized = true;
+	}
 
 	struct stream_sink test_sink = {
 		.write = ipc_stream_write_chunk,
@@ -136,4 +178,39 @@ void test_full_stack(void)
 	zassert_equal(expected_checksum, received_checksum, "%d vs %d", expected_checksum,
 		      received_checksum);
 	zassert_equal(rc, SUIT_PLAT_SUCCESS, "suit_ipc_streamer_stream returned (%d)", rc);
+	zassert_true(chunk_cnt <= CHUNK_CNT_MAX, "Too many chunks (%zu)", chunk_cnt);
+}
+
+void test_full_stack(void)
+{
+	full_stack_run(default_ap_table, ARRAY_SIZE(default_ap_table), ITERATIONS, 10);
+}
+
+void test_full_stack_slow_source(void)
+{
+	full_stack_run(slow_source_ap_table, ARRAY_SIZE(slow_source_ap_table), 1, 0);
+
+	/* The requestor waits for data, so the chunks are passed as soon as they hold
+	 * MIN_CHUNK_SIZE bytes. The last chunk holds the rest of the image.
+	 */
+	for (size_t i = 0; i + 1 < chunk_cnt; i++) {
+		zassert_true(chunk_sizes[i] >= MIN_CHUNK_SIZE && chunk_sizes[i] < BUFFER_SIZE,
+			     "Chunk %zu of %zu bytes", i, chunk_sizes[i]);
+	}
+}
+
+void test_full_stack_fast_source(void)
+{
+	full_stack_run(fast_source_ap_table, ARRAY_SIZE(fast_source_ap_table), 1, 10);
+
+	/* The requestor is busy, so the buffers are filled before they are passed. The first
+	 * chunk is passed while the requestor waits for data, the last one holds the rest of
+	 * the image.
+	 */
+	zassert_true(chunk_cnt > 2, "Only %zu chunks", chunk_cnt);
+	zassert_true(chunk_sizes[0] >= MIN_CHUNK_SIZE, "First chunk of %zu bytes", chunk_sizes[0]);
+	for (size_t i = 1; i + 1 < chunk_cnt; i++) {
+		zassert_equal(chunk_sizes[i], BUFFER_SIZE, "Chunk %zu of %zu bytes", i,
+			      chunk_sizes[i]);
+	}
 }
@@ -8,6 +8,8 @@
 void test_ipc_streamer_requestor_no_response(void);
 void test_ipc_streamer_requestor(void);
 void test_full_stack(void);
+void test_full_stack_slow_source(void);
+void test_full_stack_fast_source(void);
 
 ZTEST_SUITE(test_fetch_source_mgr, NULL, NULL, NULL, NULL, NULL);
 
@@ -25,3 +27,13 @@ ZTEST(test_fetch_source_mgr, test_full_stack)
 {
 	test_full_stack();
 }
+
+ZTEST(test_fetch_source_mgr, test_full_stack_slow_source)
+{
+	test_full_stack_slow_source();
+}
+
+ZTEST(test_fetch_source_mgr, test_full_stack_fast_source)
+{
+	test_full_stack_fast_source();
+}
@@ -344,4 +344,24 @@ void test_ipc_streamer_requestor(void)
 	zassert_equal(expected_bytes, received_bytes, "%d vs %d", expected_bytes, received_bytes);
 	zassert_equal(expected_checksum, received_checksum, "%d vs %d", expected_checksum,
 		      received_checksum);
+
+	suit_ipc_streamer_stats_t stats;
+
+	rc = suit_ipc_streamer_stats_get(&stats);
+	zassert_equal(rc, SUIT_PLAT_SUCCESS, "suit_ipc_streamer_stats_get returned (%d)", rc);
+	zassert_equal(stats.byte_count, expected_bytes, "%d vs %d", stats.byte_count,
+		      expected_bytes);
+	/* Every buffer of the injector is enqueued, and the end of stream as well */
+	zassert_equal(stats.chunk_count,
+		      ITERATIONS * DIV_ROUND_UP(sizeof(test_buf), BUFFER_SIZE) + 1,
+		      "chunk_count (%d)", stats.chunk_count);
+	zassert_true(stats.chunks_in_flight_max >= 1 &&
+			     stats.chunks_in_flight_max <= CONFIG_SUIT_STREAM_IPC_REQUESTOR_MAX_CHUNKS,
+		     "chunks_in_flight_max (%d)", stats.chunks_in_flight_max);
+	zassert_true(stats.chunk_latency_total_us >= stats.chunk_latency_max_us,
+		     "chunk latency total (%llu) below max (%u)", stats.chunk_latency_total_us,
+		     stats.chunk_latency_max_us);
+
+	rc = suit_ipc_streamer_stats_get(NULL);
+	zassert_equal(rc, SUIT_PLAT_ERR_INVAL, "suit_ipc_streamer_stats_get returned (%d)", rc);
 }
@@ -0,0 +1,177 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <zephyr/drivers/flash.h>
+#include <suit_flash_streamer.h>
+#include <suit_sink.h>
+
+#define CHUNK_SIZE CONFIG_SUIT_STREAM_SOURCE_FLASH_CHUNK_SIZE
+/* Several chunks and a partial one, so that the read offset must advance between chunks. */
+#define PAYLOAD_SIZE (5 * CHUNK_SIZE + 24)
+/* Offset of the payload in the flash simulator, on an erase page boundary. */
+#define PAYLOAD_FLASH_OFFSET 0x80000
+#define PAYLOAD_ERASE_SIZE   0x1000
+
+#define EXTMEM_START CONFIG_SUIT_MEMORY_LAYOUT_EXTMEM_ADDRESS_RANGE_START
+#define EXTMEM_SIZE  CONFIG_SUIT_MEMORY_LAYOUT_EXTMEM_ADDRESS_RANGE_SIZE
+
+#define PAYLOAD_ADDRESS ((const uint8_t *)(EXTMEM_START + PAYLOAD_FLASH_OFFSET))
+
+struct test_sink_ctx {
+	uint8_t data[PAYLOAD_SIZE];
+	size_t offset;
+	size_t write_cnt;
+	size_t fail_at_write;
+	suit_plat_err_t nested_result;
+	bool nested_stream;
+};
+
+static const struct device *fdev = DEVICE_DT_GET(DT_CHOSEN(extmem_device));
+static uint8_t payload[PAYLOAD_SIZE];
+static struct test_sink_ctx sink_ctx;
+static struct test_sink_ctx nested_sink_ctx;
+
+static suit_plat_err_t test_write(void *ctx, const uint8_t *buf, size_t size);
+
+static struct stream_sink test_sink = {
+	.write = test_write,
+	.ctx = &sink_ctx,
+};
+
+static struct stream_sink nested_sink = {
+	.write = test_write,
+	.ctx = &nested_sink_ctx,
+};
+
+static suit_plat_err_t test_write(void *ctx, const uint8_t *buf, size_t size)
+{
+	struct test_sink_ctx *test_ctx = ctx;
+
+	test_ctx->write_cnt++;
+
+	if (size > CHUNK_SIZE) {
+		return SUIT_PLAT_ERR_INVAL;
+	}
+
+	if (test_ctx->write_cnt == test_ctx->fail_at_write) {
+		return SUIT_PLAT_ERR_IO;
+	}
+
+	if (test_ctx->offset + size > sizeof(test_ctx->data)) {
+		return SUIT_PLAT_ERR_NOMEM;
+	}
+
+	if (test_ctx->nested_stream) {
+		test_ctx->nested_stream = false;
+		test_ctx->nested_result =
+			suit_flash_streamer_stream(PAYLOAD_ADDRESS, PAYLOAD_SIZE, &nested_sink);
+	}
+
+	memcpy(&test_ctx->data[test_ctx->offset], buf, size);
+	test_ctx->offset += size;
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+ZTEST(flash_streamer_tests, test_multi_chunk_payload)
+{
+	suit_plat_err_t err = suit_flash_streamer_stream(PAYLOAD_ADDRESS, PAYLOAD_SIZE, &test_sink);
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Streaming failed: %d", err);
+	zassert_equal(sink_ctx.offset, PAYLOAD_SIZE, "Wrong number of bytes streamed");
+	zassert_equal(sink_ctx.write_cnt, DIV_ROUND_UP(PAYLOAD_SIZE, CHUNK_SIZE),
+		      "Payload not streamed in chunks");
+	zassert_mem_equal(sink_ctx.data, payload, PAYLOAD_SIZE, "Wrong data streamed");
+}
+
+ZTEST(flash_streamer_tests, test_unaligned_payload)
+{
+	/* The payload does not start on a chunk boundary of the flash */
+	const size_t start = CHUNK_SIZE / 2 + 3;
+	const size_t size = PAYLOAD_SIZE - start;
+	suit_plat_err_t err = suit_flash_streamer_stream(PAYLOAD_ADDRESS + start, size, &test_sink);
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Streaming failed: %d", err);
+	zassert_equal(sink_ctx.offset, size, "Wrong number of bytes streamed");
+	zassert_mem_equal(sink_ctx.data, &payload[start], size, "Wrong data streamed");
+}
+
+ZTEST(flash_streamer_tests, test_sink_error)
+{
+	suit_plat_err_t err;
+
+	/* The error of the sink stops the streaming in the middle of the payload */
+	sink_ctx.fail_at_write = 3;
+	err = suit_flash_streamer_stream(PAYLOAD_ADDRESS, PAYLOAD_SIZE, &test_sink);
+	zassert_equal(err, SUIT_PLAT_ERR_IO, "Unexpected error: %d", err);
+	zassert_equal(sink_ctx.write_cnt, 3, "Streaming not stopped");
+	zassert_equal(sink_ctx.offset, 2 * CHUNK_SIZE, "Wrong number of bytes streamed");
+
+	/* The read buffer is free for the next payload */
+	memset(&sink_ctx, 0, sizeof(sink_ctx));
+	err = suit_flash_streamer_stream(PAYLOAD_ADDRESS, PAYLOAD_SIZE, &test_sink);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Streaming failed: %d", err);
+	zassert_mem_equal(sink_ctx.data, payload, PAYLOAD_SIZE, "Wrong data streamed");
+}
+
+ZTEST(flash_streamer_tests, test_nested_stream)
+{
+	suit_plat_err_t err;
+
+	/* A sink streams another payload from flash while its data is streamed */
+	sink_ctx.nested_stream = true;
+	err = suit_flash_streamer_stream(PAYLOAD_ADDRESS, PAYLOAD_SIZE, &test_sink);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "Streaming failed: %d", err);
+	zassert_mem_equal(sink_ctx.data, payload, PAYLOAD_SIZE, "Wrong data streamed");
+
+	zassert_equal(sink_ctx.nested_result, SUIT_PLAT_SUCCESS, "Nested streaming failed: %d",
+		      sink_ctx.nested_result);
+	zassert_equal(nested_sink_ctx.offset, PAYLOAD_SIZE, "Wrong number of bytes streamed");
+	zassert_equal(nested_sink_ctx.write_cnt, DIV_ROUND_UP(PAYLOAD_SIZE, CHUNK_SIZE),
+		      "Nested payload not streamed in chunks");
+	zassert_mem_equal(nested_sink_ctx.data, payload, PAYLOAD_SIZE, "Wrong data streamed");
+}
+
+ZTEST(flash_streamer_tests, test_invalid_args)
+{
+	const uint8_t *outside = (const uint8_t *)(EXTMEM_START + EXTMEM_SIZE);
+	struct stream_sink no_write_sink = {0};
+
+	zassert_equal(suit_flash_streamer_stream(outside, PAYLOAD_SIZE, &test_sink),
+		      SUIT_PLAT_ERR_INVAL, "Payload outside of the external memory accepted");
+	zassert_equal(suit_flash_streamer_stream(PAYLOAD_ADDRESS, 0, &test_sink),
+		      SUIT_PLAT_ERR_INVAL, "Empty payload accepted");
+	zassert_equal(suit_flash_streamer_stream(PAYLOAD_ADDRESS, PAYLOAD_SIZE, NULL),
+		      SUIT_PLAT_ERR_INVAL, "Missing sink accepted");
+	zassert_equal(suit_flash_streamer_stream(PAYLOAD_ADDRESS, PAYLOAD_SIZE, &no_write_sink),
+		      SUIT_PLAT_ERR_INVAL, "Sink without write accepted");
+	zassert_equal(sink_ctx.write_cnt, 0, "Sink written");
+}
+
+static void *test_suite_setup(void)
+{
+	zassert_true(device_is_ready(fdev), "Flash simulator not ready");
+
+	for (size_t i = 0; i < sizeof(payload); i++) {
+		payload[i] = (uint8_t)(i * 13 + (i >> 8));
+	}
+
+	zassert_ok(flash_erase(fdev, PAYLOAD_FLASH_OFFSET, PAYLOAD_ERASE_SIZE));
+	zassert_ok(flash_write(fdev, PAYLOAD_FLASH_OFFSET, payload, sizeof(payload)));
+
+	return NULL;
+}
+
+static void test_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	memset(&sink_ctx, 0, sizeof(sink_ctx));
+	memset(&nested_sink_ctx, 0, sizeof(nested_sink_ctx));
+}
+
+ZTEST_SUITE(flash_streamer_tests, NULL, test_suite_setup, test_before, NULL, NULL);
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+#include <stdint.h>
+#include <suit_tee_sink.h>
+#include <suit_sink.h>
+
+static uint8_t test_data[] = {0,  1,  2,  3,  4,  5,  6,  7,  8,  9,  10, 11, 12, 13, 14, 15,
+			      16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, 27, 28, 29, 30, 31};
+
+struct test_sink_ctx {
+	uint8_t data[sizeof(test_data)];
+	size_t offset;
+	size_t erase_cnt;
+	size_t flush_cnt;
+	suit_plat_err_t write_result;
+};
+
+static struct test_sink_ctx first_ctx;
+static struct test_sink_ctx second_ctx;
+
+static suit_plat_err_t test_erase(void *ctx)
+{
+	struct test_sink_ctx *test_ctx = ctx;
+
+	memset(test_ctx->data, 0xFF, sizeof(test_ctx->data));
+	test_ctx->erase_cnt++;
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+static suit_plat_err_t test_write(void *ctx, const uint8_t *buf, size_t size)
+{
+	struct test_sink_ctx *test_ctx = ctx;
+
+	if (test_ctx->write_result != SUIT_PLAT_SUCCESS) {
+		return test_ctx->write_result;
+	}
+
+	if (test_ctx->offset + size > sizeof(test_ctx->data)) {
+		return SUIT_PLAT_ERR_NOMEM;
+	}
+
+	memcpy(&test_ctx->data[test_ctx->offset], buf, size);
+	test_ctx->offset += size;
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+static suit_plat_err_t test_seek(void *ctx, size_t offset)
+{
+	struct test_sink_ctx *test_ctx = ctx;
+
+	test_ctx->offset = offset;
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+static suit_plat_err_t test_flush(void *ctx)
+{
+	struct test_sink_ctx *test_ctx = ctx;
+
+	test_ctx->flush_cnt++;
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+static suit_plat_err_t test_used_storage(void *ctx, size_t *size)
+{
+	struct test_sink_ctx *test_ctx = ctx;
+
+	*size = test_ctx->offset;
+
+	return SUIT_PLAT_SUCCESS;
+}
+
+/* Sink supporting all the operations. */
+static void full_sink_get(struct stream_sink *sink, struct test_sink_ctx *ctx)
+{
+	memset(ctx, 0, sizeof(*ctx));
+
+	sink->erase = test_erase;
+	sink->write = test_write;
+	sink->seek = test_seek;
+	sink->flush = test_flush;
+	sink->used_storage = test_used_storage;
+	sink->release = NULL;
+	sink->ctx = ctx;
+}
+
+/* Sink supporting only writes, as the digest sink. */
+static void write_only_sink_get(struct stream_sink *sink, struct test_sink_ctx *ctx)
+{
+	full_sink_get(sink, ctx);
+
+	sink->erase = NULL;
+	sink->seek = NULL;
+	sink->flush = NULL;
+	sink->used_storage = NULL;
+}
+
+ZTEST_SUITE(tee_sink_tests, NULL, NULL, NULL, NULL, NULL);
+
+ZTEST(tee_sink_tests, test_tee_sink_write_OK)
+{
+	struct stream_sink first, second, tee;
+	size_t used = 0;
+
+	full_sink_get(&first, &first_ctx);
+	write_only_sink_get(&second, &second_ctx);
+
+	int err = suit_tee_sink_get(&tee, &first, &second);
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "suit_tee_sink_get failed - error %i", err);
+	zassert_is_null(tee.seek, "Seek supported without the support of the second sink");
+	zassert_not_null(tee.used_storage, "Used storage not supported");
+
+	err = tee.erase(tee.ctx);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.erase failed - error %i", err);
+	zassert_equal(first_ctx.erase_cnt, 1, "The first sink was not erased");
+
+	err = tee.write(tee.ctx, test_data, 10);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.write failed - error %i", err);
+	err = tee.write(tee.ctx, &test_data[10], sizeof(test_data) - 10);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.write failed - error %i", err);
+
+	err = tee.flush(tee.ctx);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.flush failed - error %i", err);
+	zassert_equal(first_ctx.flush_cnt, 1, "The first sink was not flushed");
+
+	err = tee.used_storage(tee.ctx, &used);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.used_storage failed - error %i", err);
+	zassert_equal(used, sizeof(test_data), "Incorrect used storage");
+
+	zassert_mem_equal(first_ctx.data, test_data, sizeof(test_data),
+			  "Incorrect data in the first sink");
+	zassert_mem_equal(second_ctx.data, test_data, sizeof(test_data),
+			  "Incorrect data in the second sink");
+
+	err = release_sink(&tee);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.release failed - error %i", err);
+}
+
+ZTEST(tee_sink_tests, test_tee_sink_seek_OK)
+{
+	struct stream_sink first, second, tee;
+
+	full_sink_get(&first, &first_ctx);
+	full_sink_get(&second, &second_ctx);
+
+	int err = suit_tee_sink_get(&tee, &first, &second);
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "suit_tee_sink_get failed - error %i", err);
+	zassert_not_null(tee.seek, "Seek not supported");
+
+	err = tee.seek(tee.ctx, 16);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.seek failed - error %i", err);
+	zassert_equal(first_ctx.offset, 16, "Incorrect offset of the first sink");
+	zassert_equal(second_ctx.offset, 16, "Incorrect offset of the second sink");
+
+	err = release_sink(&tee);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.release failed - error %i", err);
+}
+
+ZTEST(tee_sink_tests, test_tee_sink_write_NOK)
+{
+	struct stream_sink first, second, tee;
+
+	full_sink_get(&first, &first_ctx);
+	full_sink_get(&second, &second_ctx);
+	first_ctx.write_result = SUIT_PLAT_ERR_IO;
+
+	int err = suit_tee_sink_get(&tee, &first, &second);
+
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "suit_tee_sink_get failed - error %i", err);
+
+	err = tee.write(tee.ctx, test_data, sizeof(test_data));
+	zassert_equal(err, SUIT_PLAT_ERR_IO, "Unexpected error code");
+	zassert_equal(second_ctx.offset, 0, "Data written to the second sink");
+
+	first_ctx.write_result = SUIT_PLAT_SUCCESS;
+	second_ctx.write_result = SUIT_PLAT_ERR_CRASH;
+
+	err = tee.write(tee.ctx, test_data, sizeof(test_data));
+	zassert_equal(err, SUIT_PLAT_ERR_CRASH, "Unexpected error code");
+
+	err = release_sink(&tee);
+	zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.release failed - error %i", err);
+}
+
+ZTEST(tee_sink_tests, test_tee_sink_get_NOK)
+{
+	struct stream_sink first, second, tee;
+
+	full_sink_get(&first, &first_ctx);
+	full_sink_get(&second, &second_ctx);
+
+	int err = suit_tee_sink_get(NULL, &first, &second);
+
+	zassert_equal(err, SUIT_PLAT_ERR_INVAL, "Unexpected error code - sink == NULL");
+
+	err = suit_tee_sink_get(&tee, NULL, &second);
+	zassert_equal(err, SUIT_PLAT_ERR_INVAL, "Unexpected error code - first == NULL");
+
+	second.write = NULL;
+	err = suit_tee_sink_get(&tee, &first, &second);
+	zassert_equal(err, SUIT_PLAT_ERR_INVAL, "Unexpected error code - second.write == NULL");
+}
+
+ZTEST(tee_sink_tests, test_tee_sink_get_out_of_contexts)
+{
+	struct stream_sink first, second;
+	struct stream_sink tees[CONFIG_SUIT_STREAM_SINK_TEE_CONTEXT_COUNT + 1];
+	suit_plat_err_t err;
+
+	full_sink_get(&first, &first_ctx);
+	full_sink_get(&second, &second_ctx);
+
+	for (size_t i = 0; i < CONFIG_SUIT_STREAM_SINK_TEE_CONTEXT_COUNT; i++) {
+		err = suit_tee_sink_get(&tees[i], &first, &second);
+		zassert_equal(err, SUIT_PLAT_SUCCESS, "Unexpected error code");
+	}
+
+	err = suit_tee_sink_get(&tees[CONFIG_SUIT_STREAM_SINK_TEE_CONTEXT_COUNT], &first, &second);
+	zassert_equal(err, SUIT_PLAT_ERR_NO_RESOURCES, "Unexpected error code");
+
+	for (size_t i = 0; i < CONFIG_SUIT_STREAM_SINK_TEE_CONTEXT_COUNT; i++) {
+		err = release_sink(&tees[i]);
+		zassert_equal(err, SUIT_PLAT_SUCCESS, "tee.release failed - error %i", err);
+	}
+}
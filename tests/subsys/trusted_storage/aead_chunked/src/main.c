@@ -0,0 +1,514 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <stdio.h>
+#include <zephyr/ztest.h>
+#include <zephyr/settings/settings.h>
+#include <psa/crypto.h>
+#include <psa/protected_storage.h>
+
+#include "storage_backend.h"
+#include "aead/aead_crypt.h"
+#include "aead/aead_key.h"
+#include "aead/aead_nonce.h"
+
+#define PREFIX	       CONFIG_PSA_PROTECTED_STORAGE_PREFIX
+#define CHUNK_SIZE     CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNK_SIZE
+#define ASSET_SIZE_MAX CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_MAX_DATA_SIZE
+#define ASSET_UID      0x1234
+/* Four chunks, the last one partial */
+#define ASSET_SIZE     (3 * CHUNK_SIZE + 10)
+
+#define NONCE_SIZE	  12
+#define TAG_SIZE	  16
+#define GENERATION_COUNT  2
+#define CHUNK_PREFIX_SIZE 20
+
+/* Layout of the objects stored by the AEAD backend in trusted_backend_aead.c */
+struct single_header {
+	psa_storage_create_flags_t create_flags;
+	size_t data_size;
+};
+
+struct single_object {
+	struct single_header header;
+	uint8_t nonce[NONCE_SIZE];
+	uint8_t data[ASSET_SIZE_MAX + TAG_SIZE];
+};
+
+struct chunked_header {
+	struct single_header header;
+	uint32_t capacity;
+	uint32_t chunk_size;
+};
+
+static uint8_t asset[ASSET_SIZE_MAX];
+static uint8_t buf[ASSET_SIZE_MAX];
+static uint8_t object[sizeof(struct single_object)];
+static uint8_t chunk[CHUNK_SIZE + TAG_SIZE];
+static uint8_t other_chunk[CHUNK_SIZE + TAG_SIZE];
+
+/* Status of the writes of the object of the asset, which holds the chunk table */
+static psa_status_t object_write_status = PSA_SUCCESS;
+
+psa_status_t __real_storage_set_object(const psa_storage_uid_t uid, const char *prefix,
+				       const void *object_data, const size_t object_size);
+
+psa_status_t __wrap_storage_set_object(const psa_storage_uid_t uid, const char *prefix,
+				       const void *object_data, const size_t object_size)
+{
+	if (object_write_status != PSA_SUCCESS && strcmp(prefix, PREFIX) == 0) {
+		return object_write_status;
+	}
+
+	return __real_storage_set_object(uid, prefix, object_data, object_size);
+}
+
+static void asset_fill(uint8_t seed)
+{
+	for (size_t i = 0; i < sizeof(asset); i++) {
+		asset[i] = (uint8_t)(i * 13 + seed);
+	}
+}
+
+static void asset_check(size_t size)
+{
+	struct psa_storage_info_t info;
+	size_t length;
+
+	zassert_equal(psa_ps_get_info(ASSET_UID, &info), PSA_SUCCESS, "Failed to get the info");
+	zassert_equal(info.size, size, "Incorrect size");
+
+	zassert_equal(psa_ps_get(ASSET_UID, 0, sizeof(buf), buf, &length), PSA_SUCCESS,
+		      "Failed to get the asset");
+	zassert_equal(length, size, "Incorrect length");
+	zassert_mem_equal(buf, asset, size, "Incorrect data");
+}
+
+static void chunk_prefix_create(char *chunk_prefix, uint8_t generation, size_t index)
+{
+	snprintf(chunk_prefix, CHUNK_PREFIX_SIZE, "%s.%u.%u", PREFIX, generation,
+		 (unsigned int)index);
+}
+
+static bool chunk_stored(size_t index, uint8_t generation)
+{
+	char chunk_prefix[CHUNK_PREFIX_SIZE];
+	uint8_t sealed_chunk[CHUNK_SIZE + TAG_SIZE];
+	size_t length;
+
+	chunk_prefix_create(chunk_prefix, generation, index);
+
+	return storage_get_object(ASSET_UID, chunk_prefix, sealed_chunk, sizeof(sealed_chunk),
+				  &length) == PSA_SUCCESS;
+}
+
+/* Finds the stored chunk of the given index, and returns its generation, or -1 if not found. */
+static int chunk_find(size_t index)
+{
+	for (uint8_t generation = 0; generation < GENERATION_COUNT; generation++) {
+		if (chunk_stored(index, generation)) {
+			return generation;
+		}
+	}
+
+	return -1;
+}
+
+static size_t chunk_get(size_t index, uint8_t *sealed_chunk, char *chunk_prefix)
+{
+	int generation = chunk_find(index);
+	size_t length;
+
+	zassert_true(generation >= 0, "Chunk %zu not found", index);
+
+	chunk_prefix_create(chunk_prefix, generation, index);
+	zassert_equal(storage_get_object(ASSET_UID, chunk_prefix, sealed_chunk,
+					 CHUNK_SIZE + TAG_SIZE, &length),
+		      PSA_SUCCESS, "Failed to get chunk %zu", index);
+
+	return length;
+}
+
+static size_t object_get(void)
+{
+	size_t length;
+
+	zassert_equal(storage_get_object(ASSET_UID, PREFIX, object, sizeof(object), &length),
+		      PSA_SUCCESS, "Failed to get the object");
+
+	return length;
+}
+
+/* Stores the asset in the single-entry format, as done with the chunks disabled. */
+static void single_object_set(size_t size)
+{
+	struct single_object *single = (struct single_object *)object;
+	uint8_t key[AEAD_KEY_SIZE];
+	size_t length;
+
+	memset(single, 0, sizeof(*single));
+	single->header.data_size = size;
+
+	zassert_equal(trusted_storage_get_key(ASSET_UID, key, sizeof(key)), PSA_SUCCESS,
+		      "Failed to get the key");
+	zassert_equal(trusted_storage_get_nonce(single->nonce, NONCE_SIZE), PSA_SUCCESS,
+		      "Failed to get a nonce");
+	zassert_equal(trusted_storage_aead_encrypt(key, sizeof(key), single->nonce, NONCE_SIZE,
+						   &single->header, sizeof(single->header), asset,
+						   size, single->data, sizeof(single->data),
+						   &length),
+		      PSA_SUCCESS, "Failed to encrypt the asset");
+	zassert_equal(storage_set_object(ASSET_UID, PREFIX, single,
+					 offsetof(struct single_object, data) + length),
+		      PSA_SUCCESS, "Failed to store the object");
+}
+
+ZTEST(trusted_storage_aead_chunked, test_get_across_chunks)
+{
+	const struct {
+		size_t offset;
+		size_t length;
+	} reads[] = {
+		{0, CHUNK_SIZE},
+		{CHUNK_SIZE - 1, 2},
+		{CHUNK_SIZE - 5, 2 * CHUNK_SIZE + 10},
+		{ASSET_SIZE - 3, 3},
+		{ASSET_SIZE, 0},
+	};
+	size_t length;
+
+	asset_fill(1);
+	zassert_equal(psa_ps_set(ASSET_UID, ASSET_SIZE, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to set the asset");
+
+	for (size_t i = 0; i < ARRAY_SIZE(reads); i++) {
+		zassert_equal(psa_ps_get(ASSET_UID, reads[i].offset, reads[i].length, buf, &length),
+			      PSA_SUCCESS, "Failed to get at %zu", reads[i].offset);
+		zassert_equal(length, reads[i].length, "Incorrect length at %zu", reads[i].offset);
+		zassert_mem_equal(buf, &asset[reads[i].offset], length, "Incorrect data at %zu",
+				  reads[i].offset);
+	}
+
+	/* A read past the end of the asset is cut */
+	zassert_equal(psa_ps_get(ASSET_UID, ASSET_SIZE - 3, 10, buf, &length), PSA_SUCCESS,
+		      "Failed to get the end of the asset");
+	zassert_equal(length, 3, "Incorrect length");
+	zassert_equal(psa_ps_get(ASSET_UID, ASSET_SIZE + 1, 1, buf, &length),
+		      PSA_ERROR_INVALID_ARGUMENT, "Read past the asset accepted");
+}
+
+ZTEST(trusted_storage_aead_chunked, test_create_set_extended)
+{
+	const size_t capacity = 2 * CHUNK_SIZE + 1;
+	struct psa_storage_info_t info;
+	size_t length;
+
+	asset_fill(2);
+	zassert_equal(psa_ps_create(ASSET_UID, capacity, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to create the asset");
+	zassert_equal(psa_ps_create(ASSET_UID, capacity, PSA_STORAGE_FLAG_NONE),
+		      PSA_ERROR_ALREADY_EXISTS, "Asset created twice");
+
+	zassert_equal(psa_ps_get_info(ASSET_UID, &info), PSA_SUCCESS, "Failed to get the info");
+	zassert_equal(info.size, 0, "Created asset not empty");
+	zassert_equal(info.capacity, capacity, "Incorrect capacity");
+	zassert_equal(psa_ps_get(ASSET_UID, 0, 1, buf, &length), PSA_SUCCESS,
+		      "Failed to get the empty asset");
+	zassert_equal(length, 0, "Data read from the empty asset");
+
+	zassert_equal(psa_ps_set_extended(ASSET_UID, 0, capacity, asset), PSA_SUCCESS,
+		      "Failed to write the asset");
+	asset_check(capacity);
+
+	zassert_equal(psa_ps_set_extended(ASSET_UID, 1, capacity, asset),
+		      PSA_ERROR_INVALID_ARGUMENT, "Write past the capacity accepted");
+	asset_check(capacity);
+}
+
+ZTEST(trusted_storage_aead_chunked, test_set_extended_growth)
+{
+	const size_t steps[] = {10, CHUNK_SIZE, 1, 2 * CHUNK_SIZE, CHUNK_SIZE - 11};
+	size_t size = 0;
+	size_t length;
+
+	asset_fill(3);
+	zassert_equal(psa_ps_create(ASSET_UID, ASSET_SIZE_MAX, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to create the asset");
+
+	/* Only the appended chunks and the table are written again */
+	for (size_t i = 0; i < ARRAY_SIZE(steps); i++) {
+		zassert_equal(psa_ps_set_extended(ASSET_UID, size, steps[i], &asset[size]),
+			      PSA_SUCCESS, "Failed to append %zu bytes", steps[i]);
+		size += steps[i];
+		asset_check(size);
+	}
+
+	/* A write must not leave a gap in the asset */
+	zassert_equal(psa_ps_set_extended(ASSET_UID, size + 1, 1, asset),
+		      PSA_ERROR_INVALID_ARGUMENT, "Write past the end of the asset accepted");
+
+	/* A write both overwriting and growing the asset */
+	asset_fill(4);
+	zassert_equal(psa_ps_set_extended(ASSET_UID, size - 5, 10, &asset[size - 5]), PSA_SUCCESS,
+		      "Failed to write across the end of the asset");
+	zassert_equal(psa_ps_get(ASSET_UID, size - 5, 10, buf, &length), PSA_SUCCESS,
+		      "Failed to get the asset");
+	zassert_equal(length, 10, "Incorrect length");
+	zassert_mem_equal(buf, &asset[size - 5], 10, "Incorrect data");
+}
+
+ZTEST(trusted_storage_aead_chunked, test_single_to_chunked)
+{
+	const size_t offset = CHUNK_SIZE - 4;
+	size_t length;
+
+	asset_fill(5);
+	single_object_set(ASSET_SIZE);
+	zassert_equal(chunk_find(0), -1, "Chunk stored for a single-entry object");
+
+	/* The single-entry object is read as such */
+	asset_check(ASSET_SIZE);
+
+	/* It is converted to chunks on its first partial write */
+	memset(&asset[offset], 0xaa, 8);
+	zassert_equal(psa_ps_set_extended(ASSET_UID, offset, 8, &asset[offset]), PSA_SUCCESS,
+		      "Failed to write the asset");
+	for (size_t i = 0; i < DIV_ROUND_UP(ASSET_SIZE, CHUNK_SIZE); i++) {
+		zassert_true(chunk_find(i) >= 0, "Chunk %zu not stored", i);
+	}
+	asset_check(ASSET_SIZE);
+
+	length = object_get();
+	zassert_true(length < offsetof(struct single_object, data) + ASSET_SIZE,
+		     "Data left in the object");
+}
+
+ZTEST(trusted_storage_aead_chunked, test_single_invalid_write)
+{
+	size_t length;
+
+	asset_fill(10);
+	single_object_set(ASSET_SIZE);
+	length = object_get();
+	memcpy(buf, object, length);
+
+	/* The arguments are checked before the object is converted to chunks */
+	zassert_equal(psa_ps_set_extended(ASSET_UID, ASSET_SIZE + 1, 1, asset),
+		      PSA_ERROR_INVALID_ARGUMENT, "Write past the end of the asset accepted");
+	zassert_equal(psa_ps_set_extended(ASSET_UID, ASSET_SIZE - 1, 2, asset),
+		      PSA_ERROR_INVALID_ARGUMENT, "Write past the capacity accepted");
+
+	/* An empty write does not change the object */
+	zassert_equal(psa_ps_set_extended(ASSET_UID, 0, 0, NULL), PSA_SUCCESS,
+		      "Failed to write nothing");
+
+	zassert_equal(chunk_find(0), -1, "Object converted to chunks");
+	zassert_equal(object_get(), length, "Object changed");
+	zassert_mem_equal(object, buf, length, "Object changed");
+	asset_check(ASSET_SIZE);
+}
+
+ZTEST(trusted_storage_aead_chunked, test_table_write_failure)
+{
+	const size_t offset = CHUNK_SIZE + 5;
+	const size_t length = 3 * CHUNK_SIZE;
+	const size_t chunks = DIV_ROUND_UP(ASSET_SIZE, CHUNK_SIZE);
+	int generations[DIV_ROUND_UP(ASSET_SIZE, CHUNK_SIZE)];
+	psa_status_t status;
+
+	asset_fill(11);
+	zassert_equal(psa_ps_create(ASSET_UID, ASSET_SIZE_MAX, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to create the asset");
+	zassert_equal(psa_ps_set_extended(ASSET_UID, 0, ASSET_SIZE, asset), PSA_SUCCESS,
+		      "Failed to write the asset");
+
+	for (size_t i = 0; i < chunks; i++) {
+		generations[i] = chunk_find(i);
+	}
+
+	/* The write overwrites chunks and appends one, then fails to store the table */
+	memset(buf, 0x55, length);
+	object_write_status = PSA_ERROR_STORAGE_FAILURE;
+	status = psa_ps_set_extended(ASSET_UID, offset, length, buf);
+	object_write_status = PSA_SUCCESS;
+	zassert_equal(status, PSA_ERROR_STORAGE_FAILURE, "Failed table write not reported");
+
+	/* The previous version of the asset is left, without the new chunks */
+	asset_check(ASSET_SIZE);
+	for (size_t i = 0; i < chunks; i++) {
+		zassert_equal(chunk_find(i), generations[i], "Chunk %zu changed", i);
+		zassert_false(chunk_stored(i, (generations[i] + 1) % GENERATION_COUNT),
+			      "New chunk %zu left", i);
+	}
+	zassert_equal(chunk_find(chunks), -1, "Appended chunk left");
+}
+
+ZTEST(trusted_storage_aead_chunked, test_set_shrink)
+{
+	const size_t size = CHUNK_SIZE + 1;
+
+	asset_fill(6);
+	zassert_equal(psa_ps_set(ASSET_UID, ASSET_SIZE, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to set the asset");
+
+	asset_fill(7);
+	zassert_equal(psa_ps_set(ASSET_UID, size, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to set the smaller asset");
+	asset_check(size);
+
+	/* The chunks past the new size are removed */
+	for (size_t i = 0; i < DIV_ROUND_UP(ASSET_SIZE, CHUNK_SIZE); i++) {
+		zassert_equal(chunk_find(i) >= 0, i < DIV_ROUND_UP(size, CHUNK_SIZE),
+			      "Chunk %zu not as expected", i);
+	}
+
+	zassert_equal(psa_ps_remove(ASSET_UID), PSA_SUCCESS, "Failed to remove the asset");
+	zassert_equal(chunk_find(0), -1, "Chunk left after removal");
+}
+
+ZTEST(trusted_storage_aead_chunked, test_chunk_size_mismatch)
+{
+	struct chunked_header *header = (struct chunked_header *)object;
+	size_t length;
+
+	asset_fill(8);
+	zassert_equal(psa_ps_set(ASSET_UID, ASSET_SIZE, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to set the asset");
+
+	/* As if stored with another CONFIG_TRUSTED_STORAGE_BACKEND_AEAD_CHUNK_SIZE */
+	length = object_get();
+	header->chunk_size = 2 * CHUNK_SIZE;
+	zassert_equal(storage_set_object(ASSET_UID, PREFIX, object, length), PSA_SUCCESS,
+		      "Failed to store the object");
+
+	zassert_equal(psa_ps_get(ASSET_UID, 0, 1, buf, &length), PSA_ERROR_NOT_SUPPORTED,
+		      "Asset of another chunk size read");
+	zassert_equal(psa_ps_set_extended(ASSET_UID, 0, 1, asset), PSA_ERROR_NOT_SUPPORTED,
+		      "Asset of another chunk size written");
+
+	/* The asset can still be replaced as a whole */
+	zassert_equal(psa_ps_set(ASSET_UID, ASSET_SIZE, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to replace the asset");
+	asset_check(ASSET_SIZE);
+}
+
+ZTEST(trusted_storage_aead_chunked, test_tampered_object_rejected)
+{
+	struct chunked_header *header = (struct chunked_header *)object;
+	char chunk_prefix[CHUNK_PREFIX_SIZE];
+	size_t length;
+
+	asset_fill(9);
+	zassert_equal(psa_ps_set(ASSET_UID, ASSET_SIZE, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to set the asset");
+
+	/* The table of the chunks */
+	length = object_get();
+	object[length - TAG_SIZE - 1] ^= 0x01;
+	zassert_equal(storage_set_object(ASSET_UID, PREFIX, object, length), PSA_SUCCESS,
+		      "Failed to store the object");
+	zassert_equal(psa_ps_get(ASSET_UID, 0, 1, buf, &length), PSA_ERROR_INVALID_SIGNATURE,
+		      "Tampered table accepted");
+
+	/* The header */
+	zassert_equal(psa_ps_set(ASSET_UID, ASSET_SIZE, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to set the asset");
+	length = object_get();
+	header->capacity = ASSET_SIZE_MAX;
+	zassert_equal(storage_set_object(ASSET_UID, PREFIX, object, length), PSA_SUCCESS,
+		      "Failed to store the object");
+	zassert_equal(psa_ps_get(ASSET_UID, 0, 1, buf, &length), PSA_ERROR_INVALID_SIGNATURE,
+		      "Tampered header accepted");
+	zassert_equal(psa_ps_set_extended(ASSET_UID, ASSET_SIZE, 1, asset),
+		      PSA_ERROR_INVALID_SIGNATURE, "Tampered header accepted");
+
+	/* A chunk */
+	zassert_equal(psa_ps_set(ASSET_UID, ASSET_SIZE, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to set the asset");
+	length = chunk_get(1, chunk, chunk_prefix);
+	chunk[0] ^= 0x01;
+	zassert_equal(storage_set_object(ASSET_UID, chunk_prefix, chunk, length), PSA_SUCCESS,
+		      "Failed to store the chunk");
+	zassert_equal(psa_ps_get(ASSET_UID, CHUNK_SIZE - 1, 2, buf, &length),
+		      PSA_ERROR_INVALID_SIGNATURE, "Tampered chunk accepted");
+
+	/* The other chunks are still read */
+	zassert_equal(psa_ps_get(ASSET_UID, 0, CHUNK_SIZE, buf, &length), PSA_SUCCESS,
+		      "Failed to get the first chunk");
+	zassert_mem_equal(buf, asset, CHUNK_SIZE, "Incorrect data");
+}
+
+ZTEST(trusted_storage_aead_chunked, test_swapped_chunk_rejected)
+{
+	char chunk_prefix[CHUNK_PREFIX_SIZE];
+	char other_prefix[CHUNK_PREFIX_SIZE];
+	size_t length;
+	size_t other_length;
+
+	asset_fill(10);
+	zassert_equal(psa_ps_set(ASSET_UID, ASSET_SIZE, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to set the asset");
+
+	/* Full chunks of the same length, stored in the place of each other */
+	length = chunk_get(0, chunk, chunk_prefix);
+	other_length = chunk_get(1, other_chunk, other_prefix);
+	zassert_equal(storage_set_object(ASSET_UID, chunk_prefix, other_chunk, other_length),
+		      PSA_SUCCESS, "Failed to store the chunk");
+	zassert_equal(storage_set_object(ASSET_UID, other_prefix, chunk, length), PSA_SUCCESS,
+		      "Failed to store the chunk");
+
+	zassert_equal(psa_ps_get(ASSET_UID, 0, 1, buf, &length), PSA_ERROR_INVALID_SIGNATURE,
+		      "Swapped chunk accepted");
+	zassert_equal(psa_ps_get(ASSET_UID, CHUNK_SIZE, 1, buf, &length),
+		      PSA_ERROR_INVALID_SIGNATURE, "Swapped chunk accepted");
+}
+
+ZTEST(trusted_storage_aead_chunked, test_replayed_chunk_rejected)
+{
+	char chunk_prefix[CHUNK_PREFIX_SIZE];
+	size_t length;
+	size_t old_length;
+
+	asset_fill(11);
+	zassert_equal(psa_ps_set(ASSET_UID, ASSET_SIZE, asset, PSA_STORAGE_FLAG_NONE), PSA_SUCCESS,
+		      "Failed to set the asset");
+	old_length = chunk_get(1, other_chunk, chunk_prefix);
+
+	/* The new chunk replaces the old one, which is removed */
+	asset[CHUNK_SIZE] ^= 0xff;
+	zassert_equal(psa_ps_set_extended(ASSET_UID, CHUNK_SIZE, 1, &asset[CHUNK_SIZE]),
+		      PSA_SUCCESS, "Failed to write the asset");
+	zassert_equal(storage_get_object(ASSET_UID, chunk_prefix, chunk, sizeof(chunk), &length),
+		      PSA_ERROR_DOES_NOT_EXIST, "Replaced chunk not removed");
+	asset_check(ASSET_SIZE);
+
+	/* The old chunk, stored in the place of the new one */
+	chunk_get(1, chunk, chunk_prefix);
+	zassert_equal(storage_set_object(ASSET_UID, chunk_prefix, other_chunk, old_length),
+		      PSA_SUCCESS, "Failed to store the chunk");
+	zassert_equal(psa_ps_get(ASSET_UID, CHUNK_SIZE, 1, buf, &length),
+		      PSA_ERROR_INVALID_SIGNATURE, "Replayed chunk accepted");
+}
+
+static void *trusted_storage_setup(void)
+{
+	zassert_equal(psa_crypto_init(), PSA_SUCCESS, "Failed to init PSA crypto");
+	zassert_ok(settings_subsys_init(), "Failed to init the settings subsystem");
+
+	return NULL;
+}
+
+static void trusted_storage_before(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	/* Also removes the chunks of the asset, up to its capacity */
+	(void)psa_ps_remove(ASSET_UID);
+}
+
+ZTEST_SUITE(trusted_storage_aead_chunked, NULL, trusted_storage_setup, trusted_storage_before,
+	    NULL, NULL);
@@ -0,0 +1,247 @@
+/*
+ * Copyright (c) 2024 Nordic Semiconductor ASA
+ *
+ * SPDX-License-Identifier: LicenseRef-Nordic-5-Clause
+ */
+
+#include <zephyr/ztest.h>
+
+#include "storage_backend.h"
+
+#define SLOT_COUNT  CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_NVS_SLOTS
+#define PROBE_COUNT CONFIG_TRUSTED_STORAGE_STORAGE_BACKEND_NVS_PROBES
+
+#define PREFIX	     "ps"
+#define OTHER_PREFIX "its"
+
+#define PREFIX_MAX_LENGTH 15
+#define UID_SEARCH_MAX	  4096
+#define OBJECT_SIZE_MAX	  32
+#define STORED_MAX	  (2 * PROBE_COUNT)
+
+/* Key record of a slot, as hashed by storage_backend_nvs.c */
+struct key_record {
+	psa_storage_uid_t uid;
+	char prefix[PREFIX_MAX_LENGTH + 1];
+};
+
+struct stored_object {
+	psa_storage_uid_t uid;
+	const char *prefix;
+};
+
+static struct stored_object stored[STORED_MAX];
+static size_t stored_count;
+
+static uint32_t slot_of(psa_storage_uid_t uid, const char *prefix)
+{
+	struct key_record key;
+	const uint8_t *bytes = (const uint8_t *)&key;
+	uint32_t hash = 2166136261u;
+
+	memset(&key, 0, sizeof(key));
+	key.uid = uid;
+	strcpy(key.prefix, prefix);
+
+	for (size_t i = 0; i < sizeof(key); i++) {
+		hash ^= bytes[i];
+		hash *= 16777619u;
+	}
+
+	return hash % SLOT_COUNT;
+}
+
+/* Finds UIDs of objects of the given prefix, whose hash gives the given slot. */
+static void uids_find(const char *prefix, uint32_t slot, psa_storage_uid_t *uids, size_t count)
+{
+	size_t found = 0;
+
+	for (psa_storage_uid_t uid = 1; uid < UID_SEARCH_MAX && found < count; uid++) {
+		if (slot_of(uid, prefix) == slot) {
+			uids[found++] = uid;
+		}
+	}
+
+	zassert_equal(found, count, "Not enough UIDs found for slot %u", slot);
+}
+
+static size_t object_fill(uint8_t *data, psa_storage_uid_t uid, const char *prefix)
+{
+	size_t size = 1 + (uid + strlen(prefix)) % OBJECT_SIZE_MAX;
+
+	for (size_t i = 0; i < size; i++) {
+		data[i] = (uint8_t)(uid + i + prefix[0]);
+	}
+
+	return size;
+}
+
+static psa_status_t object_set(psa_storage_uid_t uid, const char *prefix)
+{
+	uint8_t data[OBJECT_SIZE_MAX];
+	size_t size = object_fill(data, uid, prefix);
+	psa_status_t status = storage_set_object(uid, prefix, data, size);
+
+	if (status == PSA_SUCCESS) {
+		zassert_true(stored_count < STORED_MAX, "Too many stored objects");
+		stored[stored_count].uid = uid;
+		stored[stored_count].prefix = prefix;
+		stored_count++;
+	}
+
+	return status;
+}
+
+static void object_check(psa_storage_uid_t uid, const char *prefix)
+{
+	uint8_t expected[OBJECT_SIZE_MAX];
+	uint8_t data[OBJECT_SIZE_MAX];
+	size_t size = object_fill(expected, uid, prefix);
+	size_t length;
+
+	zassert_equal(storage_get_object(uid, prefix, data, sizeof(data), &length), PSA_SUCCESS,
+		      "Failed to get object %s/%llu", prefix, (unsigned long long)uid);
+	zassert_equal(length, size, "Incorrect length");
+	zassert_mem_equal(data, expected, size, "Incorrect data");
+}
+
+static void object_check_removed(psa_storage_uid_t uid, const char *prefix)
+{
+	uint8_t data[OBJECT_SIZE_MAX];
+	size_t length;
+
+	zassert_equal(storage_get_object(uid, prefix, data, sizeof(data), &length),
+		      PSA_ERROR_DOES_NOT_EXIST, "Object %s/%llu found", prefix,
+		      (unsigned long long)uid);
+}
+
+ZTEST(trusted_storage_nvs, test_probe_collision)
+{
+	psa_storage_uid_t uids[2];
+
+	uids_find(PREFIX, 3, uids, ARRAY_SIZE(uids));
+
+	/* The second object is stored in the slot after the slot of its hash */
+	zassert_equal(object_set(uids[0], PREFIX), PSA_SUCCESS, "Failed to set the object");
+	zassert_equal(object_set(uids[1], PREFIX), PSA_SUCCESS, "Failed to set the object");
+	object_check(uids[0], PREFIX);
+	object_check(uids[1], PREFIX);
+
+	/* It is still found once the slot of its hash is empty */
+	zassert_equal(storage_remove_object(uids[0], PREFIX), PSA_SUCCESS,
+		      "Failed to remove the object");
+	object_check_removed(uids[0], PREFIX);
+	object_check(uids[1], PREFIX);
+}
+
+ZTEST(trusted_storage_nvs, test_probe_wraparound)
+{
+	psa_storage_uid_t last_uids[PROBE_COUNT + 1];
+	psa_storage_uid_t first_uids[2];
+
+	uids_find(PREFIX, SLOT_COUNT - 1, last_uids, ARRAY_SIZE(last_uids));
+	uids_find(PREFIX, 0, first_uids, ARRAY_SIZE(first_uids));
+
+	/* The objects of the last slot are stored from the first slot on */
+	for (size_t i = 0; i < PROBE_COUNT; i++) {
+		zassert_equal(object_set(last_uids[i], PREFIX), PSA_SUCCESS,
+			      "Failed to set object %zu", i);
+	}
+	zassert_equal(object_set(last_uids[PROBE_COUNT], PREFIX), PSA_ERROR_INSUFFICIENT_STORAGE,
+		      "Object stored past the probed slots");
+
+	/* Only the slot at PROBE_COUNT - 1 is left for the objects of the first slot */
+	zassert_equal(object_set(first_uids[0], PREFIX), PSA_SUCCESS, "Failed to set the object");
+	zassert_equal(object_set(first_uids[1], PREFIX), PSA_ERROR_INSUFFICIENT_STORAGE,
+		      "Object stored in a used slot");
+
+	for (size_t i = 0; i < PROBE_COUNT; i++) {
+		object_check(last_uids[i], PREFIX);
+	}
+	object_check(first_uids[0], PREFIX);
+}
+
+ZTEST(trusted_storage_nvs, test_probes_exhausted)
+{
+	psa_storage_uid_t uids[PROBE_COUNT + 1];
+	uint8_t data[OBJECT_SIZE_MAX];
+	size_t size;
+
+	uids_find(PREFIX, 5, uids, ARRAY_SIZE(uids));
+
+	for (size_t i = 0; i < PROBE_COUNT; i++) {
+		zassert_equal(object_set(uids[i], PREFIX), PSA_SUCCESS,
+			      "Failed to set object %zu", i);
+	}
+
+	zassert_equal(object_set(uids[PROBE_COUNT], PREFIX), PSA_ERROR_INSUFFICIENT_STORAGE,
+		      "Object stored past the probed slots");
+	object_check_removed(uids[PROBE_COUNT], PREFIX);
+
+	/* The stored objects can still be written */
+	size = object_fill(data, uids[PROBE_COUNT - 1], PREFIX);
+	zassert_equal(storage_set_object(uids[PROBE_COUNT - 1], PREFIX, data, size), PSA_SUCCESS,
+		      "Failed to write a stored object");
+
+	for (size_t i = 0; i < PROBE_COUNT; i++) {
+		object_check(uids[i], PREFIX);
+	}
+}
+
+ZTEST(trusted_storage_nvs, test_removed_slot_reused)
+{
+	psa_storage_uid_t uids[PROBE_COUNT + 1];
+
+	uids_find(PREFIX, 7, uids, ARRAY_SIZE(uids));
+
+	for (size_t i = 0; i < PROBE_COUNT; i++) {
+		zassert_equal(object_set(uids[i], PREFIX), PSA_SUCCESS,
+			      "Failed to set object %zu", i);
+	}
+	zassert_equal(object_set(uids[PROBE_COUNT], PREFIX), PSA_ERROR_INSUFFICIENT_STORAGE,
+		      "Object stored past the probed slots");
+
+	/* The slot of a removed object is used again, the objects after it are still found */
+	zassert_equal(storage_remove_object(uids[1], PREFIX), PSA_SUCCESS,
+		      "Failed to remove the object");
+	zassert_equal(storage_remove_object(uids[1], PREFIX), PSA_ERROR_DOES_NOT_EXIST,
+		      "Object removed twice");
+	zassert_equal(object_set(uids[PROBE_COUNT], PREFIX), PSA_SUCCESS,
+		      "Failed to set the object in the removed slot");
+
+	object_check_removed(uids[1], PREFIX);
+	for (size_t i = 0; i <= PROBE_COUNT; i++) {
+		if (i != 1) {
+			object_check(uids[i], PREFIX);
+		}
+	}
+}
+
+ZTEST(trusted_storage_nvs, test_same_uid_prefixes)
+{
+	const psa_storage_uid_t uid = 0x1234;
+
+	zassert_equal(object_set(uid, PREFIX), PSA_SUCCESS, "Failed to set the object");
+	object_check_removed(uid, OTHER_PREFIX);
+
+	zassert_equal(object_set(uid, OTHER_PREFIX), PSA_SUCCESS, "Failed to set the object");
+	object_check(uid, PREFIX);
+	object_check(uid, OTHER_PREFIX);
+
+	zassert_equal(storage_remove_object(uid, OTHER_PREFIX), PSA_SUCCESS,
+		      "Failed to remove the object");
+	object_check_removed(uid, OTHER_PREFIX);
+	object_check(uid, PREFIX);
+}
+
+static void trusted_storage_after(void *fixture)
+{
+	ARG_UNUSED(fixture);
+
+	for (size_t i = 0; i < stored_count; i++) {
+		(void)storage_remove_object(stored[i].uid, stored[i].prefix);
+	}
+	stored_count = 0;
+}
+
+ZTEST_SUITE(trusted_storage_nvs, NULL, NULL, NULL, trusted_storage_after, NULL);